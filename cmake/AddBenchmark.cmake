@@ -0,0 +1,117 @@
+##---------------------------------------------------------------------------##
+## cmake/AddBenchmark.cmake
+## Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+##---------------------------------------------------------------------------##
+
+include_guard()
+
+#[=======================================================================[.rst:
+add_benchmark
+-------------
+
+Add a Google Benchmark executable linked against the YAYP library and its
+test support library.
+
+.. cmake:command:: add_benchmark
+
+  .. code-block:: cmake
+
+    add_benchmark(<BENCHMARK_FILENAME> [SOURCES <source>...])
+
+  BENCHMARK_FILENAME Specifies the C++ benchmark filename.  The executable
+  target is named after the file with its extension removed.
+
+  SOURCES Specifies additional source files compiled into the benchmark
+  (e.g., kernels that must be built with different settings).
+
+#]=======================================================================]
+
+function(add_benchmark BENCHMARK_FILENAME)
+  cmake_parse_arguments(PARSE_ARGV 1 BENCHMARK "" "" "SOURCES")
+
+  # Compute benchmark name and add benchmark executable
+  string(REGEX REPLACE "\\.[^.]*$" "" BENCHMARK_NAME ${BENCHMARK_FILENAME})
+  add_executable(${BENCHMARK_NAME} ${BENCHMARK_FILENAME} ${BENCHMARK_SOURCES})
+
+  # Set include and link directories and libraries
+  target_include_directories(
+      ${BENCHMARK_NAME}
+      PUBLIC ${PROJECT_SOURCE_DIR}/src)
+  target_link_libraries(${BENCHMARK_NAME}
+                          PRIVATE benchmark::benchmark benchmark::benchmark_main
+                          yayp_testing)
+endfunction()
+
+#[=======================================================================[.rst:
+add_benchmark_gate
+------------------
+
+Compare selected benchmarks of an executable with a stored baseline.
+
+.. cmake:command:: add_benchmark_gate
+
+  .. code-block:: cmake
+
+    add_benchmark_gate(<BENCHMARK_NAME> FILTER <regex>)
+
+  BENCHMARK_NAME Specifies a benchmark executable target added with
+  ``add_benchmark``.  Its baseline is ``baselines/<BENCHMARK_NAME>.json`` in
+  the current source directory, the JSON output of a run with repetitions.
+
+  FILTER Specifies the regular expression selecting the benchmarks to
+  compare (``--benchmark_filter``).
+
+  Nothing is done unless ``YAYP_ENABLE_BENCHMARK_GATE`` is on.  Otherwise a
+  CTest test ``<BENCHMARK_NAME>_gate`` (labeled ``benchmark``) reruns the
+  selected benchmarks ``YAYP_BENCHMARK_REPETITIONS`` times and fails if the
+  median throughput of any of them is more than ``YAYP_BENCHMARK_TOLERANCE``
+  percent below the baseline's, and the target
+  ``<BENCHMARK_NAME>_baseline`` (built by ``benchmark_baselines``) replaces
+  the baseline with a fresh run.  Everything runs locally.
+
+#]=======================================================================]
+
+function(add_benchmark_gate BENCHMARK_NAME)
+  cmake_parse_arguments(PARSE_ARGV 1 GATE "" "FILTER" "")
+  if (NOT YAYP_ENABLE_BENCHMARK_GATE)
+    return()
+  endif ()
+
+  # Arguments shared by the test and the baseline update
+  set(BASELINE ${CMAKE_CURRENT_SOURCE_DIR}/baselines/${BENCHMARK_NAME}.json)
+  set(GATE_ARGS
+      -DBENCHMARK=$<TARGET_FILE:${BENCHMARK_NAME}>
+      -DFILTER=${GATE_FILTER}
+      -DREPETITIONS=${YAYP_BENCHMARK_REPETITIONS}
+      -DBASELINE=${BASELINE})
+
+  # Replace the baseline with a fresh run
+  add_custom_target(${BENCHMARK_NAME}_baseline
+    COMMAND ${CMAKE_COMMAND} ${GATE_ARGS} -DUPDATE=ON
+            -P ${PROJECT_SOURCE_DIR}/cmake/RunBenchmarkGate.cmake
+    DEPENDS ${BENCHMARK_NAME}
+    COMMENT "Recording ${BASELINE}"
+    VERBATIM)
+  add_dependencies(benchmark_baselines ${BENCHMARK_NAME}_baseline)
+
+  # Register the comparison with the baseline (the builtin add_test is
+  # shadowed by the unit test function of AddTest)
+  if (NOT EXISTS ${BASELINE})
+    message(STATUS "No baseline for ${BENCHMARK_NAME}: "
+                   "build benchmark_baselines to record it")
+    return()
+  endif ()
+  _add_test(NAME ${BENCHMARK_NAME}_gate
+    COMMAND ${CMAKE_COMMAND} ${GATE_ARGS}
+            -DRESULTS=${CMAKE_CURRENT_BINARY_DIR}/${BENCHMARK_NAME}.json
+            -DGATE=$<TARGET_FILE:BenchmarkGate>
+            -DTOLERANCE=${YAYP_BENCHMARK_TOLERANCE}
+            -P ${PROJECT_SOURCE_DIR}/cmake/RunBenchmarkGate.cmake)
+  set_tests_properties(${BENCHMARK_NAME}_gate PROPERTIES
+    LABELS benchmark
+    RUN_SERIAL TRUE)
+endfunction()
+
+##---------------------------------------------------------------------------##
+## end of cmake/AddBenchmark.cmake
+##---------------------------------------------------------------------------##
@@ -0,0 +1,53 @@
+##---------------------------------------------------------------------------##
+## cmake/AddFuzzTarget.cmake
+## Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+##---------------------------------------------------------------------------##
+
+include_guard()
+
+#[=======================================================================[.rst:
+add_fuzz_target
+---------------
+
+Add a libFuzzer target built with the address and undefined behavior
+sanitizers.  Requires the Clang compiler.
+
+.. cmake:command:: add_fuzz_target
+
+  .. code-block:: cmake
+
+    add_fuzz_target(<FUZZ_FILENAME>)
+
+  FUZZ_FILENAME Specifies the C++ fuzz target filename.  The executable target
+  is named after the file with its extension removed.  If the directory
+  ``corpus/<target name>`` exists next to the file, it is copied to the build
+  directory as the seed corpus.
+
+#]=======================================================================]
+
+function(add_fuzz_target FUZZ_FILENAME)
+
+  # Compute fuzz target name and add executable
+  string(REGEX REPLACE "\\.[^.]*$" "" FUZZ_NAME ${FUZZ_FILENAME})
+  add_executable(${FUZZ_NAME} ${FUZZ_FILENAME})
+
+  # Set include directories, sanitizers, and libraries
+  target_include_directories(
+      ${FUZZ_NAME}
+      PUBLIC ${PROJECT_SOURCE_DIR}/src)
+  target_compile_options(${FUZZ_NAME}
+                           PRIVATE -fsanitize=fuzzer,address,undefined)
+  target_link_options(${FUZZ_NAME}
+                        PRIVATE -fsanitize=fuzzer,address,undefined)
+  target_link_libraries(${FUZZ_NAME} PRIVATE yayp)
+
+  # Copy the seed corpus
+  set(SEED_DIR "${CMAKE_CURRENT_SOURCE_DIR}/corpus/${FUZZ_NAME}")
+  if (EXISTS ${SEED_DIR})
+    file(COPY ${SEED_DIR} DESTINATION ${CMAKE_CURRENT_BINARY_DIR}/corpus)
+  endif ()
+endfunction()
+
+##---------------------------------------------------------------------------##
+## end of cmake/AddFuzzTarget.cmake
+##---------------------------------------------------------------------------##
@@ -3,7 +3,7 @@
 ## Copyright (c) 2022 Oak Ridge National Laboratory, UT-Battelle, LLC.
 ##---------------------------------------------------------------------------##
 
-include_guard()
+include_guard(GLOBAL)
 
 #[=======================================================================[.rst:
 vulcan_add_tests
@@ -30,7 +30,7 @@ function(add_test TEST_FILENAME)
       PUBLIC ${PROJECT_SOURCE_DIR}/src)
   target_link_libraries(${TEST_NAME}
                           PUBLIC
-                          PRIVATE GTest::gtest GTest::gtest_main yayp)
+                          PRIVATE GTest::gtest GTest::gtest_main yayp_testing)
 
   # Register test
   include(GoogleTest)
@@ -0,0 +1,63 @@
+##---------------------------------------------------------------------------##
+## cmake/RunBenchmarkGate.cmake
+## Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+##---------------------------------------------------------------------------##
+
+#[=======================================================================[.rst:
+RunBenchmarkGate
+----------------
+
+Script run by the tests and targets of ``add_benchmark_gate``.  It runs the
+selected benchmarks of an executable with repetitions, writing their JSON
+results, and then either compares them with the baseline (failing if any
+benchmark regressed) or, with ``UPDATE``, stores them as the new baseline.
+
+.. code-block:: cmake
+
+  cmake -DBENCHMARK=<executable> -DFILTER=<regex> -DREPETITIONS=<count>
+        -DBASELINE=<baseline.json> [-DUPDATE=ON | -DRESULTS=<results.json>
+        -DGATE=<BenchmarkGate> -DTOLERANCE=<percent>]
+        -P RunBenchmarkGate.cmake
+
+#]=======================================================================]
+
+foreach (_var BENCHMARK FILTER REPETITIONS BASELINE)
+  if (NOT DEFINED ${_var})
+    message(FATAL_ERROR "RunBenchmarkGate requires ${_var}")
+  endif ()
+endforeach ()
+
+# Run the benchmarks, reporting only the aggregates of the repetitions
+if (UPDATE)
+  set(_output ${BASELINE})
+  get_filename_component(_directory ${BASELINE} DIRECTORY)
+  file(MAKE_DIRECTORY ${_directory})
+else ()
+  set(_output ${RESULTS})
+endif ()
+execute_process(
+  COMMAND ${BENCHMARK}
+          --benchmark_filter=${FILTER}
+          --benchmark_repetitions=${REPETITIONS}
+          --benchmark_report_aggregates_only=true
+          --benchmark_out=${_output}
+          --benchmark_out_format=json
+  RESULT_VARIABLE _result)
+if (_result)
+  message(FATAL_ERROR "${BENCHMARK} failed: ${_result}")
+endif ()
+if (UPDATE)
+  return()
+endif ()
+
+# Compare their medians with the baseline
+execute_process(
+  COMMAND ${GATE} ${BASELINE} ${_output} ${TOLERANCE}
+  RESULT_VARIABLE _result)
+if (_result)
+  message(FATAL_ERROR "Benchmarks of ${BENCHMARK} regressed from ${BASELINE}")
+endif ()
+
+##---------------------------------------------------------------------------##
+## end of cmake/RunBenchmarkGate.cmake
+##---------------------------------------------------------------------------##
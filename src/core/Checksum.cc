@@ -0,0 +1,115 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/Checksum.cc
+ * \brief  Checksum function definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "Checksum.hh"
+
+#include <cstring>
+
+namespace
+{
+//---------------------------------------------------------------------------//
+constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ull;
+constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr std::uint64_t prime3 = 0x165667B19E3779F9ull;
+
+//---------------------------------------------------------------------------//
+//! Rotate the bits of a word left
+inline std::uint64_t rotl(std::uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+//---------------------------------------------------------------------------//
+//! Mix one word into a lane
+inline std::uint64_t mix(std::uint64_t acc, std::uint64_t word)
+{
+    return rotl(acc + word * prime2, 31) * prime1;
+}
+
+//---------------------------------------------------------------------------//
+//! Load an unaligned word
+inline std::uint64_t load(const unsigned char* p)
+{
+    std::uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a 64-bit checksum of a block of memory
+ *
+ * The checksum detects accidental changes (e.g., truncated or corrupted
+ * files) and is not cryptographically secure.  Four independent lanes
+ * consume 32 bytes per step, so that the checksum of a large block runs
+ * close to memory bandwidth.  Words are read in the native byte order, so
+ * checksums are only comparable between machines of the same endianness.
+ *
+ * \param[in] data  The memory
+ * \param[in] size  The number of bytes
+ * \param[in] seed  A value to start from, e.g. to chain checksums
+ */
+std::uint64_t
+checksum64(const void* data, std::size_t size, std::uint64_t seed)
+{
+    const auto* p   = static_cast<const unsigned char*>(data);
+    const auto* end = p + size;
+
+    std::uint64_t lanes[4] = {seed + prime1 + prime2,
+                              seed + prime2,
+                              seed,
+                              seed - prime1};
+    for (; end - p >= 32; p += 32)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            lanes[i] = mix(lanes[i], load(p + 8 * i));
+        }
+    }
+
+    std::uint64_t h = rotl(lanes[0], 1) + rotl(lanes[1], 7)
+                      + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+    h += static_cast<std::uint64_t>(size);
+    for (; end - p >= 8; p += 8)
+    {
+        h = rotl(h ^ mix(0, load(p)), 27) * prime1 + prime3;
+    }
+    for (; p != end; ++p)
+    {
+        h = rotl(h ^ (*p * prime3), 11) * prime1;
+    }
+
+    // Avalanche
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a 64-bit checksum of a string
+ */
+std::uint64_t checksum64(std::string_view s, std::uint64_t seed)
+{
+    return checksum64(s.data(), s.size(), seed);
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/core/Checksum.cc
+//---------------------------------------------------------------------------//
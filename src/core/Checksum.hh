@@ -0,0 +1,32 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/Checksum.hh
+ * \brief  Checksum function declarations.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_CORE_CHECKSUM_HH
+#define YAYP_CORE_CHECKSUM_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace yayp
+{
+// >>> CHECKSUMS
+// Return a 64-bit checksum of a block of memory
+std::uint64_t
+checksum64(const void* data, std::size_t size, std::uint64_t seed = 0);
+
+// Return a 64-bit checksum of a string
+std::uint64_t checksum64(std::string_view s, std::uint64_t seed = 0);
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_CORE_CHECKSUM_HH
+//---------------------------------------------------------------------------//
+// end of src/core/Checksum.hh
+//---------------------------------------------------------------------------//
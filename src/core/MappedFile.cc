@@ -0,0 +1,150 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/MappedFile.cc
+ * \brief  MappedFile class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "MappedFile.hh"
+
+#include <cstdint>
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define YAYP_MAPPEDFILE_MMAP 1
+#endif
+
+#include "harness/DBC.hh"
+#include "harness/Timing.hh"
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Map the given file
+ *
+ * \param[in] filename  The file to map
+ */
+MappedFile::MappedFile(const std::string& filename)
+{
+    YAYP_TIMER_DETAIL(Read);
+
+#ifdef YAYP_MAPPEDFILE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw Exception("Unable to open file '" + filename + "'");
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw Exception("Unable to read the size of file '" + filename + "'");
+    }
+    m_size = static_cast<std::size_t>(info.st_size);
+    if (m_size > 0)
+    {
+        void* addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED)
+        {
+            ::close(fd);
+            throw Exception("Unable to map file '" + filename + "'");
+        }
+        m_data   = static_cast<const char*>(addr);
+        m_mapped = true;
+    }
+    ::close(fd);
+#else
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    if (!in)
+    {
+        throw Exception("Unable to open file '" + filename + "'");
+    }
+    m_size = static_cast<std::size_t>(in.tellg());
+    if (m_size > 0)
+    {
+        // Allocate in words so that the contents are aligned
+        auto* buffer = new std::uint64_t[(m_size + 7) / 8];
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(buffer),
+                static_cast<std::streamsize>(m_size));
+        m_data = reinterpret_cast<const char*>(buffer);
+        if (!in)
+        {
+            this->release();
+            throw Exception("Unable to read file '" + filename + "'");
+        }
+    }
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Unmap the file
+ */
+MappedFile::~MappedFile()
+{
+    this->release();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Move constructor
+ */
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_mapped(std::exchange(other.m_mapped, false))
+{
+    /* * */
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Move assignment
+ */
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        this->release();
+        m_data   = std::exchange(other.m_data, nullptr);
+        m_size   = std::exchange(other.m_size, 0);
+        m_mapped = std::exchange(other.m_mapped, false);
+    }
+    return *this;
+}
+
+//---------------------------------------------------------------------------//
+// PRIVATE IMPLEMENTATION FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Release the contents
+ */
+void MappedFile::release() noexcept
+{
+#ifdef YAYP_MAPPEDFILE_MMAP
+    if (m_mapped)
+    {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+#else
+    delete[] reinterpret_cast<const std::uint64_t*>(m_data);
+#endif
+    m_data   = nullptr;
+    m_size   = 0;
+    m_mapped = false;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/core/MappedFile.cc
+//---------------------------------------------------------------------------//
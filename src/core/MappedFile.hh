@@ -0,0 +1,83 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/MappedFile.hh
+ * \brief  MappedFile class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_CORE_MAPPEDFILE_HH
+#define YAYP_CORE_MAPPEDFILE_HH
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace yayp
+{
+//===========================================================================//
+/*!
+ * \class MappedFile
+ * \brief Read-only view of the contents of a file.
+ *
+ * On POSIX systems the file is mapped into memory, so opening it costs a
+ * single system call regardless of its size and pages are only read as they
+ * are accessed.  Elsewhere the file is read into memory.  The data is
+ * aligned to at least 8 bytes and remains valid until the MappedFile is
+ * destroyed or moved from.
+ *
+ * The constructor throws an Exception if the file cannot be opened or
+ * mapped.
+ *
+ * \example src/core/tests/tstMappedFile.cc
+ */
+//===========================================================================//
+
+class MappedFile
+{
+  public:
+    // Construct an empty view
+    MappedFile() = default;
+
+    // Map the given file
+    explicit MappedFile(const std::string& filename);
+
+    // Unmap the file
+    ~MappedFile();
+
+    //@{
+    //! Move-only
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    //@}
+
+    // >>> ACCESSORS
+    //! Return the file contents
+    const char* data() const { return m_data; }
+
+    //! Return the file size in bytes
+    std::size_t size() const { return m_size; }
+
+    //! Return the file contents as a string view
+    std::string_view view() const { return std::string_view(m_data, m_size); }
+
+  private:
+    // Release the contents
+    void release() noexcept;
+
+  private:
+    // >>> DATA
+    const char* m_data   = nullptr;
+    std::size_t m_size   = 0;
+    bool        m_mapped = false;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_CORE_MAPPEDFILE_HH
+//---------------------------------------------------------------------------//
+// end of src/core/MappedFile.hh
+//---------------------------------------------------------------------------//
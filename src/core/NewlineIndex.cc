@@ -0,0 +1,285 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/NewlineIndex.cc
+ * \brief  NewlineIndex class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "NewlineIndex.hh"
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define YAYP_NEWLINE_SSE2 1
+#endif
+
+#include "harness/DBC.hh"
+#include "harness/Timing.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a bitmap of the newlines among the given 64 bytes
+ */
+inline std::uint64_t newlineMask(const char* p)
+{
+#ifdef YAYP_NEWLINE_SSE2
+    const __m128i nl = _mm_set1_epi8('\n');
+    auto          chunk = [p, nl](int i) {
+        __m128i bytes = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(p + 16 * i));
+        return static_cast<std::uint64_t>(static_cast<std::uint16_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, nl))));
+    };
+    return chunk(0) | (chunk(1) << 16) | (chunk(2) << 32) | (chunk(3) << 48);
+#else
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        mask |= static_cast<std::uint64_t>(p[i] == '\n') << i;
+    }
+    return mask;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a bitmap of the UTF-8 continuation bytes among 64 bytes
+ */
+inline std::uint64_t continuationMask(const char* p)
+{
+#ifdef YAYP_NEWLINE_SSE2
+    // Continuation bytes (0x80 to 0xBF) are the signed bytes below -64
+    const __m128i lead  = _mm_set1_epi8(-64);
+    auto          chunk = [p, lead](int i) {
+        __m128i bytes = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(p + 16 * i));
+        return static_cast<std::uint64_t>(static_cast<std::uint16_t>(
+            _mm_movemask_epi8(_mm_cmplt_epi8(bytes, lead))));
+    };
+    return chunk(0) | (chunk(1) << 16) | (chunk(2) << 32) | (chunk(3) << 48);
+#else
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        const auto byte = static_cast<unsigned char>(p[i]);
+        mask |= static_cast<std::uint64_t>((byte & 0xC0) == 0x80) << i;
+    }
+    return mask;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the number of set bits
+ */
+inline int popcount(std::uint64_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(mask);
+#else
+    int count = 0;
+    for (; mask; mask &= mask - 1)
+    {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the index of the lowest set bit of a nonzero mask
+ */
+inline int lowestBit(std::uint64_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#else
+    int index = 0;
+    for (; !(mask & 1); mask >>= 1)
+    {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor
+ *
+ * The index is built on first use.
+ *
+ * \param[in] text  The text, which must outlive the index
+ */
+NewlineIndex::NewlineIndex(std::string_view text) : m_text(text)
+{
+    /* * */
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Index a new text, keeping the allocated storage
+ *
+ * \param[in] text  The text, which must outlive the index
+ */
+void NewlineIndex::reset(std::string_view text)
+{
+    m_text  = text;
+    m_built = false;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build the index if it is not yet built
+ *
+ * Each block of 64 bytes is reduced to a bitmap of its newlines.  The
+ * population count of the bitmap sizes the output, and the positions are
+ * then extracted by clearing the lowest set bit, so the cost depends on the
+ * number of lines rather than on the number of bytes.
+ */
+void NewlineIndex::build() const
+{
+    if (m_built)
+    {
+        return;
+    }
+    YAYP_TIMER_DETAIL(Index);
+
+    m_starts.clear();
+    m_starts.push_back(0);
+
+    const char* const begin = m_text.data();
+    const std::size_t size  = m_text.size();
+    auto append = [this](std::uint64_t mask, std::size_t base) {
+        std::size_t n = m_starts.size();
+        m_starts.resize(n + static_cast<std::size_t>(popcount(mask)));
+        for (; mask; mask &= mask - 1)
+        {
+            m_starts[n++] = base + static_cast<std::size_t>(lowestBit(mask))
+                            + 1;
+        }
+    };
+
+    std::size_t offset = 0;
+    for (; offset + 64 <= size; offset += 64)
+    {
+        if (std::uint64_t mask = newlineMask(begin + offset))
+        {
+            append(mask, offset);
+        }
+    }
+
+    // Pad the remaining bytes to a full block
+    if (offset < size)
+    {
+        char tail[64] = {};
+        std::copy(begin + offset, begin + size, tail);
+        append(newlineMask(tail), offset);
+    }
+
+    m_built = true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the line and column of a byte offset
+ *
+ * The offset of the end of the text is valid, and a newline belongs to the
+ * line it ends.  The column is counted 64 bytes at a time, as the population
+ * count of the bitmap of continuation bytes between the line start and the
+ * offset.
+ *
+ * \param[in] offset  The byte offset, which may not exceed the text size
+ */
+NewlineIndex::Location NewlineIndex::locate(std::size_t offset) const
+{
+    YAYP_REQUIRE(offset <= m_text.size());
+    this->build();
+
+    // Find the last line starting at or before the offset
+    auto iter = std::upper_bound(m_starts.begin(), m_starts.end(), offset);
+    YAYP_CHECK(iter != m_starts.begin());
+    --iter;
+
+    // Count the characters, skipping UTF-8 continuation bytes
+    const char* const begin         = m_text.data();
+    std::size_t       pos           = *iter;
+    std::size_t       continuations = 0;
+    for (; pos + 64 <= offset; pos += 64)
+    {
+        continuations += popcount(continuationMask(begin + pos));
+    }
+    if (pos < offset)
+    {
+        // Zero padding holds no continuation bytes
+        char tail[64] = {};
+        std::copy(begin + pos, begin + offset, tail);
+        continuations += popcount(continuationMask(tail));
+    }
+
+    Location result;
+    result.line   = static_cast<std::size_t>(iter - m_starts.begin()) + 1;
+    result.column = offset - *iter - continuations + 1;
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the number of lines
+ *
+ * Text after the last newline (or the empty text) is a line of its own.
+ */
+std::size_t NewlineIndex::numLines() const
+{
+    this->build();
+    return m_starts.size();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the byte offset of the start of a line
+ *
+ * \param[in] line  The line number, starting at 1
+ */
+std::size_t NewlineIndex::lineStart(std::size_t line) const
+{
+    this->build();
+    YAYP_REQUIRE(line >= 1 && line <= m_starts.size());
+    return m_starts[line - 1];
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the text of a line, excluding its line break
+ *
+ * \param[in] line  The line number, starting at 1
+ */
+std::string_view NewlineIndex::line(std::size_t line) const
+{
+    std::size_t start = this->lineStart(line);
+    std::size_t end   = line < m_starts.size() ? m_starts[line] - 1
+                                               : m_text.size();
+    if (end > start && m_text[end - 1] == '\r')
+    {
+        --end;
+    }
+    return m_text.substr(start, end - start);
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/core/NewlineIndex.cc
+//---------------------------------------------------------------------------//
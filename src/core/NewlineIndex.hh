@@ -0,0 +1,94 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/NewlineIndex.hh
+ * \brief  NewlineIndex class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_CORE_NEWLINEINDEX_HH
+#define YAYP_CORE_NEWLINEINDEX_HH
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace yayp
+{
+//===========================================================================//
+/*!
+ * \class NewlineIndex
+ * \brief Maps byte offsets in a text to line and column numbers.
+ *
+ * The index holds the offset at which each line starts.  It is built on
+ * first use, in a single pass that compares the text 64 bytes at a time
+ * against a newline (with SSE2 where available) and extracts the positions
+ * from the resulting bitmap; a lookup is then a binary search over the line
+ * starts.  Lines end at \c '\\n', so CRLF line endings are handled and a lone
+ * \c '\\r' is not a line break.
+ *
+ * Line and column numbers start at 1.  The column counts UTF-8 characters
+ * (i.e., bytes other than continuation bytes) from the start of the line to
+ * the offset.  They are counted 64 bytes at a time in the same way, so a
+ * lookup still costs time linear in the column, but with a small constant.
+ *
+ * The text is not copied and must outlive the index.  Lazy building mutates
+ * the index, so call build() before sharing an index between threads.
+ *
+ * \example src/core/tests/tstNewlineIndex.cc
+ */
+//===========================================================================//
+
+class NewlineIndex
+{
+  public:
+    //! A location in the text
+    struct Location
+    {
+        std::size_t line   = 0;
+        std::size_t column = 0;
+    };
+
+  public:
+    // Constructor
+    explicit NewlineIndex(std::string_view text = {});
+
+    // Index a new text, keeping the allocated storage
+    void reset(std::string_view text);
+
+    // Build the index if it is not yet built
+    void build() const;
+
+    // Return the line and column of a byte offset
+    Location locate(std::size_t offset) const;
+
+    // Return the number of lines
+    std::size_t numLines() const;
+
+    // Return the byte offset of the start of a line
+    std::size_t lineStart(std::size_t line) const;
+
+    // Return the text of a line, excluding its line break
+    std::string_view line(std::size_t line) const;
+
+    // >>> ACCESSORS
+    //! Return the indexed text
+    std::string_view text() const { return m_text; }
+
+    //! Return whether the index has been built
+    bool isBuilt() const { return m_built; }
+
+  private:
+    // >>> DATA
+    std::string_view                 m_text;
+    mutable std::vector<std::size_t> m_starts;
+    mutable bool                     m_built = false;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_CORE_NEWLINEINDEX_HH
+//---------------------------------------------------------------------------//
+// end of src/core/NewlineIndex.hh
+//---------------------------------------------------------------------------//
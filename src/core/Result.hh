@@ -0,0 +1,109 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/Result.hh
+ * \brief  Result class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_CORE_RESULT_HH
+#define YAYP_CORE_RESULT_HH
+
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace yayp
+{
+//===========================================================================//
+/*!
+ * \class Result
+ * \brief Holds either a value or the error that prevented computing it.
+ *
+ * Result is returned by the non-throwing APIs, so that expected failures
+ * (e.g., invalid input) are reported without the cost of an exception.  It
+ * converts implicitly from both the value and the error type, so a function
+ * returning a Result simply returns either one:
+ * \code
+ *   Result<int, ParseError> parseCount(std::string_view s)
+ *   {
+ *       if (s.empty())
+ *           return ParseError{ParseErrorCode::UnexpectedContent, 0};
+ *       return 42;
+ *   }
+ * \endcode
+ *
+ * Accessing the value of a failed result (or the error of a successful one)
+ * is a precondition violation.
+ *
+ * \tparam T  The value type
+ * \tparam E  The error type
+ *
+ * \example src/core/tests/tstResult.cc
+ */
+//===========================================================================//
+
+template<class T, class E>
+class Result
+{
+    static_assert(!std::is_same_v<T, E>,
+                  "The value and error types of a Result must differ");
+
+  public:
+    //@{
+    //! Public type aliases
+    using value_type = T;
+    using error_type = E;
+    //@}
+
+  public:
+    //! Construct a successful result
+    Result(T value)
+        : m_storage(std::in_place_index<0>, std::move(value))
+    {
+        /* * */
+    }
+
+    //! Construct a failed result
+    Result(E error)
+        : m_storage(std::in_place_index<1>, std::move(error))
+    {
+        /* * */
+    }
+
+    // >>> ACCESSORS
+    //! Return whether the result holds a value
+    bool ok() const { return m_storage.index() == 0; }
+
+    //! Return whether the result holds a value
+    explicit operator bool() const { return this->ok(); }
+
+    // Return the value
+    inline T&       value() &;
+    inline const T& value() const&;
+    inline T&&      value() &&;
+
+    // Return the error
+    inline const E& error() const;
+
+    // Return the value, or the given fallback if the result is an error
+    inline T valueOr(T fallback) const&;
+    inline T valueOr(T fallback) &&;
+
+  private:
+    // >>> DATA
+    std::variant<T, E> m_storage;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// INLINE DEFINITIONS
+//---------------------------------------------------------------------------//
+#include "Result.i.hh"
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_CORE_RESULT_HH
+//---------------------------------------------------------------------------//
+// end of src/core/Result.hh
+//---------------------------------------------------------------------------//
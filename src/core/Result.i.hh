@@ -0,0 +1,92 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/Result.i.hh
+ * \brief  Result inline and template definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_CORE_RESULT_I_HH
+#define YAYP_CORE_RESULT_I_HH
+
+#include "harness/DBC.hh"
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the value
+ */
+template<class T, class E>
+T& Result<T, E>::value() &
+{
+    YAYP_REQUIRE(this->ok());
+    return *std::get_if<0>(&m_storage);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the value
+ */
+template<class T, class E>
+const T& Result<T, E>::value() const&
+{
+    YAYP_REQUIRE(this->ok());
+    return *std::get_if<0>(&m_storage);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Move the value out of the result
+ */
+template<class T, class E>
+T&& Result<T, E>::value() &&
+{
+    YAYP_REQUIRE(this->ok());
+    return std::move(*std::get_if<0>(&m_storage));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the error
+ */
+template<class T, class E>
+const E& Result<T, E>::error() const
+{
+    YAYP_REQUIRE(!this->ok());
+    return *std::get_if<1>(&m_storage);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the value, or the given fallback if the result is an error
+ *
+ * \param[in] fallback  The value returned for a failed result
+ */
+template<class T, class E>
+T Result<T, E>::valueOr(T fallback) const&
+{
+    return this->ok() ? *std::get_if<0>(&m_storage) : std::move(fallback);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Move the value out of the result, or return the given fallback if
+ *        the result is an error
+ *
+ * \param[in] fallback  The value returned for a failed result
+ */
+template<class T, class E>
+T Result<T, E>::valueOr(T fallback) &&
+{
+    return this->ok() ? std::move(*std::get_if<0>(&m_storage))
+                      : std::move(fallback);
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+#endif // YAYP_CORE_RESULT_I_HH
+
+//---------------------------------------------------------------------------//
+// end of src/core/Result.i.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,122 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/Span.hh
+ * \brief  Span class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_CORE_SPAN_HH
+#define YAYP_CORE_SPAN_HH
+
+#include <cstddef>
+#include <type_traits>
+
+#include "harness/DBC.hh"
+
+namespace yayp
+{
+//===========================================================================//
+/*!
+ * \class Span
+ * \brief A non-owning view of contiguous elements.
+ *
+ * This is the subset of C++20 \c std::span (with a dynamic extent) that the
+ * library needs.  A span is a pointer and a size, so it is cheap to copy and
+ * pass by value; it is only valid while the storage it views is alive.
+ *
+ * Like a standard container it has a \c value_type and iterators, so that it
+ * can be compared directly with the container testing macros:
+ * \code
+ *   EXPECT_CONT_SOFT_EQ(expected, node.packed()->floats());
+ * \endcode
+ *
+ * \tparam T  The element type, usually const-qualified
+ *
+ * \example src/core/tests/tstSpan.cc
+ */
+//===========================================================================//
+
+template<class T>
+class Span
+{
+  public:
+    //@{
+    //! Public type aliases
+    using element_type   = T;
+    using value_type     = std::remove_cv_t<T>;
+    using size_type      = std::size_t;
+    using pointer        = T*;
+    using reference      = T&;
+    using iterator       = T*;
+    using const_iterator = const T*;
+    //@}
+
+  public:
+    //! Construct an empty span
+    constexpr Span() = default;
+
+    //! Construct a view of the given elements
+    constexpr Span(pointer data, size_type size) : m_data(data), m_size(size)
+    {
+        /* * */
+    }
+
+    //! Construct a view of the elements of a contiguous container
+    template<class Container,
+             class = std::enable_if_t<
+                 !std::is_same_v<std::remove_cv_t<Container>, Span>>>
+    constexpr Span(Container& values)
+        : m_data(values.data()), m_size(values.size())
+    {
+        /* * */
+    }
+
+    // >>> ACCESSORS
+    //! Return the number of elements
+    constexpr size_type size() const { return m_size; }
+
+    //! Return whether there are no elements
+    constexpr bool empty() const { return m_size == 0; }
+
+    //! Return a pointer to the first element
+    constexpr pointer data() const { return m_data; }
+
+    //! Return an iterator to the first element
+    constexpr iterator begin() const { return m_data; }
+
+    //! Return an iterator past the last element
+    constexpr iterator end() const { return m_data + m_size; }
+
+    //! Return a read-only iterator to the first element
+    constexpr const_iterator cbegin() const { return m_data; }
+
+    //! Return a read-only iterator past the last element
+    constexpr const_iterator cend() const { return m_data + m_size; }
+
+    //! Return the element at the given index
+    reference operator[](size_type index) const
+    {
+        YAYP_REQUIRE(index < m_size);
+        return m_data[index];
+    }
+
+    //! Return the first element
+    reference front() const { return (*this)[0]; }
+
+    //! Return the last element
+    reference back() const { return (*this)[m_size - 1]; }
+
+  private:
+    // >>> DATA
+    pointer   m_data = nullptr;
+    size_type m_size = 0;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_CORE_SPAN_HH
+//---------------------------------------------------------------------------//
+// end of src/core/Span.hh
+//---------------------------------------------------------------------------//
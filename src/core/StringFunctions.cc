@@ -218,8 +218,20 @@ std::vector<std::string> split(const std::string& s, std::size_t max_splits)
 std::vector<std::string>
 split(const std::string& s, const std::string& sep, std::size_t max_splits)
 {
+    YAYP_REQUIRE(!sep.empty());
+
+    // Count the substrings, so that the results are allocated once
+    std::size_t num_results = 1;
+    for (std::size_t pos = s.find(sep);
+         pos != std::string::npos && num_results <= max_splits;
+         pos = s.find(sep, pos + sep.size()))
+    {
+        ++num_results;
+    }
+
     // Create a vector to hold the results
     std::vector<std::string> result;
+    result.reserve(num_results);
 
     // Loop and find all of the substrings
     std::size_t num_splits = 0;
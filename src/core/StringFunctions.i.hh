@@ -60,11 +60,20 @@ std::string join(BiDirectionalIterator begin,
         return result;
     }
 
-    // Loop and append strings, adding separator between
+    // Reserve the joined size, so that the result is allocated once
     BiDirectionalIterator iter_end = --end;
+    std::size_t           size     = iter_end->size();
+    for (auto iter = begin; iter != iter_end; ++iter)
+    {
+        size += iter->size() + separator.size();
+    }
+    result.reserve(size);
+
+    // Loop and append strings, adding separator between
     while (begin != iter_end)
     {
-        result += *(begin++) + separator;
+        result += *(begin++);
+        result += separator;
     }
     result += *iter_end;
 
@@ -0,0 +1,36 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/benchmarks/DBCKernel.hh
+ * \brief  String kernels compiled at different DBC levels.
+ *
+ * The kernels mirror the inner loop of yayp::split(s, sep), including its
+ * precondition, without allocating, so that the cost of the precondition is
+ * not hidden behind the cost of building strings.  Each namespace holds the
+ * same kernel compiled at the DBC level in its name (see DBCKernel.i.hh).
+ *
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_CORE_BENCHMARKS_DBCKERNEL_HH
+#define YAYP_CORE_BENCHMARKS_DBCKERNEL_HH
+
+#include <cstddef>
+#include <string_view>
+
+namespace dbc0
+{
+// Count the fields of the string along the separator with YAYP_DBC == 0
+std::size_t countFields(std::string_view s, std::string_view sep);
+} // namespace dbc0
+
+namespace dbc1
+{
+// Count the fields of the string along the separator with YAYP_DBC == 1
+std::size_t countFields(std::string_view s, std::string_view sep);
+} // namespace dbc1
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_CORE_BENCHMARKS_DBCKERNEL_HH
+//---------------------------------------------------------------------------//
+// end of src/core/benchmarks/DBCKernel.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,47 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/benchmarks/DBCKernel.i.hh
+ * \brief  String kernel definitions, compiled once per DBC level.
+ *
+ * Before including this file, define YAYP_DBC to the desired level and
+ * YAYP_DBC_KERNEL_NS to the namespace of the kernels.  It must be included
+ * before any other header that includes harness/DBC.hh.
+ *
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "DBCKernel.hh"
+
+#include "harness/DBC.hh"
+
+namespace YAYP_DBC_KERNEL_NS
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Count the fields of the string along the separator
+ *
+ * \param[in] s    The string to split
+ * \param[in] sep  The separator
+ * \return The number of fields yayp::split(s, sep) would return
+ */
+std::size_t countFields(std::string_view s, std::string_view sep)
+{
+    YAYP_REQUIRE(!sep.empty());
+
+    std::size_t count = 1;
+    std::size_t pos   = s.find(sep);
+    while (pos != std::string_view::npos)
+    {
+        ++count;
+        pos = s.find(sep, pos + sep.size());
+    }
+    return count;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace YAYP_DBC_KERNEL_NS
+
+//---------------------------------------------------------------------------//
+// end of src/core/benchmarks/DBCKernel.i.hh
+//---------------------------------------------------------------------------//
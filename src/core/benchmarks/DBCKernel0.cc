@@ -0,0 +1,16 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/benchmarks/DBCKernel0.cc
+ * \brief  String kernels compiled with YAYP_DBC == 0.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#undef YAYP_DBC
+#define YAYP_DBC 0
+#define YAYP_DBC_KERNEL_NS dbc0
+#include "DBCKernel.i.hh"
+
+//---------------------------------------------------------------------------//
+// end of src/core/benchmarks/DBCKernel0.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,16 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/benchmarks/DBCKernel1.cc
+ * \brief  String kernels compiled with YAYP_DBC == 1.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#undef YAYP_DBC
+#define YAYP_DBC 1
+#define YAYP_DBC_KERNEL_NS dbc1
+#include "DBCKernel.i.hh"
+
+//---------------------------------------------------------------------------//
+// end of src/core/benchmarks/DBCKernel1.cc
+//---------------------------------------------------------------------------//
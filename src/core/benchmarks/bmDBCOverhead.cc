@@ -0,0 +1,160 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/benchmarks/bmDBCOverhead.cc
+ * \brief  Benchmarks for the overhead of DBC preconditions.
+ *
+ * The same string kernel is compiled with YAYP_DBC == 0 and YAYP_DBC == 1
+ * (see DBCKernel.hh) and run over many short lines, so that each call does
+ * little work besides its precondition.  BM_RequireOverhead interleaves the
+ * two kernels and reports the relative cost of the level 1 checks as the
+ * "overhead_pct" counter.
+ *
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "DBCKernel.hh"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "core/StringFunctions.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a set of short comma-separated lines
+ */
+const std::vector<std::string>& lines()
+{
+    static const std::vector<std::string> result = [] {
+        std::vector<std::string> lines;
+        for (int i = 0; i < 4096; ++i)
+        {
+            std::string line = "key" + std::to_string(i);
+            for (int field = 0; field < i % 4; ++field)
+            {
+                line += ", value" + std::to_string(field);
+            }
+            lines.push_back(std::move(line));
+        }
+        return lines;
+    }();
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Count the fields of all lines with the given kernel
+ */
+template<class Kernel>
+std::size_t countAll(Kernel kernel)
+{
+    std::size_t count = 0;
+    for (const auto& line : lines())
+    {
+        count += kernel(line, ", ");
+    }
+    return count;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Run the given kernel over all lines and report the throughput
+ */
+template<class Kernel>
+void runKernel(benchmark::State& state, Kernel kernel)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(countAll(kernel));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(lines().size()));
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// BENCHMARKS
+//---------------------------------------------------------------------------//
+
+static void BM_CountFieldsDBC0(benchmark::State& state)
+{
+    runKernel(state, dbc0::countFields);
+}
+BENCHMARK(BM_CountFieldsDBC0);
+
+//---------------------------------------------------------------------------//
+
+static void BM_CountFieldsDBC1(benchmark::State& state)
+{
+    runKernel(state, dbc1::countFields);
+}
+BENCHMARK(BM_CountFieldsDBC1);
+
+//---------------------------------------------------------------------------//
+
+static void BM_RequireOverhead(benchmark::State& state)
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto time = [](auto kernel) {
+        auto start = Clock::now();
+        benchmark::DoNotOptimize(countAll(kernel));
+        return Clock::now() - start;
+    };
+
+    // Interleave the kernels, alternating which runs first, so that both see
+    // the same machine state
+    Clock::duration level0{};
+    Clock::duration level1{};
+    bool            first = true;
+    for (auto _ : state)
+    {
+        if (first)
+        {
+            level0 += time(dbc0::countFields);
+            level1 += time(dbc1::countFields);
+        }
+        else
+        {
+            level1 += time(dbc1::countFields);
+            level0 += time(dbc0::countFields);
+        }
+        first = !first;
+    }
+
+    const double t0 = std::chrono::duration<double>(level0).count();
+    const double t1 = std::chrono::duration<double>(level1).count();
+    state.counters["overhead_pct"] = t0 > 0.0 ? 100.0 * (t1 - t0) / t0 : 0.0;
+}
+BENCHMARK(BM_RequireOverhead)->MinTime(1.0);
+
+//---------------------------------------------------------------------------//
+
+static void BM_Split(benchmark::State& state)
+{
+    // The library split, at the configured DBC level, for reference
+    for (auto _ : state)
+    {
+        std::size_t count = 0;
+        for (const auto& line : lines())
+        {
+            count += yayp::split(line, ", ").size();
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(lines().size()));
+}
+BENCHMARK(BM_Split);
+
+//---------------------------------------------------------------------------//
+// end of src/core/benchmarks/bmDBCOverhead.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,126 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/benchmarks/bmNewlineIndex.cc
+ * \brief  Benchmarks for class NewlineIndex.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../NewlineIndex.hh"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return roughly 16 MB of configuration-like text
+ */
+const std::string& text()
+{
+    static const std::string result = [] {
+        constexpr std::size_t size = 16 * 1024 * 1024;
+
+        std::string text;
+        text.reserve(size + 256);
+        std::size_t i = 0;
+        while (text.size() < size)
+        {
+            text += "  parameter_";
+            text += std::to_string(i++);
+            text += ": {value: 1.5e-3, units: \"m/s\"}  # comment\n";
+        }
+        return text;
+    }();
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return random offsets into the text
+ */
+const std::vector<std::size_t>& offsets()
+{
+    static const std::vector<std::size_t> result = [] {
+        std::mt19937             rng(1);
+        std::vector<std::size_t> offsets(1024);
+        for (auto& offset : offsets)
+        {
+            offset = rng() % text().size();
+        }
+        return offsets;
+    }();
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// BENCHMARKS
+//---------------------------------------------------------------------------//
+
+static void BM_Build(benchmark::State& state)
+{
+    yayp::NewlineIndex index;
+    for (auto _ : state)
+    {
+        index.reset(text());
+        index.build();
+        benchmark::DoNotOptimize(index.numLines());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(text().size()));
+}
+BENCHMARK(BM_Build);
+
+//---------------------------------------------------------------------------//
+
+static void BM_Locate(benchmark::State& state)
+{
+    yayp::NewlineIndex index(text());
+    index.build();
+    for (auto _ : state)
+    {
+        for (std::size_t offset : offsets())
+        {
+            benchmark::DoNotOptimize(index.locate(offset));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(offsets().size()));
+}
+BENCHMARK(BM_Locate);
+
+//---------------------------------------------------------------------------//
+
+static void BM_LinearScan(benchmark::State& state)
+{
+    // Counting newlines up to each offset, for reference
+    const std::string&             s = text();
+    const std::vector<std::size_t> few(offsets().begin(),
+                                       offsets().begin() + 16);
+    for (auto _ : state)
+    {
+        for (std::size_t offset : few)
+        {
+            std::size_t line = 1;
+            for (std::size_t i = 0; i < offset; ++i)
+            {
+                line += (s[i] == '\n');
+            }
+            benchmark::DoNotOptimize(line);
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(few.size()));
+}
+BENCHMARK(BM_LinearScan)->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------//
+// end of src/core/benchmarks/bmNewlineIndex.cc
+//---------------------------------------------------------------------------//
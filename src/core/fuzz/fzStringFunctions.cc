@@ -0,0 +1,113 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/fuzz/fzStringFunctions.cc
+ * \brief  libFuzzer target for the StringFunctions entry points.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ *
+ * The input is laid out as
+ *  - byte 0: maximum number of splits/replacements (255 for no limit),
+ *  - byte 1: separator length (1-4),
+ *  - byte 2: character set length (0-7),
+ *  - the separator, the character set, and the string to process.
+ *
+ * Besides running under the sanitizers, the target checks invariants that
+ * relate the functions to one another (e.g., joining the split pieces with
+ * the separator restores the string) and traps when one is violated.
+ */
+//---------------------------------------------------------------------------//
+
+#include "core/StringFunctions.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Abort the fuzzer run if the invariant does not hold
+ */
+void expect(bool invariant)
+{
+    if (!invariant)
+    {
+        __builtin_trap();
+    }
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// FUZZ TARGET
+//---------------------------------------------------------------------------//
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data,
+                                      std::size_t         size)
+{
+    if (size < 3)
+    {
+        return 0;
+    }
+
+    // Decode the parameters
+    std::size_t max_splits = (data[0] == 255)
+                                 ? std::numeric_limits<std::size_t>::max()
+                                 : data[0];
+    std::size_t sep_size   = 1 + data[1] % 4;
+    std::size_t set_size   = data[2] % 8;
+    data += 3, size -= 3;
+    if (size < sep_size + set_size)
+    {
+        return 0;
+    }
+    const char* chars = reinterpret_cast<const char*>(data);
+    std::string sep(chars, sep_size);
+    std::string char_set(chars + sep_size, set_size);
+    std::string s(chars + sep_size + set_size, size - sep_size - set_size);
+
+    // >>> SPLIT AND JOIN
+    auto pieces = yayp::split(s, sep, max_splits);
+    expect(yayp::join(pieces, sep) == s);
+    expect(max_splits == std::numeric_limits<std::size_t>::max()
+           || pieces.size() <= max_splits + 1);
+
+    auto words = yayp::split(s, max_splits);
+    for (const auto& word : words)
+    {
+        expect(!word.empty());
+    }
+
+    // >>> FIND AND REPLACE
+    expect(yayp::findAndReplace(s, sep, sep, max_splits) == s);
+    expect(yayp::findAndReplace(s, sep, char_set, 0) == s);
+    auto replaced = yayp::findAndReplace(s, sep, char_set, max_splits);
+    if (char_set.empty())
+    {
+        expect(replaced.size() <= s.size());
+    }
+
+    // >>> STRIP
+    auto stripped = yayp::strip(char_set, s);
+    expect(s.find(stripped) != std::string::npos);
+    if (!stripped.empty())
+    {
+        expect(char_set.find(stripped.front()) == std::string::npos);
+        expect(char_set.find(stripped.back()) == std::string::npos);
+    }
+    expect(yayp::lstrip(char_set, yayp::rstrip(char_set, s)) == stripped);
+    expect(yayp::strip(s).size() <= s.size());
+    expect(yayp::strip(yayp::strip(s)) == yayp::strip(s));
+
+    // >>> CASE CONVERSION
+    expect(yayp::toLower(s).size() == s.size());
+    expect(yayp::toUpper(s).size() == s.size());
+
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
+// end of src/core/fuzz/fzStringFunctions.cc
+//---------------------------------------------------------------------------//
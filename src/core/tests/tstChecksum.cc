@@ -0,0 +1,45 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/tests/tstChecksum.cc
+ * \brief  Tests for functions in Checksum.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../Checksum.hh"
+
+#include <set>
+#include <string>
+
+#include "harness/Testing.hh"
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(ChecksumTest, checksum64)
+{
+    using yayp::checksum64;
+
+    const std::string text(1000, 'x');
+    EXPECT_EQ(checksum64(text), checksum64(text.data(), text.size()));
+    EXPECT_NE(checksum64(text), checksum64(text, 1));
+    EXPECT_NE(checksum64(""), checksum64(std::string(1, '\0')));
+
+    // Every single-bit change and truncation gives a different checksum
+    std::set<std::uint64_t> seen = {checksum64(text)};
+    for (std::size_t i = 0; i < text.size(); i += 7)
+    {
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            std::string changed = text;
+            changed[i] ^= static_cast<char>(1 << bit);
+            EXPECT_TRUE(seen.insert(checksum64(changed)).second) << i;
+        }
+        EXPECT_TRUE(seen.insert(checksum64(text.substr(0, i))).second) << i;
+    }
+}
+
+//---------------------------------------------------------------------------//
+// end of src/core/tests/tstChecksum.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,64 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/tests/tstMappedFile.cc
+ * \brief  Tests for class MappedFile.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../MappedFile.hh"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::MappedFile;
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(MappedFileTest, map)
+{
+    const std::string contents = "key: value\nlist: [1, 2]\n";
+    {
+        std::ofstream out("MappedFileTest.yaml", std::ios::binary);
+        out << contents;
+    }
+
+    MappedFile file("MappedFileTest.yaml");
+    EXPECT_EQ(contents.size(), file.size());
+    EXPECT_EQ(contents, file.view());
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(file.data()) % 8);
+
+    // Moving transfers the contents
+    MappedFile other = std::move(file);
+    EXPECT_EQ(nullptr, file.data());
+    EXPECT_EQ(0, file.size());
+    EXPECT_EQ(contents, other.view());
+
+    file = std::move(other);
+    EXPECT_EQ(contents, file.view());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(MappedFileTest, empty_and_missing)
+{
+    {
+        std::ofstream out("MappedFileTest.empty");
+    }
+    MappedFile empty("MappedFileTest.empty");
+    EXPECT_EQ(0, empty.size());
+    EXPECT_TRUE(empty.view().empty());
+
+    EXPECT_THROW(MappedFile("./data/ThisWontWork.yaml"), yayp::Exception);
+}
+
+//---------------------------------------------------------------------------//
+// end of src/core/tests/tstMappedFile.cc
+//---------------------------------------------------------------------------//
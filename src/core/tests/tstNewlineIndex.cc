@@ -0,0 +1,140 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/tests/tstNewlineIndex.cc
+ * \brief  Tests for class NewlineIndex.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../NewlineIndex.hh"
+
+#include <random>
+#include <string>
+
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::NewlineIndex;
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(NewlineIndexTest, locate)
+{
+    NewlineIndex index("ab\ncd\r\n\nlast");
+    EXPECT_FALSE(index.isBuilt());
+
+    auto loc = index.locate(0);
+    EXPECT_TRUE(index.isBuilt());
+    EXPECT_EQ(1, loc.line);
+    EXPECT_EQ(1, loc.column);
+
+    // A newline belongs to the line it ends
+    loc = index.locate(2);
+    EXPECT_EQ(1, loc.line);
+    EXPECT_EQ(3, loc.column);
+
+    loc = index.locate(4);
+    EXPECT_EQ(2, loc.line);
+    EXPECT_EQ(2, loc.column);
+
+    loc = index.locate(7);
+    EXPECT_EQ(3, loc.line);
+    EXPECT_EQ(1, loc.column);
+
+    // The end of the text is a valid offset
+    loc = index.locate(12);
+    EXPECT_EQ(4, loc.line);
+    EXPECT_EQ(5, loc.column);
+
+    EXPECT_EQ(4, index.numLines());
+    EXPECT_EQ(8, index.lineStart(4));
+    EXPECT_EQ("cd", index.line(2));
+    EXPECT_EQ("", index.line(3));
+    EXPECT_EQ("last", index.line(4));
+
+#if YAYP_DBC > 0
+    EXPECT_THROW(index.locate(13), yayp::DBCException);
+    EXPECT_THROW(index.lineStart(0), yayp::DBCException);
+    EXPECT_THROW(index.lineStart(5), yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(NewlineIndexTest, utf8_columns)
+{
+    // "é" and "€" are two and three bytes
+    NewlineIndex index("x\n\xC3\xA9t\xE2\x82\xAC: v");
+    EXPECT_EQ(2, index.locate(4).column);
+    EXPECT_EQ(3, index.locate(5).column);
+    EXPECT_EQ(4, index.locate(8).column);
+
+    // Long lines are counted in blocks of 64 bytes
+    std::string line = "\n";
+    for (int i = 0; i < 100; ++i)
+    {
+        line += "\xC3\xA9";
+    }
+    index.reset(line);
+    EXPECT_EQ(101, index.locate(line.size()).column);
+    EXPECT_EQ(65, index.locate(129).column);
+    EXPECT_EQ(66, index.locate(131).column);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(NewlineIndexTest, reset)
+{
+    NewlineIndex index;
+    EXPECT_EQ(1, index.numLines());
+    EXPECT_EQ(1, index.locate(0).line);
+
+    std::string text = "a\nb\n";
+    index.reset(text);
+    EXPECT_FALSE(index.isBuilt());
+    EXPECT_EQ(3, index.numLines());
+    EXPECT_EQ(text, index.text());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(NewlineIndexTest, random_text)
+{
+    // Compare against a linear scan across block boundaries
+    std::mt19937 rng(12345);
+    for (std::size_t size : {0, 1, 63, 64, 65, 127, 128, 129, 1000, 4099})
+    {
+        std::string text(size, 'x');
+        for (auto& c : text)
+        {
+            unsigned r = rng() % 64;
+            c = r == 0 ? '\n' : r == 1 ? '\xC3' : r == 2 ? '\xA9' : 'a';
+        }
+        NewlineIndex index(text);
+
+        std::size_t line   = 1;
+        std::size_t column = 1;
+        for (std::size_t offset = 0; offset <= size; ++offset)
+        {
+            auto loc = index.locate(offset);
+            ASSERT_EQ(line, loc.line) << size << ' ' << offset;
+            ASSERT_EQ(column, loc.column) << size << ' ' << offset;
+            if (offset < size && text[offset] == '\n')
+            {
+                ++line;
+                column = 1;
+            }
+            else if (offset < size && text[offset] != '\xA9')
+            {
+                ++column;
+            }
+        }
+        EXPECT_EQ(line, index.numLines());
+    }
+}
+
+//---------------------------------------------------------------------------//
+// end of src/core/tests/tstNewlineIndex.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,90 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/tests/tstResult.cc
+ * \brief  Tests for class Result.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../Result.hh"
+
+#include <memory>
+#include <string>
+
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::Result;
+
+namespace
+{
+//---------------------------------------------------------------------------//
+enum class Error
+{
+    Empty,
+    TooLong
+};
+
+//---------------------------------------------------------------------------//
+Result<std::size_t, Error> length(const std::string& s)
+{
+    if (s.empty())
+    {
+        return Error::Empty;
+    }
+    if (s.size() > 8)
+    {
+        return Error::TooLong;
+    }
+    return s.size();
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(ResultTest, value_and_error)
+{
+    auto good = length("abc");
+    EXPECT_TRUE(good.ok());
+    EXPECT_TRUE(good);
+    EXPECT_EQ(3, good.value());
+    EXPECT_EQ(3, good.valueOr(0));
+
+    auto bad = length("");
+    EXPECT_FALSE(bad.ok());
+    EXPECT_FALSE(bad);
+    EXPECT_EQ(Error::Empty, bad.error());
+    EXPECT_EQ(0, bad.valueOr(0));
+    EXPECT_EQ(Error::TooLong, length("too long to count").error());
+
+#if YAYP_DBC > 0
+    EXPECT_THROW(bad.value(), yayp::DBCException);
+    EXPECT_THROW(good.error(), yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ResultTest, move_only)
+{
+    using Ptr = std::unique_ptr<int>;
+    Result<Ptr, Error> result(std::make_unique<int>(5));
+    ASSERT_TRUE(result);
+    EXPECT_EQ(5, *result.value());
+
+    // The value may be moved out of an rvalue result
+    Ptr ptr = std::move(result).value();
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_EQ(5, *ptr);
+
+    Result<Ptr, Error> failed(Error::Empty);
+    EXPECT_EQ(nullptr, std::move(failed).valueOr(nullptr));
+}
+
+//---------------------------------------------------------------------------//
+// end of src/core/tests/tstResult.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,83 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/core/tests/tstSpan.cc
+ * \brief  Tests for class Span.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../Span.hh"
+
+#include <array>
+#include <numeric>
+#include <vector>
+
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::Span;
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(SpanTest, construction)
+{
+    Span<const int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(0, empty.size());
+    EXPECT_EQ(empty.begin(), empty.end());
+
+    const std::vector<int> values{1, 2, 3};
+    Span<const int>        all(values);
+    EXPECT_EQ(3, all.size());
+    EXPECT_EQ(values.data(), all.data());
+    EXPECT_EQ(1, all.front());
+    EXPECT_EQ(3, all.back());
+
+    Span<const int> tail(values.data() + 1, 2);
+    EXPECT_EQ(2, tail[0]);
+    EXPECT_EQ(5, std::accumulate(tail.begin(), tail.end(), 0));
+
+    // Copies view the same elements
+    Span<const int> copy = tail;
+    EXPECT_EQ(tail.data(), copy.data());
+    EXPECT_EQ(tail.size(), copy.size());
+
+#if YAYP_DBC > 0
+    EXPECT_THROW(tail[2], yayp::DBCException);
+    EXPECT_THROW(empty.front(), yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(SpanTest, mutation)
+{
+    std::array<double, 3> values{1.0, 2.0, 3.0};
+    Span<double>          span(values);
+    span[1] = 5.0;
+    for (double& value : span)
+    {
+        value *= 2;
+    }
+    EXPECT_CONT_EQ((std::array<double, 3>{2.0, 10.0, 6.0}), values);
+
+    // Mutable spans convert to read-only views of the same elements
+    Span<const double> view(span);
+    EXPECT_EQ(values.data(), view.data());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(SpanTest, container_macros)
+{
+    const std::vector<double> values{0.1, 0.2, 0.3};
+    Span<const double>        span(values);
+    EXPECT_CONT_EQ(values, span);
+    EXPECT_CONT_SOFT_EQ((std::vector<double>{0.1, 0.2, 0.3 + 1e-15}), span);
+}
+
+//---------------------------------------------------------------------------//
+// end of src/core/tests/tstSpan.cc
+//---------------------------------------------------------------------------//
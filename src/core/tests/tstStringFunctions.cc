@@ -211,6 +211,21 @@ TEST(StringFunctionsTest, split_separator)
     std::string test_str_3     = "";
     auto        split_result_4 = yayp::split(test_str_3);
     EXPECT_EQ(0, split_result_4.size());
+
+    // The results are allocated at once, and only long substrings allocate
+    const std::string        fields = "a,b,c,d,e,f,g,h,i,j,k,l";
+    const std::string        longer = "first long field,second long field";
+    std::vector<std::string> split_result_5;
+    EXPECT_MAX_ALLOCATIONS(split_result_5 = yayp::split(fields, ","), 1);
+    EXPECT_EQ(12, split_result_5.size());
+    EXPECT_MAX_ALLOCATIONS(split_result_5 = yayp::split(fields, ",", 3), 2);
+    EXPECT_EQ("d,e,f,g,h,i,j,k,l", split_result_5[3]);
+    EXPECT_MAX_ALLOCATIONS(split_result_5 = yayp::split(longer, ","), 3);
+
+#if YAYP_DBC > 0
+    // An empty separator would never advance through the string
+    EXPECT_THROW(yayp::split(test_str_1, ""), yayp::DBCException);
+#endif
 }
 
 //---------------------------------------------------------------------------//
@@ -230,6 +245,15 @@ TEST(StringFunctionsTest, join)
 
     std::vector<std::string> test_str_3 = {""};
     EXPECT_EQ("", yayp::join(test_str_3));
+
+    // The result is allocated once
+    std::vector<std::string> test_str_4(20, "a field longer than usual");
+    std::string              joined;
+    EXPECT_MAX_ALLOCATIONS(joined = yayp::join(test_str_4, ", "), 1);
+    EXPECT_EQ(20 * 25 + 19 * 2, joined.size());
+    EXPECT_NO_ALLOCATIONS(joined = yayp::join(test_str_4.begin(),
+                                              test_str_4.begin(),
+                                              ", "));
 }
 
 //---------------------------------------------------------------------------//
@@ -0,0 +1,220 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/AllocationCounter.cc
+ * \brief  AllocationCounter member definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "AllocationCounter.hh"
+
+#include <cstdlib>
+#include <new>
+
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#    define YAYP_SANITIZED_ALLOCATION 1
+#elif defined(__has_feature)
+#    if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#        define YAYP_SANITIZED_ALLOCATION 1
+#    endif
+#endif
+
+namespace
+{
+//---------------------------------------------------------------------------//
+//! Allocations made by this thread since it started
+thread_local yayp::AllocationCounter::Counts t_counts;
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Count an allocation and make it with malloc or aligned_alloc
+ */
+void* allocate(std::size_t size, std::size_t alignment)
+{
+    ++t_counts.allocations;
+    t_counts.bytes += size;
+
+    if (size == 0)
+    {
+        size = 1;
+    }
+    void* p = nullptr;
+    if (alignment <= alignof(std::max_align_t))
+    {
+        p = std::malloc(size);
+    }
+    else
+    {
+        // The size of an aligned allocation must be a multiple of alignment
+        p = std::aligned_alloc(alignment,
+                               (size + alignment - 1) / alignment * alignment);
+    }
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Start counting the allocations of this thread
+ */
+AllocationCounter::AllocationCounter() : m_start(t_counts) {}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the allocations of this thread since the construction
+ */
+auto AllocationCounter::counts() const -> Counts
+{
+    Counts result;
+    result.allocations = t_counts.allocations - m_start.allocations;
+    result.bytes       = t_counts.bytes - m_start.bytes;
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// REPLACEMENT ALLOCATION FUNCTIONS
+//---------------------------------------------------------------------------//
+
+// The standard library implements the array, nothrow and sized forms by
+// calling these, so replacing them catches every allocation
+
+void* operator new(std::size_t size)
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+#ifdef YAYP_SANITIZED_ALLOCATION
+// Sanitizers replace the other forms with their own allocator, so they must
+// be replaced too.  They are not replaced otherwise, so that programs which
+// only use them do not link this translation unit.
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return operator new(size);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void* operator new(std::size_t           size,
+                   std::align_val_t      alignment,
+                   const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return operator new(size, alignment);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t           size,
+                     std::align_val_t      alignment,
+                     const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, alignment, tag);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p,
+                       std::align_val_t,
+                       const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+#endif
+
+//---------------------------------------------------------------------------//
+// end of src/harness/AllocationCounter.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,80 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/AllocationCounter.hh
+ * \brief  AllocationCounter class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_HARNESS_ALLOCATIONCOUNTER_HH
+#define YAYP_HARNESS_ALLOCATIONCOUNTER_HH
+
+#include <cstddef>
+
+namespace yayp
+{
+//===========================================================================//
+/*!
+ * \class AllocationCounter
+ * \brief Counts the heap allocations made within a scope.
+ *
+ * The translation unit of this class replaces the global operator new and
+ * operator delete (and, in sanitizer builds, their array and nothrow forms)
+ * with versions that count each allocation and its size before calling
+ * malloc.  It is therefore not part of the yayp library but of the separate
+ * yayp_testing library, which only the unit tests and benchmarks link.
+ * Since every one of them calls operator new, the archive member holding
+ * the replacement is linked into all of them, whether or not they use an
+ * AllocationCounter: every test and benchmark runs with the counting
+ * allocator, and the library's users never do.
+ *
+ * The counts are kept in thread-local storage and a counter only reports the
+ * allocations of the thread that constructed it, from its construction: the
+ * allocations of other threads (e.g., the workers of a parallel comparison)
+ * are not included.  Counters may be nested.
+ *
+ * \example src/harness/tests/tstAllocationCounter.cc
+ */
+//===========================================================================//
+
+class AllocationCounter
+{
+  public:
+    //! Allocations counted since the start of a counter
+    struct Counts
+    {
+        //! Number of calls to operator new
+        std::size_t allocations = 0;
+
+        //! Number of bytes requested
+        std::size_t bytes = 0;
+    };
+
+  public:
+    // Start counting the allocations of this thread
+    AllocationCounter();
+
+    // Return the allocations of this thread since the construction
+    Counts counts() const;
+
+    //! Return the allocations made by calling a function
+    template<class F>
+    static Counts count(F&& f)
+    {
+        AllocationCounter counter;
+        f();
+        return counter.counts();
+    }
+
+  private:
+    // >>> DATA
+    Counts m_start;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_HARNESS_ALLOCATIONCOUNTER_HH
+//---------------------------------------------------------------------------//
+// end of src/harness/AllocationCounter.hh
+//---------------------------------------------------------------------------//
@@ -9,6 +9,7 @@
 #include "DBC.hh"
 
 #include <sstream>
+#include <utility>
 
 namespace yayp
 {
@@ -20,8 +21,10 @@ namespace yayp
  *
  * \param[in] msg  The exception error string
  */
-Exception::Exception(const std::string& msg)
-    : Base(msg)
+Exception::Exception(std::string msg)
+    : Base(std::string())
+    , m_what(std::move(msg))
+    , m_formatted(true)
 {
     /* * */
 }
@@ -34,32 +37,68 @@ Exception::Exception(const std::string& msg)
  * \param[in] filename The file where the error condition occurred
  * \param[in] line_number The line number where the error occurred.
  */
-Exception::Exception(const std::string& msg,
-                     const std::string& filename,
-                     unsigned int       line_number)
-    : Exception(Exception::buildMessage(msg, filename, line_number))
+Exception::Exception(std::string  msg,
+                     const char*  filename,
+                     unsigned int line_number)
+    : Base(std::string())
+    , m_msg(std::move(msg))
+    , m_filename(filename)
+    , m_line_number(line_number)
 {
     /* * */
 }
 
 //---------------------------------------------------------------------------//
-// PRIVATE IMPLEMENTATION FUNCTIONS
+/*!
+ * \brief Constructor for derived classes that format their own message
+ *
+ * \param[in] filename The file where the error condition occurred
+ * \param[in] line_number The line number where the error occurred.
+ */
+Exception::Exception(const char* filename, unsigned int line_number)
+    : Base(std::string())
+    , m_filename(filename)
+    , m_line_number(line_number)
+{
+    /* * */
+}
+
 //---------------------------------------------------------------------------//
 /*!
- * \brief Builds the exception message
+ * \brief Return the exception message
  *
- * \param[in] msg         The primary message phrase
- * \param[in] filename    The file where the exception was thrown
- * \param[in] line_number The line number where the exception was thrown
- * \return The constructed exception message
+ * The message is formatted on the first call.
+ */
+const char* Exception::what() const noexcept
+{
+    if (!m_formatted)
+    {
+        try
+        {
+            m_what = this->formatMessage();
+        }
+        catch (...)
+        {
+            return "YAYP exception (failed to format the message)";
+        }
+        m_formatted = true;
+    }
+    return m_what.c_str();
+}
+
+//---------------------------------------------------------------------------//
+// PROTECTED IMPLEMENTATION FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Format the exception message
+ *
+ * \return The formatted exception message
  */
-std::string Exception::buildMessage(const std::string& msg,
-                                    const std::string& filename,
-                                    unsigned int       line_number)
+std::string Exception::formatMessage() const
 {
     std::ostringstream stream;
-    stream << "Caught YAYP exception: " << msg << "\n ^^^ at " << filename
-           << ":" << line_number;
+    stream << "Caught YAYP exception: " << m_msg << "\n ^^^ at "
+           << m_filename << ":" << m_line_number;
     return stream.str();
 }
 
@@ -74,11 +113,13 @@ std::string Exception::buildMessage(const std::string& msg,
  * \param[in] filename    The filename where the exception was thrown
  * \param[in] line_number The line number where the exception was thrown
  */
-DBCException::DBCException(const std::string& test,
-                           const std::string& test_type,
-                           const std::string& filename,
-                           unsigned int       line_number)
-    : Base(DBCException::buildMessage(test, test_type, filename, line_number))
+DBCException::DBCException(const char*  test,
+                           const char*  test_type,
+                           const char*  filename,
+                           unsigned int line_number)
+    : Base(filename, line_number)
+    , m_test(test)
+    , m_test_type(test_type)
 {
     /* * */
 }
@@ -87,22 +128,15 @@ DBCException::DBCException(const std::string& test,
 // PRIVATE IMPLEMENTATION FUNCTIONS
 //---------------------------------------------------------------------------//
 /*!
- * \brief Builds the exception message
+ * \brief Format the exception message
  *
- * \param[in] test        A string representation of the DBC test that failed
- * \param[in] test_type  The type of test (precondition, postcondition, etc...)
- * \param[in] filename    The filename where the exception was thrown
- * \param[in] line_number The line number where the exception was thrown
- * \return The constructed exception message
+ * \return The formatted exception message
  */
-std::string DBCException::buildMessage(const std::string& test,
-                                       const std::string& test_type,
-                                       const std::string& filename,
-                                       unsigned int       line_number)
+std::string DBCException::formatMessage() const
 {
     std::ostringstream stream;
-    stream << "Failed DBC " << test_type << " test: " << test << "\n ^^^ at "
-           << filename << ":" << line_number;
+    stream << "Failed DBC " << m_test_type << " test: " << m_test
+           << "\n ^^^ at " << this->filename() << ":" << this->lineNumber();
     return stream.str();
 }
 
@@ -117,11 +151,11 @@ std::string DBCException::buildMessage(const std::string& test,
  * \param[in] filename The filename where the unimplemented function resides
  * \param[in] line_number The line number where the exception was thrown
  */
-NotImplementedException::NotImplementedException(const std::string& message,
-                                                 const std::string& filename,
+NotImplementedException::NotImplementedException(std::string  message,
+                                                 const char*  filename,
                                                  unsigned int line_number)
-    : Base(
-        NotImplementedException::buildMessage(message, filename, line_number))
+    : Base(filename, line_number)
+    , m_message(std::move(message))
 {
     /* * */
 }
@@ -130,23 +164,19 @@ NotImplementedException::NotImplementedException(const std::string& message,
 // PRIVATE IMPLEMENTATION FUNCTIONS
 //---------------------------------------------------------------------------//
 /*!
- * \brief Build the exception message
+ * \brief Format the exception message
  *
- * \param[in] message  The message to report
- * \param[in] filename The filename where the unimplemented function resides
- * \param[in] line_number The line number where the exception was thrown
- * \return The constructed exception message
+ * \return The formatted exception message
  */
-std::string NotImplementedException::buildMessage(const std::string& message,
-                                                  const std::string& filename,
-                                                  unsigned int line_number)
+std::string NotImplementedException::formatMessage() const
 {
     std::ostringstream stream;
-    stream << "Unfortunately, " << message << " is not currently implemented.";
+    stream << "Unfortunately, " << m_message
+           << " is not currently implemented.";
 #if YAYP_DBC > 0
     // If DBC is enabled, write the filename and line number where the
     // unimplemented function resides.
-    stream << "\n ^^^ at " << filename << ":" << line_number;
+    stream << "\n ^^^ at " << this->filename() << ":" << this->lineNumber();
 #endif
     return stream.str();
 }
@@ -163,9 +193,9 @@ std::string NotImplementedException::buildMessage(const std::string& message,
  * \param[in] line_number The line number where the unreachable code point is
  *                        located.
  */
-NotReachableException::NotReachableException(const std::string& filename,
-                                             unsigned int       line_number)
-    : Base(NotReachableException::buildMessage(filename, line_number))
+NotReachableException::NotReachableException(const char*  filename,
+                                             unsigned int line_number)
+    : Base(filename, line_number)
 {
     /* * */
 }
@@ -174,20 +204,50 @@ NotReachableException::NotReachableException(const std::string& filename,
 // PRIVATE IMPLEMENTATION FUNCTIONS
 //---------------------------------------------------------------------------//
 /*!
- * \brief Build the exception message
+ * \brief Format the exception message
  *
- * \param[in] filename  The filename where the unreachable code point is
- *                      located
- * \param[in] line_number The line number where the unreachable code point is
- *                        located.
- * \return The constructed exception message
+ * \return The formatted exception message
+ */
+std::string NotReachableException::formatMessage() const
+{
+    std::ostringstream stream;
+    stream << "Encountered 'unreachable' code point at " << this->filename()
+           << ":" << this->lineNumber();
+    return stream.str();
+}
+
+//===========================================================================//
+// LIMITEXCEEDEDEXCEPTION CLASS DEFINITION
+//===========================================================================//
+/*!
+ * \brief Constructor for LimitExceededException when input exceeds a
+ *        resource limit.
+ *
+ * \param[in] resource  The name of the limited resource
+ * \param[in] limit     The limit that was exceeded
+ */
+LimitExceededException::LimitExceededException(std::string resource,
+                                               std::size_t limit)
+    : Base(nullptr, 0)
+    , m_resource(std::move(resource))
+    , m_limit(limit)
+{
+    /* * */
+}
+
+//---------------------------------------------------------------------------//
+// PRIVATE IMPLEMENTATION FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Format the exception message
+ *
+ * \return The formatted exception message
  */
-std::string NotReachableException::buildMessage(const std::string& filename,
-                                                unsigned int       line_number)
+std::string LimitExceededException::formatMessage() const
 {
     std::ostringstream stream;
-    stream << "Encountered 'unreachable' code point at " << filename << ":"
-           << line_number;
+    stream << "Input exceeds the limit on " << m_resource << " (" << m_limit
+           << ")";
     return stream.str();
 }
 
@@ -198,17 +258,18 @@ std::string NotReachableException::buildMessage(const std::string& filename,
  * \brief Throws the DBC exception class.
  *
  * This function provides a fixed point upon which to set a breakpoint in a
- * debugger.
+ * debugger.  It is kept out of line so that each DBC check only adds a
+ * branch and a call to the caller.
  *
  * \param[in] condition   A string representation of the DBC test that failed
  * \param[in] condition_type  The type of test
  * \param[in] filename        The filename where the exception was thrown
  * \param[in] line_number     The line number where the exception was thrown
  */
-void throwDBCException(const std::string& condition,
-                       const std::string& condition_type,
-                       const std::string& filename,
-                       unsigned int       line_number)
+void throwDBCException(const char*  condition,
+                       const char*  condition_type,
+                       const char*  filename,
+                       unsigned int line_number)
 {
     throw DBCException(condition, condition_type, filename, line_number);
 }
@@ -21,7 +21,9 @@
 #ifndef YAYP_HARNESS_DBC_HH
 #define YAYP_HARNESS_DBC_HH
 
+#include <cstddef>
 #include <exception>
+#include <stdexcept>
 #include <string>
 
 #include "Macros.hh"
@@ -41,8 +43,12 @@
  * even with -O0 GCC and Clang will compile out.
  *
  * Additionally, we use the "YAYP_UNLIKELY" macro (see Macros.hh) to ask the
- * compiler to mark the message-building and assertion call as "cold", placing
- * it outside of the main program flow (improving instruction locality).
+ * compiler to mark the assertion call as "cold", placing it outside of the
+ * main program flow (improving instruction locality).  The condition and file
+ * are passed as string literals and the message is only formatted if it is
+ * requested, so a passing check costs a single predicted branch; this keeps
+ * YAYP_REQUIRE cheap enough to leave enabled (YAYP_DBC == 1) in release
+ * builds.
  *
  * See:
  * https://stackoverflow.com/questions/5252375/custom-c-assert-macro
@@ -154,6 +160,13 @@ namespace yayp
  * catch YAYP exceptions separately from standard exceptions (or others).
  * This class represents a "generic" YAYP exception
  *
+ * The message returned by what() is formatted on its first call rather than
+ * when the exception is thrown, so that throwing (and catching without
+ * inspecting the message) only costs the construction of the exception
+ * object.  Derived classes provide their message through formatMessage().
+ * As with the message of any exception, what() should not be called
+ * concurrently on the same exception object.
+ *
  * \example src/harness/test/tstDBC.cc
  */
 //===========================================================================//
@@ -164,20 +177,39 @@ class Exception : public std::runtime_error
 
   public:
     // Constructor inherited from std::runtime_error
-    explicit Exception(const std::string& msg);
+    explicit Exception(std::string msg);
 
     // Specialized constructor for constructing Exceptions. Takes a
     // message, filename, and line number
-    Exception(const std::string& msg,
-              const std::string& filename,
-              unsigned int       line_number);
+    Exception(std::string msg, const char* filename, unsigned int line_number);
+
+    // Return the exception message
+    const char* what() const noexcept override;
+
+    // >>> ACCESSORS
+    //! Return the file where the exception was thrown (may be null)
+    const char* filename() const { return m_filename; }
+
+    //! Return the line where the exception was thrown
+    unsigned int lineNumber() const { return m_line_number; }
+
+  protected:
+    // Constructor for derived classes that format their own message
+    Exception(const char* filename, unsigned int line_number);
 
-  private:
     // >>> IMPLEMENTATION
-    // Build the exception message
-    static std::string buildMessage(const std::string& msg,
-                                    const std::string& filename,
-                                    unsigned int       line_number);
+    // Format the exception message
+    virtual std::string formatMessage() const;
+
+  private:
+    // >>> DATA
+    std::string  m_msg;
+    const char*  m_filename    = nullptr;
+    unsigned int m_line_number = 0;
+
+    //! The formatted message, built on the first call to what()
+    mutable std::string m_what;
+    mutable bool        m_formatted = false;
 };
 
 //===========================================================================//
@@ -186,7 +218,9 @@ class Exception : public std::runtime_error
  * \brief Exception class for failed design-by-contract checks.
  *
  * This class inherits from Exception and is thrown when a YAYP_REQUIRE,
- * YAYP_ENSURE, or YAYP_CHECK DBC statement fails.
+ * YAYP_ENSURE, or YAYP_CHECK DBC statement fails.  The test and test type
+ * must be string literals (or otherwise outlive the exception), as they are
+ * stored by pointer.
  *
  * \example src/harness/test/tstDBC.cc
  */
@@ -199,18 +233,20 @@ class DBCException final : public Exception
   public:
     // Constructor taking the DBC test, the type of DBC check that failed, the
     // file name, and the line number
-    DBCException(const std::string& test,
-                 const std::string& test_type,
-                 const std::string& filename,
-                 unsigned int       line_number);
+    DBCException(const char*  test,
+                 const char*  test_type,
+                 const char*  filename,
+                 unsigned int line_number);
 
   private:
     // >>> IMPLEMENTATION
-    // Build the exception message
-    static std::string buildMessage(const std::string& test,
-                                    const std::string& test_type,
-                                    const std::string& filename,
-                                    unsigned int       line_number);
+    // Format the exception message
+    std::string formatMessage() const override;
+
+  private:
+    // >>> DATA
+    const char* m_test;
+    const char* m_test_type;
 };
 
 //===========================================================================//
@@ -229,16 +265,18 @@ class NotImplementedException final : public Exception
 
   public:
     // Construct taking a message and the filename and line number
-    NotImplementedException(const std::string& message,
-                            const std::string& filename,
-                            unsigned int       line_number);
+    NotImplementedException(std::string  message,
+                            const char*  filename,
+                            unsigned int line_number);
 
   private:
     // >>> IMPLEMENTATION
-    // Build the exception message
-    static std::string buildMessage(const std::string& message,
-                                    const std::string& filename,
-                                    unsigned int       line_number);
+    // Format the exception message
+    std::string formatMessage() const override;
+
+  private:
+    // >>> DATA
+    std::string m_message;
 };
 
 //===========================================================================//
@@ -258,22 +296,60 @@ class NotReachableException final : public Exception
 
   public:
     // Constructor taking a filename and line number
-    NotReachableException(const std::string& file, unsigned int line);
+    NotReachableException(const char* file, unsigned int line);
+
+  private:
+    // >>> IMPLEMENTATION
+    // Format the exception message
+    std::string formatMessage() const override;
+};
+
+//===========================================================================//
+/*!
+ * \class LimitExceededException
+ * \brief Exception class thrown when input exceeds a configured resource
+ *        limit.
+ *
+ * This class inherits from Exception and is thrown when parsing input that
+ * exceeds one of the configured resource limits (nesting depth, document
+ * size, node count, etc.).  Unlike DBCException it signals invalid input
+ * rather than a programming error.
+ *
+ * \example src/harness/test/tstDBC.cc
+ */
+class LimitExceededException final : public Exception
+{
+    using Base = Exception;
+
+  public:
+    // Constructor taking the name of the limited resource and the limit
+    LimitExceededException(std::string resource, std::size_t limit);
+
+    //! Return the name of the limited resource
+    const std::string& resource() const { return m_resource; }
+
+    //! Return the limit that was exceeded
+    std::size_t limit() const { return m_limit; }
 
   private:
     // >>> IMPLEMENTATION
-    // Build the exception message
-    static std::string buildMessage(const std::string& file, unsigned int line);
+    // Format the exception message
+    std::string formatMessage() const override;
+
+  private:
+    // >>> DATA
+    std::string m_resource;
+    std::size_t m_limit;
 };
 
 //---------------------------------------------------------------------------//
 // HELPER FUNCTIONS
 //---------------------------------------------------------------------------//
 // Throws a DBC exception
-[[noreturn]] void throwDBCException(const std::string& condition,
-                                    const std::string& condition_type,
-                                    const std::string& filename,
-                                    unsigned int       line_number);
+[[noreturn]] void throwDBCException(const char*  condition,
+                                    const char*  condition_type,
+                                    const char*  filename,
+                                    unsigned int line_number);
 
 //---------------------------------------------------------------------------//
 } // namespace yayp
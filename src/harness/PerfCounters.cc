@@ -0,0 +1,333 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/PerfCounters.cc
+ * \brief  PerfCounters member and helper function definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "PerfCounters.hh"
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+#include "DBC.hh"
+
+#ifdef __linux__
+#    include <cstring>
+#    include <linux/perf_event.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+namespace
+{
+using yayp::PerfEvent;
+
+//! Value reported for ratios of events that were not counted
+constexpr double not_counted = std::numeric_limits<double>::quiet_NaN();
+
+#ifdef __linux__
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Open a user-space counter of an event for the calling thread
+ *
+ * \param[in] event     The counted event
+ * \param[in] group_fd  The counter leading the event's group, or -1
+ *
+ * \return The file descriptor of the counter, or -1 if the event is not
+ *         available
+ */
+int openEvent(PerfEvent event, int group_fd)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED
+                       | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    switch (event)
+    {
+        case PerfEvent::Cycles:
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfEvent::Instructions:
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfEvent::BranchMisses:
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PerfEvent::CacheMisses:
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case PerfEvent::L1DMisses:
+            attr.type   = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D
+                          | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                          | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+    }
+
+    // The calling thread (pid 0) on any CPU (-1)
+    const long fd = syscall(
+        SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+    return fd < 0 ? -1 : static_cast<int>(fd);
+}
+#endif
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+// PERFCOUNTS DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the instructions per cycle, or NaN if they were not counted
+ */
+double PerfCounts::ipc() const
+{
+    if (!this->has(PerfEvent::Instructions) || !this->has(PerfEvent::Cycles)
+        || (*this)[PerfEvent::Cycles] == 0)
+    {
+        return not_counted;
+    }
+    return static_cast<double>((*this)[PerfEvent::Instructions])
+           / static_cast<double>((*this)[PerfEvent::Cycles]);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the count of an event per unit of work, or NaN
+ *
+ * \param[in] event  The counted event
+ * \param[in] units  The amount of work, e.g., the bytes of input
+ */
+double PerfCounts::per(PerfEvent event, std::size_t units) const
+{
+    if (!this->has(event) || units == 0)
+    {
+        return not_counted;
+    }
+    return static_cast<double>((*this)[event]) / static_cast<double>(units);
+}
+
+//---------------------------------------------------------------------------//
+// PERFCOUNTERS DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Open and start the counters of the calling thread
+ *
+ * Events that cannot be opened (unsupported by the processor, forbidden by
+ * perf_event_paranoid or a seccomp filter, or not on Linux) are left closed.
+ * The instructions are opened in a group led by the cycles, so that both are
+ * always counted over the same time and their ratio is exact even when the
+ * kernel multiplexes the counters.
+ */
+PerfCounters::PerfCounters()
+{
+    m_fds.fill(-1);
+#ifdef __linux__
+    const auto cycles       = static_cast<std::size_t>(PerfEvent::Cycles);
+    const auto instructions = static_cast<std::size_t>(
+        PerfEvent::Instructions);
+    for (std::size_t i = 0; i < num_perf_events; ++i)
+    {
+        const int group = i == instructions ? m_fds[cycles] : -1;
+        m_fds[i]        = openEvent(static_cast<PerfEvent>(i), group);
+        if (m_fds[i] < 0 && group >= 0)
+        {
+            // Count the instructions alone if they cannot join the cycles
+            m_fds[i] = openEvent(static_cast<PerfEvent>(i), -1);
+        }
+    }
+#endif
+    m_start = this->read();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Close the counters
+ */
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for (int fd : m_fds)
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+    }
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Whether any event is counted
+ */
+bool PerfCounters::available() const
+{
+    for (int fd : m_fds)
+    {
+        if (fd >= 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the counts of this thread since the construction
+ *
+ * An event that the kernel only counted for part of the time, because it
+ * multiplexed more events than there are counters, is scaled up to the
+ * whole time.  An event that could not be read, or that was never scheduled
+ * since the construction, is not available.
+ */
+PerfCounts PerfCounters::counts() const
+{
+    const Readings now = this->read();
+
+    PerfCounts result;
+    for (std::size_t i = 0; i < num_perf_events; ++i)
+    {
+        if (m_fds[i] < 0 || !now[i].valid || !m_start[i].valid
+            || now[i].running == m_start[i].running)
+        {
+            continue;
+        }
+        const std::uint64_t value   = now[i].value - m_start[i].value;
+        const std::uint64_t enabled = now[i].enabled - m_start[i].enabled;
+        const std::uint64_t running = now[i].running - m_start[i].running;
+
+        result.available[i] = true;
+        result.values[i]    = value;
+        if (running < enabled)
+        {
+            result.values[i] = static_cast<std::uint64_t>(
+                static_cast<double>(value) * static_cast<double>(enabled)
+                / static_cast<double>(running));
+        }
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Read the events that are open
+ */
+auto PerfCounters::read() const -> Readings
+{
+    Readings result;
+#ifdef __linux__
+    for (std::size_t i = 0; i < num_perf_events; ++i)
+    {
+        if (m_fds[i] < 0)
+        {
+            continue;
+        }
+        std::uint64_t values[3] = {0, 0, 0};
+        if (::read(m_fds[i], values, sizeof(values)) == sizeof(values))
+        {
+            result[i].value   = values[0];
+            result[i].enabled = values[1];
+            result[i].running = values[2];
+            result[i].valid   = true;
+        }
+    }
+#endif
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+// HELPER FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the name of a hardware event
+ */
+const char* perfEventName(PerfEvent event)
+{
+    switch (event)
+    {
+        case PerfEvent::Cycles:
+            return "cycles";
+        case PerfEvent::Instructions:
+            return "instructions";
+        case PerfEvent::BranchMisses:
+            return "branch-misses";
+        case PerfEvent::CacheMisses:
+            return "cache-misses";
+        case PerfEvent::L1DMisses:
+            return "L1D-misses";
+    }
+    YAYP_NOT_REACHABLE();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Write a table of the counts, per byte of input, and the IPC
+ *
+ * Events that were not counted are written as "n/a".
+ *
+ * \param[in,out] os      The stream to write to
+ * \param[in]     counts  The counts of the measured scope
+ * \param[in]     bytes   The bytes of input processed in the scope
+ */
+void writePerfReport(std::ostream&     os,
+                     const PerfCounts& counts,
+                     std::size_t       bytes)
+{
+    auto write_ratio = [&os](double ratio) {
+        if (std::isnan(ratio))
+        {
+            os << std::setw(14) << "n/a";
+        }
+        else
+        {
+            os << std::setw(14) << ratio;
+        }
+    };
+
+    std::ios state(nullptr);
+    state.copyfmt(os);
+
+    os << std::left << std::setw(14) << "Event" << std::right
+       << std::setw(16) << "Count" << std::setw(14) << "Per byte" << '\n';
+    os << std::fixed << std::setprecision(4);
+    for (std::size_t i = 0; i < num_perf_events; ++i)
+    {
+        const auto event = static_cast<PerfEvent>(i);
+        os << std::left << std::setw(14) << perfEventName(event)
+           << std::right << std::setw(16);
+        if (counts.has(event))
+        {
+            os << counts[event];
+        }
+        else
+        {
+            os << "n/a";
+        }
+        write_ratio(counts.per(event, bytes));
+        os << '\n';
+    }
+    os << std::left << std::setw(30) << "IPC" << std::right;
+    write_ratio(counts.ipc());
+    os << '\n';
+
+    os.copyfmt(state);
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/harness/PerfCounters.cc
+//---------------------------------------------------------------------------//
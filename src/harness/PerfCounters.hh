@@ -0,0 +1,146 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/PerfCounters.hh
+ * \brief  PerfCounters class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_HARNESS_PERFCOUNTERS_HH
+#define YAYP_HARNESS_PERFCOUNTERS_HH
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+namespace yayp
+{
+//! Hardware events counted by PerfCounters
+enum class PerfEvent
+{
+    Cycles,       //!< CPU cycles
+    Instructions, //!< Retired instructions
+    BranchMisses, //!< Mispredicted branches
+    CacheMisses,  //!< Last-level cache misses
+    L1DMisses     //!< Level 1 data cache read misses
+};
+
+//! Number of hardware events
+constexpr std::size_t num_perf_events = 5;
+
+//! Counts of the hardware events, indexed by PerfEvent
+struct PerfCounts
+{
+    std::array<std::uint64_t, num_perf_events> values    = {};
+    std::array<bool, num_perf_events>          available = {};
+
+    //! Whether an event was counted
+    bool has(PerfEvent event) const
+    {
+        return available[static_cast<std::size_t>(event)];
+    }
+
+    //! Return the count of an event, zero if it was not counted
+    std::uint64_t operator[](PerfEvent event) const
+    {
+        return values[static_cast<std::size_t>(event)];
+    }
+
+    // Return the instructions per cycle, or NaN if they were not counted
+    double ipc() const;
+
+    // Return the count of an event per unit of work, or NaN
+    double per(PerfEvent event, std::size_t units) const;
+};
+
+//===========================================================================//
+/*!
+ * \class PerfCounters
+ * \brief Counts the hardware events of the calling thread within a scope.
+ *
+ * The counters are opened with perf_event_open on Linux, counting user-space
+ * events of the calling thread only, and are read relative to the
+ * construction.  The events are opened separately (except the instructions,
+ * which are grouped with the cycles so that the IPC is computed from counts
+ * of the same time), so that the events the processor (or the kernel, or a
+ * container) does not provide are simply reported as unavailable, as are
+ * events that were never scheduled.  When the kernel multiplexes more events
+ * than the processor has counters, the counts are scaled by the fraction of
+ * the time each event was counted.  On other systems, no event is
+ * available.
+ *
+ * Like AllocationCounter, a counter may wrap any scope: a benchmark loop, a
+ * timed phase, or a single function call through count().
+ *
+ * \example src/harness/tests/tstPerfCounters.cc
+ */
+//===========================================================================//
+
+class PerfCounters
+{
+  public:
+    // Open and start the counters of the calling thread
+    PerfCounters();
+
+    // Close the counters
+    ~PerfCounters();
+
+    // Counters are bound to their scope
+    PerfCounters(const PerfCounters&)            = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // Whether any event is counted
+    bool available() const;
+
+    // Return the counts of this thread since the construction
+    PerfCounts counts() const;
+
+    //! Return the counts of calling a function
+    template<class F>
+    static PerfCounts count(F&& f)
+    {
+        PerfCounters counters;
+        f();
+        return counters.counts();
+    }
+
+  private:
+    //! Raw reading of one event
+    struct Reading
+    {
+        std::uint64_t value   = 0;
+        std::uint64_t enabled = 0;
+        std::uint64_t running = 0;
+        bool          valid   = false;
+    };
+
+    using Readings = std::array<Reading, num_perf_events>;
+
+    // Read the events that are open
+    Readings read() const;
+
+  private:
+    // >>> DATA
+    std::array<int, num_perf_events> m_fds;
+    Readings                         m_start;
+};
+
+//---------------------------------------------------------------------------//
+// HELPER FUNCTIONS
+//---------------------------------------------------------------------------//
+// Return the name of a hardware event
+const char* perfEventName(PerfEvent event);
+
+// Write a table of the counts, per byte of input, and the IPC
+void writePerfReport(std::ostream&     os,
+                     const PerfCounts& counts,
+                     std::size_t       bytes);
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_HARNESS_PERFCOUNTERS_HH
+//---------------------------------------------------------------------------//
+// end of src/harness/PerfCounters.hh
+//---------------------------------------------------------------------------//
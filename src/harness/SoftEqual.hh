@@ -8,6 +8,7 @@
 #ifndef YAYP_HARNESS_SOFTEQUAL_HH
 #define YAYP_HARNESS_SOFTEQUAL_HH
 
+#include <cstddef>
 #include <type_traits>
 
 namespace yayp
@@ -26,6 +27,14 @@ namespace yayp
  *    precision.
  * Both values must be floating point types
  *
+ * forEachUnequal() compares two contiguous arrays in bulk.  The typical case
+ * (the relative difference test) is evaluated for several elements at once
+ * with SIMD instructions where available, and only the elements that fail
+ * it are passed through the full comparison, so the result is identical to
+ * comparing each pair with operator().  softContainerEqual() and the
+ * container testing macros use it for contiguous containers of the common
+ * value type, such as \c std::vector<double>.
+ *
  * \tparam T1  The type of the first object to compare
  * \tparam T2  The type of the second object to compare
  * \example Utilities/harness/test/tstSoftEqual.cc
@@ -60,6 +69,13 @@ class SoftEqual
     // Performs comparison between two values
     bool operator()(value_type expected, value_type actual) const;
 
+    // Visit the index of each pair of values that are not equal
+    template<class Visitor>
+    inline void forEachUnequal(const value_type* expected,
+                               const value_type* actual,
+                               std::size_t       size,
+                               Visitor&&         visit) const;
+
     // >>> ACCESSORS
     //! Return the tolerance of the absolute difference
     value_type abs_tol() const { return m_abs_tol; }
@@ -11,7 +11,14 @@
 #include "DBC.hh"
 
 #include <cmath>
+#include <iterator>
 #include <typeinfo>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define YAYP_SOFTEQUAL_SSE2 1
+#endif
 
 namespace
 {
@@ -65,6 +72,104 @@ constexpr float default_rel_tol<float>()
 
 namespace yayp
 {
+namespace detail
+{
+//---------------------------------------------------------------------------//
+//! Number of elements compared at once by SoftEqual::forEachUnequal
+constexpr std::size_t soft_block_size = 8;
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a bitmap of the elements of a block whose relative
+ *        difference is within the tolerance
+ *
+ * Each bit is the result of the typical case of SoftEqual::operator(),
+ * computed with the same floating point operations.
+ *
+ * \tparam T  The floating point type
+ */
+template<typename T>
+inline unsigned int
+relativePassMask(const T* expected, const T* actual, T rel_tol)
+{
+    unsigned int mask = 0;
+    for (std::size_t i = 0; i < soft_block_size; ++i)
+    {
+        mask |= static_cast<unsigned int>(std::abs(actual[i] - expected[i])
+                                          < rel_tol * std::abs(expected[i]))
+                << i;
+    }
+    return mask;
+}
+
+#ifdef YAYP_SOFTEQUAL_SSE2
+//! Return the relative difference bitmap of a block of doubles
+template<>
+inline unsigned int relativePassMask<double>(const double* expected,
+                                             const double* actual,
+                                             double        rel_tol)
+{
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d tol  = _mm_set1_pd(rel_tol);
+    unsigned int  mask = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        const __m128d e    = _mm_loadu_pd(expected + 2 * i);
+        const __m128d a    = _mm_loadu_pd(actual + 2 * i);
+        const __m128d diff = _mm_andnot_pd(sign, _mm_sub_pd(a, e));
+        const __m128d bound = _mm_mul_pd(tol, _mm_andnot_pd(sign, e));
+        mask |= static_cast<unsigned int>(
+                    _mm_movemask_pd(_mm_cmplt_pd(diff, bound)))
+                << (2 * i);
+    }
+    return mask;
+}
+
+//! Return the relative difference bitmap of a block of floats
+template<>
+inline unsigned int relativePassMask<float>(const float* expected,
+                                            const float* actual,
+                                            float        rel_tol)
+{
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 tol  = _mm_set1_ps(rel_tol);
+    unsigned int mask = 0;
+    for (int i = 0; i < 2; ++i)
+    {
+        const __m128 e     = _mm_loadu_ps(expected + 4 * i);
+        const __m128 a     = _mm_loadu_ps(actual + 4 * i);
+        const __m128 diff  = _mm_andnot_ps(sign, _mm_sub_ps(a, e));
+        const __m128 bound = _mm_mul_ps(tol, _mm_andnot_ps(sign, e));
+        mask |= static_cast<unsigned int>(
+                    _mm_movemask_ps(_mm_cmplt_ps(diff, bound)))
+                << (4 * i);
+    }
+    return mask;
+}
+#endif
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Whether a container stores elements of type T contiguously
+ */
+template<class Container, typename T, class = void>
+struct IsContiguousOf : std::false_type
+{
+};
+
+template<class Container, typename T>
+struct IsContiguousOf<
+    Container,
+    T,
+    std::enable_if_t<std::is_convertible_v<
+        decltype(std::data(std::declval<const Container&>())),
+        const T*>>> : std::true_type
+{
+};
+
+//---------------------------------------------------------------------------//
+} // namespace detail
+
 //---------------------------------------------------------------------------//
 // CONSTRUCTORS
 //---------------------------------------------------------------------------//
@@ -156,6 +261,57 @@ bool SoftEqual<T1, T2>::operator()(value_type expected, value_type actual) const
     return false;
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Visit the index of each pair of values that are not equal
+ *
+ * The values are compared a block at a time, and only the pairs that fail
+ * the relative difference test go through operator().
+ *
+ * \tparam Visitor  Callable with the index of an unequal pair, returning
+ *                  whether to continue
+ * \param[in] expected  The expected values
+ * \param[in] actual    The actual values
+ * \param[in] size      The number of values in each array
+ * \param[in] visit     The visitor, called in order of increasing index
+ */
+template<typename T1, typename T2>
+template<class Visitor>
+void SoftEqual<T1, T2>::forEachUnequal(const value_type* expected,
+                                       const value_type* actual,
+                                       std::size_t       size,
+                                       Visitor&&         visit) const
+{
+    constexpr std::size_t  block = detail::soft_block_size;
+    constexpr unsigned int all   = (1u << block) - 1;
+
+    std::size_t i = 0;
+    for (; i + block <= size; i += block)
+    {
+        const unsigned int pass
+            = detail::relativePassMask(expected + i, actual + i, m_rel_tol);
+        if (pass == all)
+        {
+            continue;
+        }
+        for (std::size_t j = i; j < i + block; ++j)
+        {
+            if (!(pass >> (j - i) & 1u) && !(*this)(expected[j], actual[j])
+                && !visit(j))
+            {
+                return;
+            }
+        }
+    }
+    for (; i < size; ++i)
+    {
+        if (!(*this)(expected[i], actual[i]) && !visit(i))
+        {
+            return;
+        }
+    }
+}
+
 //---------------------------------------------------------------------------//
 // HELPER FUNCTIONS
 //---------------------------------------------------------------------------//
@@ -215,11 +371,29 @@ inline bool softContainerEqual(const Container1& expected,
                   "Soft equal operands must be convertible to a floating "
                   "point type");
 
+    constexpr bool contiguous
+        = detail::IsContiguousOf<Container1, value_type>::value
+          && detail::IsContiguousOf<Container2, value_type>::value;
+
     // First, check length
     if (std::size(expected) != std::size(actual))
     {
         return false;
     }
+    else if constexpr (contiguous)
+    {
+        // Compare contiguous values in bulk
+        bool                equal = true;
+        SoftEqual<VT1, VT2> se(tol...);
+        se.forEachUnequal(std::data(expected),
+                          std::data(actual),
+                          std::size(expected),
+                          [&equal](std::size_t) {
+                              equal = false;
+                              return false;
+                          });
+        return equal;
+    }
     else
     {
         SoftEqual<VT1, VT2> se(tol...);
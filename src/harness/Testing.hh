@@ -10,6 +10,12 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "harness/AllocationCounter.hh"
+
 namespace testing_detail
 {
 // Return whether two values are approximately equal
@@ -52,6 +58,15 @@ template<class Container1, class Container2>
                                             const Container1& expected,
                                             const Container2& actual);
 
+// Return whether a statement made at most the given number of allocations
+inline ::testing::AssertionResult
+isMaxAllocations(const char*,
+                 const char*,
+                 const char*                            max_expr,
+                 const char*                            statement,
+                 const yayp::AllocationCounter::Counts& counts,
+                 std::size_t                            max_allocations);
+
 //---------------------------------------------------------------------------//
 } // namespace testing_detail
 
@@ -74,6 +89,16 @@ template<class Container1, class Container2>
 #define EXPECT_CONT_EQ(expected, actual) \
     EXPECT_PRED_FORMAT2(testing_detail::isContainerEqual, expected, actual)
 
+// GTest-compliant macros bounding the number of heap allocations made by a
+// statement on the calling thread (see AllocationCounter)
+#define EXPECT_MAX_ALLOCATIONS(statement, max_allocations)                 \
+    EXPECT_PRED_FORMAT3(                                                   \
+        testing_detail::isMaxAllocations,                                  \
+        #statement,                                                        \
+        ::yayp::AllocationCounter::count([&] { statement; }),              \
+        max_allocations)
+#define EXPECT_NO_ALLOCATIONS(statement) EXPECT_MAX_ALLOCATIONS(statement, 0)
+
 //---------------------------------------------------------------------------//
 // INLINE FUNCTION DEFINITIONS
 //---------------------------------------------------------------------------//
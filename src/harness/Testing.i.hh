@@ -8,16 +8,33 @@
 #ifndef YAYP_UTILITIES_HARNESS_TESTING_I_HH
 #define YAYP_UTILITIES_HARNESS_TESTING_I_HH
 
+#include <iomanip>
+#include <iterator>
 #include <numeric>
 #include <sstream>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "harness/DBC.hh"
 #include "harness/SoftEqual.hh"
 #include "harness/detail/TestingFunctions.hh"
 
 namespace testing_detail
 {
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return whether the iterators of a container are random access
+ */
+template<class Container>
+constexpr bool isRandomAccess()
+{
+    using iterator = decltype(std::cbegin(std::declval<const Container&>()));
+    return std::is_base_of_v<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<iterator>::iterator_category>;
+}
+
 //---------------------------------------------------------------------------//
 /*!
  * \brief Return whether two values are approximately equal
@@ -170,24 +187,58 @@ template<class Container1, class Container2, typename Tolerance>
                << "    which is size " << std::size(actual);
     }
 
-    // Loop over the containers and find all of the values that are not equal
-    std::vector<unsigned int> bad_indices;
-    bad_indices.reserve(std::size(actual));
+    // Find all of the values that are not equal, a range at a time
+    using value_type = typename yayp::SoftEqual<T1, T2>::value_type;
     yayp::SoftEqual<T1, T2> se(rel_tol);
-    auto                    iter2 = std::cbegin(actual);
-    for (auto iter1 = std::cbegin(expected); iter1 != std::cend(expected);
-         ++iter1, ++iter2)
-    {
-        if (!se(*iter1, *iter2))
+    constexpr bool          contiguous
+        = yayp::detail::IsContiguousOf<Container1, value_type>::value
+          && yayp::detail::IsContiguousOf<Container2, value_type>::value;
+    auto collect = [&](std::size_t               first,
+                       std::size_t               last,
+                       yayp::detail::Mismatches& bad) {
+        if constexpr (contiguous)
+        {
+            // Compare contiguous values in bulk
+            const value_type* data1 = std::data(expected) + first;
+            const value_type* data2 = std::data(actual) + first;
+            se.forEachUnequal(
+                data1, data2, last - first, [&](std::size_t index) {
+                    bad.add(first + index,
+                            yayp::detail::rel_diff(data1[index],
+                                                   data2[index]));
+                    return true;
+                });
+        }
+        else
         {
-            bad_indices.push_back(iter1 - std::cbegin(expected));
+            auto iter1 = std::next(std::cbegin(expected), first);
+            auto iter2 = std::next(std::cbegin(actual), first);
+            for (std::size_t index = first; index < last;
+                 ++index, ++iter1, ++iter2)
+            {
+                if (!se(*iter1, *iter2))
+                {
+                    bad.add(index, yayp::detail::rel_diff(*iter1, *iter2));
+                }
+            }
         }
+    };
+
+    // Split random access containers across threads, keeping only the
+    // first few indices and the largest relative difference
+    yayp::detail::Mismatches bad;
+    if constexpr (isRandomAccess<Container1>() && isRandomAccess<Container2>())
+    {
+        bad = yayp::detail::collect_bad_indices(std::size(expected), collect);
+    }
+    else
+    {
+        collect(0, std::size(expected), bad);
     }
-    bad_indices.shrink_to_fit();
 
     // If all positions were good, return success, otherwise return failure
     // with an error message
-    if (bad_indices.empty())
+    if (bad.empty())
     {
         return ::testing::AssertionSuccess();
     }
@@ -196,9 +247,13 @@ template<class Container1, class Container2, typename Tolerance>
         return ::testing::AssertionFailure()
                << "Expected soft equality between two containers which differ "
                   "in "
-               << bad_indices.size() << " element(s)\n"
-               << yayp::detail::write_unequal_values(
-                      bad_indices, expected_expr, actual_expr, expected, actual)
+               << bad.count() << " element(s)\n"
+               << yayp::detail::write_unequal_values(bad.indices(),
+                                                     expected_expr,
+                                                     actual_expr,
+                                                     expected,
+                                                     actual)
+               << yayp::detail::write_mismatch_summary(bad)
                << "\n  tested with relative tolerance " << se.rel_tol();
     }
 }
@@ -233,23 +288,37 @@ template<class Container1, class Container2>
                << "    which is size " << std::size(actual);
     }
 
-    // Loop over the containers and find all of the values that are not equal
-    std::vector<unsigned int> bad_indices;
-    bad_indices.reserve(std::size(actual));
-    auto iter2 = std::cbegin(actual);
-    for (auto iter1 = std::cbegin(expected); iter1 != std::cend(expected);
-         ++iter1, ++iter2)
-    {
-        if (*iter1 != *iter2)
+    // Find all of the values that are not equal, a range at a time
+    auto collect = [&](std::size_t               first,
+                       std::size_t               last,
+                       yayp::detail::Mismatches& bad) {
+        auto iter1 = std::next(std::cbegin(expected), first);
+        auto iter2 = std::next(std::cbegin(actual), first);
+        for (std::size_t index = first; index < last;
+             ++index, ++iter1, ++iter2)
         {
-            bad_indices.push_back(std::distance(std::cbegin(expected), iter1));
+            if (*iter1 != *iter2)
+            {
+                bad.add(index);
+            }
         }
+    };
+
+    // Split random access containers across threads, keeping only the
+    // first few indices
+    yayp::detail::Mismatches bad;
+    if constexpr (isRandomAccess<Container1>() && isRandomAccess<Container2>())
+    {
+        bad = yayp::detail::collect_bad_indices(std::size(expected), collect);
+    }
+    else
+    {
+        collect(0, std::size(expected), bad);
     }
-    bad_indices.shrink_to_fit();
 
     // If all positions were good, return success, otherwise return failure
     // with an error message
-    if (bad_indices.empty())
+    if (bad.empty())
     {
         return ::testing::AssertionSuccess();
     }
@@ -257,10 +326,44 @@ template<class Container1, class Container2>
     {
         return ::testing::AssertionFailure()
                << "Expected equality between two containers which differ in "
-               << bad_indices.size() << " elements\n"
-               << yayp::detail::write_unequal_values(
-                      bad_indices, expected_expr, actual_expr, expected, actual);
+               << bad.count() << " elements\n"
+               << yayp::detail::write_unequal_values(bad.indices(),
+                                                     expected_expr,
+                                                     actual_expr,
+                                                     expected,
+                                                     actual)
+               << yayp::detail::write_mismatch_summary(bad);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Helper function compatible with GTest for bounding the number of
+ * heap allocations made by a statement
+ *
+ * \param[in] max_expr         The expression of the maximum
+ * \param[in] statement        The text of the statement
+ * \param[in] counts           The allocations made by the statement
+ * \param[in] max_allocations  The maximum number of allocations
+ * \return A GTest AssertionResult object indicating if the test passed
+ */
+::testing::AssertionResult
+isMaxAllocations(const char*,
+                 const char*,
+                 const char*                            max_expr,
+                 const char*                            statement,
+                 const yayp::AllocationCounter::Counts& counts,
+                 std::size_t                            max_allocations)
+{
+    if (counts.allocations <= max_allocations)
+    {
+        return ::testing::AssertionSuccess();
     }
+    return ::testing::AssertionFailure()
+           << "Expected at most " << max_expr << " heap allocations\n"
+           << "  " << statement << "\n"
+           << "    which made " << counts.allocations << " allocations of "
+           << counts.bytes << " bytes";
 }
 
 //---------------------------------------------------------------------------//
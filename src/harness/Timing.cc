@@ -0,0 +1,262 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/Timing.cc
+ * \brief  Timing function and class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "Timing.hh"
+
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "DBC.hh"
+
+namespace
+{
+using yayp::num_timing_phases;
+using yayp::TimingTotals;
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Timing counters of one thread
+ *
+ * Only the owning thread writes the counters, so they are updated with
+ * relaxed loads and stores rather than read-modify-write operations.  Atomics
+ * are still needed because other threads read (and reset) them.
+ */
+struct ThreadCounters
+{
+    using Counter = std::atomic<std::uint64_t>;
+
+    std::array<Counter, num_timing_phases> calls       = {};
+    std::array<Counter, num_timing_phases> nanoseconds = {};
+
+    ThreadCounters();
+    ~ThreadCounters();
+
+    void add(std::size_t phase, std::uint64_t ns)
+    {
+        auto bump = [](Counter& c, std::uint64_t n) {
+            c.store(c.load(std::memory_order_relaxed) + n,
+                    std::memory_order_relaxed);
+        };
+        bump(calls[phase], 1);
+        bump(nanoseconds[phase], ns);
+    }
+
+    void addTo(TimingTotals& totals) const
+    {
+        for (std::size_t i = 0; i < num_timing_phases; ++i)
+        {
+            totals[i].calls += calls[i].load(std::memory_order_relaxed);
+            totals[i].nanoseconds
+                += nanoseconds[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    void reset()
+    {
+        for (std::size_t i = 0; i < num_timing_phases; ++i)
+        {
+            calls[i].store(0, std::memory_order_relaxed);
+            nanoseconds[i].store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief The counters of all live threads and the totals of exited threads
+ *
+ * The mutex is only taken when a thread first records a time, when it exits,
+ * and when the totals are read or reset.
+ */
+struct Registry
+{
+    std::mutex                   mutex;
+    std::vector<ThreadCounters*> threads;
+    TimingTotals                 retired = {};
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the registry
+ *
+ * The registry is intentionally leaked so that it outlives the thread-local
+ * counters of threads exiting during static destruction.
+ */
+Registry& registry()
+{
+    static Registry* instance = new Registry;
+    return *instance;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Register the counters of a new thread
+ */
+ThreadCounters::ThreadCounters()
+{
+    Registry&        reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    reg.threads.push_back(this);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Fold the counters of an exiting thread into the retired totals
+ */
+ThreadCounters::~ThreadCounters()
+{
+    Registry&        reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    this->addTo(reg.retired);
+    for (auto& ptr : reg.threads)
+    {
+        if (ptr == this)
+        {
+            ptr = reg.threads.back();
+            reg.threads.pop_back();
+            break;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the counters of the calling thread
+ */
+ThreadCounters& localCounters()
+{
+    thread_local ThreadCounters counters;
+    return counters;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+// SCOPEDTIMER DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Record a time for the calling thread
+ *
+ * \param[in] phase        The timed phase
+ * \param[in] nanoseconds  The elapsed time
+ */
+void ScopedTimer::addTiming(TimingPhase phase, std::uint64_t nanoseconds)
+{
+    localCounters().add(static_cast<std::size_t>(phase), nanoseconds);
+}
+
+//---------------------------------------------------------------------------//
+// HELPER FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the name of a timing phase
+ */
+const char* timingPhaseName(TimingPhase phase)
+{
+    switch (phase)
+    {
+        case TimingPhase::Read:
+            return "read";
+        case TimingPhase::Index:
+            return "index";
+        case TimingPhase::Scan:
+            return "scan";
+        case TimingPhase::Build:
+            return "build";
+        case TimingPhase::Resolve:
+            return "resolve";
+        case TimingPhase::Emit:
+            return "emit";
+    }
+    YAYP_NOT_REACHABLE();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the accumulated times of all threads
+ *
+ * Times recorded concurrently with this call may or may not be included.
+ */
+TimingTotals timingTotals()
+{
+    Registry&        reg = registry();
+    std::scoped_lock lock(reg.mutex);
+
+    TimingTotals totals = reg.retired;
+    for (const ThreadCounters* counters : reg.threads)
+    {
+        counters->addTo(totals);
+    }
+    return totals;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Reset the accumulated times of all threads
+ */
+void resetTiming()
+{
+    Registry&        reg = registry();
+    std::scoped_lock lock(reg.mutex);
+
+    reg.retired = TimingTotals();
+    for (ThreadCounters* counters : reg.threads)
+    {
+        counters->reset();
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Write a table of the accumulated times of all threads
+ *
+ * Nested timers of the same phase are each counted, so the total time of a
+ * phase is inclusive.
+ *
+ * \param[in,out] os  The stream to write to
+ */
+void writeTimingReport(std::ostream& os)
+{
+    const TimingTotals totals = timingTotals();
+
+    std::ios state(nullptr);
+    state.copyfmt(os);
+
+    os << std::left << std::setw(10) << "Phase" << std::right
+       << std::setw(12) << "Calls" << std::setw(14) << "Total (ms)"
+       << std::setw(14) << "Mean (us)" << '\n';
+    os << std::fixed << std::setprecision(3);
+    for (std::size_t i = 0; i < num_timing_phases; ++i)
+    {
+        const PhaseTiming& t    = totals[i];
+        const double       ms   = static_cast<double>(t.nanoseconds) * 1e-6;
+        const double       mean = t.calls == 0
+                                      ? 0.0
+                                      : static_cast<double>(t.nanoseconds)
+                                      * 1e-3 / static_cast<double>(t.calls);
+        os << std::left << std::setw(10)
+           << timingPhaseName(static_cast<TimingPhase>(i)) << std::right
+           << std::setw(12) << t.calls << std::setw(14) << ms
+           << std::setw(14) << mean << '\n';
+    }
+
+    os.copyfmt(state);
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/harness/Timing.cc
+//---------------------------------------------------------------------------//
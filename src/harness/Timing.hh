@@ -0,0 +1,189 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/Timing.hh
+ * \brief  Scoped timers and per-phase timing counters.
+ *
+ * Timing instrumentation is enabled at configure time using the YAYP_TIMING
+ * macro, analogous to YAYP_DBC, where:
+ *  - YAYP_TIMING == 0  All timers compile to nothing
+ *  - YAYP_TIMING >  0  Whole-document phases are timed with YAYP_TIMER
+ *  - YAYP_TIMING >  1  Components within a phase (e.g., block scalars, alias
+ *                      resolution) are timed with YAYP_TIMER_DETAIL
+ *  - YAYP_TIMING >  2  Individual parse events are timed with YAYP_TIMER_FINE
+ *
+ * Each timer adds its elapsed time and a call count to the counters of its
+ * phase.  The counters are kept in thread-local storage, so recording a time
+ * never contends between threads; timingTotals() and writeTimingReport()
+ * aggregate the counters of all threads, including threads that have exited.
+ *
+ * \note Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_HARNESS_TIMING_HH
+#define YAYP_HARNESS_TIMING_HH
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+#ifndef YAYP_TIMING
+#define YAYP_TIMING 0 // By default, timing is disabled
+#endif
+
+//===========================================================================//
+/* \def YAYP_TIMER_
+ * \brief Basic timer macro
+ *
+ * Declares a ScopedTimer whose name is unique to the line, so that several
+ * timers may appear in one scope.
+ */
+#define YAYP_TIMER_CAT_(A, B) A##B
+#define YAYP_TIMER_NAME_(LINE) YAYP_TIMER_CAT_(yayp_scoped_timer_, LINE)
+#define YAYP_TIMER_(PHASE) \
+    ::yayp::ScopedTimer YAYP_TIMER_NAME_(__LINE__)(::yayp::TimingPhase::PHASE)
+#define YAYP_NOTIMER_(PHASE) \
+    do                       \
+    {                        \
+    } while (false)
+
+//===========================================================================//
+/*!
+ * \def YAYP_TIMER
+ * \brief Time the remainder of the enclosing scope as a whole-document phase.
+ *
+ * The argument is a TimingPhase enumerator (e.g., YAYP_TIMER(Scan)).  This
+ * macro compiles out if YAYP_TIMING == 0.
+ */
+#if YAYP_TIMING > 0
+#define YAYP_TIMER_ON
+#define YAYP_TIMER(PHASE) YAYP_TIMER_(PHASE)
+#else
+#define YAYP_TIMER(PHASE) YAYP_NOTIMER_(PHASE)
+#endif
+
+//===========================================================================//
+/*!
+ * \def YAYP_TIMER_DETAIL
+ * \brief Time the remainder of the enclosing scope as a component of a phase.
+ *
+ * This macro compiles out if YAYP_TIMING <= 1.
+ */
+#if YAYP_TIMING > 1
+#define YAYP_TIMER_DETAIL_ON
+#define YAYP_TIMER_DETAIL(PHASE) YAYP_TIMER_(PHASE)
+#else
+#define YAYP_TIMER_DETAIL(PHASE) YAYP_NOTIMER_(PHASE)
+#endif
+
+//===========================================================================//
+/*!
+ * \def YAYP_TIMER_FINE
+ * \brief Time the remainder of the enclosing scope as a single parse event.
+ *
+ * This macro compiles out if YAYP_TIMING <= 2.
+ */
+#if YAYP_TIMING > 2
+#define YAYP_TIMER_FINE_ON
+#define YAYP_TIMER_FINE(PHASE) YAYP_TIMER_(PHASE)
+#else
+#define YAYP_TIMER_FINE(PHASE) YAYP_NOTIMER_(PHASE)
+#endif
+
+namespace yayp
+{
+//! Phases of loading and writing a document
+enum class TimingPhase
+{
+    Read,    //!< Reading the input
+    Index,   //!< Indexing the structure of the input
+    Scan,    //!< Scanning tokens and scalars
+    Build,   //!< Building the document tree
+    Resolve, //!< Resolving aliases and merge keys
+    Emit     //!< Writing a document
+};
+
+//! Number of timing phases
+constexpr std::size_t num_timing_phases = 6;
+
+//! Accumulated time of a phase
+struct PhaseTiming
+{
+    std::uint64_t calls       = 0;
+    std::uint64_t nanoseconds = 0;
+};
+
+//! Accumulated times of all phases, indexed by TimingPhase
+using TimingTotals = std::array<PhaseTiming, num_timing_phases>;
+
+//===========================================================================//
+/*!
+ * \class ScopedTimer
+ * \brief Adds the time between its construction and destruction to the
+ *        counters of a phase.
+ *
+ * Prefer the YAYP_TIMER macros, which compile out according to YAYP_TIMING.
+ *
+ * \example src/harness/tests/tstTiming.cc
+ */
+//===========================================================================//
+
+class ScopedTimer
+{
+    using Clock = std::chrono::steady_clock;
+
+  public:
+    //! Start timing the given phase
+    explicit ScopedTimer(TimingPhase phase)
+        : m_phase(phase)
+        , m_start(Clock::now())
+    {
+        /* * */
+    }
+
+    //! Stop timing and record the elapsed time
+    ~ScopedTimer()
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - m_start);
+        addTiming(m_phase, static_cast<std::uint64_t>(elapsed.count()));
+    }
+
+    // Timers are bound to their scope
+    ScopedTimer(const ScopedTimer&)            = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  private:
+    // Record a time for the calling thread
+    static void addTiming(TimingPhase phase, std::uint64_t nanoseconds);
+
+  private:
+    // >>> DATA
+    TimingPhase       m_phase;
+    Clock::time_point m_start;
+};
+
+//---------------------------------------------------------------------------//
+// HELPER FUNCTIONS
+//---------------------------------------------------------------------------//
+// Return the name of a timing phase
+const char* timingPhaseName(TimingPhase phase);
+
+// Return the accumulated times of all threads
+TimingTotals timingTotals();
+
+// Reset the accumulated times of all threads
+void resetTiming();
+
+// Write a table of the accumulated times of all threads
+void writeTimingReport(std::ostream& os);
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_HARNESS_TIMING_HH
+//---------------------------------------------------------------------------//
+// end of src/harness/Timing.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,57 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/YamlTesting.hh
+ * \brief  Macro declarations to compare YAML streams in unit tests
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_HARNESS_YAMLTESTING_HH
+#define YAYP_HARNESS_YAMLTESTING_HH
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+namespace testing_detail
+{
+// Return whether a YAML stream matches the contents of a YAML file
+inline ::testing::AssertionResult
+isYamlSoftEqual(const char*        expected_expr,
+                const char*        actual_expr,
+                const std::string& expected_file,
+                std::string_view   actual_doc);
+
+// Return whether a YAML stream matches the contents of a YAML file within the
+// given relative precision
+inline ::testing::AssertionResult
+isYamlSoftEqual(const char*        expected_expr,
+                const char*        actual_expr,
+                const char*,
+                const std::string& expected_file,
+                std::string_view   actual_doc,
+                double             rel_tol);
+
+//---------------------------------------------------------------------------//
+} // namespace testing_detail
+
+// GTest-compliant macros for soft equality test between a golden YAML file
+// and a YAML stream (e.g., emitted text or the view of a MappedFile), which
+// are compared without building either document
+#define EXPECT_YAML_SOFT_EQ(expected_file, actual_doc) \
+    EXPECT_PRED_FORMAT2(                               \
+        testing_detail::isYamlSoftEqual, expected_file, actual_doc)
+#define EXPECT_YAML_SOFTEQ(expected_file, actual_doc, rel_tol) \
+    EXPECT_PRED_FORMAT3(                                       \
+        testing_detail::isYamlSoftEqual, expected_file, actual_doc, rel_tol)
+
+//---------------------------------------------------------------------------//
+// INLINE FUNCTION DEFINITIONS
+//---------------------------------------------------------------------------//
+#include "YamlTesting.i.hh"
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_HARNESS_YAMLTESTING_HH
+//---------------------------------------------------------------------------//
+// end of src/harness/YamlTesting.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,138 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/YamlTesting.i.hh
+ * \brief  YamlTesting inline method definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_HARNESS_YAMLTESTING_I_HH
+#define YAYP_HARNESS_YAMLTESTING_I_HH
+
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+
+#include "core/MappedFile.hh"
+#include "harness/DBC.hh"
+#include "harness/SoftEqual.hh"
+#include "yaml/StreamComparison.hh"
+
+namespace testing_detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Write a difference between two YAML streams
+ */
+inline void writeYamlDifference(std::ostream&                             os,
+                                const yayp::StreamComparison::Difference& d)
+{
+    os << "\n  at " << (d.path.empty() ? "the root" : d.path.c_str());
+    if (d.document > 0)
+    {
+        os << " of document " << d.document;
+    }
+    os << ": expected " << d.expected << ", actual " << d.actual;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Helper function compatible with GTest for testing the soft equality
+ * of a YAML stream with a golden file
+ *
+ * \param[in] expected_expr  The name of the expected file
+ * \param[in] actual_expr    The name of the actual stream
+ * \param[in] expected_file  The path of the golden YAML file
+ * \param[in] actual_doc     The YAML text to test
+ * \return A GTest AssertionResult object indicating if the test passed
+ */
+::testing::AssertionResult isYamlSoftEqual(const char*        expected_expr,
+                                           const char*        actual_expr,
+                                           const std::string& expected_file,
+                                           std::string_view   actual_doc)
+{
+    // Call with the default relative precision
+    yayp::SoftEqual<double, double> se;
+    return isYamlSoftEqual(expected_expr,
+                           actual_expr,
+                           "",
+                           expected_file,
+                           actual_doc,
+                           se.rel_tol());
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Helper function compatible with GTest for testing the soft equality
+ * of a YAML stream with a golden file within some relative precision
+ *
+ * The file is mapped into memory and both streams are compared with a
+ * StreamComparison, so that neither document is built.  The message lists
+ * the first unequal values and the structural mismatch, if any, by path.
+ *
+ * \param[in] expected_expr  The name of the expected file
+ * \param[in] actual_expr    The name of the actual stream
+ * \param[in] expected_file  The path of the golden YAML file
+ * \param[in] actual_doc     The YAML text to test
+ * \param[in] rel_tol        The tolerance of the relative difference of
+ *                           numeric values
+ * \return A GTest AssertionResult object indicating if the test passed
+ */
+::testing::AssertionResult isYamlSoftEqual(const char*        expected_expr,
+                                           const char*        actual_expr,
+                                           const char*,
+                                           const std::string& expected_file,
+                                           std::string_view   actual_doc,
+                                           double             rel_tol)
+{
+    yayp::MappedFile expected;
+    try
+    {
+        expected = yayp::MappedFile(expected_file);
+    }
+    catch (const yayp::Exception& e)
+    {
+        return ::testing::AssertionFailure()
+               << "Expected YAML file " << expected_expr << " ("
+               << expected_file << ") could not be read: " << e.what();
+    }
+
+    yayp::StreamComparison comparison(rel_tol);
+    if (comparison.compare(expected.view(), actual_doc))
+    {
+        return ::testing::AssertionSuccess();
+    }
+
+    std::ostringstream msg;
+    msg << std::setprecision(16) << "Expected soft equality between the YAML "
+        << "file " << expected_expr << " (" << expected_file << ") and "
+        << actual_expr;
+    if (comparison.count() > 0)
+    {
+        msg << ", which differ in " << comparison.count() << " value(s)";
+        for (const auto& difference : comparison.differences())
+        {
+            writeYamlDifference(msg, difference);
+        }
+        if (comparison.count() > comparison.differences().size())
+        {
+            msg << "\n  (only the first " << comparison.differences().size()
+                << " are shown)";
+        }
+    }
+    if (const auto& mismatch = comparison.mismatch())
+    {
+        msg << "\n  and stopped at a structural mismatch";
+        writeYamlDifference(msg, *mismatch);
+    }
+    msg << "\n  tested with relative tolerance " << comparison.relTol();
+    return ::testing::AssertionFailure() << msg.str();
+}
+
+//---------------------------------------------------------------------------//
+} // namespace testing_detail
+
+#endif // YAYP_HARNESS_YAMLTESTING_I_HH
+
+//---------------------------------------------------------------------------//
+// end of src/harness/YamlTesting.i.hh
+//---------------------------------------------------------------------------//
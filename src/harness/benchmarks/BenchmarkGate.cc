@@ -0,0 +1,210 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/benchmarks/BenchmarkGate.cc
+ * \brief  Compares benchmark results with a stored baseline.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ *
+ * Usage: \c BenchmarkGate \c baseline.json \c results.json \c tolerance
+ *
+ * Both files are the JSON output of a Google Benchmark run with
+ * repetitions (\c --benchmark_out, with \c --benchmark_repetitions), which
+ * is read with the YAYP parser since JSON is a subset of YAML.  The median
+ * time of each benchmark of the baseline is compared with the median time
+ * of the same benchmark in the results.  A benchmark fails when it is
+ * missing from the results, or when its throughput (the inverse of its
+ * time) is lower than the baseline's and not SoftEqual to it with a
+ * relative tolerance of \c tolerance percent.  Faster benchmarks always
+ * pass, with a note suggesting to update the baseline.
+ *
+ * The exit status is 0 if all benchmarks pass, 1 if any fails, and 2 if
+ * the files cannot be read.
+ */
+//---------------------------------------------------------------------------//
+
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "core/MappedFile.hh"
+#include "harness/DBC.hh"
+#include "harness/SoftEqual.hh"
+#include "yaml/Node.hh"
+#include "yaml/Parser.hh"
+
+namespace
+{
+//! Median time of each benchmark, in nanoseconds
+using Medians = std::map<std::string, double>;
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the number of nanoseconds in a Google Benchmark time unit
+ */
+double nanoseconds(const std::string& unit)
+{
+    if (unit == "ns")
+    {
+        return 1;
+    }
+    if (unit == "us")
+    {
+        return 1e3;
+    }
+    if (unit == "ms")
+    {
+        return 1e6;
+    }
+    if (unit == "s")
+    {
+        return 1e9;
+    }
+    throw yayp::Exception("Unknown time unit '" + unit + "'");
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Read the median times of the benchmarks in a JSON results file
+ */
+Medians readMedians(const std::string& filename, std::string& host)
+{
+    yayp::MappedFile  file(filename);
+    yayp::NodePtr     doc        = yayp::Parser().parse(file.view());
+    const yayp::Node* benchmarks = doc->find("benchmarks");
+    const yayp::Node* context    = doc->find("context");
+    if (!benchmarks)
+    {
+        throw yayp::Exception(filename + " holds no benchmarks");
+    }
+    if (context && context->find("host_name"))
+    {
+        host = context->find("host_name")->scalar();
+    }
+
+    Medians medians;
+    for (const auto& benchmark : benchmarks->items())
+    {
+        const yayp::Node* aggregate = benchmark->find("aggregate_name");
+        if (!aggregate || aggregate->scalar() != "median")
+        {
+            continue;
+        }
+        const yayp::Node* name = benchmark->find("run_name");
+        const yayp::Node* time = benchmark->find("real_time");
+        const yayp::Node* unit = benchmark->find("time_unit");
+        if (!name || !time || !unit || !time->number())
+        {
+            throw yayp::Exception(filename + " holds an invalid benchmark");
+        }
+        medians[name->scalar()] = *time->number()
+                                  * nanoseconds(unit->scalar());
+    }
+    if (medians.empty())
+    {
+        throw yayp::Exception(filename
+                              + " holds no medians (run the benchmarks "
+                                "with --benchmark_repetitions)");
+    }
+    return medians;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// MAIN
+//---------------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+    if (argc != 4)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <baseline.json> <results.json> <tolerance (%)>\n";
+        return 2;
+    }
+
+    const double tolerance = std::atof(argv[3]) / 100;
+    if (!(tolerance > 0))
+    {
+        std::cerr << "Error: the tolerance must be positive\n";
+        return 2;
+    }
+
+    Medians     baseline;
+    Medians     results;
+    std::string baseline_host;
+    std::string results_host;
+    try
+    {
+        baseline = readMedians(argv[1], baseline_host);
+        results  = readMedians(argv[2], results_host);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 2;
+    }
+    if (baseline_host != results_host)
+    {
+        std::cout << "Note: the baseline was recorded on '" << baseline_host
+                  << "', not on '" << results_host << "'\n";
+    }
+
+    // Compare the throughput of each benchmark, the inverse of its time
+    yayp::SoftEqual<double, double> se(tolerance);
+    std::size_t                     failures = 0;
+    std::cout << std::left << std::setw(40) << "Benchmark" << std::right
+              << std::setw(14) << "Baseline (ns)" << std::setw(14)
+              << "Median (ns)" << std::setw(12) << "Throughput" << '\n';
+    for (const auto& [name, time] : baseline)
+    {
+        std::cout << std::left << std::setw(40) << name << std::right
+                  << std::setw(14) << std::setprecision(6) << time;
+        auto iter = results.find(name);
+        if (iter == results.end())
+        {
+            std::cout << std::setw(14) << "-" << "  MISSING\n";
+            ++failures;
+            continue;
+        }
+
+        // Normalize the throughput by the baseline's: per-nanosecond
+        // throughputs would fall under the absolute tolerance of SoftEqual
+        const double expected = 1;
+        const double actual   = time / iter->second;
+        const double change   = 100 * (actual - expected);
+        std::cout << std::setw(14) << iter->second << std::setw(11)
+                  << std::showpos << std::fixed << std::setprecision(1)
+                  << change << '%' << std::noshowpos << std::defaultfloat
+                  << std::setprecision(6);
+        if (se(expected, actual))
+        {
+            std::cout << '\n';
+        }
+        else if (actual < expected)
+        {
+            std::cout << "  REGRESSED\n";
+            ++failures;
+        }
+        else
+        {
+            std::cout << "  faster (consider updating the baseline)\n";
+        }
+    }
+
+    if (failures > 0)
+    {
+        std::cout << failures << " of " << baseline.size()
+                  << " benchmarks lost more than " << 100 * tolerance
+                  << "% of their baseline throughput or did not run\n";
+        return 1;
+    }
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
+// end of src/harness/benchmarks/BenchmarkGate.cc
+//---------------------------------------------------------------------------//
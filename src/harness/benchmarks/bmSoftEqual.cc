@@ -0,0 +1,92 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/benchmarks/bmSoftEqual.cc
+ * \brief  Benchmarks for the soft comparison of containers.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../SoftEqual.hh"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return random values and a copy perturbed within the tolerance
+ */
+std::pair<std::vector<double>, std::vector<double>>
+makeValues(std::size_t size)
+{
+    std::mt19937                           rng(42);
+    std::uniform_real_distribution<double> dist(-1e3, 1e3);
+
+    std::vector<double> expected(size);
+    std::vector<double> actual(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        expected[i] = dist(rng);
+        actual[i]   = expected[i] * (1 + 1e-14);
+    }
+    return {std::move(expected), std::move(actual)};
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// BENCHMARKS
+//---------------------------------------------------------------------------//
+
+static void BM_ElementWise(benchmark::State& state)
+{
+    // Compare each pair of values with SoftEqual::operator()
+    const auto [expected, actual]
+        = makeValues(static_cast<std::size_t>(state.range(0)));
+    yayp::SoftEqual<double, double> se;
+    for (auto _ : state)
+    {
+        bool equal = true;
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            if (!se(expected[i], actual[i]))
+            {
+                equal = false;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(equal);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ElementWise)
+    ->Arg(1 << 14)
+    ->Arg(1 << 24)
+    ->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------//
+
+static void BM_SoftContainerEqual(benchmark::State& state)
+{
+    // Compare the contiguous values in bulk
+    const auto [expected, actual]
+        = makeValues(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(yayp::softContainerEqual(expected, actual));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SoftContainerEqual)
+    ->Arg(1 << 14)
+    ->Arg(1 << 24)
+    ->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------//
+// end of src/harness/benchmarks/bmSoftEqual.cc
+//---------------------------------------------------------------------------//
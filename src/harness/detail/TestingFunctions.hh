@@ -8,44 +8,134 @@
 #ifndef YAYP_HARNESS_DETAIL_TESTINGFUNCTIONS_HH
 #define YAYP_HARNESS_DETAIL_TESTINGFUNCTIONS_HH
 
+#include <cstddef>
 #include <string>
 #include <type_traits>
 #include <vector>
 
-namespace utils
+namespace yayp
 {
 namespace detail
 {
+//===========================================================================//
+/*!
+ * \class Mismatches
+ * \brief The unequal elements found by comparing two containers.
+ *
+ * Every unequal element is counted, but only the indices of the first few are
+ * stored: enough to print a table of them, and no more, so that comparing two
+ * huge containers that differ everywhere does not need memory proportional to
+ * their size.  When the relative differences of the elements are known, the
+ * largest of them and its index are kept as well (a NaN difference counts as
+ * the largest).
+ *
+ * The mismatches of consecutive ranges, found separately, are combined with
+ * merge() in order, giving the same result as a single pass.
+ *
+ * \example src/harness/detail/tests/tstTestingFunctions.cc
+ */
+//===========================================================================//
+
+class Mismatches
+{
+  public:
+    //! Default number of stored indices
+    static constexpr std::size_t default_max_stored = 30;
+
+  public:
+    // Constructor
+    explicit Mismatches(std::size_t max_stored = default_max_stored);
+
+    // Record an unequal element, in increasing order of index
+    void add(std::size_t index);
+
+    // Record an unequal element and its relative difference
+    void add(std::size_t index, double rel_diff);
+
+    // Add the mismatches of a range following this one
+    void merge(const Mismatches& later);
+
+    // >>> ACCESSORS
+    //! Return the number of unequal elements
+    std::size_t count() const { return m_count; }
+
+    //! Return whether there are no unequal elements
+    bool empty() const { return m_count == 0; }
+
+    //! Return the indices of the first unequal elements, in increasing order
+    const std::vector<std::size_t>& indices() const { return m_indices; }
+
+    //! Return whether some of the unequal elements are not stored
+    bool truncated() const { return m_count > m_indices.size(); }
+
+    //! Return whether the relative differences are known
+    bool hasRelDiff() const { return m_has_rel_diff; }
+
+    //! Return the largest relative difference
+    double maxRelDiff() const { return m_max_rel_diff; }
+
+    //! Return the index of the element with the largest relative difference
+    std::size_t maxRelDiffIndex() const { return m_max_rel_diff_index; }
+
+  private:
+    // >>> DATA
+    std::size_t              m_max_stored;
+    std::size_t              m_count = 0;
+    std::vector<std::size_t> m_indices;
+    bool                     m_has_rel_diff       = false;
+    double                   m_max_rel_diff       = 0;
+    std::size_t              m_max_rel_diff_index = 0;
+};
+
+//---------------------------------------------------------------------------//
+// Return the relative difference between an expected and an actual value
+template<class T1, class T2>
+inline auto rel_diff(const T1& expected, const T2& actual)
+    -> std::common_type_t<T1, T2>;
+
 // Build a vector of relative differences between elements of the two
 // containers at the given indices.
 template<class Container1, class Container2>
-inline auto calc_rel_diffs(const std::vector<unsigned int>& indices,
-                           const Container1&                expected,
-                           const Container2&                actual)
+inline auto calc_rel_diffs(const std::vector<std::size_t>& indices,
+                           const Container1&               expected,
+                           const Container2&               actual)
     -> std::vector<std::common_type_t<typename Container1::value_type,
                                       typename Container2::value_type>>;
 
 // Compute the maximum field width to print select values from the container
 template<class Container>
 inline std::size_t
-find_max_field_width(const std::string&               header,
-                     const std::vector<unsigned int>& indices,
-                     const Container&                 cont,
-                     unsigned int                     precision);
+find_max_field_width(const std::string&              header,
+                     const std::vector<std::size_t>& indices,
+                     const Container&                cont,
+                     unsigned int                    precision);
 
 // Write a string containing a table of the unequal values in the given two
 // containers at the given bad indices
 template<class Container1, class Container2>
 inline std::string
-write_unequal_values(const std::vector<unsigned int>& bad_indices,
-                     const char*                      expected_expr,
-                     const char*                      actual_expr,
-                     const Container1&                expected,
-                     const Container2&                actual);
+write_unequal_values(const std::vector<std::size_t>& bad_indices,
+                     const char*                     expected_expr,
+                     const char*                     actual_expr,
+                     const Container1&               expected,
+                     const Container2&               actual);
+
+// Write a summary of the unequal elements to follow their table
+inline std::string write_mismatch_summary(const Mismatches& mismatches);
+
+// Collect the unequal elements, splitting large ranges across threads
+template<class Collect>
+inline Mismatches collect_bad_indices(std::size_t size, Collect&& collect);
+
+// Collect the unequal elements with the given number of threads
+template<class Collect>
+inline Mismatches collect_bad_indices(std::size_t size,
+                                      Collect&&   collect,
+                                      std::size_t num_threads);
 
 //---------------------------------------------------------------------------//
 } // namespace detail
-} // namespace utils
+} // namespace yayp
 
 //---------------------------------------------------------------------------//
 // INLINE DEFINITIONS
@@ -9,10 +9,14 @@
 #define YAYP_HARNESS_DETAIL_TESTINGFUNCTIONS_I_HH
 
 #include <algorithm>
+#include <cmath>
+#include <future>
 #include <iomanip>
+#include <iterator>
 #include <limits>
 #include <numeric>
 #include <sstream>
+#include <thread>
 
 #include "harness/DBC.hh"
 
@@ -20,11 +24,129 @@ namespace yayp
 {
 namespace detail
 {
+//---------------------------------------------------------------------------//
+//! Minimum number of elements compared by each thread
+constexpr std::size_t parallel_grain = std::size_t(1) << 20;
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return whether a relative difference is larger than another
+ *
+ * A NaN difference is larger than any other.
+ */
+inline bool is_larger_rel_diff(double a, double b)
+{
+    return a > b || (std::isnan(a) && !std::isnan(b));
+}
+
+//---------------------------------------------------------------------------//
+// MISMATCHES
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor
+ *
+ * \param[in] max_stored  The number of indices to store
+ */
+inline Mismatches::Mismatches(std::size_t max_stored)
+    : m_max_stored(max_stored)
+{
+    /* * */
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Record an unequal element
+ *
+ * \param[in] index  The index of the element, larger than any recorded so far
+ */
+inline void Mismatches::add(std::size_t index)
+{
+    YAYP_REQUIRE(m_indices.empty() || index > m_indices.back());
+    ++m_count;
+    if (m_indices.size() < m_max_stored)
+    {
+        m_indices.push_back(index);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Record an unequal element and its relative difference
+ *
+ * \param[in] index     The index of the element, larger than any recorded so
+ *                      far
+ * \param[in] rel_diff  The relative difference of the element
+ */
+inline void Mismatches::add(std::size_t index, double rel_diff)
+{
+    if (!m_has_rel_diff || is_larger_rel_diff(rel_diff, m_max_rel_diff))
+    {
+        m_has_rel_diff       = true;
+        m_max_rel_diff       = rel_diff;
+        m_max_rel_diff_index = index;
+    }
+    this->add(index);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add the mismatches of a range following this one
+ *
+ * Ties in the largest relative difference keep the earlier index.
+ *
+ * \param[in] later  The mismatches of the elements after those of this range
+ */
+inline void Mismatches::merge(const Mismatches& later)
+{
+    YAYP_REQUIRE(m_indices.empty() || later.m_indices.empty()
+                 || later.m_indices.front() > m_indices.back());
+    m_count += later.m_count;
+
+    const std::size_t num_stored = std::min(
+        later.m_indices.size(), m_max_stored - m_indices.size());
+    m_indices.insert(m_indices.end(),
+                     later.m_indices.begin(),
+                     later.m_indices.begin() + num_stored);
+
+    if (later.m_has_rel_diff
+        && (!m_has_rel_diff
+            || is_larger_rel_diff(later.m_max_rel_diff, m_max_rel_diff)))
+    {
+        m_has_rel_diff       = true;
+        m_max_rel_diff       = later.m_max_rel_diff;
+        m_max_rel_diff_index = later.m_max_rel_diff_index;
+    }
+}
+
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the relative difference between an expected and an actual
+ *        value
+ *
+ * The difference is relative to the actual value, and infinite if it is zero.
+ */
+template<class T1, class T2>
+auto rel_diff(const T1& expected, const T2& actual)
+    -> std::common_type_t<T1, T2>
+{
+    using value_type = std::common_type_t<T1, T2>;
+    if (actual != 0)
+    {
+        return std::abs(expected - actual) / std::abs(actual);
+    }
+    return std::numeric_limits<value_type>::infinity();
+}
+
 //---------------------------------------------------------------------------//
 /*!
  * \brief Build a vector of relative differences between elements of the two
  *        containers at the given indices.
  *
+ * Only the selected elements are visited: the iterators of random access
+ * containers jump directly from one index to the next.
+ *
  * \tparam Container1  The container type of expected values
  * \tparam Container2  The container type of actual values
  * \param[in] indices Elements in \a expected and \a actual to compute the
@@ -35,13 +157,16 @@ namespace detail
  *         values for the selected element indices
  */
 template<class Container1, class Container2>
-auto calc_rel_diffs(const std::vector<unsigned int>& indices,
-                    const Container1&                expected,
-                    const Container2&                actual)
+auto calc_rel_diffs(const std::vector<std::size_t>& indices,
+                    const Container1&               expected,
+                    const Container2&               actual)
     -> std::vector<std::common_type_t<typename Container1::value_type,
                                       typename Container2::value_type>>
 {
     YAYP_REQUIRE(std::is_sorted(indices.cbegin(), indices.cend()));
+    YAYP_REQUIRE(indices.empty()
+                 || (indices.back() < std::size(expected)
+                     && indices.back() < std::size(actual)));
     using value_type = std::common_type_t<typename Container1::value_type,
                                           typename Container2::value_type>;
     static_assert(std::is_floating_point<value_type>::value,
@@ -52,34 +177,17 @@ auto calc_rel_diffs(const std::vector<unsigned int>& indices,
     std::vector<value_type> rel_diffs;
     rel_diffs.reserve(indices.size());
 
-    auto         expected_iter = expected.cbegin();
-    auto         actual_iter   = actual.cbegin();
-    auto         idx_iter      = indices.cbegin();
-    unsigned int index         = 0;
-    while (idx_iter != indices.cend() && expected_iter != expected.cend()
-           && actual_iter != actual.cend())
+    auto        expected_iter = expected.cbegin();
+    auto        actual_iter   = actual.cbegin();
+    std::size_t index         = 0;
+    for (std::size_t next : indices)
     {
-        // If this is one of the requested indices, compute the relative
-        // difference
-        if (index == *idx_iter)
-        {
-            if (*actual_iter != 0)
-            {
-                rel_diffs.push_back(std::abs(*expected_iter - *actual_iter)
-                                    / std::abs(*actual_iter));
-            }
-            else
-            {
-                rel_diffs.push_back(
-                    std::numeric_limits<value_type>::infinity());
-            }
-            ++idx_iter;
-        }
-
-        ++expected_iter, ++actual_iter, ++index;
+        // Advance to the requested index and compute the relative difference
+        std::advance(expected_iter, next - index);
+        std::advance(actual_iter, next - index);
+        index = next;
+        rel_diffs.push_back(rel_diff(*expected_iter, *actual_iter));
     }
-
-    rel_diffs.shrink_to_fit();
     return rel_diffs;
 }
 
@@ -89,45 +197,39 @@ auto calc_rel_diffs(const std::vector<unsigned int>& indices,
  * in the container
  *
  * Get the maximum number characters necessary to write the values at given
- * indices in the given container with the given precision.
+ * indices in the given container with the given precision.  Only the
+ * selected elements are visited.
  *
  * \tparam Container  The type of the element container
  * \param[in] header    A string containing the table header for these elements
  * \param[in] indices   The indices of the elements in the container to
- *                      consider
+ *                      consider, in increasing order
  * \param[in] cont      The container of elements
  * \param[in] precision The precision to use when considering the elements
  * \return The maximum field width necessary to print the elements at the
  *         given indices in the container.
  */
 template<class Container>
-std::size_t find_max_field_width(const std::string&               header,
-                                 const std::vector<unsigned int>& indices,
-                                 const Container&                 cont,
-                                 unsigned int                     precision)
+std::size_t find_max_field_width(const std::string&              header,
+                                 const std::vector<std::size_t>& indices,
+                                 const Container&                cont,
+                                 unsigned int                    precision)
 {
+    YAYP_REQUIRE(std::is_sorted(indices.cbegin(), indices.cend()));
+    YAYP_REQUIRE(indices.empty() || indices.back() < std::size(cont));
     std::size_t max_field_size = header.size();
 
-    auto         elem_iter = cont.cbegin();
-    auto         idx_iter  = indices.cbegin();
-    unsigned int index     = 0;
-    while (elem_iter != cont.cend() && idx_iter != indices.cend())
+    auto        elem_iter = cont.cbegin();
+    std::size_t index     = 0;
+    for (std::size_t next : indices)
     {
-        // If the current element index corresponds to one of the listed
-        // indices, then we'll consider it's string length
-        if (index == *idx_iter)
-        {
-            // Convert the element to a string using the given precision and
-            // update the max field size
-            std::ostringstream os;
-            os << std::setprecision(precision) << *elem_iter;
-            max_field_size = std::max(max_field_size, os.str().size());
-
-            // Increment to the next element index
-            ++idx_iter;
-        }
-
-        ++elem_iter, ++index;
+        // Convert the element to a string using the given precision and
+        // update the max field size
+        std::advance(elem_iter, next - index);
+        index = next;
+        std::ostringstream os;
+        os << std::setprecision(precision) << *elem_iter;
+        max_field_size = std::max(max_field_size, os.str().size());
     }
 
     // Add one to put a space between table columns
@@ -136,15 +238,17 @@ std::size_t find_max_field_width(const std::string&               header,
 
 //---------------------------------------------------------------------------//
 /*!
- * \brief Write the values from the unequal containers if the containers aren't
- * too long.
+ * \brief Write a table of the values from the unequal containers at the
+ * given indices.
  *
- * This function is specialized for non-floating-point types.
+ * The caller bounds the number of rows: it normally passes the indices
+ * stored by Mismatches.  Relative differences are written only for
+ * floating-point types.
  *
  * \tparam Container1  The type of the expected values container
  * \tparam Container2  The type of the actual values container
  * \param[in] bad_indices  The indices into the two containers where the
- *                         unequal values are located
+ *                         unequal values are located, in increasing order
  * \param[in] expected_expr  The name of the expected container
  * \param[in] actual_expr    The name of the actual container
  * \param[in] expected       The container with the expected values
@@ -152,7 +256,7 @@ std::size_t find_max_field_width(const std::string&               header,
  * \return A string containing the unequal values from the containers
  */
 template<class Container1, class Container2>
-std::string write_unequal_values(const std::vector<unsigned int>& bad_indices,
+std::string write_unequal_values(const std::vector<std::size_t>& bad_indices,
                                  const char*       expected_expr,
                                  const char*       actual_expr,
                                  const Container1& expected,
@@ -162,83 +266,170 @@ std::string write_unequal_values(const std::vector<unsigned int>& bad_indices,
                                           typename Container1::value_type>;
     std::ostringstream msg;
 
-    // If we have a modest number of differences (<30) we will print them out
-    // explicitly (otherwise do nothing)
-    if (bad_indices.size() < 30)
+    // Hard-code the output precision
+    const std::size_t precision = 16;
+
+    // Get whether we are actually writing floating-point values
+    constexpr bool is_floating_point
+        = std::is_floating_point_v<typename Container1::value_type>;
+
+    // Positions of the sampled values, for tables built from them
+    std::vector<std::size_t> positions(bad_indices.size());
+    std::iota(positions.begin(), positions.end(), std::size_t(0));
+
+    // Get the maximum field width for the indices, the expected
+    // values, the actual values, and the relative differences
+    std::size_t max_index_width
+        = find_max_field_width("Index", positions, bad_indices, precision);
+    std::size_t max_expected_width = find_max_field_width(
+        expected_expr, bad_indices, expected, precision);
+    std::size_t max_actual_width
+        = find_max_field_width(actual_expr, bad_indices, actual, precision);
+
+    // Print the table header
+    msg << std::setw(max_index_width) << "Index"
+        << std::setw(max_expected_width) << expected_expr
+        << std::setw(max_actual_width) << actual_expr;
+
+    // Add relative differences if this is a floating point type
+    std::vector<value_type> rel_diffs;
+    std::size_t             max_rel_diff_width = 0;
+    if constexpr (is_floating_point)
+    {
+        rel_diffs = calc_rel_diffs(bad_indices, expected, actual);
+        YAYP_CHECK(rel_diffs.size() == bad_indices.size());
+
+        // Get the maximum field width of the relative differences
+        max_rel_diff_width = find_max_field_width(
+            "Rel. Diff.", positions, rel_diffs, precision);
+        msg << std::setw(max_rel_diff_width) << "Rel. Diff.";
+    }
+
+    // Write a table row for each of the sorted bad indices
+    auto        expected_iter = expected.cbegin();
+    auto        actual_iter   = actual.cbegin();
+    std::size_t index         = 0;
+    for (std::size_t i = 0; i < bad_indices.size(); ++i)
     {
-        // Hard-code the output precision
-        const std::size_t precision = 16;
-
-        // Get whether we are actually writing floating-point values
-        constexpr bool is_floating_point
-            = std::is_floating_point_v<typename Container1::value_type>;
-
-        // Get the maximum field width for the indices, the expected
-        // values, the actual values, and the relative differences
-        std::size_t max_index_width = find_max_field_width(
-            "Index", bad_indices, bad_indices, precision);
-        std::size_t max_expected_width = find_max_field_width(
-            expected_expr, bad_indices, expected, precision);
-        std::size_t max_actual_width = find_max_field_width(
-            actual_expr, bad_indices, actual, precision);
-
-        // Print the table header
-        msg << std::setw(max_index_width) << "Index"
-            << std::setw(max_expected_width) << expected_expr
-            << std::setw(max_actual_width) << actual_expr;
-
-        // Add relative differences if this is a floating point type
-        std::vector<value_type> rel_diffs;
-        std::size_t             max_rel_diff_width = 0;
+        std::advance(expected_iter, bad_indices[i] - index);
+        std::advance(actual_iter, bad_indices[i] - index);
+        index = bad_indices[i];
+
+        msg << std::endl
+            << std::setprecision(precision) << std::setw(max_index_width)
+            << index << std::setw(max_expected_width) << *expected_iter
+            << std::setw(max_actual_width) << *actual_iter;
         if constexpr (is_floating_point)
         {
-            // Calculate all of the relative differences and a (dummy) list of
-            // rel diff indices
-            rel_diffs = calc_rel_diffs(bad_indices, expected, actual);
-            std::vector<unsigned int> rel_diff_indices(rel_diffs.size());
-            std::iota(rel_diff_indices.begin(), rel_diff_indices.end(), 0);
-            YAYP_CHECK(rel_diffs.size() == bad_indices.size());
-
-            // Get the maximum field width of the relative differences
-            max_rel_diff_width = find_max_field_width(
-                "Rel. Diff.", rel_diff_indices, rel_diffs, precision);
-            msg << std::setw(max_rel_diff_width) << "Rel. Diff.";
+            msg << std::setw(max_rel_diff_width) << rel_diffs[i];
         }
+    }
+    return msg.str();
+}
 
-        // The bad indices are sorted, so we will just iterated until we
-        // find the next bad index
-        auto         bad_idx_iter  = bad_indices.cbegin();
-        auto         expected_iter = expected.cbegin();
-        auto         actual_iter   = actual.cbegin();
-        unsigned int index         = 0;
-        auto         rel_diff_iter = rel_diffs.cbegin();
-        while (bad_idx_iter != bad_indices.cend()
-               && expected_iter != expected.cend()
-               && actual_iter != actual.cend())
-        {
-            if (index == *bad_idx_iter)
-            {
-                // Write the table row
-                msg << std::endl
-                    << std::setprecision(precision)
-                    << std::setw(max_index_width) << index
-                    << std::setw(max_expected_width) << *expected_iter
-                    << std::setw(max_actual_width) << *actual_iter;
-                ++bad_idx_iter;
-                if constexpr (is_floating_point)
-                {
-                    YAYP_CHECK(rel_diff_iter != rel_diffs.cend());
-                    msg << std::setw(max_rel_diff_width) << *rel_diff_iter;
-                    ++rel_diff_iter;
-                }
-            }
-
-            ++index, ++expected_iter, ++actual_iter;
-        }
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Write a summary of the unequal elements after their table
+ *
+ * The summary notes when the table is truncated and, when known, gives the
+ * largest relative difference and its index.
+ *
+ * \param[in] mismatches  The unequal elements
+ * \return A string starting with a newline, or empty if there is nothing to
+ *         add to the table
+ */
+inline std::string write_mismatch_summary(const Mismatches& mismatches)
+{
+    std::ostringstream msg;
+    if (mismatches.truncated())
+    {
+        msg << "\n  (only the first " << mismatches.indices().size()
+            << " are shown)";
+    }
+    if (mismatches.hasRelDiff())
+    {
+        msg << std::setprecision(16) << "\n  max rel diff "
+            << mismatches.maxRelDiff() << " at index "
+            << mismatches.maxRelDiffIndex();
     }
     return msg.str();
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Collect the unequal elements, splitting large ranges across threads
+ *
+ * Each thread is given at least \c parallel_grain elements, and no more
+ * threads are used than the hardware supports.
+ *
+ * \tparam Collect  Callable as \c collect(first,last,mismatches), adding the
+ *                  unequal elements in [first, last) in increasing order
+ * \param[in] size     The number of elements
+ * \param[in] collect  The function comparing a range of elements
+ * \return The unequal elements
+ */
+template<class Collect>
+Mismatches collect_bad_indices(std::size_t size, Collect&& collect)
+{
+    const std::size_t hardware = std::thread::hardware_concurrency();
+    return collect_bad_indices(
+        size,
+        std::forward<Collect>(collect),
+        std::max<std::size_t>(1, std::min(hardware, size / parallel_grain)));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Collect the unequal elements with the given number of threads
+ *
+ * The range is split into one contiguous chunk per thread, and the
+ * mismatches found in each chunk are merged in order, so the result does not
+ * depend on the number of threads.  The calling thread compares the first
+ * chunk.
+ *
+ * \param[in] size         The number of elements
+ * \param[in] collect      The function comparing a range of elements
+ * \param[in] num_threads  The number of threads to use
+ * \return The unequal elements
+ */
+template<class Collect>
+Mismatches collect_bad_indices(std::size_t size,
+                               Collect&&   collect,
+                               std::size_t num_threads)
+{
+    YAYP_REQUIRE(num_threads > 0);
+
+    Mismatches mismatches;
+    if (num_threads == 1 || size < num_threads)
+    {
+        collect(std::size_t(0), size, mismatches);
+        return mismatches;
+    }
+
+    const std::size_t chunk = (size + num_threads - 1) / num_threads;
+    std::vector<Mismatches>        chunk_mismatches(num_threads);
+    std::vector<std::future<void>> futures;
+    for (std::size_t t = 1; t < num_threads; ++t)
+    {
+        futures.push_back(std::async(std::launch::async, [&, t] {
+            collect(std::min(size, t * chunk),
+                    std::min(size, (t + 1) * chunk),
+                    chunk_mismatches[t]);
+        }));
+    }
+    collect(std::size_t(0), chunk, mismatches);
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+
+    for (std::size_t t = 1; t < num_threads; ++t)
+    {
+        mismatches.merge(chunk_mismatches[t]);
+    }
+    return mismatches;
+}
+
 //---------------------------------------------------------------------------//
 } // namespace detail
 } // namespace yayp
@@ -11,7 +11,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
 #include <list>
+#include <string>
 #include <vector>
 
 //---------------------------------------------------------------------------//
@@ -38,11 +41,11 @@ TEST(TestingFunctionsTest, calc_rel_diffs)
 TEST(TestingFunctionsTest, max_field_width)
 {
     // Create a container of doubles
-    std::vector<double>       v         = {1.0, 2.0, 3.0, 4.555, 5.2};
-    unsigned int              precision = 16;
-    std::string               header    = "Dbl";
-    std::vector<unsigned int> indices   = {0, 1, 2, 3, 4};
-    std::size_t               result
+    std::vector<double>      v         = {1.0, 2.0, 3.0, 4.555, 5.2};
+    unsigned int             precision = 16;
+    std::string              header    = "Dbl";
+    std::vector<std::size_t> indices   = {0, 1, 2, 3, 4};
+    std::size_t              result
         = yayp::detail::find_max_field_width(header, indices, v, precision);
     EXPECT_EQ(6, result);
 
@@ -59,10 +62,10 @@ TEST(TestingFunctionsTest, max_field_width)
 TEST(TestingFunctionsTest, write_unequal_values)
 {
     // Create a couple of floating point containers
-    std::vector<double>       vd      = {0.0, 1.0, 2.0, 3.0, 4.0};
-    std::list<double>         ld      = {0.1, 1.0, 2.0, 3.2, 4.3};
-    std::vector<unsigned int> indices = {0, 3, 4};
-    std::string               result
+    std::vector<double>      vd      = {0.0, 1.0, 2.0, 3.0, 4.0};
+    std::list<double>        ld      = {0.1, 1.0, 2.0, 3.2, 4.3};
+    std::vector<std::size_t> indices = {0, 3, 4};
+    std::string              result
         = yayp::detail::write_unequal_values(indices, "vd", "ld", vd, ld);
     std::string ref = R"( Index vd  ld          Rel. Diff.
      0  0 0.1                   1
@@ -81,6 +84,98 @@ TEST(TestingFunctionsTest, write_unequal_values)
     EXPECT_EQ(ref, result);
 }
 
+//---------------------------------------------------------------------------//
+
+TEST(TestingFunctionsTest, mismatches)
+{
+    yayp::detail::Mismatches bad(3);
+    EXPECT_TRUE(bad.empty());
+    EXPECT_FALSE(bad.hasRelDiff());
+
+    // Only the first indices are stored, but all are counted
+    bad.add(2, 0.5);
+    bad.add(4, 0.25);
+    bad.add(5, 2.0);
+    bad.add(8, 1.0);
+    bad.add(std::size_t(1) << 40, 2.0);
+    EXPECT_EQ(5, bad.count());
+    EXPECT_EQ((std::vector<std::size_t>{2, 4, 5}), bad.indices());
+    EXPECT_TRUE(bad.truncated());
+    EXPECT_TRUE(bad.hasRelDiff());
+    EXPECT_EQ(2.0, bad.maxRelDiff());
+    EXPECT_EQ(5, bad.maxRelDiffIndex());
+
+    // A NaN difference is the largest
+    yayp::detail::Mismatches later(3);
+    later.add(std::size_t(1) << 41, std::nan(""));
+    bad.merge(later);
+    EXPECT_EQ(6, bad.count());
+    EXPECT_EQ(3, bad.indices().size());
+    EXPECT_TRUE(std::isnan(bad.maxRelDiff()));
+    EXPECT_EQ(std::size_t(1) << 41, bad.maxRelDiffIndex());
+
+    // Merging fills the remaining storage with the later indices
+    yayp::detail::Mismatches first(3);
+    first.add(0);
+    later = yayp::detail::Mismatches(3);
+    later.add(1);
+    later.add(3);
+    later.add(7);
+    first.merge(later);
+    EXPECT_EQ(4, first.count());
+    EXPECT_EQ((std::vector<std::size_t>{0, 1, 3}), first.indices());
+    EXPECT_FALSE(first.hasRelDiff());
+
+    EXPECT_EQ("\n  (only the first 3 are shown)",
+              yayp::detail::write_mismatch_summary(first));
+    EXPECT_EQ("\n  (only the first 3 are shown)\n  max rel diff nan at index "
+                  + std::to_string(std::size_t(1) << 41),
+              yayp::detail::write_mismatch_summary(bad));
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(TestingFunctionsTest, collect_bad_indices)
+{
+    // Mark every seventh element and the last one as unequal, with a
+    // relative difference peaking at index 500
+    const std::size_t size    = 1000;
+    auto              collect = [size](std::size_t               first,
+                                       std::size_t               last,
+                                       yayp::detail::Mismatches& bad) {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            if (i % 7 == 0 || i + 1 == size)
+            {
+                bad.add(i, i < 500 ? double(i) : 1000.0 - i);
+            }
+        }
+    };
+    const auto expected = yayp::detail::collect_bad_indices(size, collect, 1);
+    EXPECT_EQ(144, expected.count());
+    EXPECT_EQ(yayp::detail::Mismatches::default_max_stored,
+              expected.indices().size());
+    EXPECT_EQ(0, expected.indices().front());
+    EXPECT_EQ(7 * 29, expected.indices().back());
+    EXPECT_EQ(497.0, expected.maxRelDiff());
+    EXPECT_EQ(497, expected.maxRelDiffIndex());
+
+    // The threads' mismatches are merged in order
+    for (std::size_t num_threads : {2, 3, 7, 64, 2000})
+    {
+        auto bad
+            = yayp::detail::collect_bad_indices(size, collect, num_threads);
+        EXPECT_EQ(expected.count(), bad.count()) << num_threads << " threads";
+        EXPECT_EQ(expected.indices(), bad.indices())
+            << num_threads << " threads";
+        EXPECT_EQ(expected.maxRelDiffIndex(), bad.maxRelDiffIndex())
+            << num_threads << " threads";
+    }
+    EXPECT_TRUE(yayp::detail::collect_bad_indices(0, collect, 4).empty());
+    EXPECT_EQ(expected.indices(),
+              yayp::detail::collect_bad_indices(size, collect).indices());
+}
+
 //---------------------------------------------------------------------------//
 // end of src/harness/detail/tests/tstTestingFunctions.cc
 //---------------------------------------------------------------------------//
@@ -0,0 +1,100 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/tests/tstAllocationCounter.cc
+ * \brief  Tests for class AllocationCounter.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../AllocationCounter.hh"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+using yayp::AllocationCounter;
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(AllocationCounterTest, counts)
+{
+    AllocationCounter outer;
+    EXPECT_EQ(0, outer.counts().allocations);
+    EXPECT_EQ(0, outer.counts().bytes);
+
+    auto one = std::make_unique<double>(1.0);
+    EXPECT_EQ(1, outer.counts().allocations);
+    EXPECT_EQ(sizeof(double), outer.counts().bytes);
+
+    // Counters may be nested, and only count from their construction
+    {
+        AllocationCounter inner;
+        std::vector<int>  values(100);
+        auto              array = std::make_unique<char[]>(10);
+        EXPECT_EQ(2, inner.counts().allocations);
+        EXPECT_EQ(100 * sizeof(int) + 10, inner.counts().bytes);
+    }
+    EXPECT_EQ(3, outer.counts().allocations);
+
+    // Deallocations are not subtracted
+    one.reset();
+    EXPECT_EQ(3, outer.counts().allocations);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(AllocationCounterTest, forms)
+{
+    // The array, nothrow and aligned forms are counted too
+    struct alignas(64) Line
+    {
+        char bytes[64];
+    };
+    // The pointers escape through a volatile so the allocations are not
+    // elided by an optimizing compiler
+    static void* volatile escape = nullptr;
+
+    auto counts = AllocationCounter::count([] {
+        Line* line = new Line;
+        int*  ints = new int[4];
+        int*  one  = new (std::nothrow) int(1);
+        escape     = line;
+        escape     = ints;
+        escape     = one;
+        delete line;
+        delete[] ints;
+        delete one;
+    });
+    EXPECT_NE(nullptr, escape);
+    EXPECT_EQ(3, counts.allocations);
+    EXPECT_EQ(64 + 4 * sizeof(int) + sizeof(int), counts.bytes);
+
+    EXPECT_EQ(0, AllocationCounter::count([] {}).allocations);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(AllocationCounterTest, threads)
+{
+    // Allocations of other threads are not counted
+    AllocationCounter counter;
+    std::size_t       thread_allocations = 0;
+    std::thread       worker([&thread_allocations] {
+        thread_allocations = AllocationCounter::count([] {
+                                 std::vector<int> values(10);
+                             }).allocations;
+    });
+    const std::size_t after_start = counter.counts().allocations;
+    worker.join();
+    EXPECT_EQ(1, thread_allocations);
+    EXPECT_EQ(after_start, counter.counts().allocations);
+}
+
+//---------------------------------------------------------------------------//
+// end of src/harness/tests/tstAllocationCounter.cc
+//---------------------------------------------------------------------------//
@@ -172,6 +172,58 @@ TEST(DBCTest, NotImplemented)
     }
 }
 
+//---------------------------------------------------------------------------//
+TEST(DBCTest, LimitExceeded)
+{
+    // Limit violations are YAYP exceptions, but not DBC failures
+    EXPECT_THROW(throw yayp::LimitExceededException("nesting depth", 10),
+                 yayp::Exception);
+
+    try
+    {
+        throw yayp::LimitExceededException("nesting depth", 10);
+    }
+    catch (const yayp::LimitExceededException& e)
+    {
+        EXPECT_EQ("nesting depth", e.resource());
+        EXPECT_EQ(10, e.limit());
+        EXPECT_EQ(std::string("Input exceeds the limit on nesting depth (10)"),
+                  e.what());
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEST(DBCTest, LazyMessage)
+{
+    // The location is available without formatting the message
+    yayp::DBCException e("x > 0", "precondition", "file.cc", 42);
+    EXPECT_STREQ("file.cc", e.filename());
+    EXPECT_EQ(42, e.lineNumber());
+
+    // Copies (made when throwing) format the same message, which is also
+    // seen through the standard base classes
+    const std::string ref = "Failed DBC precondition test: x > 0\n ^^^ at "
+                            "file.cc:42";
+    yayp::DBCException copy(e);
+    EXPECT_EQ(ref, copy.what());
+    EXPECT_EQ(ref, e.what());
+    EXPECT_EQ(e.what(), e.what());
+
+    const std::runtime_error& base = e;
+    EXPECT_EQ(ref, base.what());
+
+    try
+    {
+        yayp::throwDBCException("y", "intermediate", "other.cc", 7);
+    }
+    catch (const std::exception& caught)
+    {
+        EXPECT_EQ(std::string("Failed DBC intermediate test: y\n ^^^ at "
+                              "other.cc:7"),
+                  caught.what());
+    }
+}
+
 //---------------------------------------------------------------------------//
 // end of src/harness/tests/tstDBC.cc
 //---------------------------------------------------------------------------//
@@ -0,0 +1,141 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/tests/tstPerfCounters.cc
+ * \brief  Tests for class PerfCounters.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../PerfCounters.hh"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+using yayp::PerfCounters;
+using yayp::PerfCounts;
+using yayp::PerfEvent;
+
+namespace
+{
+//---------------------------------------------------------------------------//
+//! Do some work that the compiler cannot remove
+unsigned int work(unsigned int n)
+{
+    volatile unsigned int sum = 0;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        sum = sum + i * i;
+    }
+    return sum;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(PerfCountersTest, counts)
+{
+    // The events may not be available (e.g., in a container or a virtual
+    // machine), in which case no count is reported
+    PerfCounters counters;
+    work(100000);
+    const PerfCounts counts = counters.counts();
+    for (std::size_t i = 0; i < yayp::num_perf_events; ++i)
+    {
+        const auto event = static_cast<PerfEvent>(i);
+        if (!counters.available())
+        {
+            EXPECT_FALSE(counts.has(event)) << yayp::perfEventName(event);
+        }
+        if (!counts.has(event))
+        {
+            EXPECT_EQ(0, counts[event]) << yayp::perfEventName(event);
+        }
+    }
+    if (counts.has(PerfEvent::Instructions))
+    {
+        // The loop alone retires several instructions per iteration
+        EXPECT_LE(100000, counts[PerfEvent::Instructions]);
+
+        // Counts are relative to the construction and keep increasing
+        const PerfCounts later = counters.counts();
+        EXPECT_LE(counts[PerfEvent::Instructions],
+                  later[PerfEvent::Instructions]);
+    }
+
+    // Events that are open but were never scheduled are not reported either
+    const PerfCounts call = PerfCounters::count([] { work(1000); });
+    if (call.has(PerfEvent::Instructions) || call.has(PerfEvent::Cycles)
+        || call.has(PerfEvent::BranchMisses)
+        || call.has(PerfEvent::CacheMisses)
+        || call.has(PerfEvent::L1DMisses))
+    {
+        EXPECT_TRUE(counters.available());
+    }
+    if (call.has(PerfEvent::Instructions) && call.has(PerfEvent::Cycles))
+    {
+        EXPECT_LT(0, call.ipc());
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(PerfCountersTest, ratios)
+{
+    PerfCounts counts;
+    EXPECT_TRUE(std::isnan(counts.ipc()));
+    EXPECT_TRUE(std::isnan(counts.per(PerfEvent::BranchMisses, 100)));
+
+    counts.values    = {400, 1000, 5, 2, 50};
+    counts.available = {true, true, true, false, true};
+    EXPECT_DOUBLE_EQ(2.5, counts.ipc());
+    EXPECT_DOUBLE_EQ(0.05, counts.per(PerfEvent::BranchMisses, 100));
+    EXPECT_DOUBLE_EQ(0.5, counts.per(PerfEvent::L1DMisses, 100));
+    EXPECT_TRUE(std::isnan(counts.per(PerfEvent::CacheMisses, 100)));
+    EXPECT_TRUE(std::isnan(counts.per(PerfEvent::Cycles, 0)));
+
+    // Without cycles, there is no IPC
+    counts.available[static_cast<std::size_t>(PerfEvent::Cycles)] = false;
+    EXPECT_TRUE(std::isnan(counts.ipc()));
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(PerfCountersTest, report)
+{
+    PerfCounts counts;
+    counts.values    = {400, 1000, 5, 0, 50};
+    counts.available = {true, true, true, false, true};
+
+    std::ostringstream os;
+    os << std::setprecision(2);
+    yayp::writePerfReport(os, counts, 100);
+    const std::string report = os.str();
+
+    EXPECT_NE(std::string::npos, report.find("Per byte"));
+    EXPECT_NE(std::string::npos, report.find("L1D-misses"));
+    EXPECT_NE(std::string::npos, report.find("0.5000"));
+    EXPECT_NE(std::string::npos, report.find("2.5000"));
+
+    // The uncounted event, and only it, is not available
+    const auto line_start = report.find("cache-misses");
+    ASSERT_NE(std::string::npos, line_start);
+    const auto        line_end = report.find('\n', line_start);
+    const std::string line = report.substr(line_start, line_end - line_start);
+    EXPECT_NE(std::string::npos, line.find("n/a")) << line;
+    EXPECT_EQ(report.find("n/a"), report.find("n/a", line_start)) << report;
+
+    // The format of the stream is restored
+    EXPECT_EQ(2, os.precision());
+}
+
+//---------------------------------------------------------------------------//
+// end of src/harness/tests/tstPerfCounters.cc
+//---------------------------------------------------------------------------//
@@ -10,7 +10,10 @@
 
 #include "harness/Testing.hh"
 
+#include <iterator>
+#include <limits>
 #include <list>
+#include <random>
 #include <vector>
 
 //---------------------------------------------------------------------------//
@@ -89,6 +92,90 @@ TEST(SoftEqualTest, containers)
     EXPECT_FALSE(yayp::softContainerEqual(vd1, vd3));
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief The bulk comparison must agree with the comparison of each pair.
+ */
+template<typename T>
+void testBulk()
+{
+    const T inf = std::numeric_limits<T>::infinity();
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    const T special[]
+        = {0, -0.0f, 1e-30f, -1e-30f, 1e-10f, inf, -inf, nan, 1, 1e30f};
+
+    std::mt19937 rng(12345);
+    auto         pick = [&rng, &special]() -> T {
+        if (rng() % 4 == 0)
+        {
+            return special[rng() % std::size(special)];
+        }
+        return std::uniform_real_distribution<T>(-2, 2)(rng);
+    };
+
+    yayp::SoftEqual<T, T> se(static_cast<T>(1e-3));
+    for (std::size_t size = 0; size < 40; ++size)
+    {
+        std::vector<T> expected(size);
+        std::vector<T> actual(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            expected[i] = pick();
+            switch (rng() % 3)
+            {
+                case 0:
+                    actual[i] = expected[i];
+                    break;
+                case 1:
+                    actual[i] = expected[i] * static_cast<T>(1.0001);
+                    break;
+                default:
+                    actual[i] = pick();
+            }
+        }
+
+        std::vector<std::size_t> bulk;
+        se.forEachUnequal(expected.data(),
+                          actual.data(),
+                          size,
+                          [&bulk](std::size_t index) {
+                              bulk.push_back(index);
+                              return true;
+                          });
+        std::vector<std::size_t> each;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (!se(expected[i], actual[i]))
+            {
+                each.push_back(i);
+            }
+        }
+        EXPECT_EQ(each, bulk) << "size " << size;
+
+        // Visiting stops when the visitor returns false
+        std::size_t visits = 0;
+        se.forEachUnequal(
+            expected.data(), actual.data(), size, [&visits](std::size_t) {
+                ++visits;
+                return false;
+            });
+        EXPECT_EQ(each.empty() ? 0 : 1, visits);
+    }
+}
+
+TEST(SoftEqualTest, bulk)
+{
+    testBulk<double>();
+    testBulk<float>();
+
+    // Contiguous containers take the bulk path
+    std::vector<double> values(100, 1.0);
+    std::vector<double> other = values;
+    EXPECT_TRUE(yayp::softContainerEqual(values, other));
+    other[97] = 1.5;
+    EXPECT_FALSE(yayp::softContainerEqual(values, other));
+}
+
 //---------------------------------------------------------------------------//
 // end of src/harness/tests/tstSoftEqual.cc
 //---------------------------------------------------------------------------//
@@ -10,7 +10,9 @@
 
 #include <gtest/gtest.h>
 
+#include <deque>
 #include <list>
+#include <string>
 #include <vector>
 
 //---------------------------------------------------------------------------//
@@ -83,6 +85,84 @@ TEST(TestingTest, container_equality)
     // EXPECT_CONT_EQ(v1, v3);
 }
 
+//---------------------------------------------------------------------------//
+TEST(TestingTest, large_containers)
+{
+    // Containers long enough to be split across threads
+    const std::size_t   size = 2 * yayp::detail::parallel_grain + 3;
+    std::vector<double> v1(size, 1.0);
+    std::vector<double> v2 = v1;
+    v2[5]                  = 2.0;
+    v2[size - 1]           = 0.0;
+    std::deque<double> d2(v2.begin(), v2.end());
+    std::list<double>  l2(v2.begin(), v2.end());
+
+    // Contiguous, random access, and sequential containers report the same
+    // differences
+    auto message = [](const ::testing::AssertionResult& result) {
+        EXPECT_FALSE(result);
+        return std::string(result.message());
+    };
+    using testing_detail::isSoftContainerEqual;
+    const std::string expected
+        = message(isSoftContainerEqual("v1", "v2", v1, v2));
+    EXPECT_NE(std::string::npos, expected.find("differ in 2 element(s)"));
+    EXPECT_NE(std::string::npos,
+              expected.find("max rel diff inf at index "
+                             + std::to_string(size - 1)));
+    EXPECT_EQ(expected, message(isSoftContainerEqual("v1", "v2", v1, d2)));
+    EXPECT_EQ(expected, message(isSoftContainerEqual("v1", "v2", v1, l2)));
+
+    const std::string exact
+        = message(testing_detail::isContainerEqual("v1", "v2", v1, v2));
+    EXPECT_NE(std::string::npos, exact.find("differ in 2 elements"));
+    EXPECT_EQ(exact,
+              message(testing_detail::isContainerEqual("v1", "v2", v1, d2)));
+    EXPECT_EQ(exact,
+              message(testing_detail::isContainerEqual("v1", "v2", v1, l2)));
+
+    // Every element differs: all are counted, but only the first few are
+    // written
+    std::vector<double> v3(size, 1.5);
+    v3[size / 2]          = 4.0;
+    const std::string all = message(isSoftContainerEqual("v1", "v3", v1, v3));
+    EXPECT_NE(std::string::npos,
+              all.find("differ in " + std::to_string(size) + " element(s)"));
+    EXPECT_NE(std::string::npos, all.find("(only the first 30 are shown)"));
+    EXPECT_NE(std::string::npos,
+              all.find("max rel diff 0.75 at index "
+                       + std::to_string(size / 2)));
+    EXPECT_EQ(std::string::npos, all.find("\n    30 "));
+    EXPECT_NE(std::string::npos, all.find("\n    29 "));
+}
+
+//---------------------------------------------------------------------------//
+TEST(TestingTest, allocations)
+{
+    std::vector<double> values(16);
+    std::string         text;
+
+    // These should pass
+    EXPECT_NO_ALLOCATIONS(values[3] = 2.0);
+    EXPECT_NO_ALLOCATIONS(values.assign(16, 1.0));
+    EXPECT_MAX_ALLOCATIONS(text = std::string(100, 'x'), 1);
+    EXPECT_MAX_ALLOCATIONS(values.resize(1000), 2);
+    EXPECT_EQ(1000, values.size());
+
+    // These should fail intelligibly
+    auto counts = yayp::AllocationCounter::count([] {
+        std::vector<int> a(10);
+        std::vector<int> b(20);
+    });
+    ::testing::AssertionResult result = testing_detail::isMaxAllocations(
+        "", "", "1", "make_vectors()", counts, 1);
+    EXPECT_FALSE(result);
+    EXPECT_EQ(std::string("Expected at most 1 heap allocations\n"
+                          "  make_vectors()\n"
+                          "    which made 2 allocations of 120 bytes"),
+              result.message());
+}
+
 //---------------------------------------------------------------------------//
 // end of src/harness/tests/tstTesting.cc
 //---------------------------------------------------------------------------//
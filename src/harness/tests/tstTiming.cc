@@ -0,0 +1,146 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/tests/tstTiming.cc
+ * \brief  Tests for timing instrumentation.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../Timing.hh"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+//---------------------------------------------------------------------------//
+std::uint64_t calls(yayp::TimingPhase phase)
+{
+    return yayp::timingTotals()[static_cast<std::size_t>(phase)].calls;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+TEST(TimingTest, scoped_timer)
+{
+    using yayp::TimingPhase;
+    yayp::resetTiming();
+
+    {
+        yayp::ScopedTimer outer(TimingPhase::Build);
+        for (int i = 0; i < 3; ++i)
+        {
+            yayp::ScopedTimer inner(TimingPhase::Scan);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    auto totals = yayp::timingTotals();
+    EXPECT_EQ(1, totals[static_cast<std::size_t>(TimingPhase::Build)].calls);
+    EXPECT_EQ(3, totals[static_cast<std::size_t>(TimingPhase::Scan)].calls);
+    EXPECT_EQ(0, totals[static_cast<std::size_t>(TimingPhase::Read)].calls);
+    EXPECT_LE(2000000,
+              totals[static_cast<std::size_t>(TimingPhase::Build)].nanoseconds);
+
+    yayp::resetTiming();
+    EXPECT_EQ(0, calls(TimingPhase::Build));
+    EXPECT_EQ(0, calls(TimingPhase::Scan));
+}
+
+//---------------------------------------------------------------------------//
+TEST(TimingTest, macros)
+{
+    using yayp::TimingPhase;
+    yayp::resetTiming();
+
+    {
+        YAYP_TIMER(Read);
+        YAYP_TIMER_DETAIL(Resolve);
+        YAYP_TIMER_FINE(Emit);
+    }
+
+    // Disabled timers compile to nothing
+#ifdef YAYP_TIMER_ON
+    EXPECT_EQ(1, calls(TimingPhase::Read));
+#else
+    EXPECT_EQ(0, calls(TimingPhase::Read));
+#endif
+#ifdef YAYP_TIMER_DETAIL_ON
+    EXPECT_EQ(1, calls(TimingPhase::Resolve));
+#else
+    EXPECT_EQ(0, calls(TimingPhase::Resolve));
+#endif
+#ifdef YAYP_TIMER_FINE_ON
+    EXPECT_EQ(1, calls(TimingPhase::Emit));
+#else
+    EXPECT_EQ(0, calls(TimingPhase::Emit));
+#endif
+}
+
+//---------------------------------------------------------------------------//
+TEST(TimingTest, threads)
+{
+    using yayp::TimingPhase;
+    yayp::resetTiming();
+
+    // Times of exited threads are retained
+    constexpr int            num_threads = 8;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([] {
+            for (int i = 0; i < 100; ++i)
+            {
+                yayp::ScopedTimer timer(TimingPhase::Index);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(num_threads * 100, calls(TimingPhase::Index));
+
+    // Times of live threads are included
+    {
+        yayp::ScopedTimer timer(TimingPhase::Index);
+    }
+    EXPECT_EQ(num_threads * 100 + 1, calls(TimingPhase::Index));
+}
+
+//---------------------------------------------------------------------------//
+TEST(TimingTest, report)
+{
+    using yayp::TimingPhase;
+    yayp::resetTiming();
+
+    {
+        yayp::ScopedTimer timer(TimingPhase::Resolve);
+    }
+
+    std::ostringstream os;
+    yayp::writeTimingReport(os);
+    std::string report = os.str();
+    std::cout << report;
+
+    for (auto phase : {"read", "index", "scan", "build", "resolve", "emit"})
+    {
+        EXPECT_NE(std::string::npos, report.find(phase)) << phase;
+    }
+    EXPECT_NE(std::string::npos, report.find("Calls"));
+
+    // The stream format is restored
+    os << 1.5;
+    EXPECT_EQ("1.5", os.str().substr(report.size()));
+}
+
+//---------------------------------------------------------------------------//
+// end of src/harness/tests/tstTiming.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,67 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/harness/tests/tstYamlTesting.cc
+ * \brief  Tests for the YAML comparison macros.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../YamlTesting.hh"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(YamlTestingTest, yaml)
+{
+    {
+        std::ofstream out("YamlTestingTest.yaml");
+        out << "energy: 1.5\nflux: [0.25, 0.5]\ncells: {a: 1, b: 2}\n";
+    }
+
+    // These should pass
+    EXPECT_YAML_SOFT_EQ("YamlTestingTest.yaml",
+                        "energy: 1.5\nflux: [0.25, 0.5]\ncells: {a: 1, b: 2}");
+    EXPECT_YAML_SOFT_EQ("YamlTestingTest.yaml",
+                        "energy: 1.5000000000000002\n"
+                        "flux:\n  - 0.25\n  - 0.5\n"
+                        "cells:\n  a: 1.0\n  b: 2\n");
+    EXPECT_YAML_SOFTEQ("YamlTestingTest.yaml",
+                       "{energy: 1.501, flux: [0.25, 0.5], "
+                       "cells: {a: 1, b: 2}}",
+                       1.0e-2);
+
+    // These should fail intelligibly
+    auto message = [](const ::testing::AssertionResult& result) {
+        EXPECT_FALSE(result);
+        return std::string(result.message());
+    };
+    using testing_detail::isYamlSoftEqual;
+    std::string msg = message(isYamlSoftEqual("golden",
+                                              "doc",
+                                              "YamlTestingTest.yaml",
+                                              "energy: 1.6\nflux: [0, 0.6]"));
+    EXPECT_NE(std::string::npos, msg.find("differ in 3 value(s)")) << msg;
+    EXPECT_NE(std::string::npos,
+              msg.find("\n  at energy: expected 1.5, actual 1.6\n"))
+        << msg;
+    EXPECT_NE(std::string::npos,
+              msg.find("\n  at flux[0]: expected 0.25, actual 0\n"))
+        << msg;
+    EXPECT_NE(std::string::npos,
+              msg.find("structural mismatch\n  at the root: expected cells, "
+                       "actual the end of the mapping"))
+        << msg;
+
+    msg = message(isYamlSoftEqual("golden", "doc", "Missing.yaml", "a: 1"));
+    EXPECT_NE(std::string::npos, msg.find("could not be read")) << msg;
+}
+
+//---------------------------------------------------------------------------//
+// end of src/harness/tests/tstYamlTesting.cc
+//---------------------------------------------------------------------------//
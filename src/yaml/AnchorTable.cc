@@ -0,0 +1,122 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/AnchorTable.cc
+ * \brief  AnchorTable class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "AnchorTable.hh"
+
+#include "harness/DBC.hh"
+#include "harness/Timing.hh"
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor
+ *
+ * \param[in] limits  Limits on the alias expansion
+ */
+AnchorTable::AnchorTable(AliasLimits limits)
+    : m_limits(limits)
+{
+    /* * */
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Anchor a node with the given name
+ *
+ * \param[in] name  The anchor name
+ * \param[in] node  The anchored node
+ */
+void AnchorTable::define(std::string name, NodePtr node)
+{
+    YAYP_REQUIRE(!name.empty());
+    YAYP_REQUIRE(node);
+    m_anchors.insert_or_assign(std::move(name), std::move(node));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create an alias of the node anchored with the given name
+ *
+ * \param[in] name  The anchor name
+ * \return An alias node sharing the anchored node
+ */
+NodePtr AnchorTable::alias(std::string_view name)
+{
+    NodePtr        result;
+    ParseErrorCode code = this->tryAlias(name, result);
+    switch (code)
+    {
+        case ParseErrorCode::None:
+            return result;
+        case ParseErrorCode::UndefinedAlias:
+            throw Exception("Alias '*" + std::string(name)
+                            + "' refers to an undefined anchor");
+        case ParseErrorCode::AliasDepthLimit:
+            throw LimitExceededException(limitResource(code),
+                                         m_limits.max_depth);
+        default:
+            throw LimitExceededException(limitResource(code),
+                                         m_limits.max_expansions);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create an alias of the node anchored with the given name, without
+ *        throwing
+ *
+ * \param[in]  name   The anchor name
+ * \param[out] alias  An alias node sharing the anchored node, if successful
+ * \return ParseErrorCode::None, or the reason the alias was rejected
+ */
+ParseErrorCode AnchorTable::tryAlias(std::string_view name, NodePtr& alias)
+{
+    YAYP_TIMER_DETAIL(Resolve);
+
+    auto iter = m_anchors.find(std::string(name));
+    if (iter == m_anchors.end())
+    {
+        return ParseErrorCode::UndefinedAlias;
+    }
+    const NodePtr& target = iter->second;
+
+    // Check the nesting depth of aliases
+    if (YAYP_UNLIKELY(target->aliasDepth() + 1 > m_limits.max_depth))
+    {
+        return ParseErrorCode::AliasDepthLimit;
+    }
+
+    // Charge the alias with the number of nodes it expands to
+    std::size_t remaining = m_limits.max_expansions - m_expansions;
+    if (YAYP_UNLIKELY(target->expandedSize() > remaining))
+    {
+        return ParseErrorCode::AliasExpansionLimit;
+    }
+    m_expansions += target->expandedSize();
+
+    alias = Node::makeAlias(iter->first, target);
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Remove all anchors and reset the expansion count
+ */
+void AnchorTable::clear()
+{
+    m_anchors.clear();
+    m_expansions = 0;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/AnchorTable.cc
+//---------------------------------------------------------------------------//
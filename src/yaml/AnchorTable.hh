@@ -0,0 +1,94 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/AnchorTable.hh
+ * \brief  AnchorTable class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_ANCHORTABLE_HH
+#define YAYP_YAML_ANCHORTABLE_HH
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Node.hh"
+#include "ParseError.hh"
+
+namespace yayp
+{
+//! Limits on the expansion of aliases within a document
+struct AliasLimits
+{
+    //! Maximum total number of nodes reachable through aliases
+    std::size_t max_expansions = 1000000;
+
+    //! Maximum length of a chain of nested aliases
+    std::size_t max_depth = 64;
+};
+
+//===========================================================================//
+/*!
+ * \class AnchorTable
+ * \brief Records the anchored nodes of a document and creates aliases to
+ *        them.
+ *
+ * An alias shares the anchored node rather than copying it.  Because a
+ * consumer walking the document still visits the anchored subtree once per
+ * alias, each alias is charged the expanded size of its target, and a
+ * LimitExceededException is thrown once the total exceeds
+ * AliasLimits::max_expansions or an alias would nest deeper than
+ * AliasLimits::max_depth.  Both checks are constant time.
+ *
+ * Redefining an anchor replaces it for all subsequent aliases, as in YAML.
+ *
+ * tryAlias() reports failures with a ParseErrorCode instead of throwing.
+ *
+ * \example src/yaml/tests/tstAnchorTable.cc
+ */
+//===========================================================================//
+
+class AnchorTable
+{
+  public:
+    // Constructor
+    explicit AnchorTable(AliasLimits limits = AliasLimits());
+
+    // Anchor a node with the given name
+    void define(std::string name, NodePtr node);
+
+    // Create an alias of the node anchored with the given name
+    NodePtr alias(std::string_view name);
+
+    // Create an alias without throwing
+    ParseErrorCode tryAlias(std::string_view name, NodePtr& alias);
+
+    // Remove all anchors and reset the expansion count
+    void clear();
+
+    // >>> ACCESSORS
+    //! Return the limits
+    const AliasLimits& limits() const { return m_limits; }
+
+    //! Return the number of nodes reachable through the aliases created
+    std::size_t expansions() const { return m_expansions; }
+
+    //! Return the number of anchors
+    std::size_t size() const { return m_anchors.size(); }
+
+  private:
+    // >>> DATA
+    AliasLimits                              m_limits;
+    std::unordered_map<std::string, NodePtr> m_anchors;
+    std::size_t                              m_expansions = 0;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_ANCHORTABLE_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/AnchorTable.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,468 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/BlockScalar.cc
+ * \brief  BlockScalar class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "BlockScalar.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include "harness/DBC.hh"
+#include "harness/Timing.hh"
+
+namespace
+{
+//===========================================================================//
+/*!
+ * \class FoldedOutput
+ * \brief Accumulates the folded value as a view into the input for as long
+ *        as the appended pieces are contiguous in the input.
+ *
+ * Once a piece is appended that does not directly follow the previous one
+ * (or that does not appear in the input at all), the value is copied into a
+ * single buffer reserved to the size of the block body, which must be set
+ * before the first piece is appended.  Every character of the folded value
+ * corresponds to a distinct character of the body, so the buffer is never
+ * reallocated.
+ */
+//===========================================================================//
+class FoldedOutput
+{
+  public:
+    //! Construct with a buffer to reuse
+    explicit FoldedOutput(std::string storage) : m_storage(std::move(storage))
+    {
+        m_storage.clear();
+    }
+
+    //! Set an upper bound on the size of the value
+    void setBodySize(std::size_t body_size) { m_body_size = body_size; }
+
+    //! Append the input characters [begin, end)
+    void append(const char* begin, const char* end)
+    {
+        if (begin == end)
+        {
+            return;
+        }
+        if (!m_owned)
+        {
+            if (m_begin == m_end)
+            {
+                m_begin = begin;
+                m_end   = end;
+                return;
+            }
+            if (begin == m_end)
+            {
+                m_end = end;
+                return;
+            }
+            this->promote();
+        }
+        m_storage.append(begin, end);
+    }
+
+    //! Append a character that does not appear at this point in the input
+    void append(std::size_t count, char c)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        if (!m_owned)
+        {
+            this->promote();
+        }
+        m_storage.append(count, c);
+    }
+
+    //! Return whether the value has been copied
+    bool owned() const { return m_owned; }
+
+    //! Return the value as a view into the input
+    std::string_view view() const
+    {
+        return std::string_view(m_begin, m_end - m_begin);
+    }
+
+    //! Release the copied value, or the buffer if it was not needed
+    std::string release() { return std::move(m_storage); }
+
+  private:
+    //! Copy the view into the owned buffer
+    void promote()
+    {
+        m_storage.reserve(m_body_size);
+        m_storage.append(m_begin, m_end);
+        m_owned = true;
+    }
+
+  private:
+    std::size_t m_body_size = 0;
+    const char* m_begin     = nullptr;
+    const char* m_end   = nullptr;
+    std::string m_storage;
+    bool        m_owned = false;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return whether the line is a document start or end marker
+ */
+bool isDocumentMarker(const char* line, const char* text_end)
+{
+    if (text_end - line < 3)
+    {
+        return false;
+    }
+    if (std::strncmp(line, "---", 3) != 0 && std::strncmp(line, "...", 3) != 0)
+    {
+        return false;
+    }
+    return (line + 3 == text_end || line[3] == ' ' || line[3] == '\t');
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the end of the lines that may belong to a block scalar
+ *
+ * The block extends over the lines that are blank or indented by at least
+ * the content indentation.  The end is an upper bound: the block itself may
+ * end earlier, e.g., before trailing blank lines.
+ */
+const char* blockEnd(const char* line, const char* end, int indent)
+{
+    while (line != end)
+    {
+        const char* nl = static_cast<const char*>(
+            std::memchr(line, '\n', end - line));
+        const char* text_end = nl ? nl : end;
+        const char* first    = line;
+        while (first != text_end && *first == ' ')
+        {
+            ++first;
+        }
+        const bool blank = (first == text_end)
+                           || (*first == '\r' && first + 1 == text_end);
+        if (!blank
+            && (first - line < indent
+                || (indent == 0 && isDocumentMarker(line, text_end))))
+        {
+            return line;
+        }
+        line = nl ? nl + 1 : end;
+    }
+    return end;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan the block scalar whose header begins the given input
+ *
+ * \param[in] input  The input, beginning with the '|' or '>' indicator.  The
+ *                   input may extend past the end of the block scalar.
+ * \param[in] parent_indent  The indentation of the parent node (-1 for a
+ *                           top-level node)
+ */
+BlockScalar::BlockScalar(std::string_view input, int parent_indent)
+{
+    std::size_t    error_offset = 0;
+    ParseErrorCode code = this->read(input, parent_indent, error_offset);
+    if (code != ParseErrorCode::None)
+    {
+        throwParseError(ParseError{code, error_offset});
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan the block scalar whose header begins the given input, without
+ *        throwing
+ *
+ * \param[in] input  The input, beginning with the '|' or '>' indicator.  The
+ *                   input may extend past the end of the block scalar.
+ * \param[in] parent_indent  The indentation of the parent node (-1 for a
+ *                           top-level node)
+ * \return The block scalar, or the error with its offset in the input
+ */
+ParseResult<BlockScalar>
+BlockScalar::scan(std::string_view input, int parent_indent)
+{
+    BlockScalar    result;
+    std::size_t    error_offset = 0;
+    ParseErrorCode code = result.read(input, parent_indent, error_offset);
+    if (code != ParseErrorCode::None)
+    {
+        return ParseError{code, error_offset};
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan another block scalar, reusing the storage of this one
+ *
+ * Once the storage has grown to fit the copied values, scanning further
+ * block scalars does not allocate.  After an error the value is unspecified.
+ *
+ * \param[in] input  The input, beginning with the '|' or '>' indicator
+ * \param[in] parent_indent  The indentation of the parent node
+ * \return The error with its offset in the input, if any
+ */
+ParseError BlockScalar::rescan(std::string_view input, int parent_indent)
+{
+    ParseError error;
+    error.code = this->read(input, parent_indent, error.offset);
+    return error;
+}
+
+//---------------------------------------------------------------------------//
+// PRIVATE IMPLEMENTATION FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan the block scalar whose header begins the given input
+ *
+ * \param[in]  input          The input, beginning with the indicator
+ * \param[in]  parent_indent  The indentation of the parent node
+ * \param[out] error_offset   The offset of an error in the input
+ * \return ParseErrorCode::None, or the reason the block scalar is invalid
+ */
+ParseErrorCode BlockScalar::read(std::string_view input,
+                                 int              parent_indent,
+                                 std::size_t&     error_offset)
+{
+    YAYP_TIMER_DETAIL(Scan);
+    YAYP_REQUIRE(!input.empty());
+    YAYP_REQUIRE(input.front() == '|' || input.front() == '>');
+    YAYP_REQUIRE(parent_indent >= -1);
+
+    const char* const begin = input.data();
+    const char* const end   = begin + input.size();
+
+    // >>> HEADER
+    // Read the indentation and chomping indicators (in either order)
+    m_style    = (*begin == '|') ? BlockStyle::Literal : BlockStyle::Folded;
+    m_chomping = Chomping::Clip;
+    int         indicator     = 0;
+    bool        have_chomping = false;
+    const char* pos           = begin + 1;
+    while (pos != end)
+    {
+        if ((*pos == '-' || *pos == '+') && !have_chomping)
+        {
+            m_chomping    = (*pos == '-') ? Chomping::Strip : Chomping::Keep;
+            have_chomping = true;
+        }
+        else if (*pos >= '1' && *pos <= '9' && indicator == 0)
+        {
+            indicator = *pos - '0';
+        }
+        else
+        {
+            break;
+        }
+        ++pos;
+    }
+
+    // The remainder of the header line may only hold whitespace and a comment
+    const char* header_nl = static_cast<const char*>(
+        std::memchr(pos, '\n', end - pos));
+    const char* header_end = header_nl ? header_nl : end;
+    const char* rest       = std::find_if(
+        pos, header_end, [](char c) { return c != ' ' && c != '\t'; });
+    bool valid = (rest == header_end)
+                 || (*rest == '\r' && rest + 1 == header_end)
+                 || (*rest == '#' && rest != pos);
+    if (!valid)
+    {
+        error_offset = 0;
+        return ParseErrorCode::InvalidBlockHeader;
+    }
+    const char* body = header_nl ? header_nl + 1 : end;
+
+    // >>> BODY
+    // Content indentation, or -1 while it has not yet been detected
+    int indent = (indicator > 0) ? parent_indent + indicator : -1;
+
+    FoldedOutput out(std::move(m_storage));
+    if (indent >= 0)
+    {
+        out.setBodySize(blockEnd(body, end, indent) - body);
+    }
+    bool         have_content = false;
+    bool         prev_spaced  = false;
+    const char*  last_break   = nullptr;
+    const char*  empty_begin  = nullptr;
+    std::size_t  num_empty    = 0;
+    bool         empty_clean  = true;
+    std::size_t  max_leading  = 0;
+    const char*  scalar_end   = body;
+
+    // Append the line break following the last content line
+    auto append_break = [&out](const char* brk) {
+        if (*brk == '\n')
+        {
+            out.append(brk, brk + 1);
+        }
+        else
+        {
+            out.append(1, '\n');
+        }
+    };
+
+    // Append the line breaks of the empty lines seen since the last content
+    // line.  Empty lines consisting of a bare '\n' are contiguous in the input
+    auto append_empty = [&]() {
+        if (empty_clean)
+        {
+            out.append(empty_begin, empty_begin + num_empty);
+        }
+        else
+        {
+            out.append(num_empty, '\n');
+        }
+    };
+
+    const char* line = body;
+    while (line != end)
+    {
+        // Locate the line break and the end of the line text
+        const char* nl = static_cast<const char*>(
+            std::memchr(line, '\n', end - line));
+        const char* text_end = nl ? nl : end;
+        if (nl && text_end != line && text_end[-1] == '\r')
+        {
+            --text_end;
+        }
+        const char* next = nl ? nl + 1 : end;
+
+        // Count the leading spaces
+        const char* first = line;
+        while (first != text_end && *first == ' ')
+        {
+            ++first;
+        }
+        int  spaces = static_cast<int>(first - line);
+        bool blank  = (first == text_end);
+
+        // Document markers always terminate the block at column zero
+        if (spaces == 0 && indent <= 0 && isDocumentMarker(line, text_end))
+        {
+            break;
+        }
+
+        // Detect the content indentation from the first non-empty line
+        if (indent < 0 && !blank)
+        {
+            if (spaces <= parent_indent)
+            {
+                break;
+            }
+            indent = spaces;
+            if (static_cast<int>(max_leading) > indent)
+            {
+                error_offset = line - begin;
+                return ParseErrorCode::InvalidBlockIndentation;
+            }
+            out.setBodySize(blockEnd(line, end, indent) - body);
+        }
+
+        if (blank && (indent < 0 || spaces <= indent))
+        {
+            // Empty line: a trailing line without a line break is ignored
+            if (!nl)
+            {
+                scalar_end = end;
+                break;
+            }
+            if (num_empty == 0)
+            {
+                empty_begin = line;
+            }
+            empty_clean = empty_clean && (text_end == line && *line == '\n');
+            max_leading = std::max<std::size_t>(max_leading, spaces);
+            ++num_empty;
+        }
+        else if (spaces < indent)
+        {
+            // A less-indented line ends the block scalar
+            break;
+        }
+        else
+        {
+            // Content line: separate it from the previous content
+            const char* text   = line + indent;
+            bool        spaced = (text != text_end)
+                          && (*text == ' ' || *text == '\t');
+            if (!have_content)
+            {
+                append_empty();
+            }
+            else if (m_style == BlockStyle::Literal || spaced || prev_spaced)
+            {
+                append_break(last_break);
+                append_empty();
+            }
+            else if (num_empty == 0)
+            {
+                out.append(1, ' ');
+            }
+            else
+            {
+                out.append(num_empty, '\n');
+            }
+            out.append(text, text_end);
+
+            have_content = true;
+            prev_spaced  = spaced;
+            last_break   = nl ? text_end : nullptr;
+            num_empty    = 0;
+            empty_clean  = true;
+        }
+        line       = next;
+        scalar_end = next;
+    }
+
+    // >>> CHOMPING
+    if (indent < 0)
+    {
+        // Only empty lines were found
+        out.setBodySize(scalar_end - body);
+    }
+    if (m_chomping != Chomping::Strip && have_content && last_break)
+    {
+        append_break(last_break);
+    }
+    if (m_chomping == Chomping::Keep)
+    {
+        append_empty();
+    }
+
+    m_indent   = static_cast<std::size_t>(
+        std::max(indent, std::max(parent_indent + 1, 0)));
+    m_consumed = scalar_end - begin;
+    m_owned    = out.owned();
+    m_view     = out.view();
+    m_storage  = out.release();
+
+    YAYP_ENSURE(this->value().size()
+                <= static_cast<std::size_t>(scalar_end - body));
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/BlockScalar.cc
+//---------------------------------------------------------------------------//
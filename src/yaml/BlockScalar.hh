@@ -0,0 +1,133 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/BlockScalar.hh
+ * \brief  BlockScalar class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_BLOCKSCALAR_HH
+#define YAYP_YAML_BLOCKSCALAR_HH
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "ParseError.hh"
+
+namespace yayp
+{
+//! Style of a block scalar, given by its indicator character
+enum class BlockStyle
+{
+    Literal, //!< '|': line breaks are preserved
+    Folded   //!< '>': line breaks between text lines are folded to spaces
+};
+
+//! Treatment of the final line break and trailing empty lines
+enum class Chomping
+{
+    Clip,  //!< Keep the final line break, drop trailing empty lines
+    Strip, //!< '-': Drop the final line break and trailing empty lines
+    Keep   //!< '+': Keep the final line break and trailing empty lines
+};
+
+//===========================================================================//
+/*!
+ * \class BlockScalar
+ * \brief Scans and folds a literal (|) or folded (>) block scalar.
+ *
+ * The block scalar is read starting at its header (the '|' or '>' indicator
+ * and optional indentation and chomping indicators) and extends until the
+ * first non-empty line that is less indented than its content.  The content
+ * indentation, chomping, and line folding are all computed in one pass over
+ * the input lines.  Once the content indentation is known, the lines of the
+ * body are also pre-scanned (finding only their line breaks and leading
+ * spaces) to bound the length of the value, so the body is read twice.
+ *
+ * When the resulting value is a contiguous slice of the input (e.g., a
+ * literal block at column zero, or a single-line block with clip or strip
+ * chomping) no copy is made and value() is a view into the input.  Otherwise,
+ * the value is written into a single allocation sized to the body found by
+ * the pre-scan, which is an upper bound on the folded length.  In the view
+ * case, the input must outlive this object.  rescan() reads another block
+ * scalar into the same object, reusing its storage, so that a scanner
+ * reading many block scalars only allocates until the storage fits the
+ * largest.
+ *
+ * The constructor throws an Exception for an invalid block scalar; scan()
+ * returns the error instead.
+ *
+ * \example src/yaml/tests/tstBlockScalar.cc
+ */
+//===========================================================================//
+
+class BlockScalar
+{
+  public:
+    // Scan the block scalar whose header begins the given input
+    explicit BlockScalar(std::string_view input, int parent_indent = -1);
+
+    // Scan the block scalar whose header begins the given input, without
+    // throwing
+    static ParseResult<BlockScalar>
+    scan(std::string_view input, int parent_indent = -1);
+
+    // Scan another block scalar, reusing the storage of this one
+    ParseError rescan(std::string_view input, int parent_indent = -1);
+
+    // >>> ACCESSORS
+    //! Return the block style
+    BlockStyle style() const { return m_style; }
+
+    //! Return the chomping method
+    Chomping chomping() const { return m_chomping; }
+
+    //! Return the indentation of the block content
+    std::size_t indentation() const { return m_indent; }
+
+    //! Return the number of input characters belonging to the block scalar
+    std::size_t consumed() const { return m_consumed; }
+
+    //! Return whether the value is a view into the input (no copy was made)
+    bool isView() const { return !m_owned; }
+
+    //! Return the folded value
+    std::string_view value() const
+    {
+        return m_owned ? std::string_view(m_storage) : m_view;
+    }
+
+  private:
+    // Construct an empty block scalar to scan into
+    BlockScalar() = default;
+
+    // >>> IMPLEMENTATION
+    // Scan the block scalar, returning the error code
+    ParseErrorCode read(std::string_view input,
+                        int              parent_indent,
+                        std::size_t&     error_offset);
+
+  private:
+    // >>> DATA
+    //! Style and chomping method given in the header
+    BlockStyle m_style = BlockStyle::Literal;
+    Chomping   m_chomping = Chomping::Clip;
+
+    //! Content indentation and number of input characters consumed
+    std::size_t m_indent   = 0;
+    std::size_t m_consumed = 0;
+
+    //! Value as a view into the input, or storage when a copy was needed
+    std::string_view m_view;
+    std::string      m_storage;
+    bool             m_owned = false;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_BLOCKSCALAR_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/BlockScalar.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,324 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/Document.cc
+ * \brief  Document class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "Document.hh"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "PackedArray.hh"
+#include "harness/DBC.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Split the next reference token off a JSON Pointer
+ *
+ * \param[in,out] pointer  The remaining pointer, which starts with '/'
+ * \param[out]    storage  Storage for a token that must be unescaped
+ * \return The unescaped token
+ */
+std::string_view nextToken(std::string_view& pointer, std::string& storage)
+{
+    YAYP_REQUIRE(!pointer.empty() && pointer.front() == '/');
+    pointer.remove_prefix(1);
+
+    std::size_t      end   = pointer.find('/');
+    std::string_view token = pointer.substr(0, end);
+    pointer.remove_prefix(token.size());
+    if (token.find('~') == std::string_view::npos)
+    {
+        return token;
+    }
+
+    storage.clear();
+    for (std::size_t i = 0; i < token.size(); ++i)
+    {
+        if (token[i] == '~' && i + 1 < token.size()
+            && (token[i + 1] == '0' || token[i + 1] == '1'))
+        {
+            storage += token[++i] == '0' ? '~' : '/';
+        }
+        else
+        {
+            storage += token[i];
+        }
+    }
+    return storage;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Parse a sequence index token
+ *
+ * \return Whether the token is a canonical decimal index that fits in a size
+ */
+bool parseIndex(std::string_view token, std::size_t& index)
+{
+    constexpr std::size_t max = std::numeric_limits<std::size_t>::max();
+
+    if (token.empty() || (token.size() > 1 && token.front() == '0'))
+    {
+        return false;
+    }
+    index = 0;
+    for (char c : token)
+    {
+        if (c < '0' || c > '9')
+        {
+            return false;
+        }
+        const auto digit = static_cast<std::size_t>(c - '0');
+        if (index > (max - digit) / 10)
+        {
+            return false;
+        }
+        index = index * 10 + digit;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Find the handle of the value of a key, including merged keys
+ */
+const yayp::NodePtr*
+findHandle(const yayp::Node& mapping, std::string_view key)
+{
+    for (const auto& entry : mapping.entries())
+    {
+        if (entry.first == key)
+        {
+            return &entry.second;
+        }
+    }
+    for (const auto& merge : mapping.merges())
+    {
+        if (const yayp::NodePtr* value = findHandle(merge->resolve(), key))
+        {
+            return value;
+        }
+    }
+    return nullptr;
+}
+
+//---------------------------------------------------------------------------//
+[[noreturn]] void throwInvalidPath(std::string_view pointer)
+{
+    throw yayp::Exception("Invalid document path '" + std::string(pointer)
+                          + "'");
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Rebuild the path to a replaced node
+ *
+ * \param[in] node     The node at the current position of the path
+ * \param[in] rest     The remainder of the path
+ * \param[in] value    The replacement
+ * \param[in] pointer  The full path, for error messages
+ * \return The rebuilt node, sharing all subtrees off the path
+ */
+yayp::NodePtr replace(const yayp::NodePtr& node,
+                      std::string_view      rest,
+                      yayp::NodePtr         value,
+                      std::string_view      pointer)
+{
+    using yayp::Node;
+
+    if (rest.empty())
+    {
+        return value;
+    }
+    if (rest.front() != '/')
+    {
+        throwInvalidPath(pointer);
+    }
+    std::string      storage;
+    std::string_view token   = nextToken(rest, storage);
+    const Node&      current = node->resolve();
+
+    if (current.kind() == Node::Kind::Mapping)
+    {
+        // Replace an own entry, or override a merged or missing key with a
+        // new own entry
+        Node::Entries entries = current.entries();
+        auto          iter    = entries.begin();
+        while (iter != entries.end() && iter->first != token)
+        {
+            ++iter;
+        }
+        if (iter != entries.end())
+        {
+            iter->second
+                = replace(iter->second, rest, std::move(value), pointer);
+        }
+        else if (const yayp::NodePtr* merged = findHandle(current, token))
+        {
+            entries.emplace_back(
+                std::string(token),
+                replace(*merged, rest, std::move(value), pointer));
+        }
+        else if (rest.empty())
+        {
+            entries.emplace_back(std::string(token), std::move(value));
+        }
+        else
+        {
+            throwInvalidPath(pointer);
+        }
+        return Node::makeMapping(std::move(entries), current.merges());
+    }
+    if (current.kind() == Node::Kind::Sequence)
+    {
+        std::size_t index = 0;
+        if (!parseIndex(token, index) || index >= current.size())
+        {
+            throwInvalidPath(pointer);
+        }
+        const yayp::PackedArray* packed = current.packed();
+        if (!packed)
+        {
+            Node::Items items = current.items();
+            items[index]
+                = replace(items[index], rest, std::move(value), pointer);
+            return Node::makeSequence(std::move(items));
+        }
+
+        // Keep the items packed if the new item fits the array
+        if (rest.empty() && value->kind() == Node::Kind::Scalar
+            && value->isPlain())
+        {
+            if (auto array = packed->with(index, value->scalar()))
+            {
+                return Node::makePackedSequence(
+                    std::make_shared<const yayp::PackedArray>(
+                        std::move(*array)));
+            }
+        }
+        // Otherwise unpack a copy, leaving the original packed
+        Node::Items items;
+        items.reserve(packed->size());
+        for (std::size_t i = 0; i < packed->size(); ++i)
+        {
+            items.push_back(Node::makeScalar(packed->format(i)));
+        }
+        items[index] = replace(items[index], rest, std::move(value), pointer);
+        return Node::makeSequence(std::move(items));
+    }
+    throwInvalidPath(pointer);
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor
+ *
+ * \param[in] root  The root of a complete document tree
+ */
+Document::Document(NodePtr root) : m_root(std::move(root))
+{
+    YAYP_REQUIRE(m_root);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Find the node at the given JSON Pointer
+ *
+ * Mapping keys are found as by Node::find(), including merged keys, and
+ * sequence items are addressed by their decimal index.  Aliases along the
+ * path are resolved.
+ *
+ * \param[in] pointer  The JSON Pointer
+ * \return The node, or nullptr if the pointer is invalid or does not match
+ */
+const Node* Document::find(std::string_view pointer) const
+{
+    const Node* node = m_root.get();
+    std::string storage;
+    while (node && !pointer.empty())
+    {
+        if (pointer.front() != '/')
+        {
+            return nullptr;
+        }
+        std::string_view token = nextToken(pointer, storage);
+
+        const Node& current = node->resolve();
+        if (current.kind() == Node::Kind::Mapping)
+        {
+            node = current.find(token);
+        }
+        else if (current.kind() == Node::Kind::Sequence)
+        {
+            std::size_t index = 0;
+            if (!parseIndex(token, index) || index >= current.size())
+            {
+                return nullptr;
+            }
+            node = &current.at(index);
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+    return node;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the numeric value at the given JSON Pointer
+ *
+ * \param[in] pointer  The JSON Pointer
+ * \return The number, or an empty optional if the pointer does not match a
+ *         numeric scalar
+ */
+std::optional<double> Document::number(std::string_view pointer) const
+{
+    const Node* node = this->find(pointer);
+    if (!node || node->resolvedKind() != Node::Kind::Scalar)
+    {
+        return std::nullopt;
+    }
+    return node->number();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a copy with the node at the given JSON Pointer replaced
+ *
+ * Every mapping and sequence along the path is rebuilt with its other
+ * entries shared, and everything else is shared with this document.  A
+ * missing last key is added to its mapping, and a key found in a merged
+ * mapping is overridden by a new own entry, leaving the merged mapping (and
+ * any other aliases of it) unchanged.  Likewise, an alias along the path is
+ * replaced by an edited copy of its target.
+ *
+ * \param[in] pointer  The JSON Pointer of the node to replace
+ * \param[in] value    The new node
+ */
+Document Document::with(std::string_view pointer, NodePtr value) const
+{
+    YAYP_REQUIRE(value);
+    return Document(replace(m_root, pointer, std::move(value), pointer));
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/Document.cc
+//---------------------------------------------------------------------------//
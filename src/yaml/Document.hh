@@ -0,0 +1,88 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/Document.hh
+ * \brief  Document class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_DOCUMENT_HH
+#define YAYP_YAML_DOCUMENT_HH
+
+#include <optional>
+#include <string_view>
+
+#include "Node.hh"
+
+namespace yayp
+{
+//===========================================================================//
+/*!
+ * \class Document
+ * \brief A finalized, immutable YAML document that may be read concurrently.
+ *
+ * A Document owns the root of a parsed tree.  Once constructed it is never
+ * modified, and every const member function (and every const function of
+ * the nodes it holds) may be called from any number of threads at once with
+ * no external synchronization.  The read path takes no locks and updates no
+ * reference counts: lookups return references and raw pointers into the
+ * tree.  Two things are created lazily, and published with a single
+ * compare-and-swap on first use and read with an acquire load (a plain load
+ * on common hardware) thereafter: the numeric values decoded by
+ * Node::number(), and the nodes of the items of packed sequences.  The first
+ * read of a packed item (e.g., \c find("/data/3")) thus allocates its node,
+ * and its chunk of slots, but not the nodes of the other items.
+ *
+ * Nodes are addressed with JSON Pointers (RFC 6901): \c "/jobs/0/cpu" is the
+ * \c cpu key of the first item of the \c jobs sequence, \c ~1 and \c ~0
+ * escape \c / and \c ~ in keys, and the empty pointer is the root.
+ *
+ * Documents are edited by copy-on-write: with() returns a new Document in
+ * which the node at a pointer is replaced, and which shares every subtree off
+ * that path with the original.  Only the containers along the path are
+ * rebuilt, so an edit costs the total number of entries of those containers
+ * (not the size of the document), and the original remains unchanged and
+ * safe to read throughout.  A packed sequence along the path is rebuilt from
+ * its packed items, and stays packed if the new item is of the same type.
+ *
+ * Copying a Document shares the tree, so share one Document by reference
+ * between threads rather than copying it in hot loops.
+ *
+ * \example src/yaml/tests/tstDocument.cc
+ */
+//===========================================================================//
+
+class Document
+{
+  public:
+    // Constructor
+    explicit Document(NodePtr root);
+
+    // Find the node at the given JSON Pointer
+    const Node* find(std::string_view pointer) const;
+
+    // Return the numeric value at the given JSON Pointer
+    std::optional<double> number(std::string_view pointer) const;
+
+    // Return a copy with the node at the given JSON Pointer replaced
+    Document with(std::string_view pointer, NodePtr value) const;
+
+    // >>> ACCESSORS
+    //! Return the root node
+    const Node& root() const { return *m_root; }
+
+    //! Return the shared handle to the root node
+    const NodePtr& handle() const { return m_root; }
+
+  private:
+    // >>> DATA
+    NodePtr m_root;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_DOCUMENT_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/Document.hh
+//---------------------------------------------------------------------------//
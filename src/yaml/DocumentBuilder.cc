@@ -0,0 +1,600 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/DocumentBuilder.cc
+ * \brief  DocumentBuilder class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "DocumentBuilder.hh"
+
+#include "harness/DBC.hh"
+#include "harness/Timing.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+//! Return whether a plain scalar denotes null
+bool isNull(std::string_view value)
+{
+    return value.empty() || value == "~" || value == "null" || value == "Null"
+           || value == "NULL";
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor
+ *
+ * \param[in] limits  The resource limits applied to each document
+ */
+DocumentBuilder::DocumentBuilder(const ParseLimits& limits)
+    : m_guard(limits)
+    , m_anchors(limits.aliases)
+{
+    /* * */
+}
+
+//---------------------------------------------------------------------------//
+// EVENTS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add a null node
+ *
+ * \param[in] anchor  Optional anchor name of the node
+ */
+void DocumentBuilder::null(std::string_view anchor)
+{
+    this->raise(this->tryNull(anchor));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add a scalar node
+ *
+ * \param[in] value   The scalar value
+ * \param[in] anchor  Optional anchor name of the node
+ * \param[in] style   The style in which the scalar was written
+ */
+void DocumentBuilder::scalar(std::string      value,
+                             std::string_view anchor,
+                             ScalarStyle      style)
+{
+    this->raise(this->tryScalar(std::move(value), anchor, style));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add an alias of a previously anchored node
+ *
+ * \param[in] name  The anchor name
+ */
+void DocumentBuilder::alias(std::string_view name)
+{
+    this->raise(this->tryAlias(name));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add a packed sequence
+ *
+ * \param[in] items   The items
+ * \param[in] anchor  Optional anchor name of the sequence
+ */
+void DocumentBuilder::packedSequence(std::shared_ptr<const PackedArray> items,
+                                     std::string_view anchor)
+{
+    this->raise(this->tryPackedSequence(std::move(items), anchor));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Begin a sequence
+ *
+ * \param[in] anchor  Optional anchor name of the sequence
+ */
+void DocumentBuilder::beginSequence(std::string_view anchor)
+{
+    this->raise(this->tryBeginSequence(anchor));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief End the current sequence
+ */
+void DocumentBuilder::endSequence()
+{
+    this->raise(this->tryEndSequence());
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Begin a mapping
+ *
+ * \param[in] anchor  Optional anchor name of the mapping
+ */
+void DocumentBuilder::beginMapping(std::string_view anchor)
+{
+    this->raise(this->tryBeginMapping(anchor));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief End the current mapping
+ */
+void DocumentBuilder::endMapping()
+{
+    this->raise(this->tryEndMapping());
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the completed document and prepare for the next one
+ *
+ * Anchors do not carry over between documents.  An empty document is null.
+ *
+ * \return The root node of the document
+ */
+NodePtr DocumentBuilder::finish()
+{
+    YAYP_REQUIRE(m_stack.empty());
+
+    NodePtr root = m_root ? std::move(m_root) : m_pool.makeNull();
+    this->reset();
+    return root;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a completed subtree, keeping the anchors of the document
+ *
+ * The resource counts also carry over, so the limits apply to all the
+ * subtrees built from one document together.
+ */
+NodePtr DocumentBuilder::takeNode()
+{
+    YAYP_REQUIRE(m_stack.empty());
+    YAYP_REQUIRE(m_root);
+    return std::move(m_root);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Abandon the current document and prepare for the next one
+ */
+void DocumentBuilder::reset()
+{
+    while (!m_stack.empty())
+    {
+        this->popFrame().clear();
+    }
+    m_root = nullptr;
+    m_anchors.clear();
+    m_guard.reset();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Reuse the nodes of a document that is no longer needed
+ *
+ * Only the nodes that are not held elsewhere are reused (see NodePool), so
+ * handles to parts of the document remain valid.
+ *
+ * \param[in] document  The root of the document
+ */
+void DocumentBuilder::recycle(NodePtr document)
+{
+    m_pool.recycle(std::move(document));
+}
+
+//---------------------------------------------------------------------------//
+// NON-THROWING EVENTS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add a null node
+ *
+ * \param[in] anchor  Optional anchor name of the node
+ */
+ParseErrorCode DocumentBuilder::tryNull(std::string_view anchor)
+{
+    if (auto code = m_guard.tryAddNode(); code != ParseErrorCode::None)
+    {
+        return code;
+    }
+    return this->attach(m_pool.makeNull(), anchor);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add a scalar node
+ *
+ * \param[in] value   The scalar value
+ * \param[in] anchor  Optional anchor name of the node
+ * \param[in] style   The style in which the scalar was written
+ */
+ParseErrorCode DocumentBuilder::tryScalar(std::string      value,
+                                          std::string_view anchor,
+                                          ScalarStyle      style)
+{
+    return this->addScalar(value, anchor, style);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add an alias of a previously anchored node
+ *
+ * \param[in] name  The anchor name
+ */
+ParseErrorCode DocumentBuilder::tryAlias(std::string_view name)
+{
+    if (auto code = m_guard.tryAddNode(); code != ParseErrorCode::None)
+    {
+        return code;
+    }
+    NodePtr node;
+    if (auto code = m_anchors.tryAlias(name, node);
+        code != ParseErrorCode::None)
+    {
+        return code;
+    }
+    return this->attach(std::move(node), {});
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add a packed sequence
+ *
+ * The sequence and each of its items count as nodes, and the sequence as a
+ * level of nesting.
+ *
+ * \param[in] items   The items
+ * \param[in] anchor  Optional anchor name of the sequence
+ */
+ParseErrorCode
+DocumentBuilder::tryPackedSequence(std::shared_ptr<const PackedArray> items,
+                                   std::string_view                   anchor)
+{
+    YAYP_REQUIRE(items);
+
+    if (auto code = m_guard.tryAddNodes(items->size() + 1);
+        code != ParseErrorCode::None)
+    {
+        return code;
+    }
+    if (auto code = m_guard.tryEnter(); code != ParseErrorCode::None)
+    {
+        return code;
+    }
+    m_guard.leave();
+    return this->attach(Node::makePackedSequence(std::move(items)), anchor);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Begin a sequence
+ *
+ * \param[in] anchor  Optional anchor name of the sequence
+ */
+ParseErrorCode DocumentBuilder::tryBeginSequence(std::string_view anchor)
+{
+    return this->begin(Node::Kind::Sequence, anchor);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief End the current sequence
+ */
+ParseErrorCode DocumentBuilder::tryEndSequence()
+{
+    YAYP_REQUIRE(!m_stack.empty());
+    YAYP_REQUIRE(m_stack.back().kind == Node::Kind::Sequence);
+
+    Frame& frame = this->popFrame();
+    m_guard.leave();
+    if (frame.packed.size() > 0)
+    {
+        return this->attach(
+            Node::makePackedSequence(
+                std::make_shared<const PackedArray>(std::move(frame.packed))),
+            frame.anchor);
+    }
+    return this->attach(m_pool.makeSequence(frame.items), frame.anchor);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Begin a mapping
+ *
+ * \param[in] anchor  Optional anchor name of the mapping
+ */
+ParseErrorCode DocumentBuilder::tryBeginMapping(std::string_view anchor)
+{
+    return this->begin(Node::Kind::Mapping, anchor);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief End the current mapping
+ */
+ParseErrorCode DocumentBuilder::tryEndMapping()
+{
+    YAYP_REQUIRE(!m_stack.empty());
+    YAYP_REQUIRE(m_stack.back().kind == Node::Kind::Mapping);
+    YAYP_REQUIRE(!m_stack.back().have_key);
+
+    Frame& frame = this->popFrame();
+    m_guard.leave();
+    return this->attach(m_pool.makeMapping(frame.entries, frame.items),
+                        frame.anchor);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add the node event of a scanner
+ *
+ * \param[in] event  A scalar, alias, or collection start or end event
+ */
+ParseErrorCode DocumentBuilder::tryEvent(const Event& event)
+{
+    switch (event.type)
+    {
+        case EventType::Scalar:
+            // A null is only known once the role of the scalar is: a key
+            // keeps its text
+            if (event.style == ScalarStyle::Plain && isNull(event.value)
+                && !this->expectsKey())
+            {
+                return this->tryNull(event.anchor);
+            }
+            return this->addScalar(event.value, event.anchor, event.style);
+        case EventType::Alias:
+            return this->tryAlias(event.value);
+        case EventType::PackedSequence:
+            return this->tryPackedSequence(event.packed, event.anchor);
+        case EventType::SequenceStart:
+            return this->tryBeginSequence(event.anchor);
+        case EventType::SequenceEnd:
+            return this->tryEndSequence();
+        case EventType::MappingStart:
+            return this->tryBeginMapping(event.anchor);
+        case EventType::MappingEnd:
+            return this->tryEndMapping();
+        default:
+            YAYP_NOT_REACHABLE();
+    }
+}
+
+//---------------------------------------------------------------------------//
+// PRIVATE IMPLEMENTATION FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add a scalar node with the given value
+ *
+ * Sequences of canonical plain scalars are packed, and the value of other
+ * scalars is copied into a node of the pool.
+ */
+ParseErrorCode DocumentBuilder::addScalar(std::string_view value,
+                                          std::string_view anchor,
+                                          ScalarStyle      style)
+{
+    if (auto code = m_guard.tryAddNode(); code != ParseErrorCode::None)
+    {
+        return code;
+    }
+    if (auto code = m_guard.tryCheckScalarLength(value.size());
+        code != ParseErrorCode::None)
+    {
+        return code;
+    }
+
+    // Pack a plain item if all the items of the sequence so far are packed
+    if (style == ScalarStyle::Plain && anchor.empty() && !m_stack.empty())
+    {
+        Frame& parent = m_stack.back();
+        if (parent.kind == Node::Kind::Sequence && parent.items.empty()
+            && parent.packed.append(value))
+        {
+            return ParseErrorCode::None;
+        }
+    }
+    return this->attach(
+        m_pool.makeScalar(value, style == ScalarStyle::Plain), anchor);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Begin a collection of the given kind
+ */
+ParseErrorCode DocumentBuilder::begin(Node::Kind kind, std::string_view anchor)
+{
+    YAYP_TIMER_FINE(Build);
+
+    if (auto code = m_guard.tryAddNode(); code != ParseErrorCode::None)
+    {
+        return code;
+    }
+    if (auto code = m_guard.tryEnter(); code != ParseErrorCode::None)
+    {
+        return code;
+    }
+
+    // Reuse the containers of a previous collection
+    if (m_spare.empty())
+    {
+        m_stack.emplace_back();
+    }
+    else
+    {
+        m_stack.push_back(std::move(m_spare.back()));
+        m_spare.pop_back();
+        m_stack.back().clear();
+    }
+    Frame& frame = m_stack.back();
+    frame.kind   = kind;
+    frame.anchor.assign(anchor.data(), anchor.size());
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Whether the next node is a mapping key
+ */
+bool DocumentBuilder::expectsKey() const
+{
+    return !m_stack.empty() && m_stack.back().kind == Node::Kind::Mapping
+           && !m_stack.back().have_key;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Move the innermost collection to the spare frames and return it
+ *
+ * The frame remains valid until the next collection begins.
+ */
+auto DocumentBuilder::popFrame() -> Frame&
+{
+    YAYP_REQUIRE(!m_stack.empty());
+
+    m_spare.push_back(std::move(m_stack.back()));
+    m_stack.pop_back();
+    return m_spare.back();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Replace the packed items of a sequence with scalar nodes
+ */
+void DocumentBuilder::unpack(Frame& frame)
+{
+    YAYP_TIMER_FINE(Build);
+
+    frame.items.reserve(frame.packed.size() + 1);
+    for (std::size_t i = 0; i < frame.packed.size(); ++i)
+    {
+        frame.items.push_back(m_pool.makeScalar(frame.packed.format(i)));
+    }
+    frame.packed = PackedArray();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Attach a completed node to its parent collection
+ *
+ * \param[in] node    The completed node
+ * \param[in] anchor  Optional anchor name of the node
+ */
+ParseErrorCode DocumentBuilder::attach(NodePtr node, std::string_view anchor)
+{
+    YAYP_TIMER_FINE(Build);
+
+    if (!anchor.empty())
+    {
+        m_anchors.define(std::string(anchor), node);
+    }
+
+    // A node outside of any collection is the document root
+    if (m_stack.empty())
+    {
+        YAYP_REQUIRE(!m_root);
+        m_root = std::move(node);
+        return ParseErrorCode::None;
+    }
+
+    Frame& parent = m_stack.back();
+    if (parent.kind == Node::Kind::Sequence)
+    {
+        if (parent.packed.size() > 0)
+        {
+            this->unpack(parent);
+        }
+        parent.items.push_back(std::move(node));
+    }
+    else if (!parent.have_key)
+    {
+        if (node->resolvedKind() != Node::Kind::Scalar)
+        {
+            return ParseErrorCode::NonScalarKey;
+        }
+        parent.key       = node->scalar();
+        parent.have_key  = true;
+        parent.merge_key = node->isPlain() && parent.key == "<<";
+        m_pool.recycle(std::move(node));
+    }
+    else if (parent.merge_key)
+    {
+        // Merge a mapping or each mapping of a sequence
+        const Node& value = node->resolve();
+        if (value.kind() == Node::Kind::Mapping)
+        {
+            parent.items.push_back(std::move(node));
+        }
+        else if (value.kind() == Node::Kind::Sequence)
+        {
+            for (const auto& item : value.items())
+            {
+                if (item->resolvedKind() != Node::Kind::Mapping)
+                {
+                    return ParseErrorCode::InvalidMerge;
+                }
+                parent.items.push_back(item);
+            }
+        }
+        else
+        {
+            return ParseErrorCode::InvalidMerge;
+        }
+        parent.have_key  = false;
+        parent.merge_key = false;
+    }
+    else
+    {
+        parent.entries.emplace_back(std::move(parent.key), std::move(node));
+        parent.have_key = false;
+    }
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Clear the frame for reuse, keeping the capacity of its containers
+ */
+void DocumentBuilder::Frame::clear()
+{
+    anchor.clear();
+    items.clear();
+    packed = PackedArray();
+    entries.clear();
+    key.clear();
+    have_key  = false;
+    merge_key = false;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Throw the exception for a failed event
+ *
+ * \param[in] code  The result of the event (no exception for None)
+ */
+void DocumentBuilder::raise(ParseErrorCode code) const
+{
+    if (YAYP_LIKELY(code == ParseErrorCode::None))
+    {
+        return;
+    }
+    if (const char* resource = limitResource(code))
+    {
+        throw LimitExceededException(resource, m_guard.limitFor(code));
+    }
+    throw Exception(describe(code));
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/DocumentBuilder.cc
+//---------------------------------------------------------------------------//
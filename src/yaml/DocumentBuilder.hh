@@ -0,0 +1,225 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/DocumentBuilder.hh
+ * \brief  DocumentBuilder class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_DOCUMENTBUILDER_HH
+#define YAYP_YAML_DOCUMENTBUILDER_HH
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AnchorTable.hh"
+#include "Node.hh"
+#include "NodePool.hh"
+#include "PackedArray.hh"
+#include "ResourceGuard.hh"
+#include "Scanner.hh"
+
+namespace yayp
+{
+//===========================================================================//
+/*!
+ * \class DocumentBuilder
+ * \brief Builds a document tree from a stream of parse events.
+ *
+ * The builder receives the events of one document (scalars, aliases, and the
+ * beginning and end of collections) and assembles the corresponding Node
+ * tree.  Within a mapping, events alternate between a scalar key and its
+ * value.  A value under the plain key \c << must be a mapping or a sequence
+ * of mappings, and is recorded as a merged mapping rather than an entry; a
+ * quoted \c "<<" is an ordinary key.
+ *
+ * All resources are checked against the ParseLimits as the events arrive:
+ * the nesting depth, the node count, the scalar length, and the alias
+ * expansion.  A LimitExceededException is thrown as soon as a limit is
+ * exceeded, so the memory held by a partially built document is bounded by
+ * the limits.
+ *
+ * Each event also has a non-throwing \c try form, which returns the
+ * ParseErrorCode of the failure (ParseErrorCode::None on success) instead of
+ * throwing; the throwing events are thin wrappers around them.  After a
+ * failure the partially built document is abandoned with reset().
+ * tryEvent() passes a node event of a Scanner to the corresponding \c try
+ * function, treating the plain scalars \c ~, \c null, \c Null, \c NULL and
+ * empty values as nulls, except as mapping keys, which keep their text (so
+ * that \c null: 1 is the entry with key \c "null").  The style of each scalar is recorded in its node,
+ * so that only plain scalars are read as numbers.
+ *
+ * A packed sequence (see PackedArray) is added as a single node.  Its items
+ * count towards ParseLimits::max_nodes like the items of any sequence, but
+ * are not checked against ParseLimits::max_scalar_length since they are not
+ * stored as text.
+ *
+ * The builder also packs the sequences it assembles itself: as long as the
+ * items of a sequence are plain scalars without anchors that are all
+ * integers, all floats, or all booleans in canonical form, they are appended
+ * to a PackedArray instead of becoming nodes (quoted items are strings).
+ * The first item that does not fit turns the items packed so far into
+ * nodes, and the sequence continues as usual.  A sequence of a million
+ * numbers is thus one node holding a contiguous array, whichever style it
+ * is written in.
+ *
+ * Besides building whole documents, the builder can build several separate
+ * subtrees of one document (as PathQuery does for the parts of a stream it
+ * selects): takeNode() returns each completed subtree while keeping the
+ * anchors defined so far, so that later subtrees may alias them.
+ *
+ * The nodes are created by a NodePool, and documents that are no longer
+ * needed may be returned with recycle() so that their nodes are reused.  The
+ * containers of the collections under construction are kept between
+ * documents too, so building documents of a steady shape does not allocate.
+ *
+ * \example src/yaml/tests/tstDocumentBuilder.cc
+ */
+//===========================================================================//
+
+class DocumentBuilder
+{
+  public:
+    // Constructor
+    explicit DocumentBuilder(const ParseLimits& limits = ParseLimits());
+
+    // >>> EVENTS
+    // Add a null node
+    void null(std::string_view anchor = {});
+
+    // Add a scalar node
+    void scalar(std::string      value,
+                std::string_view anchor = {},
+                ScalarStyle      style  = ScalarStyle::Plain);
+
+    // Add an alias of a previously anchored node
+    void alias(std::string_view name);
+
+    // Add a packed sequence
+    void packedSequence(std::shared_ptr<const PackedArray> items,
+                        std::string_view                   anchor = {});
+
+    // Begin a sequence
+    void beginSequence(std::string_view anchor = {});
+
+    // End the current sequence
+    void endSequence();
+
+    // Begin a mapping
+    void beginMapping(std::string_view anchor = {});
+
+    // End the current mapping
+    void endMapping();
+
+    // Return the completed document and prepare for the next one
+    NodePtr finish();
+
+    // Return a completed subtree, keeping the anchors of the document
+    NodePtr takeNode();
+
+    // Abandon the current document and prepare for the next one
+    void reset();
+
+    // Reuse the nodes of a document that is no longer needed
+    void recycle(NodePtr document);
+
+    // >>> NON-THROWING EVENTS
+    // Add a null node
+    ParseErrorCode tryNull(std::string_view anchor = {});
+
+    // Add a scalar node
+    ParseErrorCode tryScalar(std::string      value,
+                             std::string_view anchor = {},
+                             ScalarStyle      style  = ScalarStyle::Plain);
+
+    // Add an alias of a previously anchored node
+    ParseErrorCode tryAlias(std::string_view name);
+
+    // Add a packed sequence
+    ParseErrorCode
+    tryPackedSequence(std::shared_ptr<const PackedArray> items,
+                      std::string_view                   anchor = {});
+
+    // Begin a sequence
+    ParseErrorCode tryBeginSequence(std::string_view anchor = {});
+
+    // End the current sequence
+    ParseErrorCode tryEndSequence();
+
+    // Begin a mapping
+    ParseErrorCode tryBeginMapping(std::string_view anchor = {});
+
+    // End the current mapping
+    ParseErrorCode tryEndMapping();
+
+    // Add the node event of a scanner
+    ParseErrorCode tryEvent(const Event& event);
+
+    // >>> ACCESSORS
+    //! Return the resource guard
+    const ResourceGuard& guard() const { return m_guard; }
+
+    //! Return the anchor table
+    const AnchorTable& anchors() const { return m_anchors; }
+
+  private:
+    //! A collection under construction
+    struct Frame
+    {
+        Node::Kind    kind;
+        std::string   anchor;
+        Node::Items   items;
+        PackedArray   packed;
+        Node::Entries entries;
+        std::string   key;
+        bool          have_key  = false;
+        bool          merge_key = false;
+
+        // Clear the frame for reuse, keeping the capacity of its containers
+        void clear();
+    };
+
+  private:
+    // >>> IMPLEMENTATION
+    // Attach a completed node to its parent
+    ParseErrorCode attach(NodePtr node, std::string_view anchor);
+
+    // Add a scalar node with the given value
+    ParseErrorCode addScalar(std::string_view value,
+                             std::string_view anchor,
+                             ScalarStyle      style);
+
+    // Begin a collection of the given kind
+    ParseErrorCode begin(Node::Kind kind, std::string_view anchor);
+
+    // Whether the next node is a mapping key
+    bool expectsKey() const;
+
+    // Move the innermost collection to the spare frames and return it
+    Frame& popFrame();
+
+    // Replace the packed items of a sequence with nodes
+    void unpack(Frame& frame);
+
+    // Throw the exception for a failed event
+    void raise(ParseErrorCode code) const;
+
+  private:
+    // >>> DATA
+    ResourceGuard      m_guard;
+    AnchorTable        m_anchors;
+    std::vector<Frame> m_stack;
+    std::vector<Frame> m_spare;
+    NodePool           m_pool;
+    NodePtr            m_root;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_DOCUMENTBUILDER_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/DocumentBuilder.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,634 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/Node.cc
+ * \brief  Node class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "Node.hh"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <limits>
+#include <string_view>
+
+#include "PackedArray.hh"
+
+#include "harness/DBC.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add two sizes, saturating at the maximum representable size
+ */
+std::size_t saturatingAdd(std::size_t a, std::size_t b)
+{
+    constexpr std::size_t max = std::numeric_limits<std::size_t>::max();
+    return (a > max - b) ? max : a + b;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Publish a value created on first use, unless another thread did
+ *
+ * \return The published value, which is either the given one or the one
+ *         published by another thread (in which case the given one is freed)
+ */
+template<class T>
+T* publish(std::atomic<T*>& slot, std::unique_ptr<T> value)
+{
+    T* expected = nullptr;
+    if (slot.compare_exchange_strong(expected,
+                                     value.get(),
+                                     std::memory_order_acq_rel,
+                                     std::memory_order_acquire))
+    {
+        return value.release();
+    }
+    return expected;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Nodes created from the items of a packed sequence
+ *
+ * The slots of the nodes are allocated in chunks on first use, so that
+ * reading one item of a huge array allocates one chunk and one node.
+ */
+struct Node::PackedNodes
+{
+    //! Number of item slots per chunk
+    static constexpr std::size_t chunk_size = 256;
+
+    using Slot  = std::atomic<const NodePtr*>;
+    using Chunk = std::array<Slot, chunk_size>;
+
+    std::vector<std::atomic<Chunk*>> chunks;
+
+    //! Construct with no chunks allocated for the given number of items
+    explicit PackedNodes(std::size_t size)
+        : chunks((size + chunk_size - 1) / chunk_size)
+    {
+    }
+
+    //! Free the chunks and the nodes
+    ~PackedNodes()
+    {
+        for (auto& chunk : chunks)
+        {
+            Chunk* slots = chunk.load(std::memory_order_acquire);
+            if (!slots)
+            {
+                continue;
+            }
+            for (auto& slot : *slots)
+            {
+                delete slot.load(std::memory_order_acquire);
+            }
+            delete slots;
+        }
+    }
+};
+
+//---------------------------------------------------------------------------//
+// FACTORIES
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create a null node
+ */
+NodePtr Node::makeNull()
+{
+    return NodePtr(new Node(Kind::Null));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create a scalar node
+ *
+ * \param[in] value  The scalar value
+ * \param[in] plain  Whether the scalar was written in plain style, rather
+ *                   than quoted or as a block scalar
+ */
+NodePtr Node::makeScalar(std::string value, bool plain)
+{
+    auto node     = std::shared_ptr<Node>(new Node(Kind::Scalar));
+    node->m_value = std::move(value);
+    node->m_plain = plain;
+    return node;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create a sequence node
+ *
+ * \param[in] items  The sequence items
+ */
+NodePtr Node::makeSequence(Items items)
+{
+    auto node     = std::shared_ptr<Node>(new Node(Kind::Sequence));
+    node->m_items = std::move(items);
+    node->accumulateChildren();
+    return node;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create a sequence node holding packed items
+ *
+ * The items are shared, not copied.
+ *
+ * \param[in] items  The packed items
+ */
+NodePtr Node::makePackedSequence(std::shared_ptr<const PackedArray> items)
+{
+    YAYP_REQUIRE(items);
+
+    auto node             = std::shared_ptr<Node>(new Node(Kind::Sequence));
+    node->m_expanded_size = saturatingAdd(1, items->size());
+    node->m_packed        = std::move(items);
+    return node;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create a mapping node
+ *
+ * \param[in] entries  The key/value entries of the mapping
+ * \param[in] merges   Mappings merged into this one with the \c << key, in
+ *                     order of precedence
+ */
+NodePtr Node::makeMapping(Entries entries, Items merges)
+{
+    auto node       = std::shared_ptr<Node>(new Node(Kind::Mapping));
+    node->m_entries = std::move(entries);
+    node->m_items   = std::move(merges);
+    node->accumulateChildren();
+    return node;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create an alias node referring to the anchored node
+ *
+ * The target is shared, not copied.
+ *
+ * \param[in] anchor  The name of the anchor
+ * \param[in] target  The anchored node
+ */
+NodePtr Node::makeAlias(std::string anchor, NodePtr target)
+{
+    YAYP_REQUIRE(target);
+
+    auto node             = std::shared_ptr<Node>(new Node(Kind::Alias));
+    node->m_value         = std::move(anchor);
+    node->m_alias_depth   = target->m_alias_depth + 1;
+    node->m_expanded_size = target->m_expanded_size;
+    node->m_target        = std::move(target);
+    return node;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Destructor
+ */
+Node::~Node()
+{
+    delete m_unpacked.load(std::memory_order_acquire);
+    delete m_packed_nodes.load(std::memory_order_acquire);
+}
+
+//---------------------------------------------------------------------------//
+// ACCESSORS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the node this node refers to, following aliases
+ */
+const Node& Node::resolve() const
+{
+    const Node* node = this;
+    while (node->m_kind == Kind::Alias)
+    {
+        node = node->m_target.get();
+    }
+    return *node;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the value of a scalar node
+ */
+const std::string& Node::scalar() const
+{
+    const Node& node = this->resolve();
+    YAYP_REQUIRE(node.m_kind == Kind::Scalar);
+    return node.m_value;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return whether a scalar node was written in plain style
+ */
+bool Node::isPlain() const
+{
+    const Node& node = this->resolve();
+    YAYP_REQUIRE(node.m_kind == Kind::Scalar);
+    return node.m_plain;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the numeric value of a scalar node
+ *
+ * The value is decoded on first use, following the YAML 1.2 core schema, and
+ * published without locks so that concurrent readers are safe.  Only plain
+ * scalars are decoded: quoted and block scalars are strings.
+ *
+ * \return The number, or an empty optional if the scalar is not a number
+ */
+std::optional<double> Node::number() const
+{
+    const Node& node = this->resolve();
+    YAYP_REQUIRE(node.m_kind == Kind::Scalar);
+    if (!node.m_plain)
+    {
+        return std::nullopt;
+    }
+
+    unsigned char state = node.m_number_state.load(std::memory_order_acquire);
+    if (state == Decoded)
+    {
+        return node.m_number;
+    }
+    if (state == NotANumber)
+    {
+        return std::nullopt;
+    }
+
+    // Decode, then publish the result unless another thread is doing so
+    double        value    = 0;
+    bool          decoded  = decodeNumber(node.m_value, value);
+    unsigned char expected = Undecoded;
+    if (node.m_number_state.compare_exchange_strong(
+            expected, Publishing, std::memory_order_relaxed))
+    {
+        node.m_number = value;
+        node.m_number_state.store(decoded ? Decoded : NotANumber,
+                                  std::memory_order_release);
+    }
+    if (!decoded)
+    {
+        return std::nullopt;
+    }
+    return value;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the number of sequence items or own mapping entries
+ *
+ * Null and scalar nodes have size zero.
+ */
+std::size_t Node::size() const
+{
+    const Node& node = this->resolve();
+    if (node.m_packed)
+    {
+        return node.m_packed->size();
+    }
+    if (node.m_kind == Kind::Sequence)
+    {
+        return node.m_items.size();
+    }
+    return node.m_entries.size();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the sequence item at the given index
+ *
+ * The item of a packed sequence is created on its first use.
+ *
+ * \param[in] index  The item index
+ */
+const Node& Node::at(std::size_t index) const
+{
+    const Node& node = this->resolve();
+    YAYP_REQUIRE(node.m_kind == Kind::Sequence);
+    if (node.m_packed)
+    {
+        YAYP_REQUIRE(index < node.m_packed->size());
+        return *node.packedItem(index);
+    }
+    YAYP_REQUIRE(index < node.m_items.size());
+    return *node.m_items[index];
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the sequence items
+ *
+ * The items of a packed sequence are all created on first use.
+ */
+auto Node::items() const -> const Items&
+{
+    const Node& node = this->resolve();
+    YAYP_REQUIRE(node.m_kind == Kind::Sequence);
+    return node.m_packed ? node.unpacked() : node.m_items;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the packed items of a sequence
+ *
+ * \return The items, or nullptr if the node is not a packed sequence
+ */
+const PackedArray* Node::packed() const
+{
+    return this->resolve().m_packed.get();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the mapping's own entries
+ */
+auto Node::entries() const -> const Entries&
+{
+    const Node& node = this->resolve();
+    YAYP_REQUIRE(node.m_kind == Kind::Mapping);
+    return node.m_entries;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the mappings merged into this mapping
+ */
+auto Node::merges() const -> const Items&
+{
+    const Node& node = this->resolve();
+    YAYP_REQUIRE(node.m_kind == Kind::Mapping);
+    return node.m_items;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Find the value of the given key in a mapping
+ *
+ * The mapping's own entries are searched first, followed by each of the
+ * merged mappings in order.  Merged mappings are only visited when the key
+ * is not found among the own entries.  If a key is repeated, the value of
+ * its first occurrence is returned.
+ *
+ * \param[in] key  The key to find
+ * \return The value, or nullptr if the key is not present
+ */
+const Node* Node::find(std::string_view key) const
+{
+    const Node& node = this->resolve();
+    YAYP_REQUIRE(node.m_kind == Kind::Mapping);
+
+    auto iter = std::find_if(node.m_entries.cbegin(),
+                             node.m_entries.cend(),
+                             [key](const Entry& e) { return e.first == key; });
+    if (iter != node.m_entries.cend())
+    {
+        return iter->second.get();
+    }
+    for (const auto& merge : node.m_items)
+    {
+        if (const Node* value = merge->find(key))
+        {
+            return value;
+        }
+    }
+    return nullptr;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the anchor name of an alias
+ */
+const std::string& Node::anchor() const
+{
+    YAYP_REQUIRE(m_kind == Kind::Alias);
+    return m_value;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the aliased node
+ */
+const NodePtr& Node::target() const
+{
+    YAYP_REQUIRE(m_kind == Kind::Alias);
+    return m_target;
+}
+
+//---------------------------------------------------------------------------//
+// PRIVATE IMPLEMENTATION FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Construct a node of the given kind
+ */
+Node::Node(Kind kind)
+    : m_kind(kind)
+{
+    /* * */
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Include a child node in the alias depth and expanded size
+ */
+void Node::accumulate(const Node& child)
+{
+    m_alias_depth   = std::max(m_alias_depth, child.m_alias_depth);
+    m_expanded_size = saturatingAdd(m_expanded_size, child.m_expanded_size);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Include the items, entries and merged mappings of a collection in
+ *        the alias depth and expanded size
+ */
+void Node::accumulateChildren()
+{
+    for (const auto& entry : m_entries)
+    {
+        YAYP_REQUIRE(entry.second);
+        this->accumulate(*entry.second);
+    }
+    for (const auto& item : m_items)
+    {
+        YAYP_REQUIRE(item);
+        YAYP_REQUIRE(m_kind != Kind::Mapping
+                     || item->resolvedKind() == Kind::Mapping);
+        this->accumulate(*item);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Clear the data of the node for reuse, keeping its capacity
+ *
+ * The kind is kept, so that a node is reused for the same kind of data.
+ */
+void Node::clearForReuse()
+{
+    m_value.clear();
+    m_plain = true;
+    m_items.clear();
+    m_packed = nullptr;
+    delete m_unpacked.exchange(nullptr, std::memory_order_acquire);
+    delete m_packed_nodes.exchange(nullptr, std::memory_order_acquire);
+    m_entries.clear();
+    m_target        = nullptr;
+    m_alias_depth   = 0;
+    m_expanded_size = 1;
+    m_number_state.store(Undecoded, std::memory_order_relaxed);
+    m_number = 0;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the node of a packed item, creating it on first use
+ *
+ * Threads that race on the first use of an item (or of the chunk or table
+ * holding it) each create it, and all but the one that publishes it discard
+ * their own.
+ */
+const NodePtr& Node::packedItem(std::size_t index) const
+{
+    YAYP_REQUIRE(m_packed && index < m_packed->size());
+    using Chunk = PackedNodes::Chunk;
+
+    PackedNodes* nodes = m_packed_nodes.load(std::memory_order_acquire);
+    if (!nodes)
+    {
+        nodes = publish(m_packed_nodes,
+                        std::make_unique<PackedNodes>(m_packed->size()));
+    }
+    auto&  chunk = nodes->chunks[index / PackedNodes::chunk_size];
+    Chunk* slots = chunk.load(std::memory_order_acquire);
+    if (!slots)
+    {
+        slots = publish(chunk, std::make_unique<Chunk>());
+    }
+    auto&          slot = (*slots)[index % PackedNodes::chunk_size];
+    const NodePtr* item = slot.load(std::memory_order_acquire);
+    if (!item)
+    {
+        item = publish(slot,
+                       std::make_unique<const NodePtr>(
+                           Node::makeScalar(m_packed->format(index))));
+    }
+    return *item;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the items of a packed sequence, creating them on first use
+ *
+ * The items are the nodes returned by at(), which are created if needed.
+ * Threads that race on the first use each build the list, and all but the
+ * one that publishes it discard their own.
+ */
+auto Node::unpacked() const -> const Items&
+{
+    YAYP_REQUIRE(m_packed);
+
+    if (const Items* items = m_unpacked.load(std::memory_order_acquire))
+    {
+        return *items;
+    }
+
+    auto items = std::make_unique<Items>();
+    items->reserve(m_packed->size());
+    for (std::size_t i = 0; i < m_packed->size(); ++i)
+    {
+        items->push_back(this->packedItem(i));
+    }
+    return *publish<const Items>(m_unpacked, std::move(items));
+}
+
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Decode a number of the YAML 1.2 core schema
+ *
+ * Accepts decimal integers and floats with an optional sign, hexadecimal
+ * (\c 0x) and octal (\c 0o) integers, and the \c .inf and \c .nan forms.
+ *
+ * \param[in]  s      The scalar value
+ * \param[out] value  The decoded number
+ * \return Whether the scalar is a number
+ */
+bool decodeNumber(std::string_view s, double& value)
+{
+    if (s == ".nan" || s == ".NaN" || s == ".NAN")
+    {
+        value = std::numeric_limits<double>::quiet_NaN();
+        return true;
+    }
+
+    bool negative = false;
+    if (!s.empty() && (s.front() == '-' || s.front() == '+'))
+    {
+        negative = s.front() == '-';
+        s.remove_prefix(1);
+    }
+    if (s == ".inf" || s == ".Inf" || s == ".INF")
+    {
+        value = negative ? -std::numeric_limits<double>::infinity()
+                         : std::numeric_limits<double>::infinity();
+        return true;
+    }
+
+    // Reject the forms from_chars accepts but YAML does not (e.g., "inf")
+    if (s.empty()
+        || !(s.front() == '.' || (s.front() >= '0' && s.front() <= '9')))
+    {
+        return false;
+    }
+
+    const char* first = s.data();
+    const char* last  = s.data() + s.size();
+    if (s.size() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'o'))
+    {
+        if (negative)
+        {
+            return false;
+        }
+        unsigned long long integer = 0;
+        auto result = std::from_chars(first + 2, last, integer,
+                                      s[1] == 'x' ? 16 : 8);
+        value = static_cast<double>(integer);
+        return result.ec == std::errc() && result.ptr == last;
+    }
+
+    auto result = std::from_chars(first, last, value);
+    if (result.ec != std::errc() || result.ptr != last)
+    {
+        return false;
+    }
+    if (negative)
+    {
+        value = -value;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/Node.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,260 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/Node.hh
+ * \brief  Node class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_NODE_HH
+#define YAYP_YAML_NODE_HH
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace yayp
+{
+class Node;
+class PackedArray;
+
+//! Shared handle to an immutable node
+using NodePtr = std::shared_ptr<const Node>;
+
+//===========================================================================//
+/*!
+ * \class Node
+ * \brief An immutable node of a YAML document.
+ *
+ * Nodes are shared through NodePtr handles and never modified after
+ * construction, so a subtree may appear any number of times in a document
+ * without being copied.  An alias (\c *name) is represented by an Alias node
+ * holding a handle to the anchored node (\c &name), and the data accessors
+ * (scalar(), size(), at(), find(), ...) transparently resolve aliases.
+ *
+ * Merge keys (\c <<) are not expanded into the mapping.  The merged mappings
+ * are kept as handles and only searched by find() when a key is not among the
+ * mapping's own entries, with the own entries taking precedence over the
+ * merged ones and earlier merged mappings over later ones.  Repeated keys
+ * are kept in entries() as written, but only the first occurrence of a key
+ * has a value: find() (like PathQuery) never returns a later duplicate.
+ *
+ * Each node records its alias depth (the longest chain of aliases reachable
+ * from it) and its expanded size (the number of nodes it would hold if every
+ * alias were replaced with a copy of its target).  Both are computed in
+ * constant time at construction and are used by AnchorTable to reject
+ * pathological alias expansion ("billion laughs") before it happens.
+ *
+ * A sequence may also hold its items packed in a PackedArray (e.g., a
+ * sequence of numbers or booleans), which stores them as typed values rather
+ * than as nodes.  at() creates the scalar node of the requested item only,
+ * on its first use, with the same text it was read from, so that reading a
+ * few items of a huge array costs a few nodes.  items() must return every
+ * item, and so creates the nodes of all of them (in time and memory linear
+ * in the size of the array) on its first use; packed() gives direct access
+ * to the values, such as a contiguous Span of doubles, without creating any
+ * node.
+ *
+ * Mapping keys are restricted to scalars.
+ *
+ * Following the YAML 1.2 core schema, only a plain scalar may be a number: a
+ * quoted or block scalar (\c "12", \c '1e3') is always a string, and
+ * number() does not decode it.
+ *
+ * Nodes may also be created by a NodePool, which reuses the nodes of
+ * documents that are no longer needed.
+ *
+ * Because nodes are immutable, any number of threads may read a document
+ * concurrently without synchronization.  The only lazily computed state is
+ * the numeric value of a scalar, which number() decodes on first use and
+ * publishes with a single compare-and-swap: threads that race on the first
+ * use each decode the value themselves, one of them stores it, and later
+ * calls read it after an acquire load.  No thread ever waits.  The nodes of
+ * the items of a packed sequence are created and published the same way,
+ * each on its first use.
+ *
+ * \example src/yaml/tests/tstNode.cc
+ */
+//===========================================================================//
+
+class Node
+{
+  public:
+    //! The kind of node
+    enum class Kind
+    {
+        Null,
+        Scalar,
+        Sequence,
+        Mapping,
+        Alias
+    };
+
+    //@{
+    //! Public type aliases
+    using Entry   = std::pair<std::string, NodePtr>;
+    using Items   = std::vector<NodePtr>;
+    using Entries = std::vector<Entry>;
+    //@}
+
+  public:
+    // >>> FACTORIES
+    // Create a null node
+    static NodePtr makeNull();
+
+    // Create a scalar node, plain unless it was quoted or a block scalar
+    static NodePtr makeScalar(std::string value, bool plain = true);
+
+    // Create a sequence node
+    static NodePtr makeSequence(Items items);
+
+    // Create a sequence node holding packed items
+    static NodePtr
+    makePackedSequence(std::shared_ptr<const PackedArray> items);
+
+    // Create a mapping node with optional merged mappings
+    static NodePtr makeMapping(Entries entries, Items merges = {});
+
+    // Create an alias of the given anchored node
+    static NodePtr makeAlias(std::string anchor, NodePtr target);
+
+    // Destructor
+    ~Node();
+
+    // >>> ACCESSORS
+    //! Return the kind of this node (which may be an alias)
+    Kind kind() const { return m_kind; }
+
+    //! Return whether this node is an alias
+    bool isAlias() const { return m_kind == Kind::Alias; }
+
+    // Return the node this node refers to, following aliases
+    const Node& resolve() const;
+
+    //! Return the kind of the resolved node
+    Kind resolvedKind() const { return this->resolve().m_kind; }
+
+    // Return the value of a scalar
+    const std::string& scalar() const;
+
+    // Return whether a scalar was written in plain style
+    bool isPlain() const;
+
+    // Return the numeric value of a scalar, decoding it on first use
+    std::optional<double> number() const;
+
+    // Return the number of sequence items or own mapping entries
+    std::size_t size() const;
+
+    // Return the sequence item at the given index
+    const Node& at(std::size_t index) const;
+
+    // Return the sequence items
+    const Items& items() const;
+
+    // Return the packed items of a sequence, or nullptr if not packed
+    const PackedArray* packed() const;
+
+    // Return the mapping's own entries (excluding merged mappings)
+    const Entries& entries() const;
+
+    // Return the mapping's merged mappings
+    const Items& merges() const;
+
+    // Find the value of the given key in a mapping, including merged keys
+    const Node* find(std::string_view key) const;
+
+    // Return the anchor name of an alias
+    const std::string& anchor() const;
+
+    // Return the aliased node
+    const NodePtr& target() const;
+
+    //! Return the longest chain of aliases reachable from this node
+    std::size_t aliasDepth() const { return m_alias_depth; }
+
+    //! Return the number of nodes this node expands to, following aliases
+    std::size_t expandedSize() const { return m_expanded_size; }
+
+  private:
+    friend class NodePool;
+
+    // Construct a node of the given kind
+    explicit Node(Kind kind);
+
+    // Compute the alias depth and expanded size from the children
+    void accumulate(const Node& child);
+
+    // Compute the alias depth and expanded size of a collection
+    void accumulateChildren();
+
+    // Clear the data of the node for reuse, keeping its capacity
+    void clearForReuse();
+
+    // Return the node of a packed item, creating it on first use
+    const NodePtr& packedItem(std::size_t index) const;
+
+    // Return the items of a packed sequence, creating them on first use
+    const Items& unpacked() const;
+
+    // Nodes created from the items of a packed sequence
+    struct PackedNodes;
+
+    //! State of the lazily decoded number
+    enum NumberState : unsigned char
+    {
+        Undecoded,
+        Publishing,
+        Decoded,
+        NotANumber
+    };
+
+  private:
+    // >>> DATA
+    Kind m_kind;
+
+    //! Scalar value or the anchor name of an alias
+    std::string m_value;
+
+    //! Whether a scalar is plain, and so may be a number
+    bool m_plain = true;
+
+    //! Sequence items, or the merged mappings of a mapping
+    Items m_items;
+
+    //! Packed sequence items, the nodes created from them one at a time,
+    //! and the list of all of them
+    std::shared_ptr<const PackedArray> m_packed;
+    mutable std::atomic<PackedNodes*>  m_packed_nodes{nullptr};
+    mutable std::atomic<const Items*>  m_unpacked{nullptr};
+
+    //! Mapping entries
+    Entries m_entries;
+
+    //! Aliased node
+    NodePtr m_target;
+
+    //! Alias depth and expanded size
+    std::size_t m_alias_depth   = 0;
+    std::size_t m_expanded_size = 1;
+
+    //! Lazily decoded number, written once before its state is published
+    mutable std::atomic<unsigned char> m_number_state{Undecoded};
+    mutable double                     m_number = 0;
+};
+
+//---------------------------------------------------------------------------//
+// Decode a number of the YAML 1.2 core schema, returning whether it is one
+bool decodeNumber(std::string_view s, double& value);
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_NODE_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/Node.hh
+//---------------------------------------------------------------------------//
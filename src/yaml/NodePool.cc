@@ -0,0 +1,184 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/NodePool.cc
+ * \brief  NodePool class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "NodePool.hh"
+
+#include <atomic>
+#include <utility>
+
+#include "harness/DBC.hh"
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+// FACTORIES
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create a null node
+ */
+NodePtr NodePool::makeNull()
+{
+    return this->take(Node::Kind::Null);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create a scalar node
+ *
+ * \param[in] value  The scalar value, copied into the reused node
+ * \param[in] plain  Whether the scalar was written in plain style
+ */
+NodePtr NodePool::makeScalar(std::string_view value, bool plain)
+{
+    auto node = this->take(Node::Kind::Scalar);
+    node->m_value.assign(value.data(), value.size());
+    node->m_plain = plain;
+    return node;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create a sequence node, exchanging the items for spare capacity
+ *
+ * \param[in,out] items  The sequence items, replaced with an empty container
+ */
+NodePtr NodePool::makeSequence(Node::Items& items)
+{
+    auto node = this->take(Node::Kind::Sequence);
+    node->m_items.swap(items);
+    node->accumulateChildren();
+    return node;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create a mapping node, exchanging the containers for spare capacity
+ *
+ * \param[in,out] entries  The key/value entries of the mapping, replaced
+ *                         with an empty container
+ * \param[in,out] merges   The merged mappings, replaced with an empty
+ *                         container
+ */
+NodePtr NodePool::makeMapping(Node::Entries& entries, Node::Items& merges)
+{
+    auto node = this->take(Node::Kind::Mapping);
+    node->m_entries.swap(entries);
+    node->m_items.swap(merges);
+    node->accumulateChildren();
+    return node;
+}
+
+//---------------------------------------------------------------------------//
+// RECYCLING
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Keep the nodes of a document that are not shared, for reuse
+ *
+ * The document is walked from the root, and each node to which the pool
+ * holds the last handle is cleared and kept.  A node that is still shared
+ * (e.g., the target of an alias not yet visited, or a subtree held by the
+ * caller) is only released, and is kept later if its last other handle is
+ * within the document.  Aliases, which the pool does not create, are
+ * released once their target has been visited, so that recycling documents
+ * with aliases does not grow the pool.
+ *
+ * The pool relies on the reference count alone to know that it holds the
+ * last handle, so no \c std::weak_ptr to a node of the document may be
+ * kept (it could later be locked to a reused node), and the other threads
+ * that held handles must have released them before the call (e.g., joined,
+ * or synchronized with the caller).
+ *
+ * \param[in] root  The root of a document that is no longer needed
+ */
+void NodePool::recycle(NodePtr root)
+{
+    m_work.push_back(std::move(root));
+    while (!m_work.empty())
+    {
+        NodePtr handle = std::move(m_work.back());
+        m_work.pop_back();
+        if (!handle || handle.use_count() != 1)
+        {
+            continue;
+        }
+
+        // use_count() is a relaxed load: order the reads and writes of the
+        // threads that released their handles before the reuse of the node
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // The pool holds the only handle, so the node may be modified
+        auto node = std::const_pointer_cast<Node>(std::move(handle));
+        for (auto& item : node->m_items)
+        {
+            m_work.push_back(std::move(item));
+        }
+        for (auto& entry : node->m_entries)
+        {
+            m_work.push_back(std::move(entry.second));
+        }
+        m_work.push_back(std::move(node->m_target));
+        if (node->m_kind == Node::Kind::Alias)
+        {
+            continue;
+        }
+        node->clearForReuse();
+        m_kept[static_cast<std::size_t>(node->m_kind)].push_back(
+            std::move(node));
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Release the kept nodes
+ */
+void NodePool::clear()
+{
+    for (auto& kept : m_kept)
+    {
+        kept.clear();
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the number of kept nodes
+ */
+std::size_t NodePool::size() const
+{
+    std::size_t result = 0;
+    for (const auto& kept : m_kept)
+    {
+        result += kept.size();
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+// PRIVATE IMPLEMENTATION FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Take a kept node of the given kind, or create one
+ */
+auto NodePool::take(Node::Kind kind) -> MutableNodePtr
+{
+    auto& kept = m_kept[static_cast<std::size_t>(kind)];
+    if (kept.empty())
+    {
+        return MutableNodePtr(new Node(kind));
+    }
+    MutableNodePtr node = std::move(kept.back());
+    kept.pop_back();
+    return node;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/NodePool.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,95 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/NodePool.hh
+ * \brief  NodePool class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_NODEPOOL_HH
+#define YAYP_YAML_NODEPOOL_HH
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "Node.hh"
+
+namespace yayp
+{
+//===========================================================================//
+/*!
+ * \class NodePool
+ * \brief Creates nodes, reusing the nodes of recycled documents.
+ *
+ * The factories match those of Node, except for aliases and packed
+ * sequences, which are rare or allocate their items anyway.  A document that
+ * is no longer needed may be passed to recycle(), which keeps each of its
+ * nodes that is not shared with another document (or held by any other
+ * handle): the node, its reference count, and the capacity of its value and
+ * containers are then reused by the next node of the same kind.  Once the
+ * pool holds as many nodes as a document needs, building a document of the
+ * same shape again allocates nothing but the long mapping keys, which are
+ * moved into the entries.
+ *
+ * The collection factories exchange their containers with those of the
+ * reused node, leaving the argument empty but with the capacity of the
+ * recycled container, so that a builder may fill it again without
+ * allocating.
+ *
+ * Nodes handed out by the pool are as immutable as any other: the pool only
+ * reuses nodes to which it holds the last handle.  A recycled document must
+ * therefore not be observed through a \c std::weak_ptr, nor through handles
+ * that other threads release concurrently with recycle().
+ *
+ * \example src/yaml/tests/tstNodePool.cc
+ */
+//===========================================================================//
+
+class NodePool
+{
+  public:
+    // >>> FACTORIES
+    // Create a null node
+    NodePtr makeNull();
+
+    // Create a scalar node
+    NodePtr makeScalar(std::string_view value, bool plain = true);
+
+    // Create a sequence node, exchanging the items for spare capacity
+    NodePtr makeSequence(Node::Items& items);
+
+    // Create a mapping node, exchanging the containers for spare capacity
+    NodePtr makeMapping(Node::Entries& entries, Node::Items& merges);
+
+    // >>> RECYCLING
+    // Keep the nodes of a document that are not shared, for reuse
+    void recycle(NodePtr root);
+
+    // Release the kept nodes
+    void clear();
+
+    // Return the number of kept nodes
+    std::size_t size() const;
+
+  private:
+    using MutableNodePtr = std::shared_ptr<Node>;
+
+    // Take a kept node of the given kind, or create one
+    MutableNodePtr take(Node::Kind kind);
+
+  private:
+    // >>> DATA
+    std::array<std::vector<MutableNodePtr>, 5> m_kept;
+    std::vector<NodePtr>                       m_work;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_NODEPOOL_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/NodePool.hh
+//---------------------------------------------------------------------------//
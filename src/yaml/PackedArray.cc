@@ -0,0 +1,643 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/PackedArray.cc
+ * \brief  PackedArray class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "PackedArray.hh"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <memory>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define YAYP_PACKED_SSE2 1
+#endif
+
+#include "harness/DBC.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+//! Bitmaps of the characters of interest among 64 bytes
+struct Masks
+{
+    std::uint64_t close = 0; //!< Closing brackets
+    std::uint64_t comma = 0; //!< Commas
+    std::uint64_t other = 0; //!< Characters that cannot appear in the array
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return whether a character may appear in a packed flow sequence
+ */
+inline bool isArrayChar(char c)
+{
+    return (c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+'
+           || c == 'e' || c == 'E' || c == ' ' || c == ',' || c == ']';
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Classify 64 bytes
+ */
+inline Masks classify(const char* p)
+{
+    Masks masks;
+#ifdef YAYP_PACKED_SSE2
+    auto eq = [](__m128i bytes, char c) {
+        return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(c));
+    };
+    for (int i = 0; i < 4; ++i)
+    {
+        const __m128i bytes
+            = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        const __m128i close = eq(bytes, ']');
+        const __m128i comma = eq(bytes, ',');
+
+        __m128i allowed
+            = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('0' - 1)),
+                            _mm_cmplt_epi8(bytes, _mm_set1_epi8('9' + 1)));
+        allowed = _mm_or_si128(allowed, _mm_or_si128(close, comma));
+        allowed = _mm_or_si128(allowed, _mm_or_si128(eq(bytes, '.'),
+                                                     eq(bytes, '-')));
+        allowed = _mm_or_si128(allowed, _mm_or_si128(eq(bytes, '+'),
+                                                     eq(bytes, ' ')));
+        allowed = _mm_or_si128(allowed, _mm_or_si128(eq(bytes, 'e'),
+                                                     eq(bytes, 'E')));
+
+        auto bits = [](__m128i m) {
+            return static_cast<std::uint64_t>(
+                static_cast<std::uint16_t>(_mm_movemask_epi8(m)));
+        };
+        masks.close |= bits(close) << (16 * i);
+        masks.comma |= bits(comma) << (16 * i);
+        masks.other |= (~bits(allowed) & 0xFFFFu) << (16 * i);
+    }
+#else
+    for (int i = 0; i < 64; ++i)
+    {
+        masks.close |= static_cast<std::uint64_t>(p[i] == ']') << i;
+        masks.comma |= static_cast<std::uint64_t>(p[i] == ',') << i;
+        masks.other |= static_cast<std::uint64_t>(!isArrayChar(p[i])) << i;
+    }
+#endif
+    return masks;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the number of set bits
+ */
+inline int popcount(std::uint64_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(mask);
+#else
+    int count = 0;
+    for (; mask; mask &= mask - 1)
+    {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the index of the lowest set bit of a nonzero mask
+ */
+inline int lowestBit(std::uint64_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#else
+    int index = 0;
+    for (; !(mask & 1); mask >>= 1)
+    {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Examine a block of 64 bytes for the closing bracket
+ *
+ * \param[in]     masks   The classified block
+ * \param[in,out] commas  The number of commas, incremented by those in the
+ *                        block before the bracket
+ * \param[out]    bad     Whether another character precedes the bracket
+ * \return The index of the bracket in the block, or -1 if absent
+ */
+inline int examine(const Masks& masks, std::size_t& commas, bool& bad)
+{
+    const std::uint64_t before = masks.close
+                                     ? (masks.close & (0 - masks.close)) - 1
+                                     : ~std::uint64_t(0);
+    bad = (masks.other & before) != 0;
+    commas += static_cast<std::size_t>(popcount(masks.comma & before));
+    return masks.close ? lowestBit(masks.close) : -1;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Find the closing bracket of a flow sequence of numbers
+ *
+ * \param[in]  first   The text following the opening bracket
+ * \param[in]  last    The end of the input
+ * \param[out] commas  The number of commas before the bracket
+ * \return The closing bracket, or nullptr if it is missing or another
+ *         character precedes it
+ */
+const char* findClose(const char* first, const char* last, std::size_t& commas)
+{
+    commas   = 0;
+    bool bad = false;
+
+    const std::size_t size   = static_cast<std::size_t>(last - first);
+    std::size_t       offset = 0;
+    for (; offset + 64 <= size; offset += 64)
+    {
+        int index = examine(classify(first + offset), commas, bad);
+        if (bad)
+        {
+            return nullptr;
+        }
+        if (index >= 0)
+        {
+            return first + offset + index;
+        }
+    }
+
+    // Pad the remaining bytes to a full block (with characters that cannot
+    // appear in the array)
+    char tail[64] = {};
+    std::copy(first + offset, last, tail);
+    int index = examine(classify(tail), commas, bad);
+    if (bad || index < 0)
+    {
+        return nullptr;
+    }
+    return first + offset + index;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Write the canonical text of a float
+ *
+ * This is the shortest text that reads back as the same value, with \c .0
+ * appended to integral values (e.g., \c 2.5, \c 1.0, \c 1e+300).
+ *
+ * \param[in]  value   The value
+ * \param[out] buffer  Storage for the text
+ * \return The length of the text
+ */
+std::size_t formatFloat(double value, char (&buffer)[32])
+{
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer) - 2, value);
+    YAYP_CHECK(result.ec == std::errc());
+    const std::size_t length = static_cast<std::size_t>(result.ptr - buffer);
+    if (std::none_of(buffer, result.ptr, [](char c) {
+            return c == '.' || c == 'e' || c == 'n';
+        }))
+    {
+        buffer[length]     = '.';
+        buffer[length + 1] = '0';
+        return length + 2;
+    }
+    return length;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return whether the text of a number is that of a float
+ */
+inline bool isFloatText(const char* first, const char* last)
+{
+    return std::any_of(first, last, [](char c) {
+        return c == '.' || c == 'e' || c == 'E';
+    });
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Read an integer written in canonical form
+ */
+bool readInt(const char* first, const char* last, std::int64_t& value)
+{
+    // Reject a plus sign, leading zeros, and negative zero
+    const char* digits = first + (*first == '-');
+    if (*first == '+' || digits == last
+        || (*digits == '0' && (last - digits > 1 || digits != first)))
+    {
+        return false;
+    }
+    auto result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return whether the text of a float is known to be canonical
+ *
+ * A decimal with at most 15 significant digits reads back exactly, so when it
+ * has no superfluous zeros it is the shortest text of its value.  It is then
+ * canonical if fixed notation is also shorter than scientific notation.
+ * Other text is not necessarily non-canonical and must be formatted to tell.
+ */
+bool isShortFixed(const char* first, const char* last)
+{
+    first += (*first == '-');
+    const char* dot = std::find(first, last, '.');
+    if (dot == first || dot == last || dot + 1 == last
+        || (*first == '0' && dot - first > 1))
+    {
+        return false;
+    }
+    const auto int_digits  = dot - first;
+    const auto frac_digits = last - dot - 1;
+    for (const char* p = first; p != last; ++p)
+    {
+        if (p != dot && (*p < '0' || *p > '9'))
+        {
+            return false;
+        }
+    }
+
+    if (frac_digits == 1 && dot[1] == '0')
+    {
+        // Integral value, written as its digits followed by ".0"
+        if (int_digits > 15)
+        {
+            return false;
+        }
+        const char* sig = dot;
+        while (sig - first > 1 && sig[-1] == '0')
+        {
+            --sig;
+        }
+        const auto digits = sig - first;
+        return *first == '0' || int_digits < digits + (digits > 1) + 4;
+    }
+    if (last[-1] == '0')
+    {
+        return false;
+    }
+    if (*first != '0')
+    {
+        // Fixed notation is always shorter when there is a fraction
+        return int_digits + frac_digits <= 15;
+    }
+
+    // Value below one: count the zeros leading the significant digits
+    const char* sig = dot + 1;
+    while (*sig == '0')
+    {
+        ++sig;
+    }
+    const auto zeros  = sig - dot - 1;
+    const auto digits = last - sig;
+    return digits <= 15 && zeros < 90
+           && 2 + zeros + digits < digits + (digits > 1) + 4;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Read a float written in canonical form
+ */
+bool readFloat(const char* first, const char* last, double& value)
+{
+    auto result = std::from_chars(first, last, value);
+    if (result.ec != std::errc() || result.ptr != last)
+    {
+        return false;
+    }
+    if (isShortFixed(first, last))
+    {
+        return true;
+    }
+    char              buffer[32];
+    const std::size_t length = formatFloat(value, buffer);
+    return length == static_cast<std::size_t>(last - first)
+           && std::memcmp(buffer, first, length) == 0;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Read a boolean written in canonical form
+ */
+bool readBool(std::string_view text, bool& value)
+{
+    value = text == "true";
+    return value || text == "false";
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Read a flow sequence of numbers following its opening bracket
+ *
+ * \param[in]  first  The text following the opening bracket
+ * \param[in]  last   The end of the input
+ * \param[out] end    Past the closing bracket, if an array is returned
+ * \return The array, or an empty optional if the sequence is not packable
+ */
+std::optional<PackedArray>
+PackedArray::scanFlow(const char* first, const char* last, const char*& end)
+{
+    YAYP_REQUIRE(first <= last);
+
+    std::size_t commas = 0;
+    const char* close  = findClose(first, last, commas);
+    if (!close)
+    {
+        return std::nullopt;
+    }
+
+    auto skipSpaces = [](const char* p) {
+        while (*p == ' ')
+        {
+            ++p;
+        }
+        return p;
+    };
+    auto tokenEnd = [](const char* p) {
+        while (*p != ',' && *p != ' ' && *p != ']')
+        {
+            ++p;
+        }
+        return p;
+    };
+
+    // The first item decides the type
+    const char* p     = skipSpaces(first);
+    const char* token = p;
+    p                 = tokenEnd(p);
+    PackedArray array;
+    if (!array.appendItem(token, p))
+    {
+        return std::nullopt;
+    }
+    if (array.m_type == Type::Float)
+    {
+        array.m_floats.reserve(commas + 1);
+    }
+    else
+    {
+        array.m_ints.reserve(commas + 1);
+    }
+
+    while (true)
+    {
+        p = skipSpaces(p);
+        if (p == close)
+        {
+            break;
+        }
+        if (*p != ',')
+        {
+            return std::nullopt;
+        }
+        p     = skipSpaces(p + 1);
+        token = p;
+        p     = tokenEnd(p);
+        if (!array.appendItem(token, p))
+        {
+            return std::nullopt;
+        }
+    }
+
+    end = close + 1;
+    return array;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create an array of integers
+ */
+PackedArray PackedArray::fromValues(Span<const std::int64_t> values)
+{
+    PackedArray array;
+    array.m_type = Type::Int;
+    array.m_ints.assign(values.begin(), values.end());
+    return array;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create an array of floats
+ */
+PackedArray PackedArray::fromValues(Span<const double> values)
+{
+    PackedArray array;
+    array.m_type = Type::Float;
+    array.m_floats.assign(values.begin(), values.end());
+    return array;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create an array of booleans
+ */
+PackedArray PackedArray::fromValues(Span<const bool> values)
+{
+    PackedArray array;
+    array.m_type          = Type::Bool;
+    array.m_bool_capacity = values.size();
+    array.m_num_bools     = values.size();
+    array.m_bools         = std::make_unique<bool[]>(values.size());
+    std::copy(values.begin(), values.end(), array.m_bools.get());
+    return array;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Append an item written in canonical form
+ *
+ * The first item decides the type of the array.  Nothing is appended if the
+ * item is of another type or written differently from format().
+ *
+ * \param[in] text  The text of the item
+ * \return Whether the item was appended
+ */
+bool PackedArray::append(std::string_view text)
+{
+    return this->appendItem(text.data(), text.data() + text.size());
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a copy with an item replaced by one written in canonical form
+ *
+ * \param[in] index  The item index
+ * \param[in] text   The text of the new item
+ * \return The copy, or an empty optional if the item would not be appended
+ */
+std::optional<PackedArray>
+PackedArray::with(std::size_t index, std::string_view text) const
+{
+    YAYP_REQUIRE(index < this->size());
+
+    PackedArray item;
+    if (!item.append(text) || item.m_type != m_type)
+    {
+        return std::nullopt;
+    }
+    switch (m_type)
+    {
+        case Type::Int:
+        {
+            PackedArray result   = fromValues(this->ints());
+            result.m_ints[index] = item.m_ints.front();
+            return result;
+        }
+        case Type::Float:
+        {
+            PackedArray result     = fromValues(this->floats());
+            result.m_floats[index] = item.m_floats.front();
+            return result;
+        }
+        case Type::Bool:
+        {
+            PackedArray result    = fromValues(this->bools());
+            result.m_bools[index] = item.m_bools[0];
+            return result;
+        }
+    }
+    YAYP_NOT_REACHABLE();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the number of items
+ */
+std::size_t PackedArray::size() const
+{
+    switch (m_type)
+    {
+        case Type::Int:
+            return m_ints.size();
+        case Type::Float:
+            return m_floats.size();
+        case Type::Bool:
+            return m_num_bools;
+    }
+    YAYP_NOT_REACHABLE();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the canonical text of an item
+ *
+ * This is the text the item was read from.
+ *
+ * \param[in] index  The item index
+ */
+std::string PackedArray::format(std::size_t index) const
+{
+    YAYP_REQUIRE(index < this->size());
+
+    switch (m_type)
+    {
+        case Type::Int:
+            return std::to_string(m_ints[index]);
+        case Type::Float:
+        {
+            char buffer[32];
+            return std::string(buffer, formatFloat(m_floats[index], buffer));
+        }
+        case Type::Bool:
+            return m_bools[index] ? "true" : "false";
+    }
+    YAYP_NOT_REACHABLE();
+}
+
+//---------------------------------------------------------------------------//
+// PRIVATE IMPLEMENTATION FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Append an item of the array's type, or choose the type of the first
+ */
+bool PackedArray::appendItem(const char* first, const char* last)
+{
+    if (first == last)
+    {
+        return false;
+    }
+    const std::string_view text(first, static_cast<std::size_t>(last - first));
+    const bool             is_float = isFloatText(first, last);
+    if (this->size() == 0)
+    {
+        m_type = (text == "true" || text == "false") ? Type::Bool
+                 : is_float                            ? Type::Float
+                                                       : Type::Int;
+    }
+
+    switch (m_type)
+    {
+        case Type::Int:
+        {
+            std::int64_t value;
+            if (is_float || !readInt(first, last, value))
+            {
+                return false;
+            }
+            m_ints.push_back(value);
+            return true;
+        }
+        case Type::Float:
+        {
+            double value;
+            if (!is_float || !readFloat(first, last, value))
+            {
+                return false;
+            }
+            m_floats.push_back(value);
+            return true;
+        }
+        case Type::Bool:
+        {
+            bool value;
+            if (!readBool(text, value))
+            {
+                return false;
+            }
+            this->appendBool(value);
+            return true;
+        }
+    }
+    YAYP_NOT_REACHABLE();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Append a boolean, doubling the storage when it is full
+ */
+void PackedArray::appendBool(bool value)
+{
+    if (m_num_bools == m_bool_capacity)
+    {
+        m_bool_capacity = std::max<std::size_t>(16, 2 * m_bool_capacity);
+        auto storage    = std::make_unique<bool[]>(m_bool_capacity);
+        std::copy(m_bools.get(), m_bools.get() + m_num_bools, storage.get());
+        m_bools = std::move(storage);
+    }
+    m_bools[m_num_bools++] = value;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/PackedArray.cc
+//---------------------------------------------------------------------------//
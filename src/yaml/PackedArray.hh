@@ -0,0 +1,141 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/PackedArray.hh
+ * \brief  PackedArray class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_PACKEDARRAY_HH
+#define YAYP_YAML_PACKEDARRAY_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/Span.hh"
+
+namespace yayp
+{
+//===========================================================================//
+/*!
+ * \class PackedArray
+ * \brief The items of a homogeneous sequence of scalars, stored contiguously.
+ *
+ * scanFlow() reads a flow sequence such as \c [1.5, 2.25, -3.0] directly
+ * into a typed array, without tokenizing or allocating its items one by
+ * one.  It runs in two passes:
+ *  - the text is classified 64 bytes at a time (with SSE2 where available)
+ *    to find the closing bracket, count the commas, and check that only the
+ *    characters of numbers, commas and spaces precede the bracket;
+ *  - the items are then converted with \c std::from_chars into storage
+ *    reserved from the comma count.
+ *
+ * Only sequences whose items are all integers or all floats, written on a
+ * single line in their canonical form (see format()), are packed, so that
+ * each item can be reproduced exactly from its value.  Anything else (an
+ * empty or nested sequence, quotes, comments, line breaks, other scalars,
+ * or a number written differently, such as \c 1.50 or \c 0x10) makes
+ * scanFlow() return no array, and the caller falls back to the general
+ * scanner.
+ *
+ * append() packs the items of any other sequence one at a time, as
+ * DocumentBuilder does for block sequences.  It also accepts booleans
+ * (\c true and \c false), and likewise refuses an item that is not of the
+ * array's type or not in canonical form.  fromValues() creates an array
+ * from stored values (e.g., those of a Snapshot), and with() copies an array
+ * with one item replaced, so that an edited document keeps its items packed.
+ *
+ * The values are viewed through Span, so that a million floats are one
+ * contiguous \c double array:
+ * \code
+ *   if (const PackedArray* packed = node.packed();
+ *       packed && packed->type() == PackedArray::Type::Float)
+ *   {
+ *       Span<const double> values = packed->floats();
+ *   }
+ * \endcode
+ *
+ * \example src/yaml/tests/tstPackedArray.cc
+ */
+//===========================================================================//
+
+class PackedArray
+{
+  public:
+    //! Type of the items
+    enum class Type
+    {
+        Int,
+        Float,
+        Bool
+    };
+
+  public:
+    // Read a flow sequence of numbers following its opening bracket
+    static std::optional<PackedArray>
+    scanFlow(const char* first, const char* last, const char*& end);
+
+    //@{
+    // Create an array holding the given values
+    static PackedArray fromValues(Span<const std::int64_t> values);
+    static PackedArray fromValues(Span<const double> values);
+    static PackedArray fromValues(Span<const bool> values);
+    //@}
+
+    // Append an item written in canonical form
+    bool append(std::string_view text);
+
+    // Return a copy with an item replaced by one written in canonical form
+    std::optional<PackedArray>
+    with(std::size_t index, std::string_view text) const;
+
+    // Return the number of items
+    std::size_t size() const;
+
+    // Return the canonical text of an item
+    std::string format(std::size_t index) const;
+
+    // >>> ACCESSORS
+    //! Return the type of the items
+    Type type() const { return m_type; }
+
+    //! Return the items of an integer array
+    Span<const std::int64_t> ints() const { return m_ints; }
+
+    //! Return the items of a float array
+    Span<const double> floats() const { return m_floats; }
+
+    //! Return the items of a boolean array
+    Span<const bool> bools() const { return {m_bools.get(), m_num_bools}; }
+
+  private:
+    // Append an item of the array's type, or choose the type of the first
+    bool appendItem(const char* first, const char* last);
+
+    // Append a boolean
+    void appendBool(bool value);
+
+  private:
+    // >>> DATA
+    Type                      m_type = Type::Int;
+    std::vector<std::int64_t> m_ints;
+    std::vector<double>       m_floats;
+
+    //! Booleans, kept out of std::vector<bool> so that they are addressable
+    std::unique_ptr<bool[]> m_bools;
+    std::size_t             m_num_bools     = 0;
+    std::size_t             m_bool_capacity = 0;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_PACKEDARRAY_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/PackedArray.hh
+//---------------------------------------------------------------------------//
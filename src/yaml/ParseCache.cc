@@ -0,0 +1,112 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/ParseCache.cc
+ * \brief  ParseCache class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "ParseCache.hh"
+
+#include <utility>
+
+#include "core/Checksum.hh"
+#include "core/FileFunctions.hh"
+#include "core/MappedFile.hh"
+#include "harness/DBC.hh"
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor
+ *
+ * \param[in] directory  The cache directory, which must exist
+ * \param[in] limits     The resource limits used when parsing
+ */
+ParseCache::ParseCache(std::string directory, const ParseLimits& limits)
+    : m_directory(std::move(directory)), m_parser(limits)
+{
+    if (m_directory.empty())
+    {
+        m_directory = "./";
+    }
+    else if (m_directory.back() != '/')
+    {
+        m_directory += '/';
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Load a YAML file holding at most one document
+ *
+ * A cache entry that cannot be opened, fails validation, or was written from
+ * different text is counted as a miss and overwritten.  The new entry is
+ * opened with full validation, like a hit.  Errors reading or parsing the
+ * YAML file itself are thrown as by Parser::parse().
+ *
+ * \param[in] filename  The YAML file
+ * \return A snapshot of the parsed document
+ */
+Snapshot ParseCache::load(const std::string& filename)
+{
+    MappedFile          file(filename);
+    const std::uint64_t checksum = checksum64(file.view());
+    const std::string   entry    = this->entryPath(filename, checksum);
+
+    if (fileExists(entry))
+    {
+        try
+        {
+            Snapshot snapshot = Snapshot::open(entry);
+            if (snapshot.isCurrent(file.view()))
+            {
+                ++m_stats.hits;
+                return snapshot;
+            }
+        }
+        catch (const Exception&)
+        {
+            // Fall through and replace the entry
+        }
+        ++m_stats.invalid;
+    }
+
+    ++m_stats.misses;
+    NodePtr root = m_parser.parse(file.view());
+    saveSnapshot(entry, *root, file.view());
+
+    // The entry may since have been replaced by another process
+    return Snapshot::open(entry, Snapshot::Verify::Full);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the cache entry of a file with the given contents
+ *
+ * \param[in] filename  The YAML file
+ * \param[in] checksum  The checksum64() of its contents
+ */
+std::string ParseCache::entryPath(const std::string& filename,
+                                  std::uint64_t      checksum) const
+{
+    static const char digits[] = "0123456789abcdef";
+
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; --i, checksum >>= 4)
+    {
+        hex[i] = digits[checksum & 0xF];
+    }
+
+    FilePath path = splitFilepath(filename);
+    YAYP_CHECK(!path.basename.empty() || !path.extension.empty());
+    return m_directory + path.basename + '.' + hex + ".snap";
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/ParseCache.cc
+//---------------------------------------------------------------------------//
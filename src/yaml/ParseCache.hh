@@ -0,0 +1,88 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/ParseCache.hh
+ * \brief  ParseCache class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_PARSECACHE_HH
+#define YAYP_YAML_PARSECACHE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Parser.hh"
+#include "Snapshot.hh"
+
+namespace yayp
+{
+//===========================================================================//
+/*!
+ * \class ParseCache
+ * \brief Loads YAML files through an on-disk cache of snapshots.
+ *
+ * load() maps the file and computes the checksum64() of its contents, which
+ * names the cache entry \c <directory>/<basename>.<checksum>.snap.  When the
+ * entry exists and is a valid snapshot of the same text, it is mapped and
+ * returned without parsing (a hit).  Otherwise the file is parsed, a new
+ * snapshot is written to the cache, and that snapshot is returned (a miss).
+ * Because the entry is keyed by content, editing a file simply produces a
+ * new entry; stale entries are never read, but neither are they removed.
+ *
+ * Cache entries are replaced atomically, so several processes may share a
+ * cache directory.  The directory must exist.  A ParseCache itself is not
+ * safe to use from several threads at once.
+ *
+ * \example src/yaml/tests/tstParseCache.cc
+ */
+//===========================================================================//
+
+class ParseCache
+{
+  public:
+    //! Counters of cache lookups
+    struct Statistics
+    {
+        std::size_t hits    = 0; //!< Loads served from a snapshot
+        std::size_t misses  = 0; //!< Loads that parsed the file
+        std::size_t invalid = 0; //!< Misses that replaced a corrupt entry
+    };
+
+  public:
+    // Constructor
+    explicit ParseCache(std::string        directory,
+                        const ParseLimits& limits = ParseLimits());
+
+    // Load a YAML file holding at most one document
+    Snapshot load(const std::string& filename);
+
+    // Return the cache entry of a file with the given contents
+    std::string
+    entryPath(const std::string& filename, std::uint64_t checksum) const;
+
+    //! Reset the counters
+    void resetStatistics() { m_stats = Statistics(); }
+
+    // >>> ACCESSORS
+    //! Return the cache directory
+    const std::string& directory() const { return m_directory; }
+
+    //! Return the lookup counters
+    const Statistics& statistics() const { return m_stats; }
+
+  private:
+    // >>> DATA
+    std::string m_directory;
+    Parser      m_parser;
+    Statistics  m_stats;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_PARSECACHE_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/ParseCache.hh
+//---------------------------------------------------------------------------//
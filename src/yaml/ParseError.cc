@@ -0,0 +1,162 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/ParseError.cc
+ * \brief  ParseError helper function definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "ParseError.hh"
+
+#include <sstream>
+
+#include "harness/DBC.hh"
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a description of an error code
+ */
+const char* describe(ParseErrorCode code)
+{
+    switch (code)
+    {
+        case ParseErrorCode::None:
+            return "No error";
+        case ParseErrorCode::UnexpectedCharacter:
+            return "Unexpected character";
+        case ParseErrorCode::UnexpectedContent:
+            return "Unexpected content after a complete node";
+        case ParseErrorCode::ExpectedKey:
+            return "Expected a mapping key";
+        case ParseErrorCode::InvalidIndentation:
+            return "Indentation does not match any enclosing node";
+        case ParseErrorCode::TabIndentation:
+            return "Tabs may not be used for indentation";
+        case ParseErrorCode::UnterminatedQuote:
+            return "Quoted scalar is not terminated";
+        case ParseErrorCode::InvalidEscape:
+            return "Invalid escape sequence";
+        case ParseErrorCode::UnterminatedFlow:
+            return "Flow collection is not terminated";
+        case ParseErrorCode::InvalidBlockHeader:
+            return "Invalid block scalar header";
+        case ParseErrorCode::InvalidBlockIndentation:
+            return "Leading empty lines of a block scalar may not be more "
+                   "indented than its content";
+        case ParseErrorCode::InvalidAnchor:
+            return "Anchors and aliases must have a name";
+        case ParseErrorCode::UnsupportedFeature:
+            return "Unsupported YAML feature";
+        case ParseErrorCode::UndefinedAlias:
+            return "Alias refers to an undefined anchor";
+        case ParseErrorCode::NonScalarKey:
+            return "Only scalar mapping keys are supported";
+        case ParseErrorCode::InvalidMerge:
+            return "Merge key values must be mappings";
+        case ParseErrorCode::MultipleDocuments:
+            return "Expected a single document";
+        case ParseErrorCode::DocumentSizeLimit:
+        case ParseErrorCode::ScalarLengthLimit:
+        case ParseErrorCode::NodeCountLimit:
+        case ParseErrorCode::DepthLimit:
+        case ParseErrorCode::AliasDepthLimit:
+        case ParseErrorCode::AliasExpansionLimit:
+            return "Input exceeds a resource limit";
+    }
+    YAYP_NOT_REACHABLE();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the name of the resource of a limit error
+ *
+ * The names match LimitExceededException::resource().
+ *
+ * \return The resource name, or nullptr if the code is not a limit error
+ */
+const char* limitResource(ParseErrorCode code)
+{
+    switch (code)
+    {
+        case ParseErrorCode::DocumentSizeLimit:
+            return "document size";
+        case ParseErrorCode::ScalarLengthLimit:
+            return "scalar length";
+        case ParseErrorCode::NodeCountLimit:
+            return "node count";
+        case ParseErrorCode::DepthLimit:
+            return "nesting depth";
+        case ParseErrorCode::AliasDepthLimit:
+            return "alias depth";
+        case ParseErrorCode::AliasExpansionLimit:
+            return "alias expansions";
+        default:
+            return nullptr;
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Set the line and column of an error from its offset in the input
+ *
+ * Columns count UTF-8 characters rather than bytes.
+ *
+ * \param[in,out] error  The error, whose offset is within the input
+ * \param[in]     lines  The newline index of the parsed input
+ */
+void locate(ParseError& error, const NewlineIndex& lines)
+{
+    NewlineIndex::Location loc = lines.locate(error.offset);
+    error.line                 = loc.line;
+    error.column               = loc.column;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Format a message describing an error and its location
+ */
+std::string formatParseError(const ParseError& error)
+{
+    std::ostringstream stream;
+    stream << describe(error.code);
+    if (const char* resource = limitResource(error.code))
+    {
+        stream << " (" << resource << " " << error.limit << ")";
+    }
+    if (error.line > 0)
+    {
+        stream << " at line " << error.line << ", column " << error.column;
+    }
+    else
+    {
+        stream << " at offset " << error.offset;
+    }
+    return stream.str();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Throw the exception corresponding to an error
+ *
+ * Resource limit failures throw a LimitExceededException; all other failures
+ * throw an Exception with the formatted message.
+ */
+void throwParseError(const ParseError& error)
+{
+    YAYP_REQUIRE(error.code != ParseErrorCode::None);
+
+    if (const char* resource = limitResource(error.code))
+    {
+        throw LimitExceededException(resource, error.limit);
+    }
+    throw Exception(formatParseError(error));
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/ParseError.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,106 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/ParseError.hh
+ * \brief  ParseError declaration and helper functions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_PARSEERROR_HH
+#define YAYP_YAML_PARSEERROR_HH
+
+#include <cstddef>
+#include <string>
+
+#include "core/NewlineIndex.hh"
+#include "core/Result.hh"
+
+namespace yayp
+{
+//! Reasons a document fails to parse
+enum class ParseErrorCode
+{
+    None, //!< No error
+
+    // >>> SYNTAX
+    UnexpectedCharacter,     //!< Character not valid at this point
+    UnexpectedContent,       //!< Content after a complete node
+    ExpectedKey,             //!< Block mapping entry without a key
+    InvalidIndentation,      //!< Indentation matches no enclosing node
+    TabIndentation,          //!< Tab character used for indentation
+    UnterminatedQuote,       //!< Quoted scalar without closing quote
+    InvalidEscape,           //!< Invalid escape sequence in a quoted scalar
+    UnterminatedFlow,        //!< Flow collection without closing bracket
+    InvalidBlockHeader,      //!< Invalid block scalar header
+    InvalidBlockIndentation, //!< Leading empty lines over-indented
+    InvalidAnchor,           //!< Anchor or alias without a name
+    UnsupportedFeature,      //!< Valid YAML that is not supported
+
+    // >>> DOCUMENT STRUCTURE
+    UndefinedAlias,    //!< Alias of an anchor that is not defined
+    NonScalarKey,      //!< Mapping key that is not a scalar
+    InvalidMerge,      //!< Merge key value that is not a mapping
+    MultipleDocuments, //!< More than one document where one is expected
+
+    // >>> RESOURCE LIMITS
+    DocumentSizeLimit,  //!< ParseLimits::max_document_size exceeded
+    ScalarLengthLimit,  //!< ParseLimits::max_scalar_length exceeded
+    NodeCountLimit,     //!< ParseLimits::max_nodes exceeded
+    DepthLimit,         //!< ParseLimits::max_depth exceeded
+    AliasDepthLimit,    //!< AliasLimits::max_depth exceeded
+    AliasExpansionLimit //!< AliasLimits::max_expansions exceeded
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Location and cause of a parse failure.
+ *
+ * The offset is always set.  The line and column (both starting at 1, with
+ * the column counted in characters) are filled in by locate(), and are zero
+ * until then.
+ */
+struct ParseError
+{
+    //! Reason for the failure
+    ParseErrorCode code = ParseErrorCode::None;
+
+    //! Byte offset of the failure in the input
+    std::size_t offset = 0;
+
+    //! Line and column of the failure
+    std::size_t line   = 0;
+    std::size_t column = 0;
+
+    //! The exceeded limit, for resource limit failures
+    std::size_t limit = 0;
+};
+
+//! Value or parse error returned by the non-throwing parse functions
+template<class T>
+using ParseResult = Result<T, ParseError>;
+
+//---------------------------------------------------------------------------//
+// HELPER FUNCTIONS
+//---------------------------------------------------------------------------//
+// Return a description of an error code
+const char* describe(ParseErrorCode code);
+
+// Return the name of the resource of a limit error, or null
+const char* limitResource(ParseErrorCode code);
+
+// Set the line and column of an error from its offset in the input
+void locate(ParseError& error, const NewlineIndex& lines);
+
+// Format a message describing an error and its location
+std::string formatParseError(const ParseError& error);
+
+// Throw the exception corresponding to an error
+[[noreturn]] void throwParseError(const ParseError& error);
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_PARSEERROR_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/ParseError.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,246 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/Parser.cc
+ * \brief  Parser class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "Parser.hh"
+
+#include <utility>
+
+#include "harness/DBC.hh"
+#include "harness/Timing.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the offset of an item of a packed flow sequence
+ *
+ * \param[in] input  The YAML text
+ * \param[in] start  The offset of the opening bracket
+ * \param[in] index  The item index
+ */
+std::size_t
+packedItemOffset(std::string_view input, std::size_t start, std::size_t index)
+{
+    std::size_t offset = start + 1;
+    for (; index > 0; --index)
+    {
+        offset = input.find(',', offset) + 1;
+    }
+    return input.find_first_not_of(' ', offset);
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor
+ *
+ * \param[in] limits  The resource limits applied to each document
+ */
+Parser::Parser(const ParseLimits& limits)
+    : m_limits(limits), m_scanner({}, limits), m_builder(limits)
+{
+    m_scanner.enablePacking();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Parse a stream holding at most one document
+ *
+ * An empty stream is a null document.  Nothing is thrown for invalid input.
+ *
+ * \param[in] input  The YAML text
+ * \return The document, or the error
+ */
+ParseResult<NodePtr> Parser::tryParse(std::string_view input)
+{
+    ParseError error;
+    if (this->parseDocuments(input, true, error) != ParseErrorCode::None)
+    {
+        return error;
+    }
+    NodePtr root = m_documents.empty() ? Node::makeNull()
+                                       : std::move(m_documents.front());
+    m_documents.clear();
+    return root;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Parse all documents of a stream
+ *
+ * Nothing is thrown for invalid input.
+ *
+ * \param[in] input  The YAML text
+ * \return The documents in order, or the error
+ */
+ParseResult<std::vector<NodePtr>> Parser::tryParseAll(std::string_view input)
+{
+    ParseError error;
+    if (this->parseDocuments(input, false, error) != ParseErrorCode::None)
+    {
+        return error;
+    }
+    return std::move(m_documents);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Parse a stream holding at most one document, throwing on error
+ *
+ * \param[in] input  The YAML text
+ * \return The document
+ */
+NodePtr Parser::parse(std::string_view input)
+{
+    auto result = this->tryParse(input);
+    if (!result)
+    {
+        throwParseError(result.error());
+    }
+    return std::move(result).value();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Parse all documents of a stream, throwing on error
+ *
+ * \param[in] input  The YAML text
+ * \return The documents in order
+ */
+std::vector<NodePtr> Parser::parseAll(std::string_view input)
+{
+    auto result = this->tryParseAll(input);
+    if (!result)
+    {
+        throwParseError(result.error());
+    }
+    return std::move(result).value();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Reuse the nodes of a document that is no longer needed
+ *
+ * The nodes that are still held elsewhere (e.g., a subtree kept by the
+ * caller) are left alone, so recycling a document never invalidates a
+ * handle.  Weak pointers are not handles, however: see NodePool::recycle().
+ *
+ * \param[in] document  The root of a parsed document
+ */
+void Parser::recycle(NodePtr document)
+{
+    m_builder.recycle(std::move(document));
+}
+
+//---------------------------------------------------------------------------//
+// PRIVATE IMPLEMENTATION FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Parse documents into m_documents
+ *
+ * \param[in]  input   The YAML text
+ * \param[in]  single  Whether a second document is an error
+ * \param[out] error   The error, if any
+ * \return The error code, or ParseErrorCode::None on success
+ */
+ParseErrorCode
+Parser::parseDocuments(std::string_view input, bool single, ParseError& error)
+{
+    YAYP_TIMER(Build);
+
+    m_documents.clear();
+    m_builder.reset();
+    m_scanner.reset(input);
+    m_lines.reset(input);
+    if (auto code = m_builder.guard().tryCheckDocumentSize(input.size());
+        code != ParseErrorCode::None)
+    {
+        this->makeError(code, 0, m_builder.guard().limitFor(code), error);
+        return code;
+    }
+
+    Event       event;
+    std::size_t nodes = 0;
+    while (true)
+    {
+        if (!m_scanner.next(event))
+        {
+            const ParseError& scan_error = m_scanner.error();
+            this->makeError(
+                scan_error.code, scan_error.offset, scan_error.limit, error);
+            return error.code;
+        }
+
+        ParseErrorCode code = ParseErrorCode::None;
+        switch (event.type)
+        {
+            case EventType::StreamEnd:
+                return ParseErrorCode::None;
+            case EventType::DocumentStart:
+                if (single && !m_documents.empty())
+                {
+                    code = ParseErrorCode::MultipleDocuments;
+                }
+                break;
+            case EventType::DocumentEnd:
+                m_documents.push_back(m_builder.finish());
+                break;
+            default:
+                nodes = m_builder.guard().nodes();
+                code  = m_builder.tryEvent(event);
+        }
+        if (code != ParseErrorCode::None)
+        {
+            const std::size_t limit = limitResource(code)
+                                          ? m_builder.guard().limitFor(code)
+                                          : 0;
+
+            // Report the first item of a packed sequence beyond the limit
+            std::size_t offset = event.offset;
+            if (code == ParseErrorCode::NodeCountLimit
+                && event.type == EventType::PackedSequence
+                && nodes < m_limits.max_nodes)
+            {
+                offset = packedItemOffset(
+                    input, offset, m_limits.max_nodes - nodes - 1);
+            }
+            this->makeError(code, offset, limit, error);
+            return code;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Record an error and abandon the current document
+ */
+void Parser::makeError(ParseErrorCode code,
+                       std::size_t    offset,
+                       std::size_t    limit,
+                       ParseError&    error)
+{
+    m_builder.reset();
+    m_documents.clear();
+
+    error        = ParseError();
+    error.code   = code;
+    error.offset = offset;
+    error.limit  = limit;
+    locate(error, m_lines);
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/Parser.cc
+//---------------------------------------------------------------------------//
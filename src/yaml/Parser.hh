@@ -0,0 +1,113 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/Parser.hh
+ * \brief  Parser class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_PARSER_HH
+#define YAYP_YAML_PARSER_HH
+
+#include <string_view>
+#include <vector>
+
+#include "DocumentBuilder.hh"
+#include "Node.hh"
+#include "ParseError.hh"
+#include "ResourceGuard.hh"
+#include "Scanner.hh"
+
+#include "core/NewlineIndex.hh"
+
+namespace yayp
+{
+//===========================================================================//
+/*!
+ * \class Parser
+ * \brief Parses YAML text into document trees.
+ *
+ * The parser feeds the events of a Scanner to a DocumentBuilder.  Plain
+ * scalars \c ~, \c null, \c Null, \c NULL and empty values are null nodes.
+ * Flow sequences of numbers are read through the scanner's packed fast path
+ * and become packed sequence nodes (see PackedArray).
+ *
+ * The \c try functions never throw for invalid input or exceeded limits:
+ * they return a ParseError holding the error code, the byte offset, and the
+ * line and column of the failure.  parse() and parseAll() are thin wrappers
+ * that throw an Exception (or a LimitExceededException) with the formatted
+ * error instead.  A parser may be reused for any number of inputs.
+ *
+ * A parser keeps its buffers (the scanner's queue and scratch space, the
+ * builder's collections) from one input to the next.  Documents that are no
+ * longer needed may be handed back with recycle(), and their nodes are then
+ * reused for the next documents (see NodePool): parsing a stream of small
+ * messages of a steady shape this way does not allocate at all, except for
+ * packed sequences, anchors and long mapping keys.
+ *
+ * The line and column of an error are found with a NewlineIndex of the
+ * input, which is only built when an error occurs.  The index remains
+ * available through lines() until the next parse, so that tools can map
+ * other offsets (e.g., of Scanner events) to source locations without
+ * rescanning the input.
+ *
+ * \example src/yaml/tests/tstParser.cc
+ */
+//===========================================================================//
+
+class Parser
+{
+  public:
+    // Constructor
+    explicit Parser(const ParseLimits& limits = ParseLimits());
+
+    // Parse a stream holding at most one document
+    ParseResult<NodePtr> tryParse(std::string_view input);
+
+    // Parse all documents of a stream
+    ParseResult<std::vector<NodePtr>> tryParseAll(std::string_view input);
+
+    // Parse a stream holding at most one document, throwing on error
+    NodePtr parse(std::string_view input);
+
+    // Parse all documents of a stream, throwing on error
+    std::vector<NodePtr> parseAll(std::string_view input);
+
+    // Reuse the nodes of a document that is no longer needed
+    void recycle(NodePtr document);
+
+    // >>> ACCESSORS
+    //! Return the resource limits
+    const ParseLimits& limits() const { return m_limits; }
+
+    //! Return the newline index of the last input
+    const NewlineIndex& lines() const { return m_lines; }
+
+  private:
+    // >>> IMPLEMENTATION
+    // Parse documents, stopping after the first if only one is allowed
+    ParseErrorCode
+    parseDocuments(std::string_view input, bool single, ParseError& error);
+
+    // Record an error at the given offset
+    void makeError(ParseErrorCode code,
+                   std::size_t    offset,
+                   std::size_t    limit,
+                   ParseError&    error);
+
+  private:
+    // >>> DATA
+    ParseLimits          m_limits;
+    Scanner              m_scanner;
+    DocumentBuilder      m_builder;
+    NewlineIndex         m_lines;
+    std::vector<NodePtr> m_documents;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_PARSER_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/Parser.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,848 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/PathQuery.cc
+ * \brief  PathQuery class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "PathQuery.hh"
+
+#include <limits>
+#include <unordered_set>
+#include <utility>
+
+#include "DocumentBuilder.hh"
+#include "Scanner.hh"
+#include "harness/DBC.hh"
+#include "harness/Timing.hh"
+
+namespace
+{
+using yayp::DocumentBuilder;
+using yayp::Event;
+using yayp::EventType;
+using yayp::Node;
+using yayp::NodePtr;
+using yayp::ParseErrorCode;
+using yayp::PathQuery;
+using yayp::ScalarStyle;
+
+using KeySet = std::unordered_set<std::string_view>;
+
+//---------------------------------------------------------------------------//
+//! Return whether a character is a decimal digit
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+//---------------------------------------------------------------------------//
+//! Return whether an event starts a collection
+bool isStart(const Event& event)
+{
+    return event.type == EventType::MappingStart
+           || event.type == EventType::SequenceStart;
+}
+
+//---------------------------------------------------------------------------//
+//! Return whether an event ends a collection
+bool isEnd(const Event& event)
+{
+    return event.type == EventType::MappingEnd
+           || event.type == EventType::SequenceEnd;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Find the handle of the value of a key, including merged keys
+ */
+const NodePtr* findHandle(const Node& mapping, std::string_view key)
+{
+    for (const auto& entry : mapping.entries())
+    {
+        if (entry.first == key)
+        {
+            return &entry.second;
+        }
+    }
+    for (const auto& merge : mapping.merges())
+    {
+        if (const NodePtr* value = findHandle(merge->resolve(), key))
+        {
+            return value;
+        }
+    }
+    return nullptr;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Collect the merged entries of a mapping not hidden by other keys
+ */
+void collectMerged(const Node&                      mapping,
+                   KeySet&                          seen,
+                   std::vector<const Node::Entry*>& result)
+{
+    for (const auto& merge : mapping.merges())
+    {
+        const Node& merged = merge->resolve();
+        for (const auto& entry : merged.entries())
+        {
+            if (seen.insert(entry.first).second)
+            {
+                result.push_back(&entry);
+            }
+        }
+        collectMerged(merged, seen, result);
+    }
+}
+
+//===========================================================================//
+/*!
+ * \brief State of one run of a query over a stream.
+ *
+ * The functions that consume events return ParseErrorCode::None on success;
+ * on failure the error is recorded and every caller returns its code.
+ * Recursion only follows the steps of the query, so its depth is bounded by
+ * the length of the query rather than by the nesting of the input.
+ */
+class QueryRun
+{
+  public:
+    // Constructor
+    QueryRun(const PathQuery::Steps&    steps,
+             const PathQuery::Callback& callback,
+             const yayp::ParseLimits&   limits);
+
+    // Run the query over a stream
+    ParseErrorCode run(std::string_view input);
+
+    // >>> ACCESSORS
+    //! Return the number of matches
+    std::size_t matches() const { return m_matches; }
+
+    //! Return the error
+    const yayp::ParseError& error() const { return m_error; }
+
+  private:
+    // Read the next event
+    ParseErrorCode next(Event& event);
+
+    // Match the node starting with the given event
+    ParseErrorCode matchNode(const Event& first, std::size_t step);
+
+    // Match the entries of a streamed mapping
+    ParseErrorCode matchMapping(const Event& first, std::size_t step);
+
+    // Match the items of a streamed sequence
+    ParseErrorCode matchSequence(std::size_t step);
+
+    // Match a built subtree
+    void matchTree(const NodePtr& node, std::size_t step, std::size_t offset);
+
+    // Skip the node starting with the given event
+    ParseErrorCode skipNode(const Event& first);
+
+    // Skip the next node without reading its events
+    ParseErrorCode skipValue();
+
+    // Build the node starting with the given event
+    ParseErrorCode buildNode(const Event& first, NodePtr& node);
+
+    // Report a match
+    void emit(NodePtr node, std::size_t offset);
+
+    // Record an error
+    ParseErrorCode fail(ParseErrorCode code, std::size_t offset);
+
+  private:
+    const PathQuery::Steps&    m_steps;
+    const PathQuery::Callback& m_callback;
+    yayp::Scanner              m_scanner;
+    DocumentBuilder            m_builder;
+    std::size_t                m_document  = 0;
+    std::size_t                m_matches   = 0;
+    bool                       m_fast_skip = false;
+    yayp::ParseError           m_error;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor
+ */
+QueryRun::QueryRun(const PathQuery::Steps&    steps,
+                   const PathQuery::Callback& callback,
+                   const yayp::ParseLimits&   limits)
+    : m_steps(steps)
+    , m_callback(callback)
+    , m_scanner({}, limits)
+    , m_builder(limits)
+{
+    /* * */
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Run the query over a stream
+ */
+ParseErrorCode QueryRun::run(std::string_view input)
+{
+    m_scanner.reset(input);
+    m_fast_skip = input.find_first_of("&*") == std::string_view::npos;
+    if (auto code = m_builder.guard().tryCheckDocumentSize(input.size());
+        code != ParseErrorCode::None)
+    {
+        return this->fail(code, 0);
+    }
+
+    Event event;
+    while (true)
+    {
+        if (auto code = this->next(event); code != ParseErrorCode::None)
+        {
+            return code;
+        }
+        switch (event.type)
+        {
+            case EventType::StreamEnd:
+                return ParseErrorCode::None;
+            case EventType::DocumentStart:
+                break;
+            case EventType::DocumentEnd:
+                m_builder.reset();
+                ++m_document;
+                break;
+            default:
+                if (auto code = this->matchNode(event, 0);
+                    code != ParseErrorCode::None)
+                {
+                    return code;
+                }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Read the next event
+ */
+ParseErrorCode QueryRun::next(Event& event)
+{
+    if (!m_scanner.next(event))
+    {
+        m_error = m_scanner.error();
+        return m_error.code;
+    }
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Match the node starting with the given event
+ *
+ * Anchored nodes and aliases are built and matched as trees; other nodes are
+ * streamed until the query is complete, and only the matches are built.
+ */
+ParseErrorCode QueryRun::matchNode(const Event& first, std::size_t step)
+{
+    if (!first.anchor.empty() || first.type == EventType::Alias
+        || step == m_steps.size())
+    {
+        const std::size_t offset = first.offset;
+        NodePtr           node;
+        if (auto code = this->buildNode(first, node);
+            code != ParseErrorCode::None)
+        {
+            return code;
+        }
+        this->matchTree(node, step, offset);
+        return ParseErrorCode::None;
+    }
+
+    switch (first.type)
+    {
+        case EventType::MappingStart:
+            return this->matchMapping(first, step);
+        case EventType::SequenceStart:
+            return this->matchSequence(step);
+        default:
+            return ParseErrorCode::None;
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Match the entries of a streamed mapping
+ *
+ * Merged mappings are built as they are found, and searched once the
+ * mapping ends for a key that is not among its own entries (or, for a
+ * wildcard step, for every merged key that is not).  The values of repeated
+ * keys are skipped after the first.
+ */
+ParseErrorCode QueryRun::matchMapping(const Event& first, std::size_t step)
+{
+    using Kind = PathQuery::Step::Kind;
+
+    const PathQuery::Step&   current = m_steps[step];
+    const std::size_t        offset  = first.offset;
+    bool                     found   = false;
+    std::unordered_set<std::string> own_keys;
+    Node::Items              merges;
+
+    Event event;
+    while (true)
+    {
+        // Read the key
+        if (auto code = this->next(event); code != ParseErrorCode::None)
+        {
+            return code;
+        }
+        if (event.type == EventType::MappingEnd)
+        {
+            break;
+        }
+        std::string key;
+        bool        merge = false;
+        if (event.type == EventType::Scalar && event.anchor.empty())
+        {
+            key   = std::string(event.value);
+            merge = event.style == ScalarStyle::Plain && key == "<<";
+        }
+        else
+        {
+            const std::size_t key_offset = event.offset;
+            NodePtr           node;
+            if (auto code = this->buildNode(event, node);
+                code != ParseErrorCode::None)
+            {
+                return code;
+            }
+            if (node->resolvedKind() != Node::Kind::Scalar)
+            {
+                return this->fail(ParseErrorCode::NonScalarKey, key_offset);
+            }
+            key   = node->scalar();
+            merge = node->isPlain() && key == "<<";
+        }
+
+        // Match, merge or skip the value
+        bool match = false;
+        if (current.kind == Kind::Any)
+        {
+            match = !merge && own_keys.insert(key).second;
+        }
+        else if (current.kind == Kind::Key)
+        {
+            match = !found && current.key == key;
+        }
+        if (m_fast_skip && !match && !merge)
+        {
+            if (auto code = this->skipValue(); code != ParseErrorCode::None)
+            {
+                return code;
+            }
+            continue;
+        }
+        if (auto code = this->next(event); code != ParseErrorCode::None)
+        {
+            return code;
+        }
+        ParseErrorCode code = ParseErrorCode::None;
+        if (merge)
+        {
+            const std::size_t value_offset = event.offset;
+            NodePtr           node;
+            code = this->buildNode(event, node);
+            if (code != ParseErrorCode::None)
+            {
+                return code;
+            }
+            const Node& value = node->resolve();
+            if (value.kind() == Node::Kind::Mapping)
+            {
+                merges.push_back(std::move(node));
+            }
+            else if (value.kind() == Node::Kind::Sequence)
+            {
+                for (const auto& item : value.items())
+                {
+                    if (item->resolvedKind() != Node::Kind::Mapping)
+                    {
+                        return this->fail(ParseErrorCode::InvalidMerge,
+                                          value_offset);
+                    }
+                    merges.push_back(item);
+                }
+            }
+            else
+            {
+                return this->fail(ParseErrorCode::InvalidMerge, value_offset);
+            }
+        }
+        else if (match)
+        {
+            found = true;
+            code = this->matchNode(event, step + 1);
+        }
+        else
+        {
+            code = this->skipNode(event);
+        }
+        if (code != ParseErrorCode::None)
+        {
+            return code;
+        }
+    }
+
+    if (merges.empty() || (found && current.kind == Kind::Key)
+        || current.kind == Kind::Index)
+    {
+        return ParseErrorCode::None;
+    }
+
+    // Match the merged keys not overridden by the mapping's own entries
+    NodePtr merged = Node::makeMapping({}, std::move(merges));
+    if (current.kind == Kind::Key)
+    {
+        if (const NodePtr* value = findHandle(*merged, current.key))
+        {
+            this->matchTree(*value, step + 1, offset);
+        }
+        return ParseErrorCode::None;
+    }
+    KeySet                          seen(own_keys.begin(), own_keys.end());
+    std::vector<const Node::Entry*> entries;
+    collectMerged(*merged, seen, entries);
+    for (const Node::Entry* entry : entries)
+    {
+        this->matchTree(entry->second, step + 1, offset);
+    }
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Match the items of a streamed sequence
+ */
+ParseErrorCode QueryRun::matchSequence(std::size_t step)
+{
+    using Kind = PathQuery::Step::Kind;
+
+    const PathQuery::Step& current = m_steps[step];
+    std::size_t            index   = 0;
+
+    Event event;
+    while (true)
+    {
+        const bool match
+            = current.kind == Kind::Any
+              || (current.kind == Kind::Index && current.index == index);
+        if (m_fast_skip && !match)
+        {
+            if (!m_scanner.peek(event))
+            {
+                m_error = m_scanner.error();
+                return m_error.code;
+            }
+            if (event.type != EventType::SequenceEnd)
+            {
+                if (auto code = this->skipValue();
+                    code != ParseErrorCode::None)
+                {
+                    return code;
+                }
+                ++index;
+                continue;
+            }
+        }
+        if (auto code = this->next(event); code != ParseErrorCode::None)
+        {
+            return code;
+        }
+        if (event.type == EventType::SequenceEnd)
+        {
+            return ParseErrorCode::None;
+        }
+        ParseErrorCode code = match ? this->matchNode(event, step + 1)
+                                    : this->skipNode(event);
+        if (code != ParseErrorCode::None)
+        {
+            return code;
+        }
+        ++index;
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Match the remaining steps of a query against a built subtree
+ */
+void QueryRun::matchTree(const NodePtr& node,
+                         std::size_t    step,
+                         std::size_t    offset)
+{
+    using Kind = PathQuery::Step::Kind;
+
+    if (step == m_steps.size())
+    {
+        this->emit(node, offset);
+        return;
+    }
+
+    const PathQuery::Step& current = m_steps[step];
+    const Node&            value   = node->resolve();
+    if (value.kind() == Node::Kind::Mapping)
+    {
+        if (current.kind == Kind::Key)
+        {
+            if (const NodePtr* found = findHandle(value, current.key))
+            {
+                this->matchTree(*found, step + 1, offset);
+            }
+        }
+        else if (current.kind == Kind::Any)
+        {
+            KeySet seen;
+            for (const auto& entry : value.entries())
+            {
+                if (seen.insert(entry.first).second)
+                {
+                    this->matchTree(entry.second, step + 1, offset);
+                }
+            }
+            std::vector<const Node::Entry*> merged;
+            collectMerged(value, seen, merged);
+            for (const Node::Entry* entry : merged)
+            {
+                this->matchTree(entry->second, step + 1, offset);
+            }
+        }
+    }
+    else if (value.kind() == Node::Kind::Sequence)
+    {
+        if (current.kind == Kind::Any)
+        {
+            for (const auto& item : value.items())
+            {
+                this->matchTree(item, step + 1, offset);
+            }
+        }
+        else if (current.kind == Kind::Index && current.index < value.size())
+        {
+            this->matchTree(value.items()[current.index], step + 1, offset);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Skip the node starting with the given event
+ *
+ * Anchored nodes within the skipped node are still built, since later
+ * aliases may refer to them, and aliases are still checked, so that the
+ * errors and limits are those of parsing the whole stream.
+ */
+ParseErrorCode QueryRun::skipNode(const Event& first)
+{
+    YAYP_TIMER_DETAIL(Scan);
+
+    NodePtr anchored;
+    if (!first.anchor.empty() || first.type == EventType::Alias)
+    {
+        return this->buildNode(first, anchored);
+    }
+    if (!isStart(first))
+    {
+        return ParseErrorCode::None;
+    }
+
+    Event event;
+    for (std::size_t depth = 1; depth > 0;)
+    {
+        if (auto code = this->next(event); code != ParseErrorCode::None)
+        {
+            return code;
+        }
+        if (!event.anchor.empty() || event.type == EventType::Alias)
+        {
+            if (auto code = this->buildNode(event, anchored);
+                code != ParseErrorCode::None)
+            {
+                return code;
+            }
+        }
+        else if (isStart(event))
+        {
+            ++depth;
+        }
+        else if (isEnd(event))
+        {
+            --depth;
+        }
+    }
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Skip the next node without reading its events
+ *
+ * Only used for streams without anchors or aliases, so that no node
+ * skipped this way can be referred to (or refer to an undefined anchor).
+ */
+ParseErrorCode QueryRun::skipValue()
+{
+    YAYP_REQUIRE(m_fast_skip);
+
+    if (!m_scanner.skipValue())
+    {
+        m_error = m_scanner.error();
+        return m_error.code;
+    }
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build the node starting with the given event
+ */
+ParseErrorCode QueryRun::buildNode(const Event& first, NodePtr& node)
+{
+    auto add = [this](const Event& event) {
+        ParseErrorCode code = m_builder.tryEvent(event);
+        return code == ParseErrorCode::None ? code
+                                            : this->fail(code, event.offset);
+    };
+
+    if (auto code = add(first); code != ParseErrorCode::None)
+    {
+        return code;
+    }
+    if (isStart(first))
+    {
+        Event event;
+        for (std::size_t depth = 1; depth > 0;)
+        {
+            if (auto code = this->next(event); code != ParseErrorCode::None)
+            {
+                return code;
+            }
+            if (isStart(event))
+            {
+                ++depth;
+            }
+            else if (isEnd(event))
+            {
+                --depth;
+            }
+            if (auto code = add(event); code != ParseErrorCode::None)
+            {
+                return code;
+            }
+        }
+    }
+    node = m_builder.takeNode();
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Report a match
+ */
+void QueryRun::emit(NodePtr node, std::size_t offset)
+{
+    PathQuery::Match match;
+    match.document = m_document;
+    match.offset   = offset;
+    match.node     = std::move(node);
+    ++m_matches;
+    m_callback(match);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Record an error
+ */
+ParseErrorCode QueryRun::fail(ParseErrorCode code, std::size_t offset)
+{
+    m_error        = yayp::ParseError();
+    m_error.code   = code;
+    m_error.offset = offset;
+    m_error.limit  = yayp::limitResource(code)
+                         ? m_builder.guard().limitFor(code)
+                         : 0;
+    return code;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Compile a query expression
+ *
+ * \param[in] expression  The query, e.g. \c jobs[*].resources.memory
+ */
+PathQuery::PathQuery(std::string_view expression) : m_expression(expression)
+{
+    auto fail = [this](const char* reason) {
+        throw Exception("Invalid path query '" + m_expression + "': "
+                        + reason);
+    };
+
+    const std::size_t size = expression.size();
+    std::size_t       i    = 0;
+    while (i < size)
+    {
+        Step step;
+        if (expression[i] == '[')
+        {
+            ++i;
+            if (i < size && (expression[i] == '\'' || expression[i] == '"'))
+            {
+                const char  quote = expression[i++];
+                std::size_t end   = expression.find(quote, i);
+                if (end == std::string_view::npos)
+                {
+                    fail("unterminated quoted key");
+                }
+                step.key = std::string(expression.substr(i, end - i));
+                i        = end + 1;
+            }
+            else if (i < size && expression[i] == '*')
+            {
+                step.kind = Step::Kind::Any;
+                ++i;
+            }
+            else if (i < size && isDigit(expression[i]))
+            {
+                constexpr std::size_t max
+                    = std::numeric_limits<std::size_t>::max();
+
+                step.kind = Step::Kind::Index;
+                for (; i < size && isDigit(expression[i]); ++i)
+                {
+                    const auto digit
+                        = static_cast<std::size_t>(expression[i] - '0');
+                    if (step.index > (max - digit) / 10)
+                    {
+                        fail("index out of range");
+                    }
+                    step.index = step.index * 10 + digit;
+                }
+            }
+            else
+            {
+                fail("expected an index, '*' or a quoted key after '['");
+            }
+            if (i >= size || expression[i] != ']')
+            {
+                fail("expected ']'");
+            }
+            ++i;
+        }
+        else
+        {
+            if (!m_steps.empty())
+            {
+                if (expression[i] != '.')
+                {
+                    fail("expected '.' or '[' between steps");
+                }
+                ++i;
+            }
+            std::size_t end = std::min(expression.find_first_of(".[]", i),
+                                       size);
+            if (end == i)
+            {
+                fail("empty key");
+            }
+            step.key = std::string(expression.substr(i, end - i));
+            if (step.key == "*")
+            {
+                step.kind = Step::Kind::Any;
+                step.key.clear();
+            }
+            i = end;
+        }
+        m_steps.push_back(std::move(step));
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Pass each match in a stream to the callback
+ *
+ * Nothing is thrown for invalid input; matches found before an error have
+ * already been passed to the callback.
+ *
+ * \param[in] input     The YAML text
+ * \param[in] callback  The function receiving each match
+ * \param[in] limits    The resource limits applied to each document
+ * \return The number of matches, or the error
+ */
+ParseResult<std::size_t> PathQuery::tryRun(std::string_view   input,
+                                           const Callback&    callback,
+                                           const ParseLimits& limits) const
+{
+    YAYP_TIMER(Scan);
+
+    QueryRun query(m_steps, callback, limits);
+    if (query.run(input) != ParseErrorCode::None)
+    {
+        ParseError error = query.error();
+        locate(error, NewlineIndex(input));
+        return error;
+    }
+    return query.matches();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Pass each match in a stream to the callback, throwing on error
+ *
+ * \param[in] input     The YAML text
+ * \param[in] callback  The function receiving each match
+ * \param[in] limits    The resource limits applied to each document
+ * \return The number of matches
+ */
+std::size_t PathQuery::run(std::string_view   input,
+                           const Callback&    callback,
+                           const ParseLimits& limits) const
+{
+    auto result = this->tryRun(input, callback, limits);
+    if (!result)
+    {
+        throwParseError(result.error());
+    }
+    return result.value();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the matched nodes of a stream, throwing on error
+ *
+ * \param[in] input   The YAML text
+ * \param[in] limits  The resource limits applied to each document
+ * \return The matched nodes in order
+ */
+std::vector<NodePtr>
+PathQuery::select(std::string_view input, const ParseLimits& limits) const
+{
+    std::vector<NodePtr> nodes;
+    this->run(
+        input,
+        [&nodes](const Match& match) { nodes.push_back(match.node); },
+        limits);
+    return nodes;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/PathQuery.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,140 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/PathQuery.hh
+ * \brief  PathQuery class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_PATHQUERY_HH
+#define YAYP_YAML_PATHQUERY_HH
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Node.hh"
+#include "ParseError.hh"
+#include "ResourceGuard.hh"
+
+namespace yayp
+{
+//===========================================================================//
+/*!
+ * \class PathQuery
+ * \brief Selects the nodes at a path from a YAML stream without building
+ *        the documents.
+ *
+ * A query is compiled once from an expression of steps:
+ *  - \c name or \c .name selects the value of a mapping key (\c ['name'] or
+ *    \c ["name"] for keys holding \c . or brackets);
+ *  - \c [N] selects the sequence item with index N;
+ *  - \c * and \c [*] select every value of a mapping or sequence.
+ * For example, \c jobs[*].resources.memory selects the memory of every job
+ * in each document of a stream, and the empty expression selects each
+ * document.
+ *
+ * Running a query drives a Scanner directly and only builds the matched
+ * subtrees: the values of other keys and items are skipped, so the memory
+ * used is bounded by the nesting depth and the size of the matches rather
+ * than by the size of the documents.  In a stream without anchors or
+ * aliases (i.e., without \c & or \c * characters), values are skipped with
+ * Scanner::skipValue() without being tokenized, so that errors within them
+ * may go unreported; otherwise they are skipped event by event, with the
+ * errors and limits of a full parse.  YAML semantics are kept where they
+ * require a subtree to be built: anchored nodes are built (so that later
+ * aliases resolve), as are merged mappings, whose keys are then matched
+ * after the mapping's own keys.  Matches are reported in document order,
+ * except that matches found through a merged mapping follow those of the
+ * mapping's own entries.  As with Node::find(), only the first occurrence
+ * of a repeated key is matched, and the values of its duplicates are
+ * skipped.
+ *
+ * As with Parser, the \c try functions never throw for invalid input, and
+ * run() and select() throw the corresponding exception instead.  An invalid
+ * expression throws an Exception when the query is compiled.
+ *
+ * \example src/yaml/tests/tstPathQuery.cc
+ */
+//===========================================================================//
+
+class PathQuery
+{
+  public:
+    //! One step of a compiled query
+    struct Step
+    {
+        //! Kind of step
+        enum class Kind
+        {
+            Key,   //!< The value of the given key
+            Index, //!< The item with the given index
+            Any    //!< Every value of a mapping or sequence
+        };
+
+        Kind        kind = Kind::Key;
+        std::string key;
+        std::size_t index = 0;
+    };
+
+    //! A selected node
+    struct Match
+    {
+        //! Index of the document in the stream
+        std::size_t document = 0;
+
+        //! Byte offset of the node (or of the enclosing node that was built)
+        std::size_t offset = 0;
+
+        //! The node
+        NodePtr node;
+    };
+
+    //@{
+    //! Public type aliases
+    using Steps    = std::vector<Step>;
+    using Callback = std::function<void(const Match&)>;
+    //@}
+
+  public:
+    // Compile a query expression
+    explicit PathQuery(std::string_view expression);
+
+    // Pass each match in a stream to the callback, returning the count
+    ParseResult<std::size_t>
+    tryRun(std::string_view   input,
+           const Callback&    callback,
+           const ParseLimits& limits = ParseLimits()) const;
+
+    // Pass each match in a stream to the callback, throwing on error
+    std::size_t run(std::string_view   input,
+                    const Callback&    callback,
+                    const ParseLimits& limits = ParseLimits()) const;
+
+    // Return the matched nodes of a stream, throwing on error
+    std::vector<NodePtr>
+    select(std::string_view   input,
+           const ParseLimits& limits = ParseLimits()) const;
+
+    // >>> ACCESSORS
+    //! Return the expression
+    const std::string& expression() const { return m_expression; }
+
+    //! Return the compiled steps
+    const Steps& steps() const { return m_steps; }
+
+  private:
+    // >>> DATA
+    std::string m_expression;
+    Steps       m_steps;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_PATHQUERY_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/PathQuery.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,84 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/ResourceGuard.cc
+ * \brief  ResourceGuard class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "ResourceGuard.hh"
+
+#include "harness/DBC.hh"
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor
+ *
+ * \param[in] limits  The resource limits
+ */
+ResourceGuard::ResourceGuard(const ParseLimits& limits)
+    : m_limits(limits)
+{
+    /* * */
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Reset the counters for a new document
+ */
+void ResourceGuard::reset()
+{
+    m_depth = 0;
+    m_nodes = 0;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the limit reported by the given error code
+ *
+ * \param[in] code  A resource limit error code
+ */
+std::size_t ResourceGuard::limitFor(ParseErrorCode code) const
+{
+    switch (code)
+    {
+        case ParseErrorCode::DocumentSizeLimit:
+            return m_limits.max_document_size;
+        case ParseErrorCode::ScalarLengthLimit:
+            return m_limits.max_scalar_length;
+        case ParseErrorCode::NodeCountLimit:
+            return m_limits.max_nodes;
+        case ParseErrorCode::DepthLimit:
+            return m_limits.max_depth;
+        case ParseErrorCode::AliasDepthLimit:
+            return m_limits.aliases.max_depth;
+        case ParseErrorCode::AliasExpansionLimit:
+            return m_limits.aliases.max_expansions;
+        default:
+            YAYP_NOT_REACHABLE();
+    }
+}
+
+//---------------------------------------------------------------------------//
+// PRIVATE IMPLEMENTATION FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Throw the exception for an exceeded limit
+ *
+ * This is kept out of line so that the inlined checks remain small.
+ *
+ * \param[in] code  The error code of the exceeded limit
+ */
+void ResourceGuard::exceeded(ParseErrorCode code) const
+{
+    throw LimitExceededException(limitResource(code), this->limitFor(code));
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/ResourceGuard.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,139 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/ResourceGuard.hh
+ * \brief  ResourceGuard class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_RESOURCEGUARD_HH
+#define YAYP_YAML_RESOURCEGUARD_HH
+
+#include <cstddef>
+#include <limits>
+
+#include "AnchorTable.hh"
+#include "ParseError.hh"
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Resource limits applied while parsing a document.
+ *
+ * The defaults only bound the resources that protect the parser itself (the
+ * nesting depth, which determines stack usage, and alias expansion).
+ * Services parsing untrusted input should also set the remaining limits.
+ */
+struct ParseLimits
+{
+    //! Maximum nesting depth of collections
+    std::size_t max_depth = 1000;
+
+    //! Maximum size of the input document in bytes
+    std::size_t max_document_size = std::numeric_limits<std::size_t>::max();
+
+    //! Maximum length of a single scalar in bytes
+    std::size_t max_scalar_length = std::numeric_limits<std::size_t>::max();
+
+    //! Maximum number of nodes in a document
+    std::size_t max_nodes = std::numeric_limits<std::size_t>::max();
+
+    //! Limits on alias expansion
+    AliasLimits aliases;
+};
+
+//===========================================================================//
+/*!
+ * \class ResourceGuard
+ * \brief Tracks the resources used while parsing a document against the
+ *        ParseLimits.
+ *
+ * Each check is a single inlined comparison marked unlikely to fail, so that
+ * the checks may be left in the parser's inner loop.  The \c try functions
+ * return the ParseErrorCode of an exceeded limit (ParseErrorCode::None
+ * otherwise) and never throw; the remaining functions are thin wrappers that
+ * throw a LimitExceededException from an out-of-line function instead.
+ *
+ * \example src/yaml/tests/tstResourceGuard.cc
+ */
+//===========================================================================//
+
+class ResourceGuard
+{
+  public:
+    // Constructor
+    explicit ResourceGuard(const ParseLimits& limits = ParseLimits());
+
+    // >>> NON-THROWING CHECKS
+    // Check the size of the input document
+    inline ParseErrorCode tryCheckDocumentSize(std::size_t size) const;
+
+    // Check the length of a scalar
+    inline ParseErrorCode tryCheckScalarLength(std::size_t length) const;
+
+    // Count a node
+    inline ParseErrorCode tryAddNode();
+
+    // Count several nodes
+    inline ParseErrorCode tryAddNodes(std::size_t count);
+
+    // Enter a nested collection
+    inline ParseErrorCode tryEnter();
+
+    // >>> THROWING CHECKS
+    // Check the size of the input document
+    inline void checkDocumentSize(std::size_t size) const;
+
+    // Check the length of a scalar
+    inline void checkScalarLength(std::size_t length) const;
+
+    // Count a node
+    inline void addNode();
+
+    // Enter a nested collection
+    inline void enter();
+
+    // Leave a nested collection
+    inline void leave();
+
+    // Reset the counters for a new document
+    void reset();
+
+    // Return the limit reported by the given error code
+    std::size_t limitFor(ParseErrorCode code) const;
+
+    // >>> ACCESSORS
+    //! Return the limits
+    const ParseLimits& limits() const { return m_limits; }
+
+    //! Return the current nesting depth
+    std::size_t depth() const { return m_depth; }
+
+    //! Return the number of nodes counted
+    std::size_t nodes() const { return m_nodes; }
+
+  private:
+    // >>> IMPLEMENTATION
+    // Throw the exception for an exceeded limit
+    [[noreturn]] void exceeded(ParseErrorCode code) const;
+
+  private:
+    // >>> DATA
+    ParseLimits m_limits;
+    std::size_t m_depth = 0;
+    std::size_t m_nodes = 0;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// INLINE DEFINITIONS
+//---------------------------------------------------------------------------//
+#include "ResourceGuard.i.hh"
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_RESOURCEGUARD_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/ResourceGuard.hh
+//---------------------------------------------------------------------------//
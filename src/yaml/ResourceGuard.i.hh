@@ -0,0 +1,167 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/ResourceGuard.i.hh
+ * \brief  ResourceGuard inline method definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_RESOURCEGUARD_I_HH
+#define YAYP_YAML_RESOURCEGUARD_I_HH
+
+#include "harness/DBC.hh"
+#include "harness/Macros.hh"
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+// NON-THROWING CHECKS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Check the size of the input document
+ *
+ * \param[in] size  The document size in bytes
+ */
+ParseErrorCode ResourceGuard::tryCheckDocumentSize(std::size_t size) const
+{
+    if (YAYP_UNLIKELY(size > m_limits.max_document_size))
+    {
+        return ParseErrorCode::DocumentSizeLimit;
+    }
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Check the length of a scalar
+ *
+ * \param[in] length  The scalar length in bytes
+ */
+ParseErrorCode ResourceGuard::tryCheckScalarLength(std::size_t length) const
+{
+    if (YAYP_UNLIKELY(length > m_limits.max_scalar_length))
+    {
+        return ParseErrorCode::ScalarLengthLimit;
+    }
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Count a node
+ */
+ParseErrorCode ResourceGuard::tryAddNode()
+{
+    if (YAYP_UNLIKELY(m_nodes == m_limits.max_nodes))
+    {
+        return ParseErrorCode::NodeCountLimit;
+    }
+    ++m_nodes;
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Count several nodes
+ *
+ * \param[in] count  The number of nodes
+ */
+ParseErrorCode ResourceGuard::tryAddNodes(std::size_t count)
+{
+    if (YAYP_UNLIKELY(count > m_limits.max_nodes - m_nodes))
+    {
+        return ParseErrorCode::NodeCountLimit;
+    }
+    m_nodes += count;
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Enter a nested collection
+ */
+ParseErrorCode ResourceGuard::tryEnter()
+{
+    if (YAYP_UNLIKELY(m_depth == m_limits.max_depth))
+    {
+        return ParseErrorCode::DepthLimit;
+    }
+    ++m_depth;
+    return ParseErrorCode::None;
+}
+
+//---------------------------------------------------------------------------//
+// THROWING CHECKS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Check the size of the input document
+ *
+ * \param[in] size  The document size in bytes
+ */
+void ResourceGuard::checkDocumentSize(std::size_t size) const
+{
+    ParseErrorCode code = this->tryCheckDocumentSize(size);
+    if (YAYP_UNLIKELY(code != ParseErrorCode::None))
+    {
+        this->exceeded(code);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Check the length of a scalar
+ *
+ * \param[in] length  The scalar length in bytes
+ */
+void ResourceGuard::checkScalarLength(std::size_t length) const
+{
+    ParseErrorCode code = this->tryCheckScalarLength(length);
+    if (YAYP_UNLIKELY(code != ParseErrorCode::None))
+    {
+        this->exceeded(code);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Count a node
+ */
+void ResourceGuard::addNode()
+{
+    ParseErrorCode code = this->tryAddNode();
+    if (YAYP_UNLIKELY(code != ParseErrorCode::None))
+    {
+        this->exceeded(code);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Enter a nested collection
+ */
+void ResourceGuard::enter()
+{
+    ParseErrorCode code = this->tryEnter();
+    if (YAYP_UNLIKELY(code != ParseErrorCode::None))
+    {
+        this->exceeded(code);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Leave a nested collection
+ */
+void ResourceGuard::leave()
+{
+    YAYP_REQUIRE(m_depth > 0);
+    --m_depth;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+#endif // YAYP_YAML_RESOURCEGUARD_I_HH
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/ResourceGuard.i.hh
+//---------------------------------------------------------------------------//
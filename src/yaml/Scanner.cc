@@ -0,0 +1,1622 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/Scanner.cc
+ * \brief  Scanner class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "Scanner.hh"
+
+#include <cstring>
+
+#include "harness/DBC.hh"
+#include "harness/Timing.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+//! Return whether the character is a space or tab
+inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+//---------------------------------------------------------------------------//
+//! Return whether the character begins a line break
+inline bool isBreak(char c)
+{
+    return c == '\n' || c == '\r';
+}
+
+//---------------------------------------------------------------------------//
+//! Return whether the character is a flow indicator
+inline bool isFlowIndicator(char c)
+{
+    return c == ',' || c == '[' || c == ']' || c == '{' || c == '}';
+}
+
+//---------------------------------------------------------------------------//
+//! Return whether the position is at the end of a line
+inline bool atLineEnd(const char* p, const char* end)
+{
+    return p == end || isBreak(*p);
+}
+
+//---------------------------------------------------------------------------//
+//! Return whether the position is followed by whitespace or the line end
+inline bool followedBySpace(const char* p, const char* end)
+{
+    return p + 1 == end || isBlank(p[1]) || isBreak(p[1]);
+}
+
+//---------------------------------------------------------------------------//
+//! Return whether the position begins a block sequence entry
+inline bool isEntry(const char* p, const char* end)
+{
+    return p != end && *p == '-' && followedBySpace(p, end);
+}
+
+//---------------------------------------------------------------------------//
+//! Return whether the position holds the closing bracket of a flow collection
+inline bool isClosingBracket(const char* p, const char* end)
+{
+    return p != end && (*p == ']' || *p == '}');
+}
+
+//---------------------------------------------------------------------------//
+//! Return whether the line begins with the given document marker
+bool isMarker(const char* line, const char* end, const char* marker)
+{
+    return end - line >= 3 && std::strncmp(line, marker, 3) == 0
+           && (line + 3 == end || isBlank(line[3]) || isBreak(line[3]));
+}
+
+//---------------------------------------------------------------------------//
+//! Return the value of a hexadecimal digit, or -1
+int hexValue(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+//---------------------------------------------------------------------------//
+//! Append the UTF-8 encoding of a code point
+void appendUtf8(std::string& out, unsigned long cp)
+{
+    if (cp < 0x80)
+    {
+        out += static_cast<char>(cp);
+    }
+    else if (cp < 0x800)
+    {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000)
+    {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else
+    {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+//---------------------------------------------------------------------------//
+//! Remove trailing spaces and tabs
+void trimBlanks(std::string& s)
+{
+    while (!s.empty() && isBlank(s.back()))
+    {
+        s.pop_back();
+    }
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor
+ *
+ * \param[in] input   The input, which must outlive the scanner
+ * \param[in] limits  The resource limits (only the nesting depth is used)
+ */
+Scanner::Scanner(std::string_view input, const ParseLimits& limits)
+    : m_max_depth(limits.max_depth)
+{
+    this->reset(input);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Restart scanning with a new input
+ *
+ * Buffers are retained for reuse.
+ *
+ * \param[in] input  The input, which must outlive the scanner
+ */
+void Scanner::reset(std::string_view input)
+{
+    m_begin = input.data();
+    m_end   = m_begin + input.size();
+    m_cur   = m_begin;
+
+    // Skip a UTF-8 byte order mark
+    if (input.size() >= 3 && std::strncmp(m_begin, "\xEF\xBB\xBF", 3) == 0)
+    {
+        m_cur += 3;
+    }
+    m_line_start = m_cur;
+
+    m_state = State::Stream;
+    m_blocks.clear();
+    m_flows.clear();
+    m_expect_value   = false;
+    m_value_indent   = -1;
+    m_pending_anchor = {};
+    m_queue.clear();
+    m_head         = 0;
+    m_scratch_used = 0;
+    m_error        = ParseError();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Read the next event
+ *
+ * After the stream end, further calls return the stream end again.
+ *
+ * \param[out] event  The next event
+ * \return false if the input is invalid, in which case error() is set
+ */
+bool Scanner::next(Event& event)
+{
+    if (m_head == m_queue.size() && !this->fill())
+    {
+        return false;
+    }
+    event = m_queue[m_head++];
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the next event without consuming it
+ *
+ * \param[out] event  The next event
+ * \return false if the input is invalid, in which case error() is set
+ */
+bool Scanner::peek(Event& event)
+{
+    if (m_head == m_queue.size() && !this->fill())
+    {
+        return false;
+    }
+    event = m_queue[m_head];
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Skip the next node without reading its events
+ *
+ * Must be called where a node is expected, e.g. after reading a mapping key
+ * or where a sequence item may follow (see peek()).  A block node is
+ * skipped along with every following line that is more indented than its
+ * parent (or, for a sequence, that is an entry at its own indentation), and
+ * a flow collection up to its matching closing bracket.  Only the part of
+ * the node already scanned is tokenized.
+ *
+ * \return false if the input is invalid, in which case error() is set
+ */
+bool Scanner::skipValue()
+{
+    YAYP_TIMER_DETAIL(Scan);
+
+    // A block node on the following lines, after "key:" or "-"
+    if (m_head == m_queue.size() && m_state == State::Document
+        && m_flows.empty() && m_expect_value)
+    {
+        const bool entries = !m_blocks.empty() && m_blocks.back().mapping
+                             && m_blocks.back().indent == m_value_indent;
+        m_expect_value   = false;
+        m_pending_anchor = {};
+        this->skipLines(m_value_indent, entries);
+        return true;
+    }
+
+    Event event;
+    if (!this->next(event))
+    {
+        return false;
+    }
+    YAYP_REQUIRE(event.type == EventType::Scalar
+                 || event.type == EventType::Alias
+                 || event.type == EventType::PackedSequence
+                 || event.type == EventType::MappingStart
+                 || event.type == EventType::SequenceStart);
+    if (event.type != EventType::MappingStart
+        && event.type != EventType::SequenceStart)
+    {
+        return true;
+    }
+
+    // A flow collection, which is the last event scanned when it opens
+    if (m_head == m_queue.size() && !m_flows.empty())
+    {
+        return this->skipFlow();
+    }
+
+    // A block collection begun on a line that has been scanned: drop what
+    // was scanned of it and skip the lines within it
+    const bool  mapping = event.type == EventType::MappingStart;
+    const char* start   = m_begin + event.offset;
+    const char* line    = start;
+    while (line != m_begin && !isBreak(line[-1]))
+    {
+        --line;
+    }
+    const int indent = static_cast<int>(start - line);
+
+    auto iter = m_blocks.end();
+    while (iter != m_blocks.begin()
+           && ((iter - 1)->indent != indent || (iter - 1)->mapping != mapping))
+    {
+        --iter;
+    }
+    YAYP_CHECK(iter != m_blocks.begin());
+    m_blocks.erase(iter - 1, m_blocks.end());
+    m_flows.clear();
+    m_head           = m_queue.size();
+    m_expect_value   = false;
+    m_pending_anchor = {};
+
+    if (m_cur != m_line_start)
+    {
+        while (!atLineEnd(m_cur, m_end))
+        {
+            ++m_cur;
+        }
+        this->consumeBreak();
+    }
+    this->skipLines(mapping ? indent - 1 : indent, !mapping);
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Report flow sequences of numbers as packed sequences
+ *
+ * Packing is disabled by default, so that every item is reported as a
+ * scalar event.
+ */
+void Scanner::enablePacking(bool enable)
+{
+    m_packing = enable;
+}
+
+//---------------------------------------------------------------------------//
+// PRIVATE IMPLEMENTATION FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan until at least one event is queued
+ */
+bool Scanner::fill()
+{
+    YAYP_TIMER_FINE(Scan);
+
+    m_queue.clear();
+    m_head         = 0;
+    m_scratch_used = 0;
+    while (m_queue.empty())
+    {
+        bool ok = false;
+        switch (m_state)
+        {
+            case State::Stream:
+                ok = this->scanStream();
+                break;
+            case State::Document:
+                ok = m_flows.empty() ? this->scanBlock() : this->scanFlow();
+                break;
+            case State::End:
+                this->push(EventType::StreamEnd, m_end);
+                ok = true;
+                break;
+            case State::Failed:
+                break;
+        }
+        if (!ok)
+        {
+            // Return the events scanned before the error first
+            return !m_queue.empty();
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan between documents, up to the start of the next document
+ */
+bool Scanner::scanStream()
+{
+    while (m_cur != m_end)
+    {
+        // Skip empty lines, comments and directives
+        const char* p = m_cur;
+        while (p != m_end && isBlank(*p))
+        {
+            ++p;
+        }
+        if (atLineEnd(p, m_end) || *p == '#' || (p == m_cur && *p == '%'))
+        {
+            m_cur = p;
+            while (!atLineEnd(m_cur, m_end))
+            {
+                ++m_cur;
+            }
+            this->consumeBreak();
+            continue;
+        }
+
+        if (m_cur == p && isMarker(m_cur, m_end, "..."))
+        {
+            // Document end marker without a document
+            m_cur += 3;
+            if (!this->finishLine())
+            {
+                return false;
+            }
+            continue;
+        }
+
+        if (m_cur == p && isMarker(m_cur, m_end, "---"))
+        {
+            // Explicit document, which may begin on the marker line
+            this->beginDocument(m_cur);
+            m_cur += 3;
+            this->skipBlanks();
+            if (atLineEnd(m_cur, m_end) || *m_cur == '#')
+            {
+                return this->finishLine();
+            }
+            m_expect_value = false;
+            return this->scanNode(Context::Value, -1);
+        }
+
+        // Implicit document
+        this->beginDocument(m_cur);
+        return true;
+    }
+
+    this->push(EventType::StreamEnd, m_end);
+    m_state = State::End;
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan the next non-empty line of a block context
+ */
+bool Scanner::scanBlock()
+{
+    YAYP_CHECK(m_cur == m_line_start);
+
+    // Skip empty lines and comments
+    const char* content = nullptr;
+    while (m_cur != m_end)
+    {
+        const char* p = m_cur;
+        while (p != m_end && *p == ' ')
+        {
+            ++p;
+        }
+        const char* q = p;
+        while (q != m_end && isBlank(*q))
+        {
+            ++q;
+        }
+        if (!atLineEnd(q, m_end) && *q != '#')
+        {
+            if (q != p)
+            {
+                return this->fail(ParseErrorCode::TabIndentation, p);
+            }
+            content = p;
+            break;
+        }
+        m_cur = q;
+        while (!atLineEnd(m_cur, m_end))
+        {
+            ++m_cur;
+        }
+        this->consumeBreak();
+    }
+    if (!content)
+    {
+        this->endDocument(m_end);
+        return true;
+    }
+
+    // Document markers end the document
+    const int indent = static_cast<int>(content - m_cur);
+    if (indent == 0
+        && (isMarker(m_cur, m_end, "---") || isMarker(m_cur, m_end, "...")))
+    {
+        this->endDocument(m_cur);
+        if (*m_cur == '.')
+        {
+            m_cur += 3;
+            return this->finishLine();
+        }
+        return true;
+    }
+    m_cur = content;
+
+    // A node expected after "key:" or "- " on a preceding line
+    const bool entry = isEntry(m_cur, m_end);
+    if (m_expect_value)
+    {
+        m_expect_value = false;
+        if (indent > m_value_indent)
+        {
+            return this->scanNode(Context::Any, m_value_indent);
+        }
+        if (indent == m_value_indent && entry && !m_blocks.empty()
+            && m_blocks.back().mapping && m_blocks.back().indent == indent)
+        {
+            // Sequence at the indentation of its mapping key
+            return this->scanNode(Context::Any, indent);
+        }
+        this->pushEmpty(m_cur);
+    }
+
+    // Close the collections that this line is outside of
+    while (!m_blocks.empty()
+           && (m_blocks.back().indent > indent
+               || (m_blocks.back().indentless
+                   && m_blocks.back().indent == indent && !entry)))
+    {
+        this->popBlock(m_cur);
+    }
+    if (m_blocks.empty())
+    {
+        return this->fail(ParseErrorCode::UnexpectedContent, m_cur);
+    }
+    const Block& top = m_blocks.back();
+    if (top.indent != indent)
+    {
+        return this->fail(ParseErrorCode::InvalidIndentation, m_cur);
+    }
+    if (top.mapping)
+    {
+        return this->scanNode(Context::Key, indent);
+    }
+    if (!entry)
+    {
+        return this->fail(ParseErrorCode::UnexpectedContent, m_cur);
+    }
+    return this->scanNode(Context::Any, indent);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan a node in block context
+ *
+ * \param[in] context        Where the node appears
+ * \param[in] parent_indent  Indentation of the enclosing block collection
+ */
+bool Scanner::scanNode(Context context, int parent_indent)
+{
+    const char* start = m_cur;
+    const int   col   = this->column();
+
+    // >>> BLOCK SEQUENCE ENTRY
+    if (isEntry(m_cur, m_end))
+    {
+        if (context != Context::Any)
+        {
+            return this->fail(context == Context::Key
+                                  ? ParseErrorCode::ExpectedKey
+                                  : ParseErrorCode::UnexpectedCharacter,
+                              m_cur);
+        }
+        bool continues = !m_blocks.empty() && !m_blocks.back().mapping
+                         && m_blocks.back().indent == col;
+        if (!continues)
+        {
+            bool indentless = !m_blocks.empty() && m_blocks.back().mapping
+                              && m_blocks.back().indent == col;
+            std::string_view anchor = this->takePendingAnchor();
+            if (!this->pushBlock(false, col, indentless))
+            {
+                return false;
+            }
+            this->push(EventType::SequenceStart, start, {}, anchor);
+        }
+        ++m_cur;
+        this->skipBlanks();
+        if (atLineEnd(m_cur, m_end) || *m_cur == '#')
+        {
+            m_expect_value = true;
+            m_value_indent = col;
+            return this->finishLine();
+        }
+        return this->scanNode(Context::Any, col);
+    }
+
+    // >>> PROPERTIES
+    std::string_view anchor;
+    bool             have_properties = false;
+    if (!this->scanProperties(anchor, have_properties))
+    {
+        return false;
+    }
+    if (have_properties)
+    {
+        if (atLineEnd(m_cur, m_end) || *m_cur == '#')
+        {
+            // The properties apply to a node on the following lines
+            if (context == Context::Key)
+            {
+                return this->fail(ParseErrorCode::ExpectedKey, start);
+            }
+            m_pending_anchor = anchor;
+            m_expect_value   = true;
+            m_value_indent   = parent_indent;
+            return this->finishLine();
+        }
+        if (isEntry(m_cur, m_end))
+        {
+            return this->fail(ParseErrorCode::UnexpectedCharacter, m_cur);
+        }
+    }
+
+    // >>> NODE CONTENT
+    const char  c    = *m_cur;
+    EventType   type = EventType::Scalar;
+    ScalarStyle style = ScalarStyle::Plain;
+    std::string_view value;
+    if (c == '|' || c == '>')
+    {
+        if (context == Context::Key)
+        {
+            return this->fail(ParseErrorCode::ExpectedKey, m_cur);
+        }
+        // Reuse the storage of the previous block scalar
+        const std::string_view input(m_cur, m_end - m_cur);
+        ParseError             error;
+        if (m_block)
+        {
+            error = m_block->rescan(input, parent_indent);
+        }
+        else if (auto result = BlockScalar::scan(input, parent_indent))
+        {
+            m_block = std::move(result).value();
+        }
+        else
+        {
+            error = result.error();
+        }
+        if (error.code != ParseErrorCode::None)
+        {
+            return this->fail(error.code, m_cur + error.offset);
+        }
+        this->push(EventType::Scalar,
+                   start,
+                   m_block->value(),
+                   anchor.empty() ? this->takePendingAnchor() : anchor,
+                   m_block->style() == BlockStyle::Literal
+                       ? ScalarStyle::Literal
+                       : ScalarStyle::Folded);
+        m_cur += m_block->consumed();
+        m_line_start = m_cur;
+        return true;
+    }
+    if (c == '[' || c == '{')
+    {
+        if (context == Context::Key)
+        {
+            return this->fail(ParseErrorCode::NonScalarKey, m_cur);
+        }
+        return this->pushFlow(
+            c == '{',
+            anchor.empty() ? this->takePendingAnchor() : anchor,
+            m_cur);
+    }
+    if (c == '*')
+    {
+        ++m_cur;
+        value = this->scanName();
+        if (value.empty())
+        {
+            return this->fail(ParseErrorCode::InvalidAnchor, start);
+        }
+        type = EventType::Alias;
+    }
+    else if (c == '"' || c == '\'')
+    {
+        style = (c == '"') ? ScalarStyle::DoubleQuoted
+                           : ScalarStyle::SingleQuoted;
+        if (!this->scanQuoted(value))
+        {
+            return false;
+        }
+    }
+    else if (c == '?' && followedBySpace(m_cur, m_end))
+    {
+        return this->fail(ParseErrorCode::UnsupportedFeature, m_cur);
+    }
+    else if (c == ':' && followedBySpace(m_cur, m_end))
+    {
+        return this->fail(ParseErrorCode::UnsupportedFeature, m_cur);
+    }
+    else if (isFlowIndicator(c) || c == '#' || c == '@' || c == '`'
+             || c == '%')
+    {
+        return this->fail(ParseErrorCode::UnexpectedCharacter, m_cur);
+    }
+    else
+    {
+        value = this->scanPlain(false);
+    }
+
+    // >>> MAPPING KEY
+    this->skipBlanks();
+    if (m_cur != m_end && *m_cur == ':' && followedBySpace(m_cur, m_end))
+    {
+        if (context == Context::Value)
+        {
+            return this->fail(ParseErrorCode::UnexpectedContent, m_cur);
+        }
+        bool continues = !m_blocks.empty() && m_blocks.back().mapping
+                         && m_blocks.back().indent == col;
+        if (!continues)
+        {
+            if (!this->pushBlock(true, col, false))
+            {
+                return false;
+            }
+            this->push(EventType::MappingStart,
+                       start,
+                       {},
+                       this->takePendingAnchor());
+        }
+        this->push(type, start, value, anchor, style);
+
+        ++m_cur;
+        this->skipBlanks();
+        if (atLineEnd(m_cur, m_end) || *m_cur == '#')
+        {
+            m_expect_value = true;
+            m_value_indent = col;
+            return this->finishLine();
+        }
+        return this->scanNode(Context::Value, col);
+    }
+
+    if (context == Context::Key)
+    {
+        return this->fail(ParseErrorCode::ExpectedKey, start);
+    }
+    if (anchor.empty())
+    {
+        anchor = this->takePendingAnchor();
+    }
+    this->push(type, start, value, anchor, style);
+    return this->finishLine();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan the next token of a flow context
+ */
+bool Scanner::scanFlow()
+{
+    if (!this->skipFlowSpace())
+    {
+        return false;
+    }
+    Flow&      top = m_flows.back();
+    const char c   = *m_cur;
+
+    // >>> END OF COLLECTION
+    if (c == ']' || c == '}')
+    {
+        if ((c == '}') != top.mapping)
+        {
+            return this->fail(ParseErrorCode::UnexpectedCharacter, m_cur);
+        }
+        if (top.state == FlowState::AfterKey || top.state == FlowState::Value)
+        {
+            this->pushEmpty(m_cur);
+        }
+        this->push(top.mapping ? EventType::MappingEnd
+                               : EventType::SequenceEnd,
+                   m_cur);
+        m_flows.pop_back();
+        ++m_cur;
+        return this->endFlowNode();
+    }
+
+    // >>> SEPARATORS
+    if (c == ',')
+    {
+        switch (top.state)
+        {
+            case FlowState::AfterEntry:
+                top.state = FlowState::Entry;
+                break;
+            case FlowState::AfterKey:
+            case FlowState::Value:
+                this->pushEmpty(m_cur);
+                top.state = FlowState::Key;
+                break;
+            case FlowState::AfterValue:
+                top.state = FlowState::Key;
+                break;
+            default:
+                return this->fail(ParseErrorCode::UnexpectedCharacter,
+                                  m_cur);
+        }
+        ++m_cur;
+        return true;
+    }
+    if (c == ':' && top.mapping)
+    {
+        if (top.state == FlowState::Key)
+        {
+            return this->fail(ParseErrorCode::UnsupportedFeature, m_cur);
+        }
+        if (top.state != FlowState::AfterKey)
+        {
+            return this->fail(ParseErrorCode::UnexpectedCharacter, m_cur);
+        }
+        top.state = FlowState::Value;
+        ++m_cur;
+        return true;
+    }
+    if (top.state == FlowState::AfterEntry || top.state == FlowState::AfterKey
+        || top.state == FlowState::AfterValue)
+    {
+        return this->fail(ParseErrorCode::UnexpectedCharacter, m_cur);
+    }
+
+    // >>> NODES
+    const char*      start = m_cur;
+    std::string_view anchor;
+    bool             have_properties = false;
+    if (!this->scanProperties(anchor, have_properties))
+    {
+        return false;
+    }
+    if (m_cur == m_end)
+    {
+        return this->fail(ParseErrorCode::UnterminatedFlow, m_flow_start);
+    }
+    const char next = *m_cur;
+    if (next == '[' || next == '{')
+    {
+        return this->pushFlow(next == '{', anchor, m_cur);
+    }
+    if (have_properties && (isFlowIndicator(next) || isBreak(next)))
+    {
+        // Properties of an empty node
+        this->push(EventType::Scalar, start, {}, anchor);
+        this->completeFlowNode();
+        return true;
+    }
+
+    EventType        type  = EventType::Scalar;
+    ScalarStyle      style = ScalarStyle::Plain;
+    std::string_view value;
+    if (next == '*')
+    {
+        ++m_cur;
+        value = this->scanName();
+        if (value.empty())
+        {
+            return this->fail(ParseErrorCode::InvalidAnchor, start);
+        }
+        type = EventType::Alias;
+    }
+    else if (next == '"' || next == '\'')
+    {
+        style = (next == '"') ? ScalarStyle::DoubleQuoted
+                              : ScalarStyle::SingleQuoted;
+        if (!this->scanQuoted(value))
+        {
+            return false;
+        }
+    }
+    else if ((next == '?' || next == '-') && followedBySpace(m_cur, m_end))
+    {
+        return this->fail(ParseErrorCode::UnsupportedFeature, m_cur);
+    }
+    else if (next == '#' || next == '@' || next == '`' || next == ':')
+    {
+        return this->fail(ParseErrorCode::UnexpectedCharacter, m_cur);
+    }
+    else
+    {
+        value = this->scanPlain(true);
+    }
+    this->push(type, start, value, anchor, style);
+
+    // Single-pair mappings within sequences are not supported
+    if (!top.mapping)
+    {
+        this->skipBlanks();
+        if (m_cur != m_end && *m_cur == ':')
+        {
+            return this->fail(ParseErrorCode::UnsupportedFeature, m_cur);
+        }
+    }
+    this->completeFlowNode();
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan node properties (anchor and tag) and the following blanks
+ *
+ * Tags are skipped.
+ *
+ * \param[out] anchor  The anchor name, or empty if none
+ * \param[out] found   Whether any properties were present
+ */
+bool Scanner::scanProperties(std::string_view& anchor, bool& found)
+{
+    found = false;
+    while (m_cur != m_end && (*m_cur == '&' || *m_cur == '!'))
+    {
+        const char* start = m_cur;
+        ++m_cur;
+        if (*start == '&')
+        {
+            anchor = this->scanName();
+            if (anchor.empty())
+            {
+                return this->fail(ParseErrorCode::InvalidAnchor, start);
+            }
+        }
+        else
+        {
+            while (m_cur != m_end && !isBlank(*m_cur) && !isBreak(*m_cur))
+            {
+                ++m_cur;
+            }
+        }
+        found = true;
+        this->skipBlanks();
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan a single- or double-quoted scalar
+ *
+ * The value is a view into the input unless it contains escapes or line
+ * breaks, in which case it is decoded into a scratch buffer.
+ *
+ * \param[out] value  The scalar value
+ */
+bool Scanner::scanQuoted(std::string_view& value)
+{
+    const char* const open  = m_cur;
+    const char        quote = *m_cur++;
+    const char*       seg   = m_cur;
+    std::string*      out   = nullptr;
+
+    while (true)
+    {
+        if (m_cur == m_end)
+        {
+            return this->fail(ParseErrorCode::UnterminatedQuote, open);
+        }
+        const char c = *m_cur;
+        if (c == quote)
+        {
+            if (quote == '\'' && m_cur + 1 != m_end && m_cur[1] == '\'')
+            {
+                // Escaped single quote
+                if (!out)
+                {
+                    out = &this->scratch();
+                }
+                out->append(seg, m_cur + 1);
+                m_cur += 2;
+                seg = m_cur;
+                continue;
+            }
+            break;
+        }
+        if (quote == '"' && c == '\\')
+        {
+            if (!out)
+            {
+                out = &this->scratch();
+            }
+            out->append(seg, m_cur);
+            if (!this->scanEscape(*out))
+            {
+                return false;
+            }
+            seg = m_cur;
+            continue;
+        }
+        if (isBreak(c))
+        {
+            // Fold the line break, trimming the surrounding whitespace
+            if (!out)
+            {
+                out = &this->scratch();
+            }
+            out->append(seg, m_cur);
+            trimBlanks(*out);
+            this->consumeBreak();
+            std::size_t num_empty = 0;
+            while (true)
+            {
+                this->skipBlanks();
+                if (m_cur == m_end || !isBreak(*m_cur))
+                {
+                    break;
+                }
+                this->consumeBreak();
+                ++num_empty;
+            }
+            if (!this->checkContinuation())
+            {
+                return false;
+            }
+            if (num_empty == 0)
+            {
+                *out += ' ';
+            }
+            else
+            {
+                out->append(num_empty, '\n');
+            }
+            seg = m_cur;
+            continue;
+        }
+        ++m_cur;
+    }
+
+    if (out)
+    {
+        out->append(seg, m_cur);
+        value = *out;
+    }
+    else
+    {
+        value = std::string_view(seg, m_cur - seg);
+    }
+    ++m_cur;
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan an escape sequence of a double-quoted scalar
+ *
+ * \param[in,out] out  The decoded value, to which the character is appended
+ */
+bool Scanner::scanEscape(std::string& out)
+{
+    YAYP_REQUIRE(*m_cur == '\\');
+    const char* start = m_cur++;
+    if (m_cur == m_end)
+    {
+        return this->fail(ParseErrorCode::UnterminatedQuote, start);
+    }
+
+    const char c = *m_cur++;
+    int        num_digits = 0;
+    switch (c)
+    {
+        // clang-format off
+        case '0':  out += '\0';   return true;
+        case 'a':  out += '\a';   return true;
+        case 'b':  out += '\b';   return true;
+        case 't':
+        case '\t': out += '\t';   return true;
+        case 'n':  out += '\n';   return true;
+        case 'v':  out += '\v';   return true;
+        case 'f':  out += '\f';   return true;
+        case 'r':  out += '\r';   return true;
+        case 'e':  out += '\x1b'; return true;
+        case ' ':  out += ' ';    return true;
+        case '"':  out += '"';    return true;
+        case '/':  out += '/';    return true;
+        case '\\': out += '\\';   return true;
+        case 'N':  appendUtf8(out, 0x85);   return true;
+        case '_':  appendUtf8(out, 0xA0);   return true;
+        case 'L':  appendUtf8(out, 0x2028); return true;
+        case 'P':  appendUtf8(out, 0x2029); return true;
+        case 'x':  num_digits = 2; break;
+        case 'u':  num_digits = 4; break;
+        case 'U':  num_digits = 8; break;
+        // clang-format on
+        case '\n':
+        case '\r':
+            // Escaped line break: join the lines without a space
+            --m_cur;
+            this->consumeBreak();
+            this->skipBlanks();
+            return this->checkContinuation();
+        default:
+            return this->fail(ParseErrorCode::InvalidEscape, start);
+    }
+
+    unsigned long cp = 0;
+    for (int i = 0; i < num_digits; ++i)
+    {
+        int digit = (m_cur == m_end) ? -1 : hexValue(*m_cur);
+        if (digit < 0)
+        {
+            return this->fail(ParseErrorCode::InvalidEscape, start);
+        }
+        cp = (cp << 4) | static_cast<unsigned long>(digit);
+        ++m_cur;
+    }
+    if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+    {
+        return this->fail(ParseErrorCode::InvalidEscape, start);
+    }
+    appendUtf8(out, cp);
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan a plain scalar on the current line
+ *
+ * The scalar ends before ": ", " #", the end of the line, and in flow
+ * context before a flow indicator.  Trailing whitespace is excluded.
+ *
+ * \param[in] flow  Whether the scalar is in flow context
+ * \return The scalar value, as a view into the input
+ */
+std::string_view Scanner::scanPlain(bool flow)
+{
+    const char* start = m_cur;
+    const char* last  = m_cur;
+    const char* p     = m_cur;
+    while (!atLineEnd(p, m_end))
+    {
+        const char c = *p;
+        if (c == ':'
+            && (followedBySpace(p, m_end) || (flow && isFlowIndicator(p[1]))))
+        {
+            break;
+        }
+        if (flow && isFlowIndicator(c))
+        {
+            break;
+        }
+        if (c == '#' && p != start && isBlank(p[-1]))
+        {
+            break;
+        }
+        ++p;
+        if (!isBlank(c))
+        {
+            last = p;
+        }
+    }
+    m_cur = last;
+    return std::string_view(start, last - start);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan an anchor or alias name
+ *
+ * The name ends at whitespace or a flow indicator.
+ */
+std::string_view Scanner::scanName()
+{
+    const char* start = m_cur;
+    while (m_cur != m_end && !isBlank(*m_cur) && !isBreak(*m_cur)
+           && !isFlowIndicator(*m_cur))
+    {
+        ++m_cur;
+    }
+    return std::string_view(start, m_cur - start);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Begin a document
+ */
+void Scanner::beginDocument(const char* where)
+{
+    this->push(EventType::DocumentStart, where);
+    m_state          = State::Document;
+    m_expect_value   = true;
+    m_value_indent   = -1;
+    m_pending_anchor = {};
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief End the current document, closing all collections
+ */
+void Scanner::endDocument(const char* where)
+{
+    if (m_expect_value)
+    {
+        this->pushEmpty(where);
+        m_expect_value = false;
+    }
+    while (!m_blocks.empty())
+    {
+        this->popBlock(where);
+    }
+    this->push(EventType::DocumentEnd, where);
+    m_state = State::Stream;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Open a block collection
+ */
+bool Scanner::pushBlock(bool mapping, int indent, bool indentless)
+{
+    if (m_blocks.size() + m_flows.size() >= m_max_depth)
+    {
+        m_error.limit = m_max_depth;
+        return this->fail(ParseErrorCode::DepthLimit, m_cur);
+    }
+    m_blocks.push_back({mapping, indent, indentless});
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Close the innermost block collection
+ */
+void Scanner::popBlock(const char* where)
+{
+    YAYP_REQUIRE(!m_blocks.empty());
+    if (m_blocks.back().mapping)
+    {
+        this->push(EventType::MappingEnd, where);
+    }
+    else
+    {
+        this->push(EventType::SequenceEnd, where);
+    }
+    m_blocks.pop_back();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Open a flow collection beginning at the current position
+ */
+bool Scanner::pushFlow(bool             mapping,
+                       std::string_view anchor,
+                       const char*      where)
+{
+    if (m_blocks.size() + m_flows.size() >= m_max_depth)
+    {
+        m_error.limit = m_max_depth;
+        return this->fail(ParseErrorCode::DepthLimit, where);
+    }
+    if (!mapping && m_packing)
+    {
+        const char* end = nullptr;
+        if (auto items = PackedArray::scanFlow(where + 1, m_end, end))
+        {
+            this->push(EventType::PackedSequence, where, {}, anchor);
+            m_queue.back().packed
+                = std::make_shared<const PackedArray>(std::move(*items));
+            m_cur = end;
+            return this->endFlowNode();
+        }
+    }
+    if (m_flows.empty())
+    {
+        m_flow_start = where;
+    }
+    this->push(mapping ? EventType::MappingStart : EventType::SequenceStart,
+               where,
+               {},
+               anchor);
+    m_flows.push_back({mapping, mapping ? FlowState::Key : FlowState::Entry});
+    ++m_cur;
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Advance the state of the innermost flow collection past a node
+ */
+void Scanner::completeFlowNode()
+{
+    Flow& top = m_flows.back();
+    if (!top.mapping)
+    {
+        top.state = FlowState::AfterEntry;
+    }
+    else
+    {
+        top.state = (top.state == FlowState::Key) ? FlowState::AfterKey
+                                                  : FlowState::AfterValue;
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Continue after a flow collection that has been closed
+ *
+ * Within another flow collection the closed one is an item or a value;
+ * otherwise it is a complete block node, and the line must end.
+ */
+bool Scanner::endFlowNode()
+{
+    if (!m_flows.empty())
+    {
+        this->completeFlowNode();
+        return true;
+    }
+    this->skipBlanks();
+    if (m_cur != m_end && *m_cur == ':' && followedBySpace(m_cur, m_end))
+    {
+        return this->fail(ParseErrorCode::NonScalarKey, m_cur);
+    }
+    return this->finishLine();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Skip the lines more indented than the given indentation
+ *
+ * Empty and comment lines are skipped regardless of their indentation.
+ * Skipping stops at the first other line that is not more indented (unless
+ * it is a sequence entry at the given indentation and \c entries is set, or
+ * a closing bracket at the given indentation, which no block line can begin
+ * with) or at a document marker.
+ *
+ * \param[in] indent   The indentation of the parent
+ * \param[in] entries  Whether entries at the given indentation are skipped
+ */
+void Scanner::skipLines(int indent, bool entries)
+{
+    YAYP_REQUIRE(m_cur == m_line_start);
+
+    while (m_cur != m_end)
+    {
+        const char* p = m_cur;
+        while (p != m_end && *p == ' ')
+        {
+            ++p;
+        }
+        const char* q = p;
+        while (q != m_end && isBlank(*q))
+        {
+            ++q;
+        }
+        if (!atLineEnd(q, m_end) && *q != '#')
+        {
+            const int line_indent = static_cast<int>(p - m_cur);
+            if (line_indent == 0
+                && (isMarker(m_cur, m_end, "---")
+                    || isMarker(m_cur, m_end, "...")))
+            {
+                break;
+            }
+            if (line_indent < indent
+                || (line_indent == indent && !(entries && isEntry(p, m_end))
+                    && !isClosingBracket(p, m_end)))
+            {
+                break;
+            }
+        }
+
+        // Find the line break, which is a bare '\r' if one precedes the '\n'
+        const void* lf
+            = std::memchr(q, '\n', static_cast<std::size_t>(m_end - q));
+        const char* line_end = lf ? static_cast<const char*>(lf) : m_end;
+        const void* cr       = std::memchr(
+            q, '\r', static_cast<std::size_t>(line_end - q));
+        if (cr && static_cast<const char*>(cr) + 1 != line_end)
+        {
+            line_end = static_cast<const char*>(cr);
+        }
+        m_cur = (line_end == m_end) ? m_end : line_end + 1;
+    }
+    m_line_start = m_cur;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Skip the remainder of the innermost flow collection
+ *
+ * The brackets are matched, skipping quoted scalars (which begin after an
+ * indicator or whitespace) and comments, and the collection is then closed
+ * as if it had been scanned.
+ */
+bool Scanner::skipFlow()
+{
+    YAYP_REQUIRE(!m_flows.empty());
+
+    std::size_t depth = 1;
+    const char* p     = m_cur;
+    for (; p != m_end && depth > 0; ++p)
+    {
+        const char c = *p;
+        if (c == '[' || c == '{')
+        {
+            ++depth;
+        }
+        else if (c == ']' || c == '}')
+        {
+            --depth;
+        }
+        else if ((c == '"' || c == '\'') && p != m_begin
+                 && (isBlank(p[-1]) || isBreak(p[-1]) || isFlowIndicator(p[-1])
+                     || p[-1] == ':'))
+        {
+            // Find the closing quote, skipping escapes
+            for (++p; p != m_end; ++p)
+            {
+                if (*p == c)
+                {
+                    if (c == '"' || p + 1 == m_end || p[1] != '\'')
+                    {
+                        break;
+                    }
+                    ++p;
+                }
+                else if (*p == '\\' && c == '"' && p + 1 != m_end)
+                {
+                    ++p;
+                }
+            }
+            if (p == m_end)
+            {
+                break;
+            }
+        }
+        else if (c == '#' && (isBlank(p[-1]) || isBreak(p[-1])))
+        {
+            while (p + 1 != m_end && !isBreak(p[1]))
+            {
+                ++p;
+            }
+        }
+    }
+    if (depth > 0)
+    {
+        return this->fail(ParseErrorCode::UnterminatedFlow, m_flow_start);
+    }
+
+    m_cur = p;
+    for (const char* q = m_cur; q != m_line_start; --q)
+    {
+        if (isBreak(q[-1]))
+        {
+            m_line_start = q;
+            break;
+        }
+    }
+    m_flows.pop_back();
+    return this->endFlowNode();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Queue an empty scalar for a missing value
+ */
+void Scanner::pushEmpty(const char* where)
+{
+    this->push(EventType::Scalar, where, {}, this->takePendingAnchor());
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Queue an event
+ */
+void Scanner::push(EventType        type,
+                   const char*      where,
+                   std::string_view value,
+                   std::string_view anchor,
+                   ScalarStyle      style)
+{
+    Event event;
+    event.type   = type;
+    event.style  = style;
+    event.value  = value;
+    event.anchor = anchor;
+    event.offset = static_cast<std::size_t>(where - m_begin);
+    m_queue.push_back(event);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Take the anchor given on a preceding line
+ */
+std::string_view Scanner::takePendingAnchor()
+{
+    std::string_view anchor = m_pending_anchor;
+    m_pending_anchor        = {};
+    return anchor;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Finish the current line, which may only hold a comment
+ */
+bool Scanner::finishLine()
+{
+    this->skipBlanks();
+    if (m_cur != m_end && *m_cur == '#')
+    {
+        while (!atLineEnd(m_cur, m_end))
+        {
+            ++m_cur;
+        }
+    }
+    if (!atLineEnd(m_cur, m_end))
+    {
+        return this->fail(ParseErrorCode::UnexpectedContent, m_cur);
+    }
+    this->consumeBreak();
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Skip whitespace, line breaks and comments within a flow collection
+ *
+ * \return false if the input ends within the collection
+ */
+bool Scanner::skipFlowSpace()
+{
+    bool new_line = false;
+    while (m_cur != m_end)
+    {
+        if (isBlank(*m_cur))
+        {
+            ++m_cur;
+        }
+        else if (isBreak(*m_cur))
+        {
+            this->consumeBreak();
+            new_line = true;
+        }
+        else if (*m_cur == '#')
+        {
+            while (!atLineEnd(m_cur, m_end))
+            {
+                ++m_cur;
+            }
+        }
+        else
+        {
+            return !new_line || this->checkContinuation();
+        }
+    }
+    return this->fail(ParseErrorCode::UnterminatedFlow, m_flow_start);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Check the indentation of a continuation line of flow or quoted text
+ *
+ * Within a block collection, a line holding content must be indented more
+ * than the collection, except that a closing bracket may be at the column of
+ * the collection (as in \c "k: [\n  a,\n]").  Empty lines are not checked.
+ */
+bool Scanner::checkContinuation()
+{
+    if (m_blocks.empty() || m_cur == m_end || isBreak(*m_cur))
+    {
+        return true;
+    }
+    const char* p = m_line_start;
+    while (p != m_end && *p == ' ')
+    {
+        ++p;
+    }
+    const int indent = static_cast<int>(p - m_line_start);
+    const int block  = m_blocks.back().indent;
+    if (indent > block || (indent == block && isClosingBracket(p, m_end)))
+    {
+        return true;
+    }
+    return this->fail(ParseErrorCode::InvalidIndentation, m_cur);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Skip spaces and tabs
+ */
+void Scanner::skipBlanks()
+{
+    while (m_cur != m_end && isBlank(*m_cur))
+    {
+        ++m_cur;
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Consume a line break (LF, CRLF or CR), if any
+ */
+void Scanner::consumeBreak()
+{
+    if (m_cur != m_end && *m_cur == '\r')
+    {
+        ++m_cur;
+    }
+    if (m_cur != m_end && *m_cur == '\n')
+    {
+        ++m_cur;
+    }
+    m_line_start = m_cur;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a cleared scratch buffer
+ *
+ * The buffers are reused (keeping their capacity) once the queued events
+ * have been returned.
+ */
+std::string& Scanner::scratch()
+{
+    if (m_scratch_used == m_scratch.size())
+    {
+        m_scratch.emplace_back();
+    }
+    std::string& buffer = m_scratch[m_scratch_used++];
+    buffer.clear();
+    return buffer;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Record an error
+ *
+ * \return false
+ */
+bool Scanner::fail(ParseErrorCode code, const char* where)
+{
+    m_error.code   = code;
+    m_error.offset = static_cast<std::size_t>(where - m_begin);
+    m_state        = State::Failed;
+    return false;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/Scanner.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,357 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/Scanner.hh
+ * \brief  Scanner class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_SCANNER_HH
+#define YAYP_YAML_SCANNER_HH
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BlockScalar.hh"
+#include "PackedArray.hh"
+#include "ParseError.hh"
+#include "ResourceGuard.hh"
+
+namespace yayp
+{
+//! Kind of a parse event
+enum class EventType
+{
+    StreamEnd,
+    DocumentStart,
+    DocumentEnd,
+    SequenceStart,
+    SequenceEnd,
+    MappingStart,
+    MappingEnd,
+    Scalar,
+    Alias,
+    PackedSequence
+};
+
+//! Style in which a scalar was written
+enum class ScalarStyle
+{
+    Plain,
+    SingleQuoted,
+    DoubleQuoted,
+    Literal,
+    Folded
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief A parse event.
+ *
+ * The value and anchor are views either into the input or into the
+ * scanner's buffers, and remain valid until the next call to Scanner::next().
+ */
+struct Event
+{
+    //! Kind of event
+    EventType type = EventType::StreamEnd;
+
+    //! Style of a scalar
+    ScalarStyle style = ScalarStyle::Plain;
+
+    //! Value of a scalar or the anchor name of an alias
+    std::string_view value;
+
+    //! Anchor name of a scalar or collection (empty if none)
+    std::string_view anchor;
+
+    //! Byte offset of the event in the input
+    std::size_t offset = 0;
+
+    //! Items of a packed sequence
+    std::shared_ptr<const PackedArray> packed;
+};
+
+//===========================================================================//
+/*!
+ * \class Scanner
+ * \brief Reads the parse events of a YAML stream one at a time.
+ *
+ * The scanner produces the events of each document in order: the document
+ * start, the nodes as a nested sequence of collection starts and ends,
+ * scalars and aliases, and the document end, followed by a single stream end
+ * event.  An empty value (e.g., a key without a value) is reported as an
+ * empty plain scalar.  Events are produced on demand, so the memory used is
+ * bounded by the nesting depth and not by the size of the input.
+ *
+ * The supported subset of YAML 1.2 covers the constructs found in
+ * configuration files:
+ *  - block sequences and mappings, including compact nested entries
+ *    (\c "- key: value", \c "- - item") and sequences indented at the level
+ *    of their mapping key;
+ *  - flow sequences and mappings, which may span lines;
+ *  - plain scalars (on a single line), single- and double-quoted scalars
+ *    (which may span lines, with line folding and escapes), and literal and
+ *    folded block scalars;
+ * Within a block collection, as YAML requires, the continuation lines of
+ * flow collections and quoted scalars must be indented more than the
+ * collection (ParseErrorCode::InvalidIndentation otherwise), so that they
+ * always belong to the node being scanned; a closing bracket may also be at
+ * the column of the collection.
+ *  - anchors, aliases and comments; tags are skipped;
+ *  - multiple documents separated by \c --- and \c ... markers; directives
+ *    are skipped.
+ * Explicit (\c ?) keys and single-pair mappings within flow sequences are
+ * reported as ParseErrorCode::UnsupportedFeature.
+ *
+ * Nothing is thrown for invalid input: next() returns false and error()
+ * holds the reason and the byte offset (the line and column are not set).
+ * The nesting depth is limited by ParseLimits::max_depth.
+ *
+ * With packing enabled, a flow sequence of numbers that PackedArray can read
+ * (e.g., \c [0.5, 1.5, 2.5]) is reported as a single PackedSequence event
+ * holding its items, instead of the start, scalar and end events.  The
+ * items are neither tokenized nor copied one by one, which makes huge
+ * inline arrays cheap.  Any other flow sequence is scanned as usual.
+ *
+ * A consumer that is not interested in a node (e.g., the value of a mapping
+ * key) calls skipValue() instead of reading its events.  Block nodes are
+ * skipped line by line using only their indentation, and flow collections
+ * by matching brackets (and quotes), without tokenizing their contents.
+ * The skipped text is therefore not validated, and anchors defined within
+ * it are not reported.  Since the continuation lines of flow and quoted
+ * content are indented, skipping by indentation ends where the full scan
+ * does.
+ *
+ * \example src/yaml/tests/tstScanner.cc
+ */
+//===========================================================================//
+
+class Scanner
+{
+  public:
+    // Constructor
+    explicit Scanner(std::string_view   input  = {},
+                     const ParseLimits& limits = ParseLimits());
+
+    // Restart scanning with a new input
+    void reset(std::string_view input);
+
+    // Read the next event, returning false on error
+    bool next(Event& event);
+
+    // Return the next event without consuming it, returning false on error
+    bool peek(Event& event);
+
+    // Skip the next node without reading its events
+    bool skipValue();
+
+    // Report flow sequences of numbers as packed sequences
+    void enablePacking(bool enable = true);
+
+    // >>> ACCESSORS
+    //! Return whether flow sequences of numbers are packed
+    bool packing() const { return m_packing; }
+
+    //! Return the error after next() returns false
+    const ParseError& error() const { return m_error; }
+
+    //! Return the input
+    std::string_view input() const
+    {
+        return std::string_view(m_begin, m_end - m_begin);
+    }
+
+  private:
+    //! Position in the stream
+    enum class State
+    {
+        Stream,   //!< Between documents
+        Document, //!< Within a document
+        End,      //!< After the stream end
+        Failed    //!< After an error
+    };
+
+    //! Where a node appears in block context
+    enum class Context
+    {
+        Any,   //!< At the start of a line or after "- "
+        Key,   //!< At the indentation of a block mapping
+        Value  //!< After "key: " on the same line
+    };
+
+    //! Expected token in a flow collection
+    enum class FlowState
+    {
+        Entry,      //!< Sequence entry or closing bracket
+        AfterEntry, //!< Comma or closing bracket after a sequence entry
+        Key,        //!< Mapping key or closing brace
+        AfterKey,   //!< Colon, comma or closing brace after a key
+        Value,      //!< Mapping value after a colon
+        AfterValue  //!< Comma or closing brace after a value
+    };
+
+    //! An open block collection
+    struct Block
+    {
+        bool mapping;
+        int  indent;
+        bool indentless;
+    };
+
+    //! An open flow collection
+    struct Flow
+    {
+        bool      mapping;
+        FlowState state;
+    };
+
+  private:
+    // >>> IMPLEMENTATION
+    // Scan until at least one event is queued
+    bool fill();
+
+    // Scan between documents
+    bool scanStream();
+
+    // Scan the next line of a block context
+    bool scanBlock();
+
+    // Scan the next token of a flow context
+    bool scanFlow();
+
+    // Scan a node in block context
+    bool scanNode(Context context, int parent_indent);
+
+    // Scan node properties, returning the anchor
+    bool scanProperties(std::string_view& anchor, bool& found);
+
+    // Scan a quoted scalar
+    bool scanQuoted(std::string_view& value);
+
+    // Scan a double-quoted escape sequence
+    bool scanEscape(std::string& out);
+
+    // Scan a plain scalar
+    std::string_view scanPlain(bool flow);
+
+    // Scan an anchor or alias name
+    std::string_view scanName();
+
+    // Begin a document
+    void beginDocument(const char* where);
+
+    // End the current document
+    void endDocument(const char* where);
+
+    // Open a block collection
+    bool pushBlock(bool mapping, int indent, bool indentless);
+
+    // Close the innermost block collection
+    void popBlock(const char* where);
+
+    // Open a flow collection
+    bool pushFlow(bool mapping, std::string_view anchor, const char* where);
+
+    // Advance the state of the innermost flow collection past a node
+    void completeFlowNode();
+
+    // Continue after a flow collection that has been closed
+    bool endFlowNode();
+
+    // Skip the lines more indented than the given indentation
+    void skipLines(int indent, bool entries);
+
+    // Skip the remainder of the innermost flow collection
+    bool skipFlow();
+
+    // Queue an empty scalar for a missing value
+    void pushEmpty(const char* where);
+
+    // Queue an event
+    void push(EventType        type,
+              const char*      where,
+              std::string_view value  = {},
+              std::string_view anchor = {},
+              ScalarStyle      style  = ScalarStyle::Plain);
+
+    // Take the anchor given on a preceding line
+    std::string_view takePendingAnchor();
+
+    // Finish the current line, which may only hold a comment
+    bool finishLine();
+
+    // Skip whitespace, line breaks and comments within a flow collection
+    bool skipFlowSpace();
+
+    // Check the indentation of a continuation line of flow or quoted text
+    bool checkContinuation();
+
+    // Skip spaces and tabs
+    void skipBlanks();
+
+    // Consume a line break
+    void consumeBreak();
+
+    // Return a cleared scratch buffer
+    std::string& scratch();
+
+    // Record an error
+    bool fail(ParseErrorCode code, const char* where);
+
+    //! Return the column of the current position
+    int column() const { return static_cast<int>(m_cur - m_line_start); }
+
+  private:
+    // >>> DATA
+    //! Input and position
+    const char* m_begin      = nullptr;
+    const char* m_end        = nullptr;
+    const char* m_cur        = nullptr;
+    const char* m_line_start = nullptr;
+
+    //! Maximum nesting depth
+    std::size_t m_max_depth;
+
+    //! Whether flow sequences of numbers are packed
+    bool m_packing = false;
+
+    //! Scanner state
+    State              m_state = State::Stream;
+    std::vector<Block> m_blocks;
+    std::vector<Flow>  m_flows;
+    const char*        m_flow_start = nullptr;
+
+    //! Whether a block node is expected on a following line, and the
+    //! indentation it must exceed
+    bool m_expect_value = false;
+    int  m_value_indent = -1;
+
+    //! Anchor given on a line of its own, applying to the next node
+    std::string_view m_pending_anchor;
+
+    //! Events scanned but not yet returned
+    std::vector<Event> m_queue;
+    std::size_t        m_head = 0;
+
+    //! Buffers holding decoded scalars of the queued events
+    std::deque<std::string>    m_scratch;
+    std::size_t                m_scratch_used = 0;
+    std::optional<BlockScalar> m_block;
+
+    //! The error, if any
+    ParseError m_error;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_SCANNER_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/Scanner.hh
+//---------------------------------------------------------------------------//
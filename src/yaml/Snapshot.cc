@@ -0,0 +1,1043 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/Snapshot.cc
+ * \brief  Snapshot class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "Snapshot.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#include <unistd.h>
+#define YAYP_SNAPSHOT_MKSTEMP 1
+#endif
+
+#include "core/Checksum.hh"
+#include "harness/DBC.hh"
+#include "harness/Timing.hh"
+
+namespace yayp
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Fixed header at the start of a snapshot image
+ *
+ * The sections follow the header in the order of their counts, each padded
+ * to a multiple of 8 bytes.  The image checksum covers everything after the
+ * header.
+ */
+struct SnapshotHeader
+{
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t image_checksum;
+    std::uint64_t source_checksum;
+    std::uint64_t num_nodes;
+    std::uint64_t num_entries;
+    std::uint64_t num_items;
+    std::uint64_t payload_size;
+    std::uint64_t strings_size;
+    std::uint64_t root;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief A stored node
+ *
+ * Scalars and aliases store a string (the value or the anchor name) as
+ * (first, count) and aliases the index of their target as \c extra.
+ * Scalars that were not written in plain style set \c flags to
+ * \c quoted_scalar.
+ * Sequences store a range of the item table as (first, count).  Packed
+ * sequences set \c flags to \c packed_sequence and store the offset of
+ * their values in the payload as \c first, their number of items as
+ * \c count, and their PackedArray::Type as \c extra.  Mappings store a
+ * range of the entry table as (first, count) and a range of the item table
+ * holding their merged mappings as (extra, num_extra).
+ */
+struct SnapshotNodeRecord
+{
+    std::uint32_t kind;
+    std::uint32_t flags;
+    std::uint64_t first;
+    std::uint64_t count;
+    std::uint64_t extra;
+    std::uint64_t num_extra;
+};
+
+//---------------------------------------------------------------------------//
+//! A stored mapping entry
+struct SnapshotEntryRecord
+{
+    std::uint64_t key_offset;
+    std::uint64_t key_size;
+    std::uint64_t value;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace detail
+} // namespace yayp
+
+namespace
+{
+using yayp::Node;
+using yayp::PackedArray;
+using yayp::detail::SnapshotEntryRecord;
+using yayp::detail::SnapshotHeader;
+using yayp::detail::SnapshotNodeRecord;
+using Kind = yayp::Node::Kind;
+
+constexpr char snapshot_magic[8] = {'Y', 'A', 'Y', 'P', 'S', 'N', 'A', 'P'};
+constexpr std::uint32_t byte_order_mark = 0x01020304;
+
+//! Flag of a scalar record that is quoted or a block scalar
+constexpr std::uint32_t quoted_scalar = 1;
+
+//! Flag of a sequence record whose items are in the payload
+constexpr std::uint32_t packed_sequence = 2;
+
+static_assert(sizeof(SnapshotHeader) == 80, "Unexpected header layout");
+static_assert(sizeof(bool) == 1, "Packed booleans are stored as bytes");
+static_assert(sizeof(SnapshotNodeRecord) == 40, "Unexpected node layout");
+static_assert(sizeof(SnapshotEntryRecord) == 24, "Unexpected entry layout");
+static_assert(std::is_trivially_copyable_v<SnapshotHeader>
+                  && std::is_trivially_copyable_v<SnapshotNodeRecord>
+                  && std::is_trivially_copyable_v<SnapshotEntryRecord>,
+              "Snapshot records must be trivially copyable");
+
+//---------------------------------------------------------------------------//
+//! Round a size up to a multiple of 8 bytes
+constexpr std::uint64_t padded(std::uint64_t size)
+{
+    return (size + 7) & ~std::uint64_t(7);
+}
+
+//---------------------------------------------------------------------------//
+//! Return the size of a value of a packed array
+constexpr std::uint64_t packedValueSize(PackedArray::Type type)
+{
+    return type == PackedArray::Type::Int     ? sizeof(std::int64_t)
+           : type == PackedArray::Type::Float ? sizeof(double)
+                                              : sizeof(bool);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Flattens a document tree into snapshot tables
+ *
+ * Nodes are numbered in post-order, so that every node follows the nodes it
+ * refers to.  Shared nodes are numbered once.
+ */
+class SnapshotWriter
+{
+  public:
+    // Add a node and its descendants, returning its index
+    std::uint64_t add(const Node& node);
+
+    // Write the image
+    void write(std::ostream& os,
+               std::uint64_t root,
+               std::uint64_t source_checksum) const;
+
+  private:
+    // Intern a string, returning its offset
+    std::uint64_t intern(std::string_view s);
+
+    // Append the values of a packed array, returning their offset
+    std::uint64_t store(const PackedArray& packed);
+
+  private:
+    std::unordered_map<const Node*, std::uint64_t>      m_indices;
+    std::unordered_map<std::string_view, std::uint64_t> m_offsets;
+    std::vector<SnapshotNodeRecord>                     m_nodes;
+    std::vector<SnapshotEntryRecord>                    m_entries;
+    std::vector<std::uint64_t>                          m_items;
+    std::string                                         m_payload;
+    std::string                                         m_strings;
+};
+
+//---------------------------------------------------------------------------//
+std::uint64_t SnapshotWriter::add(const Node& node)
+{
+    auto iter = m_indices.find(&node);
+    if (iter != m_indices.end())
+    {
+        return iter->second;
+    }
+
+    SnapshotNodeRecord record = {};
+    record.kind               = static_cast<std::uint32_t>(node.kind());
+    switch (node.kind())
+    {
+        case Kind::Null:
+            break;
+        case Kind::Scalar:
+            record.first = this->intern(node.scalar());
+            record.count = node.scalar().size();
+            record.flags = node.isPlain() ? 0 : quoted_scalar;
+            break;
+        case Kind::Alias:
+            record.first = this->intern(node.anchor());
+            record.count = node.anchor().size();
+            record.extra = this->add(*node.target());
+            break;
+        case Kind::Sequence: {
+            if (const PackedArray* packed = node.packed())
+            {
+                // Store the values rather than creating the items
+                record.flags = packed_sequence;
+                record.first = this->store(*packed);
+                record.count = packed->size();
+                record.extra = static_cast<std::uint64_t>(packed->type());
+                break;
+            }
+            std::vector<std::uint64_t> items;
+            items.reserve(node.items().size());
+            for (const auto& item : node.items())
+            {
+                items.push_back(this->add(*item));
+            }
+            record.first = m_items.size();
+            record.count = items.size();
+            m_items.insert(m_items.end(), items.begin(), items.end());
+            break;
+        }
+        case Kind::Mapping: {
+            std::vector<SnapshotEntryRecord> entries;
+            entries.reserve(node.entries().size());
+            for (const auto& entry : node.entries())
+            {
+                SnapshotEntryRecord e;
+                e.key_offset = this->intern(entry.first);
+                e.key_size   = entry.first.size();
+                e.value      = this->add(*entry.second);
+                entries.push_back(e);
+            }
+            std::vector<std::uint64_t> merges;
+            for (const auto& merge : node.merges())
+            {
+                merges.push_back(this->add(*merge));
+            }
+            record.first     = m_entries.size();
+            record.count     = entries.size();
+            record.extra     = m_items.size();
+            record.num_extra = merges.size();
+            m_entries.insert(m_entries.end(), entries.begin(), entries.end());
+            m_items.insert(m_items.end(), merges.begin(), merges.end());
+            break;
+        }
+    }
+
+    std::uint64_t index = m_nodes.size();
+    m_nodes.push_back(record);
+    m_indices.emplace(&node, index);
+    return index;
+}
+
+//---------------------------------------------------------------------------//
+std::uint64_t SnapshotWriter::intern(std::string_view s)
+{
+    // The keys view the strings of the (immutable) tree being written
+    auto [iter, inserted] = m_offsets.emplace(s, m_strings.size());
+    if (inserted)
+    {
+        m_strings.append(s.data(), s.size());
+    }
+    return iter->second;
+}
+
+//---------------------------------------------------------------------------//
+std::uint64_t SnapshotWriter::store(const PackedArray& packed)
+{
+    const void* values = nullptr;
+    switch (packed.type())
+    {
+        case PackedArray::Type::Int:
+            values = packed.ints().data();
+            break;
+        case PackedArray::Type::Float:
+            values = packed.floats().data();
+            break;
+        case PackedArray::Type::Bool:
+            values = packed.bools().data();
+            break;
+    }
+    const std::uint64_t offset = m_payload.size();
+    const std::uint64_t size = packed.size() * packedValueSize(packed.type());
+
+    // Keep every array aligned for its values
+    m_payload.append(static_cast<const char*>(values), size);
+    m_payload.append(padded(size) - size, '\0');
+    return offset;
+}
+
+//---------------------------------------------------------------------------//
+void SnapshotWriter::write(std::ostream& os,
+                           std::uint64_t root,
+                           std::uint64_t source_checksum) const
+{
+    // Assemble the sections to compute their checksum
+    std::string body;
+    auto        append = [&body](const void* data, std::size_t size) {
+        body.append(static_cast<const char*>(data), size);
+        body.append(padded(size) - size, '\0');
+    };
+    body.reserve(m_nodes.size() * sizeof(SnapshotNodeRecord)
+                 + m_entries.size() * sizeof(SnapshotEntryRecord)
+                 + m_items.size() * sizeof(std::uint64_t)
+                 + m_payload.size() + padded(m_strings.size()));
+    append(m_nodes.data(), m_nodes.size() * sizeof(SnapshotNodeRecord));
+    append(m_entries.data(), m_entries.size() * sizeof(SnapshotEntryRecord));
+    append(m_items.data(), m_items.size() * sizeof(std::uint64_t));
+    append(m_payload.data(), m_payload.size());
+    append(m_strings.data(), m_strings.size());
+
+    SnapshotHeader header = {};
+    std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+    header.version         = yayp::Snapshot::version;
+    header.byte_order      = byte_order_mark;
+    header.image_checksum  = yayp::checksum64(body);
+    header.source_checksum = source_checksum;
+    header.num_nodes       = m_nodes.size();
+    header.num_entries     = m_entries.size();
+    header.num_items       = m_items.size();
+    header.payload_size    = m_payload.size();
+    header.strings_size    = m_strings.size();
+    header.root            = root;
+
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os.write(body.data(), static_cast<std::streamsize>(body.size()));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Create a temporary file next to the given file, returning its name
+ *
+ * The name is unique, so that processes writing the same file concurrently
+ * do not write into each other's temporary file.
+ */
+std::string createTempFile(const std::string& filename)
+{
+#ifdef YAYP_SNAPSHOT_MKSTEMP
+    std::string temp = filename + ".XXXXXX";
+    const int   fd   = ::mkstemp(temp.data());
+    if (fd < 0)
+    {
+        throw yayp::Exception("Unable to create snapshot file '" + temp
+                              + "'");
+    }
+    // Snapshots are readable by all, like the files of an ofstream
+    ::fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    ::close(fd);
+    return temp;
+#else
+    return filename + ".tmp";
+#endif
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+// SNAPSHOTNODE DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Construct a view of a node
+ */
+SnapshotNode::SnapshotNode(const Snapshot* snapshot, std::uint64_t index)
+    : m_snapshot(snapshot), m_index(index)
+{
+    YAYP_REQUIRE(snapshot);
+    YAYP_REQUIRE(index < snapshot->numNodes());
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the record of the node
+ */
+const detail::SnapshotNodeRecord& SnapshotNode::record() const
+{
+    YAYP_REQUIRE(m_snapshot);
+    return m_snapshot->m_nodes[m_index];
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the values of a packed sequence of the given type
+ */
+const void* SnapshotNode::packedValues(PackedArray::Type type) const
+{
+    YAYP_REQUIRE(this->packedType() == type);
+    return m_snapshot->m_payload + this->resolve().record().first;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the kind of this node (which may be an alias)
+ */
+auto SnapshotNode::kind() const -> Kind
+{
+    return static_cast<Kind>(this->record().kind);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the node this node refers to, following aliases
+ */
+SnapshotNode SnapshotNode::resolve() const
+{
+    SnapshotNode node = *this;
+    while (node.kind() == Kind::Alias)
+    {
+        node = SnapshotNode(m_snapshot, node.record().extra);
+    }
+    return node;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the value of a scalar
+ */
+std::string_view SnapshotNode::scalar() const
+{
+    const auto& rec = this->resolve().record();
+    YAYP_REQUIRE(static_cast<Kind>(rec.kind) == Kind::Scalar);
+    return m_snapshot->string(rec.first, rec.count);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return whether a scalar was written in plain style
+ */
+bool SnapshotNode::isPlain() const
+{
+    const auto& rec = this->resolve().record();
+    YAYP_REQUIRE(static_cast<Kind>(rec.kind) == Kind::Scalar);
+    return (rec.flags & quoted_scalar) == 0;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the number of sequence items or own mapping entries
+ *
+ * Null and scalar nodes have no items.
+ */
+std::size_t SnapshotNode::size() const
+{
+    const auto& rec  = this->resolve().record();
+    const auto  kind = static_cast<Kind>(rec.kind);
+    if (kind == Kind::Sequence || kind == Kind::Mapping)
+    {
+        return static_cast<std::size_t>(rec.count);
+    }
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the sequence item at the given index
+ */
+SnapshotNode SnapshotNode::at(std::size_t index) const
+{
+    const auto& rec = this->resolve().record();
+    YAYP_REQUIRE(static_cast<Kind>(rec.kind) == Kind::Sequence);
+    YAYP_REQUIRE(!(rec.flags & packed_sequence));
+    YAYP_REQUIRE(index < rec.count);
+    return SnapshotNode(m_snapshot, m_snapshot->m_items[rec.first + index]);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return whether this node is a sequence holding packed items
+ */
+bool SnapshotNode::isPacked() const
+{
+    const auto& rec = this->resolve().record();
+    return static_cast<Kind>(rec.kind) == Kind::Sequence
+           && (rec.flags & packed_sequence);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the type of the items of a packed sequence
+ */
+PackedArray::Type SnapshotNode::packedType() const
+{
+    YAYP_REQUIRE(this->isPacked());
+    return static_cast<PackedArray::Type>(this->resolve().record().extra);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the items of a packed sequence of integers
+ */
+Span<const std::int64_t> SnapshotNode::ints() const
+{
+    return {static_cast<const std::int64_t*>(
+                this->packedValues(PackedArray::Type::Int)),
+            this->size()};
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the items of a packed sequence of floats
+ */
+Span<const double> SnapshotNode::floats() const
+{
+    return {static_cast<const double*>(
+                this->packedValues(PackedArray::Type::Float)),
+            this->size()};
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the items of a packed sequence of booleans
+ */
+Span<const bool> SnapshotNode::bools() const
+{
+    return {static_cast<const bool*>(
+                this->packedValues(PackedArray::Type::Bool)),
+            this->size()};
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the key of the own mapping entry at the given index
+ */
+std::string_view SnapshotNode::keyAt(std::size_t index) const
+{
+    const auto& rec = this->resolve().record();
+    YAYP_REQUIRE(static_cast<Kind>(rec.kind) == Kind::Mapping);
+    YAYP_REQUIRE(index < rec.count);
+    const auto& entry = m_snapshot->m_entries[rec.first + index];
+    return m_snapshot->string(entry.key_offset, entry.key_size);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the value of the own mapping entry at the given index
+ */
+SnapshotNode SnapshotNode::valueAt(std::size_t index) const
+{
+    const auto& rec = this->resolve().record();
+    YAYP_REQUIRE(static_cast<Kind>(rec.kind) == Kind::Mapping);
+    YAYP_REQUIRE(index < rec.count);
+    return SnapshotNode(m_snapshot,
+                        m_snapshot->m_entries[rec.first + index].value);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the number of merged mappings
+ */
+std::size_t SnapshotNode::numMerges() const
+{
+    const auto& rec = this->resolve().record();
+    YAYP_REQUIRE(static_cast<Kind>(rec.kind) == Kind::Mapping);
+    return static_cast<std::size_t>(rec.num_extra);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the merged mapping at the given index
+ */
+SnapshotNode SnapshotNode::mergeAt(std::size_t index) const
+{
+    const auto& rec = this->resolve().record();
+    YAYP_REQUIRE(static_cast<Kind>(rec.kind) == Kind::Mapping);
+    YAYP_REQUIRE(index < rec.num_extra);
+    return SnapshotNode(m_snapshot, m_snapshot->m_items[rec.extra + index]);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Find the value of the given key in a mapping, including merged keys
+ *
+ * The lookup order is that of Node::find().
+ *
+ * \return The value, or a null view if the key is not found
+ */
+SnapshotNode SnapshotNode::find(std::string_view key) const
+{
+    const SnapshotNode node = this->resolve();
+    const auto&        rec  = node.record();
+    YAYP_REQUIRE(static_cast<Kind>(rec.kind) == Kind::Mapping);
+
+    for (std::size_t i = 0; i < rec.count; ++i)
+    {
+        if (node.keyAt(i) == key)
+        {
+            return node.valueAt(i);
+        }
+    }
+    for (std::size_t i = 0; i < rec.num_extra; ++i)
+    {
+        if (SnapshotNode value = node.mergeAt(i).find(key))
+        {
+            return value;
+        }
+    }
+    return SnapshotNode();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the anchor name of an alias
+ */
+std::string_view SnapshotNode::anchor() const
+{
+    const auto& rec = this->record();
+    YAYP_REQUIRE(static_cast<Kind>(rec.kind) == Kind::Alias);
+    return m_snapshot->string(rec.first, rec.count);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the aliased node
+ */
+SnapshotNode SnapshotNode::target() const
+{
+    const auto& rec = this->record();
+    YAYP_REQUIRE(static_cast<Kind>(rec.kind) == Kind::Alias);
+    return SnapshotNode(m_snapshot, rec.extra);
+}
+
+//---------------------------------------------------------------------------//
+// SNAPSHOT DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Open a snapshot file
+ *
+ * \param[in] filename  The snapshot file, which is mapped into memory
+ * \param[in] verify    The validation to perform
+ */
+Snapshot Snapshot::open(const std::string& filename, Verify verify)
+{
+    MappedFile       file(filename);
+    std::string_view image = file.view();
+    return Snapshot(image, std::move(file), verify);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Use a snapshot image held in memory
+ *
+ * \param[in] image   The image, which must be aligned to 8 bytes and outlive
+ *                    the snapshot
+ * \param[in] verify  The validation to perform
+ */
+Snapshot Snapshot::fromImage(std::string_view image, Verify verify)
+{
+    return Snapshot(image, MappedFile(), verify);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Construct from an image
+ */
+Snapshot::Snapshot(std::string_view image, MappedFile file, Verify verify)
+    : m_file(std::move(file)), m_image(image)
+{
+    YAYP_TIMER_DETAIL(Read);
+    this->validate(verify);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the root node
+ */
+SnapshotNode Snapshot::root() const
+{
+    return SnapshotNode(this, m_header->root);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the node with the given index
+ */
+SnapshotNode Snapshot::node(std::uint64_t index) const
+{
+    return SnapshotNode(this, index);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Rebuild the document tree
+ *
+ * The nodes are created in storage order, so every node's children already
+ * exist, and shared nodes remain shared.
+ */
+NodePtr Snapshot::toNode() const
+{
+    YAYP_TIMER_DETAIL(Build);
+
+    const std::uint64_t  num_nodes = this->numNodes();
+    std::vector<NodePtr> nodes(num_nodes);
+    for (std::uint64_t i = 0; i < num_nodes; ++i)
+    {
+        const auto& rec = m_nodes[i];
+        switch (static_cast<Node::Kind>(rec.kind))
+        {
+            case Node::Kind::Null:
+                nodes[i] = Node::makeNull();
+                break;
+            case Node::Kind::Scalar:
+                nodes[i] = Node::makeScalar(
+                    std::string(this->string(rec.first, rec.count)),
+                    (rec.flags & quoted_scalar) == 0);
+                break;
+            case Node::Kind::Alias:
+                nodes[i] = Node::makeAlias(
+                    std::string(this->string(rec.first, rec.count)),
+                    nodes[rec.extra]);
+                break;
+            case Node::Kind::Sequence: {
+                const SnapshotNode node(this, i);
+                if (node.isPacked())
+                {
+                    nodes[i] = Node::makePackedSequence(
+                        std::make_shared<const PackedArray>(
+                            this->packedArray(node)));
+                    break;
+                }
+                Node::Items items;
+                items.reserve(rec.count);
+                for (std::uint64_t j = 0; j < rec.count; ++j)
+                {
+                    items.push_back(nodes[m_items[rec.first + j]]);
+                }
+                nodes[i] = Node::makeSequence(std::move(items));
+                break;
+            }
+            case Node::Kind::Mapping: {
+                Node::Entries entries;
+                entries.reserve(rec.count);
+                for (std::uint64_t j = 0; j < rec.count; ++j)
+                {
+                    const auto& e = m_entries[rec.first + j];
+                    entries.emplace_back(
+                        std::string(this->string(e.key_offset, e.key_size)),
+                        nodes[e.value]);
+                }
+                Node::Items merges;
+                for (std::uint64_t j = 0; j < rec.num_extra; ++j)
+                {
+                    merges.push_back(nodes[m_items[rec.extra + j]]);
+                }
+                nodes[i] = Node::makeMapping(std::move(entries),
+                                             std::move(merges));
+                break;
+            }
+        }
+    }
+    return nodes[m_header->root];
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return whether the snapshot was written from the given source text
+ */
+bool Snapshot::isCurrent(std::string_view source) const
+{
+    return checksum64(source) == m_header->source_checksum;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the checksum of the source text
+ */
+std::uint64_t Snapshot::sourceChecksum() const
+{
+    return m_header->source_checksum;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the number of stored nodes
+ */
+std::uint64_t Snapshot::numNodes() const
+{
+    return m_header->num_nodes;
+}
+
+//---------------------------------------------------------------------------//
+// PRIVATE IMPLEMENTATION FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Validate the image and locate its sections
+ *
+ * Full validation checks that every record lies within its table and refers
+ * only to earlier nodes, so that the accessors cannot read outside the image
+ * or loop forever.
+ */
+void Snapshot::validate(Verify verify)
+{
+    auto invalid = [](const char* reason) {
+        throw Exception(std::string("Invalid snapshot: ") + reason);
+    };
+
+    // >>> HEADER
+    if (m_image.size() < sizeof(SnapshotHeader)
+        || std::memcmp(m_image.data(), snapshot_magic, sizeof(snapshot_magic))
+               != 0)
+    {
+        invalid("not a snapshot image");
+    }
+    if (reinterpret_cast<std::uintptr_t>(m_image.data()) % 8 != 0)
+    {
+        invalid("image is not aligned");
+    }
+    m_header = reinterpret_cast<const SnapshotHeader*>(m_image.data());
+    const SnapshotHeader& h = *m_header;
+    if (h.byte_order != byte_order_mark)
+    {
+        invalid("byte order differs from this machine");
+    }
+    if (h.version != version)
+    {
+        invalid("unsupported format version");
+    }
+
+    // Check the section sizes without overflow
+    const std::uint64_t available = m_image.size() - sizeof(SnapshotHeader);
+    std::uint64_t       offset    = 0;
+    auto section = [&](std::uint64_t count, std::uint64_t record_size) {
+        if (count > (available - offset) / record_size)
+        {
+            invalid("image is truncated");
+        }
+        std::uint64_t start = offset;
+        offset += padded(count * record_size);
+        if (offset > available)
+        {
+            invalid("image is truncated");
+        }
+        return m_image.data() + sizeof(SnapshotHeader) + start;
+    };
+    const char* nodes = section(h.num_nodes, sizeof(SnapshotNodeRecord));
+    const char* entries
+        = section(h.num_entries, sizeof(SnapshotEntryRecord));
+    const char* items   = section(h.num_items, sizeof(std::uint64_t));
+    const char* payload = section(h.payload_size, 1);
+    const char* strings = section(h.strings_size, 1);
+    if (offset != available)
+    {
+        invalid("unexpected data after the image");
+    }
+    if (h.root >= h.num_nodes)
+    {
+        invalid("root node is out of range");
+    }
+    m_nodes   = reinterpret_cast<const SnapshotNodeRecord*>(nodes);
+    m_entries = reinterpret_cast<const SnapshotEntryRecord*>(entries);
+    m_items   = reinterpret_cast<const std::uint64_t*>(items);
+    m_payload = payload;
+    m_strings = strings;
+
+    if (verify == Verify::Header)
+    {
+        return;
+    }
+
+    // >>> CHECKSUM
+    if (checksum64(m_image.data() + sizeof(SnapshotHeader), available)
+        != h.image_checksum)
+    {
+        invalid("checksum mismatch (the image is corrupt)");
+    }
+
+    // >>> RECORDS
+    auto string_ok = [&h](std::uint64_t first, std::uint64_t count) {
+        return first <= h.strings_size && count <= h.strings_size - first;
+    };
+    auto range_ok = [](std::uint64_t first, std::uint64_t count,
+                       std::uint64_t size) {
+        return first <= size && count <= size - first;
+    };
+    auto packed_ok = [this, &h](const SnapshotNodeRecord& rec) {
+        if (rec.extra > static_cast<std::uint64_t>(PackedArray::Type::Bool)
+            || rec.first % 8 != 0)
+        {
+            return false;
+        }
+        const auto          type = static_cast<PackedArray::Type>(rec.extra);
+        const std::uint64_t size = packedValueSize(type);
+        if (rec.first > h.payload_size
+            || rec.count > (h.payload_size - rec.first) / size)
+        {
+            return false;
+        }
+        // Every byte of a stored boolean must be a valid bool
+        const char* values = m_payload + rec.first;
+        return type != PackedArray::Type::Bool
+               || std::all_of(values, values + rec.count, [](char c) {
+                      return c == 0 || c == 1;
+                  });
+    };
+    auto items_ok = [this](std::uint64_t first, std::uint64_t count,
+                           std::uint64_t node) {
+        for (std::uint64_t j = 0; j < count; ++j)
+        {
+            if (m_items[first + j] >= node)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    for (std::uint64_t i = 0; i < h.num_nodes; ++i)
+    {
+        const auto& rec = m_nodes[i];
+        bool        ok  = false;
+        switch (static_cast<Kind>(rec.kind))
+        {
+            case Kind::Null:
+                ok = true;
+                break;
+            case Kind::Scalar:
+                ok = string_ok(rec.first, rec.count)
+                     && (rec.flags & ~quoted_scalar) == 0;
+                break;
+            case Kind::Alias:
+                ok = string_ok(rec.first, rec.count) && rec.extra < i;
+                break;
+            case Kind::Sequence:
+                if (rec.flags == packed_sequence)
+                {
+                    ok = packed_ok(rec);
+                    break;
+                }
+                ok = rec.flags == 0
+                     && range_ok(rec.first, rec.count, h.num_items)
+                     && items_ok(rec.first, rec.count, i);
+                break;
+            case Kind::Mapping:
+                ok = range_ok(rec.first, rec.count, h.num_entries)
+                     && range_ok(rec.extra, rec.num_extra, h.num_items)
+                     && items_ok(rec.extra, rec.num_extra, i);
+                for (std::uint64_t j = 0; ok && j < rec.count; ++j)
+                {
+                    const auto& e = m_entries[rec.first + j];
+                    ok = string_ok(e.key_offset, e.key_size) && e.value < i;
+                }
+                break;
+        }
+        if (!ok)
+        {
+            invalid("node record is out of range");
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Copy the values of a packed sequence into an array
+ */
+PackedArray Snapshot::packedArray(SnapshotNode node) const
+{
+    switch (node.packedType())
+    {
+        case PackedArray::Type::Int:
+            return PackedArray::fromValues(node.ints());
+        case PackedArray::Type::Float:
+            return PackedArray::fromValues(node.floats());
+        case PackedArray::Type::Bool:
+            return PackedArray::fromValues(node.bools());
+    }
+    YAYP_NOT_REACHABLE();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a string stored in the snapshot
+ */
+std::string_view
+Snapshot::string(std::uint64_t offset, std::uint64_t size) const
+{
+    return std::string_view(m_strings + offset, size);
+}
+
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Write a snapshot of a document
+ *
+ * \param[in,out] os      A binary stream to write to
+ * \param[in]     root    The root of the document
+ * \param[in]     source  The source text, whose checksum is stored
+ */
+void writeSnapshot(std::ostream&    os,
+                   const Node&      root,
+                   std::string_view source)
+{
+    YAYP_TIMER_DETAIL(Emit);
+
+    SnapshotWriter writer;
+    std::uint64_t  index = writer.add(root);
+    writer.write(os, index, checksum64(source));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Write a snapshot of a document to a file
+ *
+ * The snapshot is written to a uniquely named temporary file which then
+ * replaces the given file, so that readers never see a partially written
+ * snapshot and concurrent writers do not interfere.
+ *
+ * \param[in] filename  The snapshot file
+ * \param[in] root      The root of the document
+ * \param[in] source    The source text, whose checksum is stored
+ */
+void saveSnapshot(const std::string& filename,
+                  const Node&        root,
+                  std::string_view   source)
+{
+    const std::string temp = createTempFile(filename);
+    {
+        std::ofstream os(temp, std::ios::binary | std::ios::trunc);
+        if (!os)
+        {
+            std::remove(temp.c_str());
+            throw Exception("Unable to create snapshot file '" + temp + "'");
+        }
+        writeSnapshot(os, root, source);
+        os.close();
+        if (!os)
+        {
+            std::remove(temp.c_str());
+            throw Exception("Unable to write snapshot file '" + temp + "'");
+        }
+    }
+    if (std::rename(temp.c_str(), filename.c_str()) != 0)
+    {
+        std::remove(temp.c_str());
+        throw Exception("Unable to replace snapshot file '" + filename + "'");
+    }
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/Snapshot.cc
+//---------------------------------------------------------------------------//
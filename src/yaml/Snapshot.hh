@@ -0,0 +1,266 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/Snapshot.hh
+ * \brief  Snapshot class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_SNAPSHOT_HH
+#define YAYP_YAML_SNAPSHOT_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+#include "Node.hh"
+#include "PackedArray.hh"
+#include "core/MappedFile.hh"
+#include "core/Span.hh"
+
+namespace yayp
+{
+class Snapshot;
+
+namespace detail
+{
+struct SnapshotHeader;
+struct SnapshotNodeRecord;
+struct SnapshotEntryRecord;
+} // namespace detail
+
+//===========================================================================//
+/*!
+ * \class SnapshotNode
+ * \brief Read-only view of a node stored in a Snapshot.
+ *
+ * The accessors mirror those of Node, including the transparent resolution
+ * of aliases and the lookup of merged keys by find(), but return views into
+ * the snapshot instead of copies.  A default-constructed (or not found) view
+ * is null and converts to false.  Views remain valid as long as their
+ * snapshot, which must not be moved while they are in use.
+ *
+ * The items of a packed sequence are stored as typed values rather than as
+ * nodes: they are read through ints(), floats() or bools() instead of at().
+ */
+//===========================================================================//
+
+class SnapshotNode
+{
+  public:
+    //@{
+    //! Public type aliases
+    using Kind = Node::Kind;
+    //@}
+
+  public:
+    //! Construct a null view
+    SnapshotNode() = default;
+
+    //! Return whether the view refers to a node
+    explicit operator bool() const { return m_snapshot != nullptr; }
+
+    // Return the kind of this node (which may be an alias)
+    Kind kind() const;
+
+    //! Return whether this node is an alias
+    bool isAlias() const { return this->kind() == Kind::Alias; }
+
+    // Return the node this node refers to, following aliases
+    SnapshotNode resolve() const;
+
+    //! Return the kind of the resolved node
+    Kind resolvedKind() const { return this->resolve().kind(); }
+
+    // Return the value of a scalar
+    std::string_view scalar() const;
+
+    // Return whether a scalar was written in plain style
+    bool isPlain() const;
+
+    // Return the number of sequence items or own mapping entries
+    std::size_t size() const;
+
+    // Return the sequence item at the given index
+    SnapshotNode at(std::size_t index) const;
+
+    // Return whether this node is a sequence holding packed items
+    bool isPacked() const;
+
+    // Return the type of the items of a packed sequence
+    PackedArray::Type packedType() const;
+
+    // Return the items of a packed sequence of integers
+    Span<const std::int64_t> ints() const;
+
+    // Return the items of a packed sequence of floats
+    Span<const double> floats() const;
+
+    // Return the items of a packed sequence of booleans
+    Span<const bool> bools() const;
+
+    // Return the key of the own mapping entry at the given index
+    std::string_view keyAt(std::size_t index) const;
+
+    // Return the value of the own mapping entry at the given index
+    SnapshotNode valueAt(std::size_t index) const;
+
+    // Return the number of merged mappings
+    std::size_t numMerges() const;
+
+    // Return the merged mapping at the given index
+    SnapshotNode mergeAt(std::size_t index) const;
+
+    // Find the value of the given key in a mapping, including merged keys
+    SnapshotNode find(std::string_view key) const;
+
+    // Return the anchor name of an alias
+    std::string_view anchor() const;
+
+    // Return the aliased node
+    SnapshotNode target() const;
+
+    //! Return the index of the node in the snapshot
+    std::uint64_t index() const { return m_index; }
+
+  private:
+    friend class Snapshot;
+
+    // Construct a view of a node
+    SnapshotNode(const Snapshot* snapshot, std::uint64_t index);
+
+    // Return the record of the node
+    const detail::SnapshotNodeRecord& record() const;
+
+    // Return the values of a packed sequence of the given type
+    const void* packedValues(PackedArray::Type type) const;
+
+  private:
+    // >>> DATA
+    const Snapshot* m_snapshot = nullptr;
+    std::uint64_t   m_index    = 0;
+};
+
+//===========================================================================//
+/*!
+ * \class Snapshot
+ * \brief A parsed document stored in a relocatable binary format.
+ *
+ * writeSnapshot() serializes a document tree into a flat, versioned image
+ * that references nodes by index and strings by offset, so that it can be
+ * used directly from a mapped file with no parsing or pointer fix-ups:
+ *  - a fixed header (magic, format version, byte order, section sizes, and
+ *    the checksums of the image and of the source text);
+ *  - a table of fixed-size node records, in which each node follows its
+ *    children;
+ *  - tables of mapping entries and of sequence items and merges;
+ *  - a blob of the values of packed sequences, stored as the typed arrays of
+ *    their PackedArray, so that they are neither formatted nor parsed again;
+ *  - a blob of interned strings (each distinct scalar, key and anchor name
+ *    is stored once).
+ * Shared subtrees (anchors and their aliases) are stored once, preserving
+ * the structure of the tree.
+ *
+ * Opening a snapshot validates its header and, by default, the checksum of
+ * the whole image and the bounds of every record, throwing an Exception for
+ * an invalid or corrupt image.  A snapshot is stale when its source text has
+ * changed since it was written, which isCurrent() detects by comparing the
+ * stored source checksum.
+ *
+ * \example src/yaml/tests/tstSnapshot.cc
+ */
+//===========================================================================//
+
+class Snapshot
+{
+  public:
+    //! Amount of validation performed when opening a snapshot
+    enum class Verify
+    {
+        Header, //!< Check the header only (constant time)
+        Full    //!< Also check the image checksum and all records
+    };
+
+    //! Current format version
+    static constexpr std::uint32_t version = 2;
+
+  public:
+    // Open a snapshot file
+    static Snapshot open(const std::string& filename,
+                         Verify             verify = Verify::Full);
+
+    // Use a snapshot image held in memory, which must outlive the snapshot
+    static Snapshot fromImage(std::string_view image,
+                              Verify           verify = Verify::Full);
+
+    // Return the root node
+    SnapshotNode root() const;
+
+    // Return the node with the given index
+    SnapshotNode node(std::uint64_t index) const;
+
+    // Rebuild the document tree
+    NodePtr toNode() const;
+
+    // Return whether the snapshot was written from the given source text
+    bool isCurrent(std::string_view source) const;
+
+    // Return the checksum of the source text
+    std::uint64_t sourceChecksum() const;
+
+    // Return the number of stored nodes
+    std::uint64_t numNodes() const;
+
+    // >>> ACCESSORS
+    //! Return the image
+    std::string_view image() const { return m_image; }
+
+  private:
+    friend class SnapshotNode;
+
+    // Construct from an image
+    Snapshot(std::string_view image, MappedFile file, Verify verify);
+
+    // Validate the image
+    void validate(Verify verify);
+
+    // Copy the values of a packed sequence into an array
+    PackedArray packedArray(SnapshotNode node) const;
+
+    // Return a string stored in the snapshot
+    std::string_view string(std::uint64_t offset, std::uint64_t size) const;
+
+  private:
+    // >>> DATA
+    MappedFile                         m_file;
+    std::string_view                   m_image;
+    const detail::SnapshotHeader*      m_header  = nullptr;
+    const detail::SnapshotNodeRecord*  m_nodes   = nullptr;
+    const detail::SnapshotEntryRecord* m_entries = nullptr;
+    const std::uint64_t*               m_items   = nullptr;
+    const char*                        m_payload = nullptr;
+    const char*                        m_strings = nullptr;
+};
+
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+// Write a snapshot of a document
+void writeSnapshot(std::ostream&    os,
+                   const Node&      root,
+                   std::string_view source);
+
+// Write a snapshot of a document to a file
+void saveSnapshot(const std::string& filename,
+                  const Node&        root,
+                  std::string_view   source);
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_SNAPSHOT_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/Snapshot.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,492 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/StreamComparison.cc
+ * \brief  StreamComparison class definitions.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "StreamComparison.hh"
+
+#include <utility>
+
+#include "Node.hh"
+#include "harness/DBC.hh"
+#include "harness/SoftEqual.hh"
+
+namespace
+{
+using yayp::Event;
+using yayp::EventType;
+using yayp::PackedArray;
+using yayp::ScalarStyle;
+
+//---------------------------------------------------------------------------//
+//! Return whether a plain scalar denotes null
+bool isNull(std::string_view value)
+{
+    return value.empty() || value == "~" || value == "null" || value == "Null"
+           || value == "NULL";
+}
+
+//---------------------------------------------------------------------------//
+//! Return whether a packed array holds numbers
+bool isNumeric(const PackedArray& packed)
+{
+    return packed.type() != PackedArray::Type::Bool;
+}
+
+//---------------------------------------------------------------------------//
+//! Return an item of a packed array of numbers as a double
+double numberAt(const PackedArray& packed, std::size_t index)
+{
+    return packed.type() == PackedArray::Type::Int
+               ? static_cast<double>(packed.ints()[index])
+               : packed.floats()[index];
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Describe an event for a difference
+ */
+std::string describeEvent(const Event& event)
+{
+    switch (event.type)
+    {
+        case EventType::StreamEnd:
+            return "the end of the stream";
+        case EventType::DocumentStart:
+            return "the start of a document";
+        case EventType::DocumentEnd:
+            return "the end of the document";
+        case EventType::SequenceStart:
+        case EventType::PackedSequence:
+            return "a sequence";
+        case EventType::SequenceEnd:
+            return "the end of the sequence";
+        case EventType::MappingStart:
+            return "a mapping";
+        case EventType::MappingEnd:
+            return "the end of the mapping";
+        case EventType::Alias:
+            return "*" + std::string(event.value);
+        case EventType::Scalar:
+            if (event.style == ScalarStyle::Plain)
+            {
+                return std::string(event.value);
+            }
+            return "\"" + std::string(event.value) + "\"";
+    }
+    YAYP_NOT_REACHABLE();
+}
+
+//---------------------------------------------------------------------------//
+//! Describe the error of a scanner for a difference
+std::string describeError(const yayp::Scanner& scanner)
+{
+    return "invalid YAML: " + yayp::formatParseError(scanner.error());
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Write a mapping key as a step of a PathQuery expression
+ */
+void appendKey(std::string& path, const std::string& key)
+{
+    if (!key.empty() && key != "*"
+        && key.find_first_of(".[]") == std::string::npos)
+    {
+        if (!path.empty())
+        {
+            path += '.';
+        }
+        path += key;
+    }
+    else
+    {
+        const char quote = key.find('\'') == std::string::npos ? '\'' : '"';
+        path += '[';
+        path += quote;
+        path += key;
+        path += quote;
+        path += ']';
+    }
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace yayp
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor
+ *
+ * \param[in] rel_tol  The relative tolerance of numeric values
+ * \param[in] limits   The resource limits applied to both streams
+ */
+StreamComparison::StreamComparison(double rel_tol, const ParseLimits& limits)
+    : m_rel_tol(rel_tol)
+    , m_expected{Scanner({}, limits), nullptr, 0, {}}
+    , m_actual{Scanner({}, limits), nullptr, 0, {}}
+{
+    YAYP_REQUIRE(rel_tol > 0);
+    m_expected.scanner.enablePacking();
+    m_actual.scanner.enablePacking();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Compare two streams
+ *
+ * Nothing is thrown for invalid input: the error is recorded as the
+ * mismatch.
+ *
+ * \param[in] expected  The YAML text of the expected stream
+ * \param[in] actual    The YAML text of the actual stream
+ * \return Whether the streams have the same structure and equal values
+ */
+bool StreamComparison::compare(std::string_view expected,
+                               std::string_view actual)
+{
+    m_expected.scanner.reset(expected);
+    m_expected.packed = nullptr;
+    m_actual.scanner.reset(actual);
+    m_actual.packed = nullptr;
+    m_levels.clear();
+    m_document = 0;
+    m_count    = 0;
+    m_differences.clear();
+    m_mismatch.reset();
+
+    Event expected_event;
+    Event actual_event;
+    for (;;)
+    {
+        const bool expected_ok = read(m_expected, expected_event);
+        const bool actual_ok   = read(m_actual, actual_event);
+        if (!expected_ok || !actual_ok)
+        {
+            m_mismatch = Difference{m_document, this->path(), {}, {}};
+            m_mismatch->expected = expected_ok
+                                       ? describeEvent(expected_event)
+                                       : describeError(m_expected.scanner);
+            m_mismatch->actual = actual_ok ? describeEvent(actual_event)
+                                           : describeError(m_actual.scanner);
+            return false;
+        }
+
+        // Within a mapping, keys must match for the comparison to go on
+        if (!m_levels.empty() && m_levels.back().at_key)
+        {
+            Level& level = m_levels.back();
+            if (expected_event.type == EventType::MappingEnd
+                && actual_event.type == EventType::MappingEnd)
+            {
+                m_levels.pop_back();
+                this->advance();
+            }
+            else if (expected_event.type == EventType::Scalar
+                     && actual_event.type == EventType::Scalar
+                     && expected_event.value == actual_event.value)
+            {
+                level.key    = std::string(expected_event.value);
+                level.at_key = false;
+            }
+            else
+            {
+                return this->stop(expected_event, actual_event);
+            }
+            continue;
+        }
+
+        // Otherwise the nodes must be of the same kind
+        const EventType type = expected_event.type;
+        if (type != actual_event.type
+            && !(type == EventType::Scalar
+                 && actual_event.type == EventType::Alias)
+            && !(type == EventType::Alias
+                 && actual_event.type == EventType::Scalar))
+        {
+            return this->stop(expected_event, actual_event);
+        }
+
+        switch (type)
+        {
+            case EventType::StreamEnd:
+                return m_count == 0;
+            case EventType::DocumentStart:
+                break;
+            case EventType::DocumentEnd:
+                ++m_document;
+                break;
+            case EventType::Scalar:
+            case EventType::Alias:
+                if (!this->equalValues(expected_event, actual_event)
+                    && this->countDifference())
+                {
+                    this->storeDifference(describeEvent(expected_event),
+                                          describeEvent(actual_event));
+                }
+                this->advance();
+                break;
+            case EventType::SequenceStart:
+                m_levels.push_back(Level());
+                this->comparePacked();
+                break;
+            case EventType::MappingStart:
+                m_levels.push_back(Level());
+                m_levels.back().mapping = true;
+                m_levels.back().at_key  = true;
+                break;
+            case EventType::SequenceEnd:
+                m_levels.pop_back();
+                this->advance();
+                break;
+            case EventType::MappingEnd:
+            case EventType::PackedSequence:
+                // Handled with the keys, or expanded by read()
+                YAYP_NOT_REACHABLE();
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+// PRIVATE FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Read the next event of a stream
+ *
+ * A packed sequence is read as the start of a sequence followed by a plain
+ * scalar for each of its items (in the text PackedArray::format() gives
+ * them) and the end of the sequence, so that it can be compared with a
+ * sequence of the other stream whatever way that one is written.
+ */
+bool StreamComparison::read(Input& input, Event& event)
+{
+    if (input.packed)
+    {
+        if (input.packed_next < input.packed->size())
+        {
+            input.item   = input.packed->format(input.packed_next++);
+            event.type   = EventType::Scalar;
+            event.style  = ScalarStyle::Plain;
+            event.value  = input.item;
+            event.anchor = {};
+        }
+        else
+        {
+            event.type = EventType::SequenceEnd;
+            input.packed.reset();
+        }
+        return true;
+    }
+
+    if (!input.scanner.next(event))
+    {
+        return false;
+    }
+    if (event.type == EventType::PackedSequence)
+    {
+        input.packed      = std::move(event.packed);
+        input.packed_next = 0;
+        event.type        = EventType::SequenceStart;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Compare two packed sequences that have just started in bulk
+ *
+ * Sequences of numbers (or of booleans) of the same length are compared
+ * directly from their arrays, contiguous floats with
+ * SoftEqual::forEachUnequal(), and are then read as ended.  Any other pair
+ * of sequences is left to be compared item by item.
+ */
+void StreamComparison::comparePacked()
+{
+    const PackedArray* expected = m_expected.packed.get();
+    const PackedArray* actual   = m_actual.packed.get();
+    if (!expected || !actual || expected->size() != actual->size()
+        || isNumeric(*expected) != isNumeric(*actual))
+    {
+        return;
+    }
+    YAYP_CHECK(m_expected.packed_next == 0 && m_actual.packed_next == 0);
+
+    Level&            level = m_levels.back();
+    const std::size_t size  = expected->size();
+    auto              visit = [&](std::size_t index) {
+        if (this->countDifference())
+        {
+            level.index = index;
+            this->storeDifference(expected->format(index),
+                                  actual->format(index));
+        }
+        return true;
+    };
+
+    SoftEqual<double, double> se(m_rel_tol);
+    if (expected->type() == PackedArray::Type::Float
+        && actual->type() == PackedArray::Type::Float)
+    {
+        se.forEachUnequal(
+            expected->floats().data(), actual->floats().data(), size, visit);
+    }
+    else if (isNumeric(*expected))
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (!se(numberAt(*expected, i), numberAt(*actual, i)))
+            {
+                visit(i);
+            }
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (expected->bools()[i] != actual->bools()[i])
+            {
+                visit(i);
+            }
+        }
+    }
+
+    level.index            = size;
+    m_expected.packed_next = size;
+    m_actual.packed_next   = size;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return whether two scalar or alias events are equal
+ */
+bool StreamComparison::equalValues(const Event& expected,
+                                   const Event& actual) const
+{
+    if (expected.type != actual.type)
+    {
+        return false;
+    }
+    if (expected.type == EventType::Alias)
+    {
+        return expected.value == actual.value;
+    }
+
+    // A plain scalar that is a null or a number is only equal to another
+    const bool expected_plain  = expected.style == ScalarStyle::Plain;
+    const bool actual_plain    = actual.style == ScalarStyle::Plain;
+    double     expected_number = 0;
+    double     actual_number   = 0;
+    const bool expected_typed
+        = expected_plain
+          && (isNull(expected.value)
+              || decodeNumber(expected.value, expected_number));
+    const bool actual_typed
+        = actual_plain
+          && (isNull(actual.value)
+              || decodeNumber(actual.value, actual_number));
+    if (!expected_typed || !actual_typed)
+    {
+        return expected_typed == actual_typed
+               && expected.value == actual.value;
+    }
+    if (isNull(expected.value) || isNull(actual.value))
+    {
+        return isNull(expected.value) && isNull(actual.value);
+    }
+    return expected.value == actual.value
+           || softEqual(expected_number, actual_number, m_rel_tol);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Count an unequal value
+ *
+ * \return Whether the difference is among the first ones, to be stored
+ */
+bool StreamComparison::countDifference()
+{
+    ++m_count;
+    return m_differences.size() < max_stored;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Store an unequal value at the current path
+ */
+void StreamComparison::storeDifference(std::string expected,
+                                       std::string actual)
+{
+    m_differences.push_back(Difference{
+        m_document, this->path(), std::move(expected), std::move(actual)});
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Record the structural mismatch that stops the comparison
+ *
+ * \return false, the result of the comparison
+ */
+bool StreamComparison::stop(const Event& expected, const Event& actual)
+{
+    m_mismatch = Difference{m_document,
+                            this->path(),
+                            describeEvent(expected),
+                            describeEvent(actual)};
+    return false;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Advance past a completed value within the innermost collection
+ */
+void StreamComparison::advance()
+{
+    if (m_levels.empty())
+    {
+        return;
+    }
+    Level& level = m_levels.back();
+    if (level.mapping)
+    {
+        level.at_key = true;
+    }
+    else
+    {
+        ++level.index;
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the path of the current node
+ *
+ * Within a mapping that expects a key, this is the path of the mapping.
+ */
+std::string StreamComparison::path() const
+{
+    std::string path;
+    for (const Level& level : m_levels)
+    {
+        if (!level.mapping)
+        {
+            path += '[' + std::to_string(level.index) + ']';
+        }
+        else if (!level.at_key)
+        {
+            appendKey(path, level.key);
+        }
+    }
+    return path;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/StreamComparison.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,169 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/StreamComparison.hh
+ * \brief  StreamComparison class declaration.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_STREAMCOMPARISON_HH
+#define YAYP_YAML_STREAMCOMPARISON_HH
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "PackedArray.hh"
+#include "ResourceGuard.hh"
+#include "Scanner.hh"
+
+namespace yayp
+{
+//===========================================================================//
+/*!
+ * \class StreamComparison
+ * \brief Compares two YAML streams without building the documents.
+ *
+ * The two streams are read in parallel by two Scanners, so the memory used
+ * is bounded by the nesting depth and not by the size of the inputs: two
+ * memory-mapped files of several gigabytes are compared without either
+ * document being built.
+ *
+ * The streams must have the same structure: the same documents, holding
+ * the same collections, with sequences of the same length and mappings with
+ * the same keys in the same order.  The comparison stops at the first
+ * structural mismatch (or invalid input), which is recorded as mismatch().
+ * Within that structure the values (scalar leaves) are compared one by one,
+ * and every unequal value is counted without stopping the comparison:
+ *  - plain scalars that are numbers of the YAML 1.2 core schema (see
+ *    decodeNumber()) are compared with SoftEqual, using the given relative
+ *    tolerance;
+ *  - plain nulls (\c ~, \c null, empty, ...) are equal to one another;
+ *  - other scalars, including quoted numbers, are compared as text, whatever
+ *    style they are written in;
+ *  - aliases are compared by name, and anchors are ignored.
+ * Only the first few unequal values are stored as differences(), so that
+ * comparing two huge streams that differ everywhere does not need memory
+ * proportional to their size.
+ *
+ * Each difference is located by its document and its path, written as a
+ * PathQuery expression (e.g., \c jobs[3].resources.memory).  Flow sequences
+ * of numbers are read as packed sequences and compared in bulk.
+ *
+ * \example src/yaml/tests/tstStreamComparison.cc
+ */
+//===========================================================================//
+
+class StreamComparison
+{
+  public:
+    //! A difference between the two streams
+    struct Difference
+    {
+        //! Index of the document in the stream
+        std::size_t document = 0;
+
+        //! Path of the node in the document, as a PathQuery expression
+        std::string path;
+
+        //! The expected node
+        std::string expected;
+
+        //! The actual node
+        std::string actual;
+    };
+
+    //! Public type aliases
+    using Differences = std::vector<Difference>;
+
+    //! Number of stored differences
+    static constexpr std::size_t max_stored = 30;
+
+  public:
+    // Constructor
+    explicit StreamComparison(double             rel_tol = 1.0e-12,
+                              const ParseLimits& limits  = ParseLimits());
+
+    // Compare two streams, returning whether they are equal
+    bool compare(std::string_view expected, std::string_view actual);
+
+    // >>> ACCESSORS
+    //! Return the tolerance of the relative difference
+    double relTol() const { return m_rel_tol; }
+
+    //! Return the number of unequal values found by the last comparison
+    std::size_t count() const { return m_count; }
+
+    //! Return the first unequal values, in stream order
+    const Differences& differences() const { return m_differences; }
+
+    //! Return the structural mismatch that stopped the comparison, if any
+    const std::optional<Difference>& mismatch() const { return m_mismatch; }
+
+  private:
+    //! One of the two streams being read
+    struct Input
+    {
+        Scanner                            scanner;
+        std::shared_ptr<const PackedArray> packed;
+        std::size_t                        packed_next = 0;
+        std::string                        item;
+    };
+
+    //! An open collection
+    struct Level
+    {
+        bool        mapping = false;
+        bool        at_key  = false;
+        std::size_t index   = 0;
+        std::string key;
+    };
+
+  private:
+    // >>> IMPLEMENTATION
+    // Read the next event of a stream, expanding packed sequences
+    static bool read(Input& input, Event& event);
+
+    // Compare two packed sequences in bulk
+    void comparePacked();
+
+    // Return whether two scalar or alias events are equal
+    bool equalValues(const Event& expected, const Event& actual) const;
+
+    // Count an unequal value, returning whether to store it
+    bool countDifference();
+
+    // Store an unequal value at the current path
+    void storeDifference(std::string expected, std::string actual);
+
+    // Record the mismatch that stops the comparison
+    bool stop(const Event& expected, const Event& actual);
+
+    // Advance past a completed value
+    void advance();
+
+    // Return the path of the current node
+    std::string path() const;
+
+  private:
+    // >>> DATA
+    double                    m_rel_tol;
+    Input                     m_expected;
+    Input                     m_actual;
+    std::vector<Level>        m_levels;
+    std::size_t               m_document = 0;
+    std::size_t               m_count    = 0;
+    Differences               m_differences;
+    std::optional<Difference> m_mismatch;
+};
+
+//---------------------------------------------------------------------------//
+} // namespace yayp
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_STREAMCOMPARISON_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/StreamComparison.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,396 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/benchmarks/Corpus.cc
+ * \brief  Deterministic generator of a YAML benchmark corpus.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "Corpus.hh"
+
+#include "harness/DBC.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+//! Words of the generated names and text
+const char* const words[] = {
+    "alpha",  "beta",   "gamma",  "delta",   "flux",    "mesh",   "cell",
+    "energy", "photon", "neutron", "source", "tally",   "region", "surface",
+    "batch",  "queue",  "worker", "cache",   "gateway", "proxy",  "store",
+    "index",  "shard",  "replica", "backup", "monitor", "alert",  "report",
+};
+
+//! Number of words
+constexpr std::size_t num_words = sizeof(words) / sizeof(words[0]);
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Portable pseudo-random numbers and the text made from them
+ *
+ * The SplitMix64 sequence is fully specified by its seed, and every value is
+ * formatted with integer arithmetic only.
+ */
+class Random
+{
+  public:
+    //! Construct with a seed
+    explicit Random(std::uint64_t seed) : m_state(seed) {}
+
+    //! Return the next number of the sequence
+    std::uint64_t next()
+    {
+        std::uint64_t z = (m_state += 0x9e3779b97f4a7c15ull);
+        z               = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z               = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    //! Return a number in [0, n)
+    std::size_t below(std::size_t n) { return this->next() % n; }
+
+    //! Return a number in [first, last]
+    std::size_t between(std::size_t first, std::size_t last)
+    {
+        return first + this->below(last - first + 1);
+    }
+
+    //! Return a random word
+    const char* word() { return words[this->below(num_words)]; }
+
+    //! Return a random integer with at most the given number of digits
+    std::string integer(int digits)
+    {
+        std::size_t limit = 1;
+        for (int i = 0; i < digits; ++i)
+        {
+            limit *= 10;
+        }
+        return std::to_string(this->below(limit));
+    }
+
+    //! Return a random decimal number, with some of them negative
+    std::string decimal()
+    {
+        std::string result = this->below(4) == 0 ? "-" : "";
+        result += this->integer(3);
+        std::string frac = std::to_string(this->below(1000000));
+        result += '.';
+        result.append(6 - frac.size(), '0');
+        return result += frac;
+    }
+
+    //! Return a line of random words of about the given length
+    std::string sentence(std::size_t length)
+    {
+        std::string line = this->word();
+        while (line.size() < length)
+        {
+            line += ' ';
+            line += this->word();
+        }
+        return line;
+    }
+
+    //! Return a random timestamp in 2023
+    std::string timestamp()
+    {
+        std::string result = "2023";
+        const char* seps[] = {"-", "-", "T", ":", ":"};
+        std::size_t firsts[] = {1, 1, 0, 0, 0};
+        std::size_t lasts[]  = {12, 28, 23, 59, 59};
+        for (int i = 0; i < 5; ++i)
+        {
+            std::string field = std::to_string(
+                this->between(firsts[i], lasts[i]));
+            result += seps[i];
+            result += field.size() < 2 ? "0" + field : field;
+        }
+        return result += 'Z';
+    }
+
+  private:
+    std::uint64_t m_state;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Append a Kubernetes-like deployment manifest as a list item
+ *
+ * Like the other appenders, it draws each random value in its own statement,
+ * since the order in which the operands of + are evaluated is unspecified.
+ */
+void appendManifest(std::string& out, Random& rng, std::size_t index)
+{
+    const std::string app = rng.word() + ("-" + std::to_string(index));
+    out += "  - apiVersion: apps/v1\n"
+           "    kind: Deployment\n"
+           "    metadata:\n"
+           "      name: " + app + "\n"
+           "      namespace: ";
+    out += rng.word();
+    out += "\n"
+           "      labels:\n"
+           "        app: " + app + "\n"
+           "        tier: ";
+    out += rng.word();
+    out += "\n"
+           "      annotations:\n"
+           "        deployment.kubernetes.io/revision: \"";
+    out += rng.integer(2);
+    out += "\"\n"
+           "    spec:\n"
+           "      replicas: ";
+    out += std::to_string(rng.between(1, 9));
+    out += "\n"
+           "      selector:\n"
+           "        matchLabels:\n"
+           "          app: " + app + "\n"
+           "      template:\n"
+           "        metadata:\n"
+           "          labels:\n"
+           "            app: " + app + "\n"
+           "        spec:\n"
+           "          containers:\n";
+    for (std::size_t c = rng.between(1, 3); c > 0; --c)
+    {
+        out += "            - name: ";
+        out += rng.word();
+        out += "\n"
+               "              image: \"registry.example.com/";
+        out += rng.word();
+        out += ":1.";
+        out += rng.integer(1);
+        out += '.';
+        out += rng.integer(2);
+        out += "\"\n"
+               "              ports:\n"
+               "                - containerPort: ";
+        out += std::to_string(rng.between(1024, 65535));
+        out += "\n"
+               "                  protocol: TCP\n"
+               "              env:\n";
+        for (std::size_t e = rng.between(1, 4); e > 0; --e)
+        {
+            out += "                - name: ";
+            out += rng.word();
+            out += "_LEVEL\n"
+                   "                  value: ";
+            out += rng.word();
+            out += '\n';
+        }
+        out += "              resources:\n"
+               "                limits:\n"
+               "                  cpu: ";
+        out += std::to_string(rng.between(1, 20) * 100);
+        out += "m\n"
+               "                  memory: ";
+        out += std::to_string(rng.between(1, 16) * 128);
+        out += "Mi\n";
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Append a flat record as a sequence item
+ */
+void appendRecord(std::string& out, Random& rng, std::size_t index)
+{
+    const std::string first = rng.word();
+    const std::string last  = rng.word();
+    out += "- id: " + std::to_string(index) + "\n  name: " + first + " "
+           + last + "\n  email: \"" + first + "." + last
+           + "@example.com\"\n  score: ";
+    out += rng.decimal();
+    out += "\n  active: ";
+    out += rng.below(2) ? "true" : "false";
+    out += "\n  created: ";
+    out += rng.timestamp();
+    out += "\n  tags: [";
+    for (int i = 0; i < 3; ++i)
+    {
+        out += i ? ", " : "";
+        out += rng.word();
+    }
+    out += "]\n";
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Append a series holding huge flow arrays of integers and floats
+ */
+void appendSeries(std::string& out, Random& rng, std::size_t index)
+{
+    out += "  - name: series" + std::to_string(index) + "\n    counts: [";
+    for (std::size_t i = 0; i < 4096; ++i)
+    {
+        out += i ? ", " : "";
+        out += rng.integer(6);
+    }
+    out += "]\n    values: [";
+    for (std::size_t i = 0; i < 16384; ++i)
+    {
+        out += i ? ", " : "";
+        out += rng.decimal();
+    }
+    out += "]\n";
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Append an item holding a long literal and a long folded scalar
+ */
+void appendBlockScalars(std::string& out, Random& rng, std::size_t index)
+{
+    out += "- id: " + std::to_string(index) + "\n  script: |\n";
+    for (std::size_t n = rng.between(5, 40); n > 0; --n)
+    {
+        out += "    ";
+        out += rng.sentence(rng.between(20, 100));
+        out += '\n';
+    }
+    out += "  description: >\n";
+    for (std::size_t n = rng.between(5, 40); n > 0; --n)
+    {
+        out += "    ";
+        out += rng.sentence(rng.between(40, 80));
+        out += rng.below(8) == 0 ? "\n\n" : "\n";
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Append anchored defaults and services that alias and merge them
+ */
+void appendAnchors(std::string& out, Random& rng, std::size_t index)
+{
+    const std::string n = std::to_string(index);
+    out += "defaults" + n + ": &defaults" + n + "\n  image: ";
+    out += rng.word();
+    out += ":latest\n  restart: always\n  ports: &ports" + n + " [";
+    out += rng.integer(4);
+    out += ", ";
+    out += rng.integer(4);
+    out += "]\n  environment: &env" + n + "\n    LOG_LEVEL: ";
+    out += rng.word();
+    out += "\n    REGION: ";
+    out += rng.word();
+    out += "\nservices" + n + ":\n";
+    for (std::size_t s = rng.between(4, 12); s > 0; --s)
+    {
+        out += "  - name: ";
+        out += rng.word();
+        out += "\n    <<: *defaults" + n + "\n    replicas: ";
+        out += std::to_string(rng.between(1, 9));
+        out += "\n    ports: *ports" + n + "\n    environment: *env" + n
+               + "\n";
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Append a small document, like an event of a log stream
+ */
+void appendDocument(std::string& out, Random& rng, std::size_t index)
+{
+    out += "---\nid: " + std::to_string(index) + "\nevent: ";
+    out += rng.word();
+    out += "\ntimestamp: ";
+    out += rng.timestamp();
+    out += "\nlevel: ";
+    out += rng.below(4) ? "info" : "warning";
+    out += "\nmessage: \"";
+    out += rng.sentence(rng.between(20, 60));
+    out += "\"\nvalues: [";
+    for (int i = 0; i < 3; ++i)
+    {
+        out += i ? ", " : "";
+        out += rng.decimal();
+    }
+    out += "]\n";
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+namespace corpus
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the name of a shape
+ */
+const char* name(Shape shape)
+{
+    switch (shape)
+    {
+        case Shape::Manifests:
+            return "manifests";
+        case Shape::Records:
+            return "records";
+        case Shape::Arrays:
+            return "arrays";
+        case Shape::BlockScalars:
+            return "block_scalars";
+        case Shape::Anchors:
+            return "anchors";
+        case Shape::Documents:
+            return "documents";
+    }
+    YAYP_NOT_REACHABLE();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Generate a stream of the given shape of at least the given size
+ *
+ * Items of the shape are appended until the size is reached, so the stream
+ * is at most one item larger.
+ */
+std::string generate(Shape shape, std::size_t size, std::uint64_t seed)
+{
+    using Append = void (*)(std::string&, Random&, std::size_t);
+    Append      append = nullptr;
+    std::string out;
+    switch (shape)
+    {
+        case Shape::Manifests:
+            out    = "apiVersion: v1\nkind: List\nitems:\n";
+            append = appendManifest;
+            break;
+        case Shape::Records:
+            append = appendRecord;
+            break;
+        case Shape::Arrays:
+            out    = "series:\n";
+            append = appendSeries;
+            break;
+        case Shape::BlockScalars:
+            append = appendBlockScalars;
+            break;
+        case Shape::Anchors:
+            append = appendAnchors;
+            break;
+        case Shape::Documents:
+            append = appendDocument;
+            break;
+    }
+    if (!append)
+    {
+        YAYP_NOT_REACHABLE();
+    }
+
+    out.reserve(size + (1 << 20));
+    Random rng(seed);
+    for (std::size_t index = 0; out.size() < size; ++index)
+    {
+        append(out, rng, index);
+    }
+    return out;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace corpus
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/benchmarks/Corpus.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,73 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/benchmarks/Corpus.hh
+ * \brief  Deterministic generator of a YAML benchmark corpus.
+ *
+ * The corpus covers the shapes of YAML found in practice, one stream per
+ * shape, each growing to a requested size:
+ *  - \c manifests: deep block mappings, like Kubernetes manifests;
+ *  - \c records: a block sequence of flat records;
+ *  - \c arrays: huge flow sequences of integers and floats;
+ *  - \c block_scalars: long literal and folded block scalars;
+ *  - \c anchors: configurations sharing anchored defaults through aliases
+ *    and merge keys;
+ *  - \c documents: a stream of many small documents.
+ *
+ * The text depends only on the shape, the size and the seed: the random
+ * numbers are drawn from a SplitMix64 sequence and formatted without the
+ * standard distributions or the C locale, whose results vary between
+ * platforms, so that benchmark numbers are comparable across machines and
+ * releases.
+ *
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+#ifndef YAYP_YAML_BENCHMARKS_CORPUS_HH
+#define YAYP_YAML_BENCHMARKS_CORPUS_HH
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace corpus
+{
+//! A shape of YAML
+enum class Shape
+{
+    Manifests,
+    Records,
+    Arrays,
+    BlockScalars,
+    Anchors,
+    Documents
+};
+
+//! All the shapes, in corpus order
+constexpr std::array<Shape, 6> shapes = {Shape::Manifests,
+                                         Shape::Records,
+                                         Shape::Arrays,
+                                         Shape::BlockScalars,
+                                         Shape::Anchors,
+                                         Shape::Documents};
+
+//! Seed of the standard corpus
+constexpr std::uint64_t default_seed = 20230615;
+
+//! Size of each stream of the standard corpus, in bytes
+constexpr std::size_t default_size = 4 << 20;
+
+// Return the name of a shape
+const char* name(Shape shape);
+
+// Generate a stream of the given shape of at least the given size
+std::string generate(Shape         shape,
+                     std::size_t   size = default_size,
+                     std::uint64_t seed = default_seed);
+} // namespace corpus
+
+//---------------------------------------------------------------------------//
+#endif // YAYP_YAML_BENCHMARKS_CORPUS_HH
+//---------------------------------------------------------------------------//
+// end of src/yaml/benchmarks/Corpus.hh
+//---------------------------------------------------------------------------//
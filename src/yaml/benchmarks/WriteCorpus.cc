@@ -0,0 +1,58 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/benchmarks/WriteCorpus.cc
+ * \brief  Writes the YAML benchmark corpus to files.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ *
+ * Usage: \c WriteCorpus \c directory [\c size [\c seed]]
+ *
+ * Writes one file per shape of the corpus, \c <shape>.yaml, of at least the
+ * given size in bytes, so that other parsers or tools can be measured on the
+ * same inputs as bmCorpus.  The defaults are those of the standard corpus.
+ */
+//---------------------------------------------------------------------------//
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "Corpus.hh"
+
+//---------------------------------------------------------------------------//
+// MAIN
+//---------------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 4)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <directory> [size (bytes) [seed]]\n";
+        return 2;
+    }
+    const std::size_t size = argc > 2 ? std::strtoull(argv[2], nullptr, 10)
+                                      : corpus::default_size;
+    const std::uint64_t seed = argc > 3
+                                   ? std::strtoull(argv[3], nullptr, 10)
+                                   : corpus::default_seed;
+
+    for (corpus::Shape shape : corpus::shapes)
+    {
+        const std::string filename = std::string(argv[1]) + "/"
+                                     + corpus::name(shape) + ".yaml";
+        const std::string text     = corpus::generate(shape, size, seed);
+        std::ofstream     out(filename, std::ios::binary);
+        if (!out.write(text.data(), static_cast<std::streamsize>(text.size())))
+        {
+            std::cerr << "Error: cannot write " << filename << '\n';
+            return 2;
+        }
+        std::cout << filename << ": " << text.size() << " bytes\n";
+    }
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/benchmarks/WriteCorpus.cc
+//---------------------------------------------------------------------------//
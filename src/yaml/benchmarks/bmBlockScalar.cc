@@ -0,0 +1,104 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/benchmarks/bmBlockScalar.cc
+ * \brief  Benchmarks for class BlockScalar.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../BlockScalar.hh"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build a block scalar of roughly 10 MB with the given header and
+ *        content indentation, followed by a less-indented mapping key
+ */
+std::string makeBlock(const std::string& header, std::size_t indent)
+{
+    constexpr std::size_t size = 10 * 1024 * 1024;
+
+    const std::string prefix(indent, ' ');
+    std::string       block = header + "\n";
+    block.reserve(size + 1024);
+    std::size_t line = 0;
+    while (block.size() < size)
+    {
+        block += prefix;
+        block += "echo \"embedded script line ";
+        block += std::to_string(line++);
+        block += "\" >> /var/log/output.log\n";
+        if (line % 16 == 0)
+        {
+            block += "\n";
+        }
+    }
+    block += "next: value\n";
+    return block;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Fold the given block scalar and report the throughput
+ */
+void foldBlock(benchmark::State& state, const std::string& block, int parent)
+{
+    for (auto _ : state)
+    {
+        yayp::BlockScalar scalar(block, parent);
+        benchmark::DoNotOptimize(scalar.value().data());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(block.size()));
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// BENCHMARKS
+//---------------------------------------------------------------------------//
+
+static void BM_LiteralTopLevel(benchmark::State& state)
+{
+    // Zero-copy path: the value is a view into the input
+    static const std::string block = makeBlock("|", 0);
+    foldBlock(state, block, -1);
+}
+BENCHMARK(BM_LiteralTopLevel)->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------//
+
+static void BM_LiteralIndented(benchmark::State& state)
+{
+    static const std::string block = makeBlock("|", 4);
+    foldBlock(state, block, 2);
+}
+BENCHMARK(BM_LiteralIndented)->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------//
+
+static void BM_FoldedIndented(benchmark::State& state)
+{
+    static const std::string block = makeBlock(">", 4);
+    foldBlock(state, block, 2);
+}
+BENCHMARK(BM_FoldedIndented)->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------//
+
+static void BM_KeepIndented(benchmark::State& state)
+{
+    static const std::string block = makeBlock("|+", 4);
+    foldBlock(state, block, 2);
+}
+BENCHMARK(BM_KeepIndented)->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/benchmarks/bmBlockScalar.cc
+//---------------------------------------------------------------------------//
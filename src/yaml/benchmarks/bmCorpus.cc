@@ -0,0 +1,275 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/benchmarks/bmCorpus.cc
+ * \brief  Throughput benchmarks over the standard YAML corpus.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ *
+ * Each stage of the processing of a YAML stream is run on every shape of the
+ * corpus (see Corpus.hh), reporting the throughput in bytes of YAML per
+ * second and the number of heap allocations per megabyte of YAML (counted
+ * with an AllocationCounter):
+ *  - \c BM_Scan reads the parse events with a Scanner, also reporting the
+ *    instructions per cycle and the branch, cache and L1D misses per byte
+ *    when the hardware counters are available (see PerfCounters);
+ *  - \c BM_Build parses the documents into Node trees;
+ *  - \c BM_Decode decodes every scalar of the trees as a number of the core
+ *    schema, where possible, and sums the packed sequences;
+ *  - \c BM_Emit writes the trees as snapshots, which is how this library
+ *    serializes documents.
+ */
+//---------------------------------------------------------------------------//
+
+#include "Corpus.hh"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "harness/AllocationCounter.hh"
+#include "harness/PerfCounters.hh"
+
+#include "../Node.hh"
+#include "../PackedArray.hh"
+#include "../Parser.hh"
+#include "../Scanner.hh"
+#include "../Snapshot.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the corpus stream of a shape, generated on first use
+ */
+const std::string& corpusText(corpus::Shape shape)
+{
+    static std::array<std::string, corpus::shapes.size()> texts;
+    std::string& text = texts[static_cast<std::size_t>(shape)];
+    if (text.empty())
+    {
+        text = corpus::generate(shape);
+    }
+    return text;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Decode the scalars of a tree, skipping aliases
+ */
+double decode(const yayp::Node& node)
+{
+    double sum = 0;
+    switch (node.kind())
+    {
+        case yayp::Node::Kind::Scalar: {
+            double value = 0;
+            if (yayp::decodeNumber(node.scalar(), value))
+            {
+                sum += value;
+            }
+            break;
+        }
+        case yayp::Node::Kind::Sequence:
+            if (const yayp::PackedArray* packed = node.packed())
+            {
+                for (double value : packed->floats())
+                {
+                    sum += value;
+                }
+                for (auto value : packed->ints())
+                {
+                    sum += static_cast<double>(value);
+                }
+                break;
+            }
+            for (const auto& item : node.items())
+            {
+                sum += decode(*item);
+            }
+            break;
+        case yayp::Node::Kind::Mapping:
+            for (const auto& entry : node.entries())
+            {
+                sum += decode(*entry.second);
+            }
+            break;
+        case yayp::Node::Kind::Null:
+        case yayp::Node::Kind::Alias:
+            break;
+    }
+    return sum;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Report the throughput and allocations of a benchmark over a stream
+ */
+void report(benchmark::State&  state,
+            const std::string& text,
+            std::size_t        allocations)
+{
+    const double megabytes = static_cast<double>(state.iterations())
+                             * static_cast<double>(text.size()) / 1.0e6;
+    state.counters["allocs_per_MB"] = static_cast<double>(allocations)
+                                      / megabytes;
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(text.size()));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Report the hardware counters of a benchmark over a stream
+ *
+ * Only the events that were counted are reported.
+ */
+void reportPerf(benchmark::State&       state,
+                const std::string&      text,
+                const yayp::PerfCounts& counts)
+{
+    using yayp::PerfEvent;
+
+    const auto bytes = static_cast<std::size_t>(state.iterations())
+                       * text.size();
+    if (counts.has(PerfEvent::Instructions) && counts.has(PerfEvent::Cycles))
+    {
+        state.counters["IPC"] = counts.ipc();
+    }
+    const std::pair<PerfEvent, const char*> misses[] = {
+        {PerfEvent::BranchMisses, "branch_misses_per_B"},
+        {PerfEvent::CacheMisses, "cache_misses_per_B"},
+        {PerfEvent::L1DMisses, "L1D_misses_per_B"},
+    };
+    for (const auto& [event, name] : misses)
+    {
+        if (counts.has(event))
+        {
+            state.counters[name] = counts.per(event, bytes);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// BENCHMARKS
+//---------------------------------------------------------------------------//
+
+static void BM_Scan(benchmark::State& state, corpus::Shape shape)
+{
+    // Read the events as the parser does, with packing
+    const std::string&            text = corpusText(shape);
+    yayp::Scanner                 scanner;
+    scanner.enablePacking();
+    const yayp::AllocationCounter counter;
+    const yayp::PerfCounters      perf;
+    for (auto _ : state)
+    {
+        scanner.reset(text);
+        yayp::Event event;
+        while (scanner.next(event) && event.type != yayp::EventType::StreamEnd)
+        {
+            benchmark::DoNotOptimize(event);
+        }
+    }
+    if (scanner.error().code != yayp::ParseErrorCode::None)
+    {
+        state.SkipWithError(yayp::describe(scanner.error().code));
+    }
+    reportPerf(state, text, perf.counts());
+    report(state, text, counter.counts().allocations);
+}
+
+//---------------------------------------------------------------------------//
+
+static void BM_Build(benchmark::State& state, corpus::Shape shape)
+{
+    // Parse every document of the stream
+    const std::string&            text = corpusText(shape);
+    yayp::Parser                  parser;
+    const yayp::AllocationCounter counter;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parser.parseAll(text));
+    }
+    report(state, text, counter.counts().allocations);
+}
+
+//---------------------------------------------------------------------------//
+
+static void BM_Decode(benchmark::State& state, corpus::Shape shape)
+{
+    // Decode the values of the parsed documents
+    const std::string&            text      = corpusText(shape);
+    const auto                    documents = yayp::Parser().parseAll(text);
+    const yayp::AllocationCounter counter;
+    for (auto _ : state)
+    {
+        for (const auto& doc : documents)
+        {
+            benchmark::DoNotOptimize(decode(*doc));
+        }
+    }
+    report(state, text, counter.counts().allocations);
+}
+
+//---------------------------------------------------------------------------//
+
+static void BM_Emit(benchmark::State& state, corpus::Shape shape)
+{
+    // Serialize the parsed documents, without a source checksum since the
+    // documents of a stream share one source
+    const std::string&            text      = corpusText(shape);
+    const auto                    documents = yayp::Parser().parseAll(text);
+    const yayp::AllocationCounter counter;
+    for (auto _ : state)
+    {
+        std::ostringstream os;
+        for (const auto& doc : documents)
+        {
+            yayp::writeSnapshot(os, *doc, {});
+        }
+        benchmark::DoNotOptimize(os);
+    }
+    report(state, text, counter.counts().allocations);
+}
+
+//---------------------------------------------------------------------------//
+// REGISTRATION
+//---------------------------------------------------------------------------//
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Register a benchmark for each shape of the corpus
+ */
+bool registerShapes(const char* name,
+                    void (*function)(benchmark::State&, corpus::Shape))
+{
+    for (corpus::Shape shape : corpus::shapes)
+    {
+        const std::string full = std::string(name) + "/"
+                                 + corpus::name(shape);
+        benchmark::RegisterBenchmark(full.c_str(), function, shape)
+            ->Unit(benchmark::kMillisecond);
+    }
+    return true;
+}
+
+//! Register the stages in the order of processing
+const bool registered = registerShapes("BM_Scan", BM_Scan)
+                        && registerShapes("BM_Build", BM_Build)
+                        && registerShapes("BM_Decode", BM_Decode)
+                        && registerShapes("BM_Emit", BM_Emit);
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/benchmarks/bmCorpus.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,142 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/benchmarks/bmDocument.cc
+ * \brief  Benchmarks for class Document.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../Document.hh"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Parser.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+constexpr int num_jobs = 4096;
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a shared configuration of jobs with merged defaults
+ */
+const yayp::Document& sharedDocument()
+{
+    static const yayp::Document doc = [] {
+        std::string text = "defaults: &defaults\n"
+                           "  cpu: 2\n"
+                           "  memory: 4096\n"
+                           "  queue: batch\n"
+                           "jobs:\n";
+        for (int i = 0; i < num_jobs; ++i)
+        {
+            text += "  - name: job" + std::to_string(i) + "\n";
+            text += "    <<: *defaults\n";
+            text += "    walltime: " + std::to_string(i % 97) + ".5\n";
+        }
+        return yayp::Document(yayp::Parser().parse(text));
+    }();
+    return doc;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return pointers to a spread of job values
+ */
+std::vector<std::string> makePointers(const char* key)
+{
+    std::vector<std::string> pointers;
+    for (int i = 0; i < 256; ++i)
+    {
+        unsigned job = (i * 2654435761u) % num_jobs;
+        pointers.push_back("/jobs/" + std::to_string(job) + "/" + key);
+    }
+    return pointers;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Register thread counts from one to the number of cores
+ */
+void threadCounts(benchmark::internal::Benchmark* bm)
+{
+    const int cores = static_cast<int>(
+        std::max(1u, std::thread::hardware_concurrency()));
+    for (int n = 1; n < cores; n *= 2)
+    {
+        bm->Threads(n);
+    }
+    bm->Threads(cores);
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// BENCHMARKS
+//---------------------------------------------------------------------------//
+
+static void BM_ConcurrentFind(benchmark::State& state)
+{
+    // Structural lookups, including merged keys, with no shared writes
+    const yayp::Document& doc      = sharedDocument();
+    static const auto     pointers = makePointers("queue");
+    for (auto _ : state)
+    {
+        for (const auto& pointer : pointers)
+        {
+            benchmark::DoNotOptimize(doc.find(pointer));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(pointers.size()));
+}
+BENCHMARK(BM_ConcurrentFind)->Apply(threadCounts)->UseRealTime();
+
+//---------------------------------------------------------------------------//
+
+static void BM_ConcurrentNumber(benchmark::State& state)
+{
+    // Lookups of lazily decoded numbers, published by the first reader
+    const yayp::Document& doc      = sharedDocument();
+    static const auto     pointers = makePointers("walltime");
+    for (auto _ : state)
+    {
+        for (const auto& pointer : pointers)
+        {
+            benchmark::DoNotOptimize(doc.number(pointer));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(pointers.size()));
+}
+BENCHMARK(BM_ConcurrentNumber)->Apply(threadCounts)->UseRealTime();
+
+//---------------------------------------------------------------------------//
+
+static void BM_With(benchmark::State& state)
+{
+    // Copy-on-write edit of one job: only the root mapping, the jobs
+    // sequence and the job itself are rebuilt
+    const yayp::Document& doc      = sharedDocument();
+    const auto            value    = yayp::Node::makeScalar("8");
+    static const auto     pointers = makePointers("cpu");
+    std::size_t           i        = 0;
+    for (auto _ : state)
+    {
+        yayp::Document edited = doc.with(pointers[i++ % pointers.size()],
+                                         value);
+        benchmark::DoNotOptimize(&edited.root());
+    }
+}
+BENCHMARK(BM_With);
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/benchmarks/bmDocument.cc
+//---------------------------------------------------------------------------//
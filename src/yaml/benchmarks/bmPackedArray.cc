@@ -0,0 +1,195 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/benchmarks/bmPackedArray.cc
+ * \brief  Benchmarks for class PackedArray.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../PackedArray.hh"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "../DocumentBuilder.hh"
+#include "../Node.hh"
+#include "../Parser.hh"
+#include "../Scanner.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+//! Number of bytes currently allocated with operator new
+std::size_t g_live_bytes = 0;
+
+//! Room in front of each allocation for its size, keeping the alignment
+constexpr std::size_t header_size = alignof(std::max_align_t);
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build a document holding a block sequence of the given number of
+ *        floats
+ */
+std::string makeBlock(std::size_t count)
+{
+    std::string text;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        text += "- " + std::to_string(i % 100000) + ".125\n";
+    }
+    return text;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build a document holding a flow sequence of the given number of
+ *        floats on one line
+ */
+std::string makeArray(std::size_t count)
+{
+    std::string text = "values: [";
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        text += (i ? ", " : "") + std::to_string(i % 100000) + ".125";
+    }
+    text += "]\n";
+    return text;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// ALLOCATION TRACKING
+//---------------------------------------------------------------------------//
+
+void* operator new(std::size_t size)
+{
+    auto* block = static_cast<char*>(std::malloc(size + header_size));
+    if (!block)
+    {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<std::size_t*>(block) = size;
+    g_live_bytes += size;
+    return block + header_size;
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p)
+    {
+        char* block = static_cast<char*>(p) - header_size;
+        g_live_bytes -= *reinterpret_cast<std::size_t*>(block);
+        std::free(block);
+    }
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+//---------------------------------------------------------------------------//
+// BENCHMARKS
+//---------------------------------------------------------------------------//
+
+static void BM_PackedFlow(benchmark::State& state)
+{
+    // Parse the sequence into a packed array
+    const std::string text
+        = makeArray(static_cast<std::size_t>(state.range(0)));
+    yayp::Parser parser;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parser.parse(text));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_PackedFlow)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------//
+
+static void BM_GeneralFlow(benchmark::State& state)
+{
+    // Tokenize the sequence and append the items one at a time
+    const std::string text
+        = makeArray(static_cast<std::size_t>(state.range(0)));
+    yayp::Scanner         scanner;
+    yayp::DocumentBuilder builder;
+    for (auto _ : state)
+    {
+        scanner.reset(text);
+        yayp::Event event;
+        while (scanner.next(event) && event.type != yayp::EventType::StreamEnd)
+        {
+            if (event.type == yayp::EventType::DocumentEnd)
+            {
+                benchmark::DoNotOptimize(builder.finish());
+            }
+            else if (event.type != yayp::EventType::DocumentStart)
+            {
+                builder.tryEvent(event);
+            }
+        }
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_GeneralFlow)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------//
+
+static void BM_PackedBlock(benchmark::State& state)
+{
+    // Parse a block sequence, whose items the builder packs
+    const auto        count = static_cast<std::size_t>(state.range(0));
+    const std::string text  = makeBlock(count);
+    yayp::Parser      parser;
+    std::size_t       bytes = 0;
+    for (auto _ : state)
+    {
+        const std::size_t before = g_live_bytes;
+        yayp::NodePtr     root   = parser.parse(text);
+        bytes                    = g_live_bytes - before;
+        benchmark::DoNotOptimize(root);
+    }
+    state.counters["bytes_per_item"] = static_cast<double>(bytes) / count;
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_PackedBlock)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------//
+
+static void BM_NodeBlock(benchmark::State& state)
+{
+    // Build the same sequence with a scalar node for each item
+    const auto  count = static_cast<std::size_t>(state.range(0));
+    std::size_t bytes = 0;
+    for (auto _ : state)
+    {
+        const std::size_t before = g_live_bytes;
+        yayp::Node::Items items;
+        items.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            items.push_back(yayp::Node::makeScalar(
+                std::to_string(i % 100000) + ".125"));
+        }
+        yayp::NodePtr root = yayp::Node::makeSequence(std::move(items));
+        bytes              = g_live_bytes - before;
+        benchmark::DoNotOptimize(root);
+    }
+    state.counters["bytes_per_item"] = static_cast<double>(bytes) / count;
+}
+BENCHMARK(BM_NodeBlock)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/benchmarks/bmPackedArray.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,186 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/benchmarks/bmParser.cc
+ * \brief  Benchmarks for class Parser on small messages.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ *
+ * Each benchmark parses the same batch of messages of about 1 KB, like those
+ * of a service, reporting the messages and bytes per second and the heap
+ * allocations per message:
+ *  - \c BM_FreshParser constructs a parser for each message;
+ *  - \c BM_ReusedParser parses every message with one parser;
+ *  - \c BM_RecycledParser also hands each document back to the parser once
+ *    it has been read, so that its nodes are reused.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../Parser.hh"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "harness/AllocationCounter.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+//! Number of distinct messages
+constexpr std::size_t num_messages = 64;
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a message of about 1 KB, with values depending on its index
+ */
+std::string makeMessage(std::size_t index)
+{
+    const std::string n = std::to_string(index);
+    std::string       text
+        = "kind: order\n"
+          "id: 8f14e45f-ceea-467f-a9d8-"
+          + std::to_string(100000000000 + index * 7919)
+          + "\n"
+            "created: 2023-06-15T10:42:"
+          + std::to_string(10 + index % 50)
+          + "Z\n"
+            "customer:\n"
+            "  name: Customer number "
+          + n
+          + "\n"
+            "  email: \"customer."
+          + n
+          + "@example.com\"\n"
+            "  tier: gold\n"
+            "  address:\n"
+            "    street: 12 Analytical Engine Lane\n"
+            "    city: London\n"
+            "    postcode: NW1 6XE\n"
+            "items:\n";
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+        text += "  - sku: KB-" + std::to_string(2041 + index + i)
+                + "\n"
+                  "    description: Mechanical keyboard with brown switches\n"
+                  "    quantity: "
+                + std::to_string(1 + (index + i) % 5)
+                + "\n"
+                  "    price: "
+                + std::to_string(10 + (index * 3 + i) % 90) + ".95\n";
+    }
+    text += "tags: [priority, gift, express]\n"
+            "shipping:\n"
+            "  method: courier\n"
+            "  insured: true\n"
+            "  notes: >\n"
+            "    Leave the parcel with the concierge if\n"
+            "    nobody answers the door.\n";
+    return text;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the batch of messages, generated on first use
+ */
+const std::vector<std::string>& messages()
+{
+    static const std::vector<std::string> batch = [] {
+        std::vector<std::string> result;
+        for (std::size_t i = 0; i < num_messages; ++i)
+        {
+            result.push_back(makeMessage(i));
+        }
+        return result;
+    }();
+    return batch;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Report the throughput and allocations of a benchmark
+ */
+void report(benchmark::State& state, std::size_t allocations)
+{
+    std::size_t bytes = 0;
+    for (const std::string& message : messages())
+    {
+        bytes += message.size();
+    }
+    const auto count = static_cast<std::int64_t>(state.iterations())
+                       * static_cast<std::int64_t>(num_messages);
+    state.counters["allocs_per_message"] = static_cast<double>(allocations)
+                                           / static_cast<double>(count);
+    state.SetItemsProcessed(count);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(bytes));
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// BENCHMARKS
+//---------------------------------------------------------------------------//
+
+static void BM_FreshParser(benchmark::State& state)
+{
+    // Construct a parser for each message
+    const auto&                   batch = messages();
+    const yayp::AllocationCounter counter;
+    for (auto _ : state)
+    {
+        for (const std::string& message : batch)
+        {
+            yayp::Parser parser;
+            benchmark::DoNotOptimize(parser.parse(message));
+        }
+    }
+    report(state, counter.counts().allocations);
+}
+BENCHMARK(BM_FreshParser);
+
+//---------------------------------------------------------------------------//
+
+static void BM_ReusedParser(benchmark::State& state)
+{
+    // Parse every message with one parser, dropping the documents
+    const auto&                   batch = messages();
+    yayp::Parser                  parser;
+    const yayp::AllocationCounter counter;
+    for (auto _ : state)
+    {
+        for (const std::string& message : batch)
+        {
+            benchmark::DoNotOptimize(parser.parse(message));
+        }
+    }
+    report(state, counter.counts().allocations);
+}
+BENCHMARK(BM_ReusedParser);
+
+//---------------------------------------------------------------------------//
+
+static void BM_RecycledParser(benchmark::State& state)
+{
+    // Parse every message with one parser, recycling the documents
+    const auto&                   batch = messages();
+    yayp::Parser                  parser;
+    const yayp::AllocationCounter counter;
+    for (auto _ : state)
+    {
+        for (const std::string& message : batch)
+        {
+            auto doc = parser.parse(message);
+            benchmark::DoNotOptimize(doc);
+            parser.recycle(std::move(doc));
+        }
+    }
+    report(state, counter.counts().allocations);
+}
+BENCHMARK(BM_RecycledParser);
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/benchmarks/bmParser.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,176 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/benchmarks/bmPathQuery.cc
+ * \brief  Benchmarks for class PathQuery.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../PathQuery.hh"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "../Parser.hh"
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build a stream of job documents of roughly the given size in MB
+ */
+std::string makeStream(std::size_t megabytes)
+{
+    const std::size_t size = megabytes * 1024 * 1024;
+
+    std::string stream;
+    stream.reserve(size + 4096);
+    std::size_t job = 0;
+    while (stream.size() < size)
+    {
+        stream += "---\nname: batch\njobs:\n";
+        for (int i = 0; i < 64; ++i, ++job)
+        {
+            const std::string id = std::to_string(job);
+            stream += "  - name: job" + id + "\n";
+            stream += "    command: [run, --input, data" + id
+                      + ".h5, --verbose]\n";
+            stream += "    environment:\n";
+            stream += "      PATH: /usr/local/bin:/usr/bin\n";
+            stream += "      OMP_NUM_THREADS: 8\n";
+            stream += "    resources:\n";
+            stream += "      cpu: 8\n";
+            stream += "      memory: " + std::to_string(job % 512) + "G\n";
+        }
+    }
+    return stream;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build a configuration nested to the given depth
+ *
+ * Each level holds a few sibling subtrees (block and flow) besides the key
+ * leading to the next level, and the innermost level holds a value.
+ */
+std::string makeDeepConfig(int depth)
+{
+    std::string config;
+    for (int level = 0; level < depth; ++level)
+    {
+        const std::string indent(2 * level, ' ');
+        for (int i = 0; i < 4; ++i)
+        {
+            const std::string id = std::to_string(i);
+            config += indent + "options" + id + ":\n";
+            for (int j = 0; j < 8; ++j)
+            {
+                config += indent + "  setting" + std::to_string(j)
+                          + ": {enabled: true, limits: [1, 2, 4, 8]}\n";
+            }
+            config += indent + "  files:\n";
+            config += indent + "    - input" + id + ".h5\n";
+            config += indent + "    - output" + id + ".h5\n";
+        }
+        config += indent + "next:\n";
+    }
+    config += std::string(2 * depth, ' ') + "value: 42\n";
+    return config;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// BENCHMARKS
+//---------------------------------------------------------------------------//
+
+static void BM_Query(benchmark::State& state)
+{
+    // Stream the input, building only the selected scalars
+    const std::string stream
+        = makeStream(static_cast<std::size_t>(state.range(0)));
+    const yayp::PathQuery query("jobs[*].resources.memory");
+    for (auto _ : state)
+    {
+        std::size_t total = 0;
+        query.run(stream, [&total](const yayp::PathQuery::Match& match) {
+            total += match.node->scalar().size();
+        });
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(stream.size()));
+}
+BENCHMARK(BM_Query)->Arg(16)->Arg(256)->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------//
+
+static void BM_DomThenWalk(benchmark::State& state)
+{
+    // Parse every document, then walk the trees
+    const std::string stream
+        = makeStream(static_cast<std::size_t>(state.range(0)));
+    yayp::Parser parser;
+    for (auto _ : state)
+    {
+        std::size_t total = 0;
+        for (const auto& doc : parser.parseAll(stream))
+        {
+            for (const auto& job : doc->find("jobs")->items())
+            {
+                const yayp::Node* resources = job->find("resources");
+                total += resources->find("memory")->scalar().size();
+            }
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(stream.size()));
+}
+BENCHMARK(BM_DomThenWalk)->Arg(16)->Arg(256)->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------//
+
+static void BM_DeepQuery(benchmark::State& state)
+{
+    // Select the innermost value of a deep configuration, skipping the
+    // sibling subtrees of each level
+    const int         depth  = static_cast<int>(state.range(0));
+    const std::string config = makeDeepConfig(depth);
+    std::string       expression;
+    for (int level = 0; level < depth; ++level)
+    {
+        expression += "next.";
+    }
+    const yayp::PathQuery query(expression + "value");
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(query.select(config));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(config.size()));
+}
+BENCHMARK(BM_DeepQuery)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+//---------------------------------------------------------------------------//
+
+static void BM_DeepParse(benchmark::State& state)
+{
+    // Parse the whole deep configuration
+    const std::string config
+        = makeDeepConfig(static_cast<int>(state.range(0)));
+    yayp::Parser parser;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parser.parse(config));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations())
+                            * static_cast<std::int64_t>(config.size()));
+}
+BENCHMARK(BM_DeepParse)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/benchmarks/bmPathQuery.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,71 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/fuzz/fzBlockScalar.cc
+ * \brief  libFuzzer target for BlockScalar.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ *
+ * The first input byte selects the block indicator ('|' or '>') and the
+ * parent indentation (-1 to 6); the remainder is the text following the
+ * indicator.  Invalid block scalars are expected to throw yayp::Exception,
+ * but a failed DBC check is a bug and is left to abort the run.
+ */
+//---------------------------------------------------------------------------//
+
+#include "yaml/BlockScalar.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "harness/DBC.hh"
+
+//---------------------------------------------------------------------------//
+// FUZZ TARGET
+//---------------------------------------------------------------------------//
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data,
+                                      std::size_t         size)
+{
+    if (size < 1)
+    {
+        return 0;
+    }
+
+    // Decode the parameters
+    char        indicator = (data[0] & 0x80) ? '>' : '|';
+    int         parent    = static_cast<int>(data[0] % 8) - 1;
+    std::string input(1, indicator);
+    input.append(reinterpret_cast<const char*>(data + 1), size - 1);
+
+    try
+    {
+        yayp::BlockScalar scalar(input, parent);
+        if (scalar.consumed() > input.size()
+            || scalar.value().size() > input.size())
+        {
+            __builtin_trap();
+        }
+
+        // A view must lie within the input
+        if (scalar.isView() && !scalar.value().empty()
+            && (scalar.value().data() < input.data()
+                || scalar.value().data() + scalar.value().size()
+                       > input.data() + input.size()))
+        {
+            __builtin_trap();
+        }
+    }
+    catch (const yayp::DBCException&)
+    {
+        throw;
+    }
+    catch (const yayp::Exception&)
+    {
+        // Invalid block scalar
+    }
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/fuzz/fzBlockScalar.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,123 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/fuzz/fzDocumentBuilder.cc
+ * \brief  libFuzzer target for DocumentBuilder.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ *
+ * Each input byte is decoded into a parse event (the low three bits select
+ * the event, and the high bits an anchor or scalar length).  Events that a
+ * parser could never produce at that point (e.g., ending a collection that is
+ * not open) are skipped, so that any failed DBC check indicates a bug.  Small
+ * resource limits are used so that limit handling is exercised frequently.
+ */
+//---------------------------------------------------------------------------//
+
+#include "yaml/DocumentBuilder.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "harness/DBC.hh"
+
+//---------------------------------------------------------------------------//
+// FUZZ TARGET
+//---------------------------------------------------------------------------//
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data,
+                                      std::size_t         size)
+{
+    yayp::ParseLimits limits;
+    limits.max_depth              = 64;
+    limits.max_scalar_length      = 16;
+    limits.max_nodes              = 4096;
+    limits.aliases.max_expansions = 65536;
+    limits.aliases.max_depth      = 16;
+    yayp::DocumentBuilder builder(limits);
+
+    // Open collections, and for mappings whether a key is pending
+    struct Open
+    {
+        bool mapping;
+        bool have_key;
+    };
+    std::vector<Open> open;
+
+    // Record a completed node in the innermost collection
+    auto attach = [&open]() {
+        if (!open.empty() && open.back().mapping)
+        {
+            open.back().have_key = !open.back().have_key;
+        }
+    };
+
+    try
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            std::string arg = "a" + std::to_string(data[i] >> 5);
+            switch (data[i] & 0x7)
+            {
+                case 0:
+                    builder.null(arg);
+                    attach();
+                    break;
+                case 1:
+                    builder.scalar(std::string(data[i] >> 3, 'x'), arg);
+                    attach();
+                    break;
+                case 2:
+                    builder.scalar("<<");
+                    attach();
+                    break;
+                case 3:
+                    builder.alias(arg);
+                    attach();
+                    break;
+                case 4:
+                    builder.beginSequence(arg);
+                    open.push_back({false, false});
+                    break;
+                case 5:
+                    builder.beginMapping(arg);
+                    open.push_back({true, false});
+                    break;
+                default:
+                    if (open.empty() || open.back().have_key)
+                    {
+                        break;
+                    }
+                    if (open.back().mapping)
+                    {
+                        builder.endMapping();
+                    }
+                    else
+                    {
+                        builder.endSequence();
+                    }
+                    open.pop_back();
+                    attach();
+            }
+
+            // Only one root node per document
+            if (open.empty())
+            {
+                builder.finish();
+            }
+        }
+    }
+    catch (const yayp::DBCException&)
+    {
+        throw;
+    }
+    catch (const yayp::Exception&)
+    {
+        // Invalid document or exceeded limit
+    }
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/fuzz/fzDocumentBuilder.cc
+//---------------------------------------------------------------------------//
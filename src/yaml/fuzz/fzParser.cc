@@ -0,0 +1,51 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/fuzz/fzParser.cc
+ * \brief  libFuzzer target for the non-throwing Parser API.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ *
+ * The input is parsed with tight limits through Parser::tryParseAll, which
+ * must not throw for any input: an exception of any kind aborts the run.  A
+ * reported error must lie within the input.
+ */
+//---------------------------------------------------------------------------//
+
+#include "yaml/Parser.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//---------------------------------------------------------------------------//
+// FUZZ TARGET
+//---------------------------------------------------------------------------//
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data,
+                                      std::size_t         size)
+{
+    static const yayp::ParseLimits limits = [] {
+        yayp::ParseLimits l;
+        l.max_depth              = 64;
+        l.max_nodes              = 4096;
+        l.aliases.max_expansions = 1 << 16;
+        return l;
+    }();
+    static yayp::Parser parser(limits);
+
+    std::string_view input(reinterpret_cast<const char*>(data), size);
+    auto             result = parser.tryParseAll(input);
+    if (!result)
+    {
+        const yayp::ParseError& error = result.error();
+        if (error.code == yayp::ParseErrorCode::None || error.offset > size
+            || error.line == 0 || error.column == 0)
+        {
+            __builtin_trap();
+        }
+    }
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/fuzz/fzParser.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,107 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstAnchorTable.cc
+ * \brief  Tests for class AnchorTable.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../AnchorTable.hh"
+
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+#include <string>
+
+using yayp::AliasLimits;
+using yayp::AnchorTable;
+using yayp::Node;
+using yayp::NodePtr;
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(AnchorTableTest, alias)
+{
+    AnchorTable anchors;
+    auto        defaults = Node::makeMapping({{"a", Node::makeScalar("1")}});
+    anchors.define("defaults", defaults);
+    EXPECT_EQ(1, anchors.size());
+
+    auto alias = anchors.alias("defaults");
+    EXPECT_TRUE(alias->isAlias());
+    EXPECT_EQ(defaults.get(), alias->target().get());
+    EXPECT_EQ(2, anchors.expansions());
+
+    // Undefined anchors are an error
+    EXPECT_THROW(anchors.alias("undefined"), yayp::Exception);
+
+    // Redefinition replaces the anchor for subsequent aliases
+    auto other = Node::makeScalar("other");
+    anchors.define("defaults", other);
+    EXPECT_EQ(other.get(), anchors.alias("defaults")->target().get());
+    EXPECT_EQ(3, anchors.expansions());
+
+    anchors.clear();
+    EXPECT_EQ(0, anchors.size());
+    EXPECT_EQ(0, anchors.expansions());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(AnchorTableTest, depth_limit)
+{
+    AliasLimits limits;
+    limits.max_depth = 3;
+    AnchorTable anchors(limits);
+
+    // Build a chain of nested aliases
+    anchors.define("a0", Node::makeScalar("x"));
+    for (int i = 1; i <= 3; ++i)
+    {
+        auto prev = anchors.alias("a" + std::to_string(i - 1));
+        anchors.define("a" + std::to_string(i), Node::makeSequence({prev}));
+    }
+    EXPECT_NO_THROW(anchors.alias("a2"));
+    EXPECT_THROW(anchors.alias("a3"), yayp::LimitExceededException);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(AnchorTableTest, billion_laughs)
+{
+    AliasLimits limits;
+    limits.max_expansions = 100000;
+    AnchorTable anchors(limits);
+
+    // Each level holds ten aliases of the previous level, so that level n
+    // expands to more than 10^n nodes while only storing ten handles
+    anchors.define("lol0", Node::makeScalar("lol"));
+    int level = 1;
+    try
+    {
+        for (; level < 10; ++level)
+        {
+            Node::Items items;
+            for (int i = 0; i < 10; ++i)
+            {
+                items.push_back(
+                    anchors.alias("lol" + std::to_string(level - 1)));
+            }
+            anchors.define("lol" + std::to_string(level),
+                           Node::makeSequence(std::move(items)));
+        }
+        FAIL() << "Expected the alias expansion limit to be exceeded";
+    }
+    catch (const yayp::LimitExceededException& e)
+    {
+        EXPECT_EQ("alias expansions", e.resource());
+    }
+    EXPECT_EQ(5, level);
+    EXPECT_LE(anchors.expansions(), limits.max_expansions);
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstAnchorTable.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,198 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstBlockScalar.cc
+ * \brief  Tests for class BlockScalar.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../BlockScalar.hh"
+
+#include "harness/AllocationCounter.hh"
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::BlockScalar;
+using yayp::BlockStyle;
+using yayp::Chomping;
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(BlockScalarTest, header)
+{
+    BlockScalar b1("|\n  text\n", 0);
+    EXPECT_EQ(BlockStyle::Literal, b1.style());
+    EXPECT_EQ(Chomping::Clip, b1.chomping());
+    EXPECT_EQ(2, b1.indentation());
+
+    BlockScalar b2(">-\n  text\n", 0);
+    EXPECT_EQ(BlockStyle::Folded, b2.style());
+    EXPECT_EQ(Chomping::Strip, b2.chomping());
+
+    // Indicators may appear in either order, followed by a comment
+    BlockScalar b3("|+2 # comment\n    text\n", 0);
+    EXPECT_EQ(Chomping::Keep, b3.chomping());
+    EXPECT_EQ(2, b3.indentation());
+    EXPECT_EQ("  text\n", b3.value());
+
+    BlockScalar b4(">3-\n    text\n", 0);
+    EXPECT_EQ(Chomping::Strip, b4.chomping());
+    EXPECT_EQ(3, b4.indentation());
+    EXPECT_EQ(" text", b4.value());
+
+    // Invalid headers
+    EXPECT_THROW(BlockScalar("|x\n  text\n", 0), yayp::Exception);
+    EXPECT_THROW(BlockScalar("|--\n  text\n", 0), yayp::Exception);
+    EXPECT_THROW(BlockScalar("|#comment\n  text\n", 0), yayp::Exception);
+#if YAYP_DBC > 0
+    EXPECT_THROW(BlockScalar("text", 0), yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(BlockScalarTest, literal)
+{
+    std::string input = "|\n  line 1\n\n    line 2\n  line 3\n\n\nkey: value";
+    BlockScalar b(input, 0);
+    EXPECT_EQ("line 1\n\n  line 2\nline 3\n", b.value());
+    EXPECT_FALSE(b.isView());
+
+    // The trailing empty lines belong to the block scalar
+    EXPECT_EQ("key: value", input.substr(b.consumed()));
+
+    // Windows line endings are normalized
+    BlockScalar crlf("|\r\n  line 1\r\n  line 2\r\n", 0);
+    EXPECT_EQ("line 1\nline 2\n", crlf.value());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(BlockScalarTest, folded)
+{
+    std::string input = ">\n folded\n text\n\n  spaced\n  text\n\n last\n";
+    BlockScalar b(input, 0);
+    EXPECT_EQ("folded text\n\n spaced\n text\n\nlast\n", b.value());
+    EXPECT_EQ(input.size(), b.consumed());
+
+    // Empty lines between text lines replace the folded line break
+    BlockScalar b2(">\n a\n\n\n b\n", 0);
+    EXPECT_EQ("a\n\nb\n", b2.value());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(BlockScalarTest, chomping)
+{
+    BlockScalar strip("|-\n  text\n\n\nnext", 0);
+    EXPECT_EQ("text", strip.value());
+
+    BlockScalar clip("|\n  text\n\n\nnext", 0);
+    EXPECT_EQ("text\n", clip.value());
+
+    BlockScalar keep("|+\n  text\n\n\nnext", 0);
+    EXPECT_EQ("text\n\n\n", keep.value());
+
+    // No final line break at the end of the input
+    BlockScalar eof("|\n  text", 0);
+    EXPECT_EQ("text", eof.value());
+
+    // Empty block scalars
+    BlockScalar empty_clip("|\nnext", 0);
+    EXPECT_EQ("", empty_clip.value());
+    EXPECT_EQ(2, empty_clip.consumed());
+
+    BlockScalar empty_keep("|+\n\n\nnext", 0);
+    EXPECT_EQ("\n\n", empty_keep.value());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(BlockScalarTest, indentation)
+{
+    // Auto-detected indentation stops at a less indented line
+    std::string input = "|\n    a\n    b\n  c\n";
+    BlockScalar b(input, 1);
+    EXPECT_EQ(4, b.indentation());
+    EXPECT_EQ("a\nb\n", b.value());
+    EXPECT_EQ("  c\n", input.substr(b.consumed()));
+
+    // Leading empty lines may not be more indented than the content
+    EXPECT_THROW(BlockScalar("|\n      \n    a\n", 0), yayp::Exception);
+
+    // Document markers end a top-level block scalar
+    std::string doc = "|\nline\n---\nnext\n";
+    BlockScalar top(doc, -1);
+    EXPECT_EQ("line\n", top.value());
+    EXPECT_EQ("---\nnext\n", doc.substr(top.consumed()));
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(BlockScalarTest, zero_copy)
+{
+    // Top-level literal blocks are contiguous in the input
+    std::string input = "|\nline 1\n\nline 2\n";
+    BlockScalar b(input, -1);
+    EXPECT_TRUE(b.isView());
+    EXPECT_EQ("line 1\n\nline 2\n", b.value());
+    EXPECT_EQ(input.data() + 2, b.value().data());
+
+    BlockScalar keep("|+\nline\n\n\n", -1);
+    EXPECT_TRUE(keep.isView());
+    EXPECT_EQ("line\n\n\n", keep.value());
+
+    // Single-line blocks are views regardless of indentation
+    BlockScalar single(">-\n    single line\nnext: 1\n", 0);
+    EXPECT_TRUE(single.isView());
+    EXPECT_EQ("single line", single.value());
+
+    // Copies of a block scalar do not refer to the original's storage
+    BlockScalar owned("|\n  a\n  b\n", 0);
+    EXPECT_FALSE(owned.isView());
+    BlockScalar copy = owned;
+    EXPECT_EQ("a\nb\n", copy.value());
+    EXPECT_NE(owned.value().data(), copy.value().data());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(BlockScalarTest, rescan)
+{
+    // Rescanning reads each block scalar as if it were new
+    BlockScalar b("|-\n  first line\n  second line\n", 0);
+    EXPECT_EQ("first line\nsecond line", b.value());
+    EXPECT_EQ(yayp::ParseErrorCode::None, b.rescan(">\n  a\n  b\n", 0).code);
+    EXPECT_EQ(BlockStyle::Folded, b.style());
+    EXPECT_EQ(Chomping::Clip, b.chomping());
+    EXPECT_EQ("a b\n", b.value());
+    EXPECT_EQ(yayp::ParseErrorCode::None, b.rescan("|\nview\n", -1).code);
+    EXPECT_TRUE(b.isView());
+    EXPECT_EQ("view\n", b.value());
+
+    // Copies reuse the storage once it fits them
+    const std::string input = "|\n  a line longer than a short string\n"
+                              "  and another one\n";
+    b.rescan(input, 0);
+    EXPECT_NO_ALLOCATIONS(b.rescan(input, 0));
+    EXPECT_FALSE(b.isView());
+    EXPECT_EQ("a line longer than a short string\nand another one\n",
+              b.value());
+
+    // The copy is reserved to the block, not to the rest of the input
+    std::string tail = "|\n  a\n  b\nnext: ";
+    tail.append(100000, 'x');
+    const auto counts = yayp::AllocationCounter::count(
+        [&tail] { BlockScalar(tail, 0); });
+    EXPECT_LT(counts.bytes, 1000);
+
+    const yayp::ParseError error = b.rescan("|x\n  text\n", 0);
+    EXPECT_EQ(yayp::ParseErrorCode::InvalidBlockHeader, error.code);
+    EXPECT_EQ(0, error.offset);
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstBlockScalar.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,225 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstDocument.cc
+ * \brief  Tests for class Document.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../Document.hh"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../PackedArray.hh"
+#include "../Parser.hh"
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::Document;
+
+namespace
+{
+//---------------------------------------------------------------------------//
+const char config[] = R"(
+defaults: &defaults
+  cpu: 2
+  memory: 4.5
+jobs:
+  - name: small
+    <<: *defaults
+  - name: large
+    <<: *defaults
+    cpu: 0x10
+"a/b~c": 1
+)";
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(DocumentTest, find)
+{
+    Document doc(yayp::Parser().parse(config));
+    EXPECT_EQ(&doc.root(), doc.find(""));
+    EXPECT_EQ(doc.handle().get(), &doc.root());
+
+    ASSERT_NE(nullptr, doc.find("/jobs/1/name"));
+    EXPECT_EQ("large", doc.find("/jobs/1/name")->scalar());
+    EXPECT_EQ("2", doc.find("/jobs/0/cpu")->scalar());
+    EXPECT_EQ(doc.find("/defaults/memory"), doc.find("/jobs/1/memory"));
+    EXPECT_EQ("1", doc.find("/a~1b~0c")->scalar());
+
+    EXPECT_EQ(nullptr, doc.find("/missing"));
+    EXPECT_EQ(nullptr, doc.find("/jobs/2"));
+    EXPECT_EQ(nullptr, doc.find("/jobs/01"));
+    EXPECT_EQ(nullptr, doc.find("/jobs/18446744073709551616"));
+    EXPECT_EQ(nullptr, doc.find("/jobs/99999999999999999999999"));
+    EXPECT_EQ(nullptr, doc.find("/jobs/x"));
+    EXPECT_EQ(nullptr, doc.find("/jobs/0/cpu/deeper"));
+    EXPECT_EQ(nullptr, doc.find("jobs"));
+
+    EXPECT_EQ(16.0, doc.number("/jobs/1/cpu"));
+    EXPECT_EQ(4.5, doc.number("/jobs/0/memory"));
+    EXPECT_FALSE(doc.number("/jobs/0/name"));
+    EXPECT_FALSE(doc.number("/jobs"));
+    EXPECT_FALSE(doc.number("/missing"));
+
+    // Only plain scalars are numbers
+    Document styles(yayp::Parser().parse(
+        "a: \"12\"\nb: '1e3'\nc: |\n  7\nd: 12\ne: [\"1\", 2]\n"));
+    EXPECT_FALSE(styles.number("/a"));
+    EXPECT_FALSE(styles.number("/b"));
+    EXPECT_FALSE(styles.number("/c"));
+    EXPECT_EQ(12.0, styles.number("/d"));
+    EXPECT_FALSE(styles.number("/e/0"));
+    EXPECT_EQ(2.0, styles.number("/e/1"));
+
+#if YAYP_DBC > 0
+    EXPECT_THROW(Document(nullptr), yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(DocumentTest, with)
+{
+    using yayp::Node;
+    const Document original(yayp::Parser().parse(config));
+
+    // Replacing a nested value rebuilds only the containers on the path
+    Document edited = original.with("/jobs/0/name", Node::makeScalar("tiny"));
+    EXPECT_EQ("tiny", edited.find("/jobs/0/name")->scalar());
+    EXPECT_EQ("small", original.find("/jobs/0/name")->scalar());
+    EXPECT_NE(&original.root(), &edited.root());
+    EXPECT_NE(original.find("/jobs"), edited.find("/jobs"));
+    EXPECT_NE(original.find("/jobs/0"), edited.find("/jobs/0"));
+    EXPECT_EQ(original.find("/jobs/1"), edited.find("/jobs/1"));
+    EXPECT_EQ(original.find("/defaults"), edited.find("/defaults"));
+    EXPECT_EQ(original.find("/a~1b~0c"), edited.find("/a~1b~0c"));
+
+    // Merged keys are overridden by an own entry, leaving the anchor intact
+    Document overridden = original.with("/jobs/0/memory",
+                                        Node::makeScalar("64"));
+    EXPECT_EQ(64.0, overridden.number("/jobs/0/memory"));
+    EXPECT_EQ(4.5, overridden.number("/jobs/1/memory"));
+    EXPECT_EQ(4.5, overridden.number("/defaults/memory"));
+    EXPECT_EQ(1, overridden.find("/jobs/0")->merges().size());
+
+    // Editing through an alias copies its target
+    Document aliased = original.with("/jobs/1/cpu", Node::makeScalar("1"))
+                           .with("/defaults/cpu", Node::makeScalar("3"));
+    EXPECT_EQ(1.0, aliased.number("/jobs/1/cpu"));
+    EXPECT_EQ(3.0, aliased.number("/defaults/cpu"));
+    EXPECT_EQ(2.0, aliased.number("/jobs/0/cpu"));
+
+    // Missing keys are added, and the root may be replaced
+    Document added = original.with("/jobs/1/gpu", Node::makeScalar("1"));
+    EXPECT_EQ(1.0, added.number("/jobs/1/gpu"));
+    EXPECT_EQ(nullptr, original.find("/jobs/1/gpu"));
+    Document replaced = original.with("", Node::makeNull());
+    EXPECT_EQ(Node::Kind::Null, replaced.root().kind());
+
+    EXPECT_THROW(original.with("/jobs/2", Node::makeNull()), yayp::Exception);
+    EXPECT_THROW(original.with("/jobs/x", Node::makeNull()), yayp::Exception);
+    EXPECT_THROW(original.with("/missing/key", Node::makeNull()),
+                 yayp::Exception);
+    EXPECT_THROW(original.with("/jobs/0/name/x", Node::makeNull()),
+                 yayp::Exception);
+    EXPECT_THROW(original.with("jobs", Node::makeNull()), yayp::Exception);
+
+    // Indices that overflow a size match nothing
+    EXPECT_THROW(original.with("/jobs/18446744073709551617", Node::makeNull()),
+                 yayp::Exception);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(DocumentTest, with_packed)
+{
+    using yayp::Node;
+    const Document original(yayp::Parser().parse("v: [1.5, 2.5, 3.5]\n"));
+    ASSERT_NE(nullptr, original.find("/v")->packed());
+
+    // An item of the same type keeps the copy packed
+    Document edited = original.with("/v/1", Node::makeScalar("-2.0"));
+    const yayp::PackedArray* packed = edited.find("/v")->packed();
+    ASSERT_NE(nullptr, packed);
+    EXPECT_EQ(-2.0, packed->floats()[1]);
+    EXPECT_EQ(2.5, original.find("/v")->packed()->floats()[1]);
+    EXPECT_EQ("-2.0", edited.find("/v/1")->scalar());
+
+    // Any other item unpacks the copy
+    Document quoted = original.with("/v/0", Node::makeScalar("1.5", false));
+    EXPECT_EQ(nullptr, quoted.find("/v")->packed());
+    EXPECT_FALSE(quoted.find("/v/0")->isPlain());
+    EXPECT_EQ("3.5", quoted.find("/v/2")->scalar());
+    Document ints = original.with("/v/2", Node::makeScalar("3"));
+    EXPECT_EQ(nullptr, ints.find("/v")->packed());
+    EXPECT_EQ(3.0, ints.number("/v/2"));
+    EXPECT_EQ(1.5, ints.number("/v/0"));
+
+    EXPECT_NE(nullptr, original.find("/v")->packed());
+    EXPECT_EQ(3u, original.find("/v")->size());
+    EXPECT_THROW(original.with("/v/3", Node::makeNull()), yayp::Exception);
+    EXPECT_THROW(original.with("/v/0/x", Node::makeNull()), yayp::Exception);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(DocumentTest, concurrent_reads)
+{
+    // Build a document whose numbers have not been decoded, and have every
+    // thread read all of it at once.  Run under ThreadSanitizer
+    // (YAYP_ENABLE_TSAN) to check that the read path is free of data races.
+    std::string text = "values:\n";
+    for (int i = 0; i < 500; ++i)
+    {
+        text += "  - {id: " + std::to_string(i) + ", name: item"
+                + std::to_string(i) + ", ratio: " + std::to_string(i)
+                + ".25}\n";
+    }
+    const Document doc(yayp::Parser().parse(text));
+
+    constexpr int            num_threads = 8;
+    std::atomic<int>         ready{0};
+    std::atomic<int>         errors{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&doc, &ready, &errors, t] {
+            ready.fetch_add(1);
+            while (ready.load() < num_threads)
+            {
+                // Start together to maximize contention
+            }
+            for (int n = 0; n < 500; ++n)
+            {
+                int         i    = (n + t * 61) % 500;
+                std::string item = "/values/" + std::to_string(i);
+                if (doc.number(item + "/id") != static_cast<double>(i)
+                    || doc.number(item + "/ratio") != i + 0.25
+                    || doc.number(item + "/name")
+                    || doc.find(item + "/name")->scalar()
+                           != "item" + std::to_string(i))
+                {
+                    errors.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(0, errors.load());
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstDocument.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,365 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstDocumentBuilder.cc
+ * \brief  Tests for class DocumentBuilder.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../DocumentBuilder.hh"
+
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+#include <chrono>
+#include <functional>
+#include <initializer_list>
+#include <random>
+#include <string>
+#include <vector>
+
+using yayp::DocumentBuilder;
+using yayp::LimitExceededException;
+using yayp::Node;
+using yayp::ParseLimits;
+using Kind = yayp::Node::Kind;
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(DocumentBuilderTest, build)
+{
+    // defaults: &defaults {cpu: 2, memory: 1G}
+    // jobs:
+    //   - {<<: *defaults, name: a}
+    //   - {<<: *defaults, cpu: 4, name: b}
+    //   - *defaults
+    DocumentBuilder builder;
+    builder.beginMapping();
+    builder.scalar("defaults");
+    builder.beginMapping("defaults");
+    builder.scalar("cpu");
+    builder.scalar("2");
+    builder.scalar("memory");
+    builder.scalar("1G");
+    builder.endMapping();
+    builder.scalar("jobs");
+    builder.beginSequence();
+    builder.beginMapping();
+    builder.scalar("<<");
+    builder.alias("defaults");
+    builder.scalar("name");
+    builder.scalar("a");
+    builder.endMapping();
+    builder.beginMapping();
+    builder.scalar("<<");
+    builder.alias("defaults");
+    builder.scalar("cpu");
+    builder.scalar("4");
+    builder.scalar("name");
+    builder.scalar("b");
+    builder.endMapping();
+    builder.alias("defaults");
+    builder.null();
+    builder.endSequence();
+    builder.endMapping();
+    EXPECT_EQ(23, builder.guard().nodes());
+
+    auto doc = builder.finish();
+    EXPECT_EQ(0, builder.guard().nodes());
+    EXPECT_EQ(0, builder.anchors().size());
+
+    const Node* defaults = doc->find("defaults");
+    const Node* jobs     = doc->find("jobs");
+    ASSERT_NE(nullptr, defaults);
+    ASSERT_NE(nullptr, jobs);
+    ASSERT_EQ(4, jobs->size());
+
+    // Merged keys resolve to the shared anchored values
+    EXPECT_EQ(1, jobs->at(0).size());
+    EXPECT_EQ("2", jobs->at(0).find("cpu")->scalar());
+    EXPECT_EQ(defaults->find("memory"), jobs->at(0).find("memory"));
+    EXPECT_EQ("4", jobs->at(1).find("cpu")->scalar());
+    EXPECT_EQ("1G", jobs->at(1).find("memory")->scalar());
+    EXPECT_EQ(defaults, &jobs->at(2).resolve());
+    EXPECT_EQ(Kind::Null, jobs->at(3).kind());
+
+    // Empty documents are null
+    EXPECT_EQ(Kind::Null, builder.finish()->kind());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(DocumentBuilderTest, errors)
+{
+    DocumentBuilder builder;
+    builder.beginMapping();
+    builder.beginSequence();
+    EXPECT_THROW(builder.endSequence(), yayp::Exception);
+
+    DocumentBuilder merge_builder;
+    merge_builder.beginMapping();
+    merge_builder.scalar("<<");
+    EXPECT_THROW(merge_builder.scalar("x"), yayp::Exception);
+
+    DocumentBuilder alias_builder;
+    EXPECT_THROW(alias_builder.alias("undefined"), yayp::Exception);
+
+#if YAYP_DBC > 0
+    DocumentBuilder dbc_builder;
+    EXPECT_THROW(dbc_builder.endSequence(), yayp::DBCException);
+    dbc_builder.beginSequence();
+    EXPECT_THROW(dbc_builder.endMapping(), yayp::DBCException);
+    EXPECT_THROW(dbc_builder.finish(), yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(DocumentBuilderTest, packing)
+{
+    DocumentBuilder builder;
+    builder.beginMapping();
+    auto sequence = [&builder](const char*                        key,
+                               std::initializer_list<const char*> items) {
+        builder.scalar(key);
+        builder.beginSequence();
+        for (const char* item : items)
+        {
+            builder.scalar(item);
+        }
+        builder.endSequence();
+    };
+    sequence("flags", {"true", "false"});
+    sequence("mixed", {"1", "2", "x", "3"});
+    sequence("strings", {"01", "2"});
+    builder.scalar("anchored");
+    builder.beginSequence();
+    builder.scalar("1", "one");
+    builder.scalar("2");
+    builder.endSequence();
+    builder.scalar("nested");
+    builder.beginSequence();
+    builder.scalar("1.5");
+    builder.beginSequence();
+    builder.scalar("2.5");
+    builder.endSequence();
+    builder.endSequence();
+    builder.endMapping();
+    auto root = builder.finish();
+
+    // Homogeneous sequences are packed
+    const Node* flags = root->find("flags");
+    ASSERT_NE(nullptr, flags->packed());
+    EXPECT_CONT_EQ((std::vector<bool>{true, false}), flags->packed()->bools());
+
+    // Others keep their items in order, whether or not some were packed
+    auto texts = [](const Node& node) {
+        std::vector<std::string> result;
+        for (const auto& item : node.items())
+        {
+            result.push_back(item->resolvedKind() == Kind::Scalar
+                                 ? item->scalar()
+                                 : "[]");
+        }
+        return result;
+    };
+    using Texts = std::vector<std::string>;
+    for (const auto& [key, expected] :
+         {std::pair{"mixed", Texts{"1", "2", "x", "3"}},
+          std::pair{"strings", Texts{"01", "2"}},
+          std::pair{"anchored", Texts{"1", "2"}},
+          std::pair{"nested", Texts{"1.5", "[]"}}})
+    {
+        const Node* node = root->find(key);
+        EXPECT_EQ(nullptr, node->packed()) << key;
+        EXPECT_CONT_EQ(expected, texts(*node)) << key;
+    }
+    EXPECT_NE(nullptr, root->find("nested")->at(1).packed());
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Adversarial inputs must fail quickly with a LimitExceededException,
+ *        without holding more than the configured number of nodes.
+ */
+TEST(DocumentBuilderTest, adversarial_corpus)
+{
+    ParseLimits limits;
+    limits.max_depth              = 100;
+    limits.max_scalar_length      = 1024;
+    limits.max_nodes              = 10000;
+    limits.aliases.max_expansions = 10000;
+    limits.aliases.max_depth      = 16;
+
+    using Input = std::function<void(DocumentBuilder&)>;
+    struct Case
+    {
+        const char* name;
+        const char* resource;
+        Input       input;
+    };
+
+    // clang-format off
+    std::vector<Case> corpus = {
+        {"deep nesting", "nesting depth", [](DocumentBuilder& b) {
+            for (int i = 0; i < 1000000; ++i) { b.beginSequence(); }
+        }},
+        {"deep mapping nesting", "nesting depth", [](DocumentBuilder& b) {
+            b.beginMapping();
+            for (int i = 0; i < 1000000; ++i)
+            {
+                b.scalar("k");
+                b.beginMapping();
+            }
+        }},
+        {"wide sequence", "node count", [](DocumentBuilder& b) {
+            b.beginSequence();
+            for (int i = 0; i < 10000000; ++i) { b.null(); }
+        }},
+        {"huge scalar", "scalar length", [](DocumentBuilder& b) {
+            b.scalar(std::string(1 << 20, 'x'));
+        }},
+        {"billion laughs", "alias expansions", [](DocumentBuilder& b) {
+            b.beginSequence();
+            b.scalar("lol", "a0");
+            for (int level = 1; level < 10; ++level)
+            {
+                b.beginSequence("a" + std::to_string(level));
+                for (int i = 0; i < 10; ++i)
+                {
+                    b.alias("a" + std::to_string(level - 1));
+                }
+                b.endSequence();
+            }
+        }},
+        {"alias chain", "alias depth", [](DocumentBuilder& b) {
+            b.beginSequence();
+            b.scalar("x", "a0");
+            for (int level = 1; level < 1000; ++level)
+            {
+                b.beginSequence("a" + std::to_string(level));
+                b.alias("a" + std::to_string(level - 1));
+                b.endSequence();
+            }
+        }},
+        {"merge bomb", "alias expansions", [](DocumentBuilder& b) {
+            b.beginSequence();
+            b.beginMapping("m0");
+            b.scalar("k");
+            b.scalar("v");
+            b.endMapping();
+            for (int level = 1; level < 100; ++level)
+            {
+                b.beginMapping("m" + std::to_string(level));
+                for (int i = 0; i < 4; ++i)
+                {
+                    b.scalar("<<");
+                    b.alias("m" + std::to_string(level - 1));
+                }
+                b.endMapping();
+            }
+        }},
+    };
+    // clang-format on
+
+    for (const auto& c : corpus)
+    {
+        SCOPED_TRACE(c.name);
+        DocumentBuilder builder(limits);
+        auto            start = std::chrono::steady_clock::now();
+        try
+        {
+            c.input(builder);
+            ADD_FAILURE() << "Expected a limit to be exceeded";
+        }
+        catch (const LimitExceededException& e)
+        {
+            EXPECT_EQ(c.resource, e.resource());
+        }
+        std::chrono::duration<double> elapsed
+            = std::chrono::steady_clock::now() - start;
+        EXPECT_LT(elapsed.count(), 1.0);
+        EXPECT_LE(builder.guard().nodes(), limits.max_nodes);
+        EXPECT_LE(builder.guard().depth(), limits.max_depth);
+        EXPECT_LE(builder.anchors().expansions(),
+                  limits.aliases.max_expansions);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Random well-formed event streams either build or fail with a
+ *        LimitExceededException, and never exceed the limits.
+ */
+TEST(DocumentBuilderTest, random_streams)
+{
+    ParseLimits limits;
+    limits.max_depth              = 32;
+    limits.max_nodes              = 2000;
+    limits.aliases.max_expansions = 5000;
+    limits.aliases.max_depth      = 8;
+
+    std::mt19937 rng(20230601);
+    int          num_built = 0;
+    for (int trial = 0; trial < 200; ++trial)
+    {
+        DocumentBuilder builder(limits);
+        int             num_anchors = 0;
+        try
+        {
+            // Emit random nodes into a root sequence until the budget runs
+            // out, then close all open sequences
+            builder.beginSequence();
+            int open       = 1;
+            int num_events = rng() % 4000;
+            for (int event = 0; event < num_events; ++event)
+            {
+                switch (rng() % 5)
+                {
+                    case 0:
+                        builder.beginSequence();
+                        ++open;
+                        break;
+                    case 1:
+                        if (open > 1)
+                        {
+                            builder.endSequence();
+                            --open;
+                        }
+                        break;
+                    case 2:
+                        if (num_anchors > 0)
+                        {
+                            builder.alias("a"
+                                          + std::to_string(rng() % num_anchors));
+                            break;
+                        }
+                        [[fallthrough]];
+                    default:
+                        builder.scalar("s", "a" + std::to_string(num_anchors++));
+                }
+            }
+            for (; open > 0; --open)
+            {
+                builder.endSequence();
+            }
+            builder.finish();
+            ++num_built;
+        }
+        catch (const yayp::LimitExceededException&)
+        {
+            EXPECT_LE(builder.guard().nodes(), limits.max_nodes);
+            EXPECT_LE(builder.guard().depth(), limits.max_depth);
+            EXPECT_LE(builder.anchors().expansions(),
+                      limits.aliases.max_expansions);
+        }
+    }
+    EXPECT_GT(num_built, 0);
+    EXPECT_LT(num_built, 200);
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstDocumentBuilder.cc
+//---------------------------------------------------------------------------//
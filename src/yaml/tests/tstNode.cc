@@ -0,0 +1,211 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstNode.cc
+ * \brief  Tests for class Node.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../Node.hh"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../PackedArray.hh"
+
+#include "harness/AllocationCounter.hh"
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::Node;
+using Kind = yayp::Node::Kind;
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(NodeTest, construction)
+{
+    auto null = Node::makeNull();
+    EXPECT_EQ(Kind::Null, null->kind());
+    EXPECT_EQ(0, null->size());
+
+    auto scalar = Node::makeScalar("value");
+    EXPECT_EQ(Kind::Scalar, scalar->kind());
+    EXPECT_EQ("value", scalar->scalar());
+    EXPECT_EQ(1, scalar->expandedSize());
+
+    auto seq = Node::makeSequence({Node::makeScalar("a"), null});
+    EXPECT_EQ(Kind::Sequence, seq->kind());
+    EXPECT_EQ(2, seq->size());
+    EXPECT_EQ("a", seq->at(0).scalar());
+    EXPECT_EQ(Kind::Null, seq->at(1).kind());
+    EXPECT_EQ(3, seq->expandedSize());
+
+    auto map = Node::makeMapping({{"key", scalar}, {"list", seq}});
+    EXPECT_EQ(Kind::Mapping, map->kind());
+    EXPECT_EQ(2, map->size());
+    ASSERT_NE(nullptr, map->find("list"));
+    EXPECT_EQ(seq.get(), map->find("list"));
+    EXPECT_EQ(nullptr, map->find("missing"));
+    EXPECT_EQ(5, map->expandedSize());
+    EXPECT_EQ(0, map->aliasDepth());
+
+#if YAYP_DBC > 0
+    EXPECT_THROW(scalar->at(0), yayp::DBCException);
+    EXPECT_THROW(seq->scalar(), yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(NodeTest, alias)
+{
+    auto defaults = Node::makeMapping({{"cpu", Node::makeScalar("2")}});
+    auto alias    = Node::makeAlias("defaults", defaults);
+    EXPECT_TRUE(alias->isAlias());
+    EXPECT_EQ(Kind::Alias, alias->kind());
+    EXPECT_EQ(Kind::Mapping, alias->resolvedKind());
+    EXPECT_EQ("defaults", alias->anchor());
+
+    // The anchored node is shared rather than copied
+    EXPECT_EQ(defaults.get(), alias->target().get());
+    EXPECT_EQ(defaults.get(), &alias->resolve());
+    EXPECT_EQ("2", alias->find("cpu")->scalar());
+
+    // Aliases carry the expanded size of their target
+    EXPECT_EQ(2, alias->expandedSize());
+    EXPECT_EQ(1, alias->aliasDepth());
+
+    auto doc = Node::makeSequence({alias, alias, alias});
+    EXPECT_EQ(7, doc->expandedSize());
+    EXPECT_EQ(1, doc->aliasDepth());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(NodeTest, merge)
+{
+    auto base = Node::makeMapping(
+        {{"cpu", Node::makeScalar("1")}, {"memory", Node::makeScalar("1G")}});
+    auto extra = Node::makeMapping(
+        {{"memory", Node::makeScalar("2G")}, {"disk", Node::makeScalar("4G")}});
+
+    // Own entries take precedence over merged entries, and earlier merges
+    // over later ones
+    auto job = Node::makeMapping(
+        {{"cpu", Node::makeScalar("8")}},
+        {Node::makeAlias("base", base), Node::makeAlias("extra", extra)});
+    EXPECT_EQ(1, job->size());
+    EXPECT_EQ(2, job->merges().size());
+    EXPECT_EQ("8", job->find("cpu")->scalar());
+    EXPECT_EQ("1G", job->find("memory")->scalar());
+    EXPECT_EQ("4G", job->find("disk")->scalar());
+    EXPECT_EQ(nullptr, job->find("gpu"));
+
+    // Merged values are the anchored nodes themselves
+    EXPECT_EQ(base->find("memory"), job->find("memory"));
+
+    // Merges nest
+    auto nested = Node::makeMapping({}, {job});
+    EXPECT_EQ("4G", nested->find("disk")->scalar());
+
+#if YAYP_DBC > 0
+    EXPECT_THROW(Node::makeMapping({}, {Node::makeScalar("x")}),
+                 yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(NodeTest, number)
+{
+    auto number = [](const std::string& s) {
+        return Node::makeScalar(s)->number();
+    };
+    EXPECT_EQ(42.0, number("42"));
+    EXPECT_EQ(-3.0, number("-3"));
+    EXPECT_EQ(7.0, number("+7"));
+    EXPECT_EQ(0.5, number(".5"));
+    EXPECT_EQ(1.5e3, number("1.5e3"));
+    EXPECT_EQ(255.0, number("0xff"));
+    EXPECT_EQ(8.0, number("0o10"));
+    EXPECT_TRUE(std::isinf(*number("-.inf")) && *number("-.inf") < 0);
+    EXPECT_TRUE(std::isinf(*number(".Inf")));
+    EXPECT_TRUE(std::isnan(*number(".nan")));
+
+    for (const char* s : {"", "abc", "1.2.3", "inf", "nan", "+-1", "0x",
+                          "-0x10", "0o9", "1e", "12 ", "1_000"})
+    {
+        EXPECT_FALSE(number(s)) << s;
+    }
+
+    // The decoded value is kept, and aliases resolve to their target
+    auto scalar = Node::makeScalar("2.5");
+    auto alias  = Node::makeAlias("x", scalar);
+    EXPECT_EQ(2.5, scalar->number());
+    EXPECT_EQ(2.5, scalar->number());
+    EXPECT_EQ(2.5, alias->number());
+    EXPECT_FALSE(Node::makeScalar("text")->number());
+
+    // Quoted and block scalars are strings, whatever their text
+    auto quoted = Node::makeScalar("12", false);
+    EXPECT_TRUE(scalar->isPlain());
+    EXPECT_FALSE(quoted->isPlain());
+    EXPECT_FALSE(quoted->number());
+    EXPECT_FALSE(Node::makeAlias("q", quoted)->number());
+
+#if YAYP_DBC > 0
+    EXPECT_THROW(Node::makeNull()->number(), yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(NodeTest, packed)
+{
+    const std::string text = "[0.5, 1.0, 2.25]";
+    const char*       end  = nullptr;
+    auto              array = yayp::PackedArray::scanFlow(
+        text.data() + 1, text.data() + text.size(), end);
+    ASSERT_TRUE(array);
+    auto items = std::make_shared<const yayp::PackedArray>(std::move(*array));
+
+    auto seq = Node::makePackedSequence(items);
+    EXPECT_EQ(Kind::Sequence, seq->kind());
+    EXPECT_EQ(items.get(), seq->packed());
+    EXPECT_EQ(3, seq->size());
+    EXPECT_EQ(4, seq->expandedSize());
+
+    // Items are created on first use, with the text they were read from
+    EXPECT_EQ("1.0", seq->at(1).scalar());
+    EXPECT_EQ(2.25, seq->at(2).number());
+    const Node::Items& created = seq->items();
+    ASSERT_EQ(3, created.size());
+    EXPECT_EQ(&created[0]->scalar(), &seq->at(0).scalar());
+    EXPECT_EQ(created[1].get(), &seq->at(1));
+
+    // Reading one item of a large array creates only that item (and a table
+    // with a pointer per chunk of 256 items)
+    std::vector<std::int64_t> values(1000000);
+    auto large = Node::makePackedSequence(
+        std::make_shared<const yayp::PackedArray>(
+            yayp::PackedArray::fromValues(yayp::Span<const std::int64_t>(
+                values.data(), values.size()))));
+    const auto counts = yayp::AllocationCounter::count(
+        [&large] { EXPECT_EQ("0", large->at(123456).scalar()); });
+    EXPECT_GT(counts.allocations, 0);
+    EXPECT_LT(counts.bytes, values.size() / 16);
+    EXPECT_EQ(&large->at(123456), &large->at(123456));
+
+    auto alias = Node::makeAlias("a", seq);
+    EXPECT_EQ(items.get(), alias->packed());
+    EXPECT_EQ("0.5", alias->at(0).scalar());
+    EXPECT_EQ(nullptr, Node::makeSequence({})->packed());
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstNode.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,172 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstNodePool.cc
+ * \brief  Tests for class NodePool.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../NodePool.hh"
+
+#include <memory>
+#include <string>
+
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::Node;
+using yayp::NodePool;
+using yayp::NodePtr;
+using Kind = yayp::Node::Kind;
+
+namespace
+{
+//---------------------------------------------------------------------------//
+//! Build {a: [x, ~], b: {c: y}} with a pool
+NodePtr makeDocument(NodePool& pool)
+{
+    Node::Items items = {pool.makeScalar("x"), pool.makeNull()};
+    NodePtr     seq   = pool.makeSequence(items);
+
+    Node::Entries inner_entries = {{"c", pool.makeScalar("y")}};
+    Node::Items   no_merges;
+    NodePtr       inner = pool.makeMapping(inner_entries, no_merges);
+
+    Node::Entries entries = {{"a", seq}, {"b", inner}};
+    return pool.makeMapping(entries, no_merges);
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(NodePoolTest, factories)
+{
+    NodePool pool;
+    EXPECT_EQ(0, pool.size());
+
+    auto null = pool.makeNull();
+    EXPECT_EQ(Kind::Null, null->kind());
+
+    auto scalar = pool.makeScalar("value");
+    EXPECT_EQ(Kind::Scalar, scalar->kind());
+    EXPECT_EQ("value", scalar->scalar());
+
+    // The containers are exchanged for the (empty) ones of the new node
+    Node::Items items = {scalar, null};
+    auto        seq   = pool.makeSequence(items);
+    EXPECT_TRUE(items.empty());
+    ASSERT_EQ(2, seq->size());
+    EXPECT_EQ(3, seq->expandedSize());
+    EXPECT_EQ("value", seq->at(0).scalar());
+
+    auto          alias   = Node::makeAlias("s", seq);
+    Node::Entries entries = {{"k", alias}};
+    Node::Items   merges  = {Node::makeMapping({})};
+    auto          map     = pool.makeMapping(entries, merges);
+    EXPECT_TRUE(entries.empty());
+    EXPECT_TRUE(merges.empty());
+    EXPECT_EQ(Kind::Mapping, map->kind());
+    EXPECT_EQ(1, map->size());
+    EXPECT_EQ(1, map->merges().size());
+    EXPECT_EQ(1, map->aliasDepth());
+    EXPECT_EQ(5, map->expandedSize());
+
+#if YAYP_DBC > 0
+    // Merged nodes must be mappings
+    merges = {scalar};
+    EXPECT_THROW(pool.makeMapping(entries, merges), yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(NodePoolTest, recycle)
+{
+    NodePool    pool;
+    NodePtr     doc     = makeDocument(pool);
+    const Node* address = &doc->find("b")->find("c")->resolve();
+    EXPECT_EQ(0, pool.size());
+
+    // Every node of the document is kept, and its memory reused
+    pool.recycle(std::move(doc));
+    EXPECT_EQ(6, pool.size());
+    doc = makeDocument(pool);
+    EXPECT_EQ(0, pool.size());
+    EXPECT_EQ(address, &doc->find("b")->find("c")->resolve());
+
+    // The reused nodes are cleared
+    EXPECT_EQ(2, doc->size());
+    EXPECT_EQ(3, doc->find("a")->expandedSize());
+    EXPECT_EQ("x", doc->find("a")->at(0).scalar());
+    EXPECT_EQ(Kind::Null, doc->find("a")->at(1).kind());
+    ASSERT_EQ(1, doc->find("b")->size());
+    EXPECT_EQ("y", doc->find("b")->find("c")->scalar());
+    EXPECT_FALSE(doc->find("b")->find("c")->number());
+
+    pool.recycle(std::move(doc));
+    EXPECT_EQ(6, pool.size());
+    pool.clear();
+    EXPECT_EQ(0, pool.size());
+
+    // Recycling nothing keeps nothing
+    pool.recycle(nullptr);
+    EXPECT_EQ(0, pool.size());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(NodePoolTest, shared)
+{
+    // Nodes held elsewhere are not kept, and remain valid
+    NodePool pool;
+    NodePtr  doc = makeDocument(pool);
+    NodePtr  seq = doc->entries().front().second;
+    pool.recycle(std::move(doc));
+    EXPECT_EQ(3, pool.size());
+    ASSERT_EQ(2, seq->size());
+    EXPECT_EQ("x", seq->at(0).scalar());
+
+    // Aliased nodes are kept once all their handles are in the document,
+    // whichever of the anchor and the alias is visited first
+    Node::Items items = {seq, Node::makeAlias("s", seq)};
+    seq.reset();
+    pool.clear();
+    pool.recycle(pool.makeSequence(items));
+    EXPECT_EQ(4, pool.size());
+
+    Node::Entries entries = {{"alias", nullptr}, {"anchor", nullptr}};
+    Node::Items   merges;
+    NodePtr       target = pool.makeScalar("t");
+    entries[0].second    = Node::makeAlias("t", target);
+    entries[1].second    = std::move(target);
+    pool.clear();
+    pool.recycle(pool.makeMapping(entries, merges));
+    EXPECT_EQ(2, pool.size());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(NodePoolTest, aliases)
+{
+    // Aliases are released rather than kept, so the pool reaches a steady
+    // size when documents with aliases are recycled
+    NodePool pool;
+    for (int i = 0; i < 8; ++i)
+    {
+        Node::Items   no_merges;
+        NodePtr       target  = pool.makeScalar("t");
+        Node::Entries entries = {{"anchor", target},
+                                 {"alias", Node::makeAlias("t", target)}};
+        target.reset();
+        pool.recycle(pool.makeMapping(entries, no_merges));
+        EXPECT_EQ(2, pool.size()) << i;
+    }
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstNodePool.cc
+//---------------------------------------------------------------------------//
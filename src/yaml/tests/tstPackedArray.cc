@@ -0,0 +1,235 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstPackedArray.cc
+ * \brief  Tests for class PackedArray.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../PackedArray.hh"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::PackedArray;
+using Type = PackedArray::Type;
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Scan the flow sequence at the start of a text
+ *
+ * \return The array and the length of the sequence, if packed
+ */
+std::optional<std::pair<PackedArray, std::size_t>>
+scan(const std::string& text)
+{
+    EXPECT_EQ('[', text.front());
+    const char* end   = nullptr;
+    auto        array = PackedArray::scanFlow(
+        text.data() + 1, text.data() + text.size(), end);
+    if (!array)
+    {
+        return std::nullopt;
+    }
+    return std::make_pair(std::move(*array),
+                          static_cast<std::size_t>(end - text.data()));
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(PackedArrayTest, ints)
+{
+    auto result = scan("[1, -20,300 ,  0] # comment");
+    ASSERT_TRUE(result);
+    const PackedArray& array = result->first;
+    EXPECT_EQ(17, result->second);
+    EXPECT_EQ(Type::Int, array.type());
+    EXPECT_EQ(4, array.size());
+    EXPECT_CONT_EQ((std::vector<std::int64_t>{1, -20, 300, 0}), array.ints());
+    EXPECT_TRUE(array.floats().empty());
+    EXPECT_EQ("-20", array.format(1));
+
+    result = scan("[9223372036854775807]");
+    ASSERT_TRUE(result);
+    EXPECT_EQ("9223372036854775807", result->first.format(0));
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(PackedArrayTest, floats)
+{
+    auto result = scan("[1.0, -2.5, 0.125, 1e-05, 1e+300, -0.0]");
+    ASSERT_TRUE(result);
+    const PackedArray& array = result->first;
+    EXPECT_EQ(Type::Float, array.type());
+    const std::vector<double> expected{1.0, -2.5, 0.125, 1e-5, 1e300, 0};
+    EXPECT_CONT_SOFT_EQ(expected, array.floats());
+    for (auto [index, text] : {std::pair{0, "1.0"},
+                               std::pair{3, "1e-05"},
+                               std::pair{4, "1e+300"},
+                               std::pair{5, "-0.0"}})
+    {
+        EXPECT_EQ(text, array.format(index));
+    }
+
+#if YAYP_DBC > 0
+    EXPECT_THROW(array.format(6), yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(PackedArrayTest, long_sequences)
+{
+    // Cross the blocks of 64 bytes in every position
+    for (int n = 1; n < 100; ++n)
+    {
+        std::string         text = "[";
+        std::vector<double> expected;
+        for (int i = 0; i < n; ++i)
+        {
+            text += (i ? ", " : "") + std::to_string(i) + ".5";
+            expected.push_back(i + 0.5);
+        }
+        text += "]\n- next";
+        auto result = scan(text);
+        ASSERT_TRUE(result) << n;
+        EXPECT_EQ(text.size() - 7, result->second);
+        EXPECT_CONT_EQ(expected, result->first.floats());
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(PackedArrayTest, fallback)
+{
+    // Sequences that are not packed, to be scanned by the general scanner
+    for (const char* text : {"[]",
+                             "[ ]",
+                             "[1, 2",
+                             "[1, 2,]",
+                             "[1,, 2]",
+                             "[1 2]",
+                             "[1, 2.5]",
+                             "[2.5, 1]",
+                             "[1.50]",
+                             "[0.0001]",
+                             "[100000.0]",
+                             "[1e5]",
+                             "[+1]",
+                             "[007]",
+                             "[-0]",
+                             "[0x10]",
+                             "[.5]",
+                             "[1.]",
+                             "[1e999]",
+                             "[99999999999999999999]",
+                             "[1, -]",
+                             "[true]",
+                             "[.inf]",
+                             "[1, [2]]",
+                             "[1, '2']",
+                             "[1,\n 2]",
+                             "[1,\t2]",
+                             "[1, 2 # c\n]",
+                             "[1: 2]"})
+    {
+        EXPECT_FALSE(scan(text)) << text;
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(PackedArrayTest, append)
+{
+    PackedArray bools;
+    for (const char* text : {"true", "false", "true"})
+    {
+        EXPECT_TRUE(bools.append(text)) << text;
+    }
+    for (const char* text : {"True", "1", ""})
+    {
+        EXPECT_FALSE(bools.append(text)) << text;
+    }
+    EXPECT_EQ(Type::Bool, bools.type());
+    EXPECT_CONT_EQ((std::vector<bool>{true, false, true}), bools.bools());
+    EXPECT_EQ("false", bools.format(1));
+
+    // A rejected first item leaves the type to the next one
+    PackedArray floats;
+    EXPECT_FALSE(floats.append("1.50"));
+    EXPECT_TRUE(floats.append("-2.5"));
+    EXPECT_TRUE(floats.append("1e-05"));
+    for (const char* text : {"3", "true", "nan", "inf", ".nan", "1.0 "})
+    {
+        EXPECT_FALSE(floats.append(text)) << text;
+    }
+    EXPECT_EQ(Type::Float, floats.type());
+    EXPECT_CONT_SOFT_EQ((std::vector<double>{-2.5, 1e-5}), floats.floats());
+    EXPECT_TRUE(floats.ints().empty());
+    EXPECT_TRUE(floats.bools().empty());
+
+    PackedArray ints;
+    for (const char* text : {"-", "x", "0x1"})
+    {
+        EXPECT_FALSE(ints.append(text)) << text;
+    }
+    EXPECT_TRUE(ints.append("42"));
+    for (const char* text : {"1.0", "false", "-0", "+1"})
+    {
+        EXPECT_FALSE(ints.append(text)) << text;
+    }
+    EXPECT_CONT_EQ((std::vector<std::int64_t>{42}), ints.ints());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(PackedArrayTest, values)
+{
+    const std::vector<std::int64_t> values = {1, -2, 3};
+    PackedArray ints = PackedArray::fromValues(yayp::Span<const std::int64_t>(
+        values.data(), values.size()));
+    EXPECT_EQ(Type::Int, ints.type());
+    EXPECT_CONT_EQ(values, ints.ints());
+
+    // Only an item that append() would accept replaces another
+    auto edited = ints.with(1, "7");
+    ASSERT_TRUE(edited);
+    EXPECT_CONT_EQ((std::vector<std::int64_t>{1, 7, 3}), edited->ints());
+    EXPECT_CONT_EQ(values, ints.ints());
+    for (const char* text : {"7.0", "07", "true", ""})
+    {
+        EXPECT_FALSE(ints.with(1, text)) << text;
+    }
+
+    const bool  flags[] = {true, false};
+    PackedArray bools   = PackedArray::fromValues(
+        yayp::Span<const bool>(flags, 2));
+    EXPECT_EQ(Type::Bool, bools.type());
+    auto flipped = bools.with(0, "false");
+    ASSERT_TRUE(flipped);
+    EXPECT_CONT_EQ((std::vector<bool>{false, false}), flipped->bools());
+    EXPECT_TRUE(bools.append("true"));
+    EXPECT_EQ(3u, bools.size());
+
+    const double reals[] = {0.5};
+    auto         floats  = PackedArray::fromValues(
+        yayp::Span<const double>(reals, 1)).with(0, "1e+300");
+    ASSERT_TRUE(floats);
+    EXPECT_EQ("1e+300", floats->format(0));
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstPackedArray.cc
+//---------------------------------------------------------------------------//
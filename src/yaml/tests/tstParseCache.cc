@@ -0,0 +1,139 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstParseCache.cc
+ * \brief  Tests for class ParseCache.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../ParseCache.hh"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "core/Checksum.hh"
+#include "core/FileFunctions.hh"
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::ParseCache;
+
+namespace
+{
+//---------------------------------------------------------------------------//
+void writeFile(const std::string& filename, const std::string& contents)
+{
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out << contents;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(ParseCacheTest, hits_and_misses)
+{
+    const std::string first  = "name: first\nvalues: [1, 2, 3]\n";
+    const std::string second = "name: second\nvalues: [4, 5]\n";
+    writeFile("ParseCacheTest.yaml", first);
+
+    ParseCache cache(".");
+    EXPECT_EQ("./", cache.directory());
+    const std::string entry
+        = cache.entryPath("ParseCacheTest.yaml", yayp::checksum64(first));
+    const std::string second_entry
+        = cache.entryPath("ParseCacheTest.yaml", yayp::checksum64(second));
+    std::remove(entry.c_str());
+    std::remove(second_entry.c_str());
+
+    // The first load parses and stores a snapshot
+    {
+        auto snapshot = cache.load("ParseCacheTest.yaml");
+        EXPECT_EQ("first", snapshot.root().find("name").scalar());
+        EXPECT_EQ(0, cache.statistics().hits);
+        EXPECT_EQ(1, cache.statistics().misses);
+        EXPECT_TRUE(yayp::fileExists(entry));
+    }
+
+    // Later loads, including from another cache, map the snapshot
+    for (int i = 0; i < 3; ++i)
+    {
+        auto snapshot = cache.load("ParseCacheTest.yaml");
+        EXPECT_EQ(3, snapshot.root().find("values").size());
+    }
+    EXPECT_EQ(3, cache.statistics().hits);
+    EXPECT_EQ(1, cache.statistics().misses);
+
+    ParseCache other("./");
+    other.load("ParseCacheTest.yaml");
+    EXPECT_EQ(1, other.statistics().hits);
+
+    // Changing the file is a miss under a new entry
+    writeFile("ParseCacheTest.yaml", second);
+    {
+        auto snapshot = cache.load("ParseCacheTest.yaml");
+        EXPECT_EQ("second", snapshot.root().find("name").scalar());
+        EXPECT_EQ(2, cache.statistics().misses);
+    }
+    EXPECT_NE(entry, second_entry);
+    EXPECT_TRUE(yayp::fileExists(second_entry));
+
+    // The previous entry is still valid
+    writeFile("ParseCacheTest.yaml", first);
+    cache.load("ParseCacheTest.yaml");
+    EXPECT_EQ(4, cache.statistics().hits);
+    EXPECT_EQ(0, cache.statistics().invalid);
+
+    cache.resetStatistics();
+    EXPECT_EQ(0, cache.statistics().hits);
+    EXPECT_EQ(0, cache.statistics().misses);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ParseCacheTest, invalid_entries)
+{
+    const std::string contents = "a: 1\nb: [x, y]\n";
+    writeFile("ParseCacheInvalid.yaml", contents);
+
+    ParseCache        cache(".");
+    const std::string entry = cache.entryPath("ParseCacheInvalid.yaml",
+                                              yayp::checksum64(contents));
+
+    // A corrupt entry is replaced
+    writeFile(entry, "not a snapshot");
+    {
+        auto snapshot = cache.load("ParseCacheInvalid.yaml");
+        EXPECT_EQ("1", snapshot.root().find("a").scalar());
+    }
+    EXPECT_EQ(1, cache.statistics().misses);
+    EXPECT_EQ(1, cache.statistics().invalid);
+
+    cache.load("ParseCacheInvalid.yaml");
+    EXPECT_EQ(1, cache.statistics().hits);
+
+    // Errors in the YAML file are thrown
+    writeFile("ParseCacheInvalid.yaml", "a: [1, 2\n");
+    EXPECT_THROW(cache.load("ParseCacheInvalid.yaml"), yayp::Exception);
+    EXPECT_THROW(cache.load("./data/ThisWontWork.yaml"), yayp::Exception);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ParseCacheTest, entry_path)
+{
+    ParseCache cache("cache");
+    EXPECT_EQ("cache/", cache.directory());
+    EXPECT_EQ("cache/config.00000000000000ff.snap",
+              cache.entryPath("some/path/config.yaml", 0xff));
+    EXPECT_EQ("cache/config.0123456789abcdef.snap",
+              cache.entryPath("config.yml", 0x0123456789abcdefull));
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstParseCache.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,388 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstParser.cc
+ * \brief  Tests for class Parser.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../Parser.hh"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../Snapshot.hh"
+
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::Node;
+using yayp::ParseErrorCode;
+using yayp::Parser;
+using Kind = yayp::Node::Kind;
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(ParserTest, parse)
+{
+    Parser parser;
+    auto   result = parser.tryParse(R"(
+# Solver settings
+name: "solver"
+threads: 4
+tolerance: ~
+inputs:
+  - mesh.exo
+  - 'materials.yaml'
+options: {verbose: true, log: null}
+)");
+    ASSERT_TRUE(result.ok());
+    const Node& root = *result.value();
+    ASSERT_EQ(Kind::Mapping, root.kind());
+    EXPECT_EQ(5, root.size());
+    EXPECT_EQ("solver", root.find("name")->scalar());
+    EXPECT_EQ("4", root.find("threads")->scalar());
+    EXPECT_EQ(Kind::Null, root.find("tolerance")->kind());
+
+    const Node* inputs = root.find("inputs");
+    ASSERT_NE(nullptr, inputs);
+    ASSERT_EQ(2, inputs->size());
+    EXPECT_EQ("materials.yaml", inputs->at(1).scalar());
+
+    const Node* options = root.find("options");
+    ASSERT_NE(nullptr, options);
+    EXPECT_EQ("true", options->find("verbose")->scalar());
+    EXPECT_EQ(Kind::Null, options->find("log")->kind());
+
+    // Quoted nulls are strings
+    EXPECT_EQ(Kind::Scalar, parser.parse("'null'")->kind());
+
+    // Null keys keep their text
+    auto keys = parser.parse("null: 1\n~: 2\nNULL: ~\n");
+    ASSERT_EQ(Kind::Mapping, keys->kind());
+    EXPECT_EQ("1", keys->find("null")->scalar());
+    EXPECT_EQ("2", keys->find("~")->scalar());
+    EXPECT_EQ(Kind::Null, keys->find("NULL")->kind());
+    auto flow = parser.parse("{null: 1, ~: [null]}");
+    EXPECT_EQ("1", flow->find("null")->scalar());
+    EXPECT_EQ(Kind::Null, flow->find("~")->at(0).kind());
+
+    // An empty stream is a null document
+    EXPECT_EQ(Kind::Null, parser.parse("# nothing\n")->kind());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ParserTest, packed_sequences)
+{
+    Parser parser;
+    auto   root = parser.parse(R"(
+floats: [0.5, 1.5, 2.5]
+ints: &i [1, 2, 3]
+mixed: [1, 2.5]
+nested: {values: [[1.0], [2.0, 3.0]]}
+copy: *i
+block:
+  - 0.25
+  - -1.0
+  - 3.5
+flags: [true, false]
+quoted: ['1', '2']
+quoted_block:
+  - "1"
+  - "2"
+quoted_first:
+  - 'true'
+  - false
+quoted_last:
+  - 1
+  - "2"
+)");
+
+    // Flow sequences of numbers are packed, and read back unchanged
+    const Node* floats = root->find("floats");
+    ASSERT_NE(nullptr, floats->packed());
+    EXPECT_EQ(yayp::PackedArray::Type::Float, floats->packed()->type());
+    EXPECT_EQ("1.5", floats->at(1).scalar());
+    const Node* ints = root->find("ints");
+    ASSERT_NE(nullptr, ints->packed());
+    EXPECT_EQ(yayp::PackedArray::Type::Int, ints->packed()->type());
+    EXPECT_EQ(ints->packed(), root->find("copy")->packed());
+
+    // Homogeneous sequences of any style are packed by the builder
+    const Node* block = root->find("block");
+    ASSERT_NE(nullptr, block->packed());
+    EXPECT_CONT_SOFT_EQ((std::vector<double>{0.25, -1.0, 3.5}),
+                        block->packed()->floats());
+    EXPECT_EQ("-1.0", block->at(1).scalar());
+    const Node* flags = root->find("flags");
+    ASSERT_NE(nullptr, flags->packed());
+    EXPECT_CONT_EQ((std::vector<bool>{true, false}), flags->packed()->bools());
+
+    // Other sequences are not
+    const Node* mixed = root->find("mixed");
+    EXPECT_EQ(nullptr, mixed->packed());
+    EXPECT_EQ("2.5", mixed->at(1).scalar());
+    const Node& values = *root->find("nested")->find("values");
+    EXPECT_EQ(nullptr, values.packed());
+    ASSERT_NE(nullptr, values.at(1).packed());
+    EXPECT_EQ("3.0", values.at(1).at(1).scalar());
+
+    // Quoted items are strings, which are never packed
+    for (const char* key :
+         {"quoted", "quoted_block", "quoted_first", "quoted_last"})
+    {
+        const Node* quoted = root->find(key);
+        EXPECT_EQ(nullptr, quoted->packed()) << key;
+        ASSERT_EQ(2, quoted->size()) << key;
+    }
+    EXPECT_FALSE(root->find("quoted")->at(0).number());
+    EXPECT_FALSE(root->find("quoted_block")->at(1).number());
+    EXPECT_EQ("true", root->find("quoted_first")->at(0).scalar());
+    EXPECT_EQ(1.0, root->find("quoted_last")->at(0).number());
+    EXPECT_FALSE(root->find("quoted_last")->at(1).number());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ParserTest, aliases)
+{
+    Parser parser;
+    auto   root = parser.parse(R"(
+defaults: &defaults
+  cpu: 2
+  memory: 4
+job:
+  <<: *defaults
+  cpu: 8
+copy: *defaults
+quoted:
+  "<<": {x: 1}
+)");
+    const Node* job = root->find("job");
+    ASSERT_NE(nullptr, job);
+    EXPECT_EQ("8", job->find("cpu")->scalar());
+    ASSERT_EQ(1, job->merges().size());
+    EXPECT_EQ(root->find("defaults"), &job->merges().front()->resolve());
+
+    const Node* copy = root->find("copy");
+    ASSERT_NE(nullptr, copy);
+    EXPECT_TRUE(copy->isAlias());
+    EXPECT_EQ("defaults", copy->anchor());
+
+    // A quoted << is an ordinary key
+    const Node* quoted = root->find("quoted");
+    ASSERT_NE(nullptr, quoted);
+    EXPECT_TRUE(quoted->merges().empty());
+    EXPECT_EQ(nullptr, quoted->find("x"));
+    ASSERT_NE(nullptr, quoted->find("<<"));
+    EXPECT_EQ("1", quoted->find("<<")->find("x")->scalar());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ParserTest, documents)
+{
+    Parser parser;
+    auto   docs = parser.parseAll("--- a\n---\n- b\n...\n");
+    ASSERT_EQ(2, docs.size());
+    EXPECT_EQ("a", docs[0]->scalar());
+    EXPECT_EQ(Kind::Sequence, docs[1]->kind());
+
+    // Anchors do not carry over between documents
+    auto result = parser.tryParseAll("--- &a x\n--- *a\n");
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(ParseErrorCode::UndefinedAlias, result.error().code);
+
+    auto single = parser.tryParse("--- a\n--- b\n");
+    ASSERT_FALSE(single.ok());
+    EXPECT_EQ(ParseErrorCode::MultipleDocuments, single.error().code);
+    EXPECT_EQ(6, single.error().offset);
+    EXPECT_EQ(2, single.error().line);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ParserTest, errors)
+{
+    Parser parser;
+
+    // Syntax errors have a location
+    auto result = parser.tryParse("key: value\nlist:\n  - a\n   - b\n");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(ParseErrorCode::InvalidIndentation, result.error().code);
+    EXPECT_EQ(26, result.error().offset);
+    EXPECT_EQ(4, result.error().line);
+    EXPECT_EQ(4, result.error().column);
+
+    // Structural errors from the builder
+    result = parser.tryParse("a: *missing\n");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(ParseErrorCode::UndefinedAlias, result.error().code);
+    EXPECT_EQ(3, result.error().offset);
+
+    result = parser.tryParse("<<: scalar\n");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(ParseErrorCode::InvalidMerge, result.error().code);
+
+    // The parser is usable after an error
+    EXPECT_EQ("ok", parser.parse("ok")->scalar());
+
+    // The throwing wrappers
+    try
+    {
+        parser.parse("a: 1\n  b: 2\n");
+        FAIL() << "expected an exception";
+    }
+    catch (const yayp::Exception& e)
+    {
+        EXPECT_NE(std::string::npos, std::string(e.what()).find("line 2"))
+            << e.what();
+    }
+    EXPECT_THROW(parser.parseAll("[a, b"), yayp::Exception);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ParserTest, limits)
+{
+    yayp::ParseLimits limits;
+    limits.max_document_size = 64;
+    limits.max_nodes         = 4;
+    limits.max_depth         = 2;
+    Parser parser(limits);
+
+    auto result = parser.tryParse(std::string(65, 'x'));
+    ASSERT_FALSE(result);
+    EXPECT_EQ(ParseErrorCode::DocumentSizeLimit, result.error().code);
+    EXPECT_EQ(64, result.error().limit);
+
+    result = parser.tryParse("[1, 2, 3, 4]");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(ParseErrorCode::NodeCountLimit, result.error().code);
+    EXPECT_EQ(4, result.error().limit);
+    EXPECT_EQ(10, result.error().offset);
+
+    result = parser.tryParse("[[[1]]]");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(ParseErrorCode::DepthLimit, result.error().code);
+    EXPECT_EQ(2, result.error().limit);
+
+    EXPECT_THROW(parser.parse("[[[1]]]"), yayp::LimitExceededException);
+    EXPECT_EQ(3, parser.parse("[1, 2]")->size() + 1);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ParserTest, invalid_inputs)
+{
+    // Nothing is thrown for any prefix of a valid document
+    const std::string input = R"(
+base: &b {x: [1, 2], y: "a\tb"}
+list:
+- &i item
+- *i
+- k: |
+    text
+  l: 'q''s'
+derived:
+  <<: *b
+  z: >-
+    folded
+)";
+    Parser parser;
+    ASSERT_TRUE(parser.tryParse(input));
+    for (std::size_t n = 0; n < input.size(); ++n)
+    {
+        EXPECT_NO_THROW(parser.tryParse(input.substr(0, n))) << n;
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ParserTest, recycle)
+{
+    auto snapshot = [](const Node& doc) {
+        std::ostringstream os;
+        yayp::writeSnapshot(os, doc, {});
+        return os.str();
+    };
+
+    // Recycled nodes make the same documents as new ones
+    const std::vector<std::string> inputs = {
+        "a: [1, 2]\nb: {c: d}\n",
+        "- &x {k: a long value that does not fit in place}\n- *x\n- ~\n",
+        "base: &b {x: 1}\nderived:\n  <<: *b\n  y: [true, false]\n",
+        "'just a scalar'\n",
+        "a: [1, 2]\nb: {c: d}\n",
+        "text: |\n  one\n  two\nlist:\n  - 1.5\n  - 2\n  - x\n",
+    };
+    Parser fresh;
+    Parser parser;
+    for (int round = 0; round < 2; ++round)
+    {
+        for (const std::string& input : inputs)
+        {
+            auto doc = parser.parse(input);
+            EXPECT_EQ(snapshot(*fresh.parse(input)), snapshot(*doc)) << input;
+            parser.recycle(std::move(doc));
+        }
+    }
+
+    // Documents that are kept are not affected by recycling others
+    auto kept     = parser.parse(inputs[1]);
+    auto expected = snapshot(*kept);
+    auto subtree  = parser.parse(inputs[0])->entries().back().second;
+    for (const std::string& input : inputs)
+    {
+        parser.recycle(parser.parse(input));
+    }
+    EXPECT_EQ(expected, snapshot(*kept));
+    EXPECT_EQ("d", subtree->find("c")->scalar());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ParserTest, steady_state)
+{
+    // Once the nodes of a few messages have been recycled, parsing messages
+    // of the same shape does not allocate
+    const std::string message = R"(
+id: 8f14e45f-ceea-467f-a9d8-3c5e0e2f9b1a
+customer:
+  name: Ada Lovelace
+  email: "ada@example.com"
+items:
+  - sku: KB-2041
+    description: Mechanical keyboard with brown switches
+    quantity: 1
+  - sku: MS-0310
+    description: Wireless mouse
+    quantity: 2
+tags: [priority, gift]
+notes: >
+  Leave the parcel with the concierge
+  if nobody answers.
+)";
+    Parser parser;
+    auto   parse = [&parser, &message] {
+        parser.recycle(parser.parse(message));
+    };
+    for (int i = 0; i < 8; ++i)
+    {
+        parse();
+    }
+    EXPECT_NO_ALLOCATIONS(parse());
+
+    auto doc = parser.parse(message);
+    EXPECT_EQ("Wireless mouse",
+              doc->find("items")->at(1).find("description")->scalar());
+    EXPECT_EQ("gift", doc->find("tags")->at(1).scalar());
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstParser.cc
+//---------------------------------------------------------------------------//
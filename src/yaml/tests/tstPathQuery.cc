@@ -0,0 +1,248 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstPathQuery.cc
+ * \brief  Tests for class PathQuery.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../PathQuery.hh"
+
+#include <string>
+#include <vector>
+
+#include "../Parser.hh"
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::PathQuery;
+using Kind = PathQuery::Step::Kind;
+
+namespace
+{
+//---------------------------------------------------------------------------//
+const char stream[] = R"(
+defaults: &defaults
+  resources: &res {cpu: 2, memory: 4G}
+jobs:
+  - name: small
+    <<: *defaults
+  - name: large
+    resources:
+      cpu: 16
+      memory: 64G
+  - name: [not, a, scalar]
+    resources: *res
+---
+jobs:
+  - name: other
+    resources: {memory: 1G}
+    extra: &x {a: 1}
+    again: *x
+)";
+
+//---------------------------------------------------------------------------//
+//! Return the scalar values of the matches
+std::vector<std::string>
+select(const std::string& expression, std::string_view input = stream)
+{
+    std::vector<std::string> values;
+    for (const auto& node : PathQuery(expression).select(input))
+    {
+        values.push_back(node->resolvedKind() == yayp::Node::Kind::Scalar
+                             ? node->scalar()
+                             : "<node>");
+    }
+    return values;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(PathQueryTest, compile)
+{
+    PathQuery query("jobs[*].resources['mem.ory'][2].*");
+    EXPECT_EQ("jobs[*].resources['mem.ory'][2].*", query.expression());
+    const auto& steps = query.steps();
+    ASSERT_EQ(6, steps.size());
+    EXPECT_EQ(Kind::Key, steps[0].kind);
+    EXPECT_EQ("jobs", steps[0].key);
+    EXPECT_EQ(Kind::Any, steps[1].kind);
+    EXPECT_EQ("resources", steps[2].key);
+    EXPECT_EQ(Kind::Key, steps[3].kind);
+    EXPECT_EQ("mem.ory", steps[3].key);
+    EXPECT_EQ(Kind::Index, steps[4].kind);
+    EXPECT_EQ(2, steps[4].index);
+    EXPECT_EQ(Kind::Any, steps[5].kind);
+
+    EXPECT_TRUE(PathQuery("").steps().empty());
+    EXPECT_EQ("a b", PathQuery("[\"a b\"]").steps()[0].key);
+
+    EXPECT_EQ(18446744073709551615u,
+              PathQuery("a[18446744073709551615]").steps()[1].index);
+
+    for (const char* bad : {"a..b",
+                            ".a",
+                            "a.",
+                            "a[",
+                            "a[x]",
+                            "a[1",
+                            "a['b]",
+                            "a]b",
+                            "a[]",
+                            "a[18446744073709551616]",
+                            "jobs[18446744073709551617]"})
+    {
+        EXPECT_THROW(PathQuery{bad}, yayp::Exception) << bad;
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(PathQueryTest, select)
+{
+    // Values are found through merges and aliases, in each document
+    EXPECT_EQ(std::vector<std::string>({"4G", "64G", "4G", "1G"}),
+              select("jobs[*].resources.memory"));
+    EXPECT_EQ(std::vector<std::string>({"large"}), select("jobs[1].name"));
+    EXPECT_EQ(std::vector<std::string>({"<node>", "<node>"}),
+              select("jobs"));
+    EXPECT_EQ(std::vector<std::string>({"1", "1"}), select("jobs[0].*.a"));
+    EXPECT_EQ(std::vector<std::string>({"not", "a", "scalar"}),
+              select("jobs[2].name[*]"));
+    EXPECT_EQ(std::vector<std::string>({"2", "4G", "1G"}),
+              select("jobs[0].resources.*"));
+    EXPECT_TRUE(select("jobs[7].name").empty());
+    EXPECT_TRUE(select("jobs.name").empty());
+    EXPECT_TRUE(select("missing").empty());
+    EXPECT_EQ(2, select("").size());
+
+    // Own keys override merged keys
+    EXPECT_EQ(std::vector<std::string>({"own", "2"}),
+              select("*", "<<: {a: 1, b: 2}\na: own\n"));
+    EXPECT_EQ(std::vector<std::string>({"own"}),
+              select("a", "<<: {a: 1, b: 2}\na: own\n"));
+
+    // Only a plain << is a merge key
+    EXPECT_TRUE(select("a", "\"<<\": {a: 1}\n").empty());
+    EXPECT_EQ(std::vector<std::string>({"1"}),
+              select("['<<'].a", "'<<': {a: 1}\n"));
+
+    // Only the first of repeated keys is matched, as with Node::find
+    for (const char* text : {"a: {k0: 1, k1: 2, k0: 3}\n",
+                             "a: {k0: 1, k1: 2, k0: 3}\nb: &x 4\nc: *x\n",
+                             "a: &a {k0: 1, k1: 2, k0: 3}\n"})
+    {
+        EXPECT_EQ(std::vector<std::string>({"1"}), select("*.k0", text));
+        EXPECT_EQ(std::vector<std::string>({"1", "2"}), select("a.*", text));
+        EXPECT_EQ("1",
+                  yayp::Parser().parse(text)->find("a")->find("k0")->scalar());
+    }
+    EXPECT_EQ(std::vector<std::string>({"2", "1"}),
+              select("*", "<<: {a: 1, a: 3}\nb: 2\nb: 4\n"));
+
+    // Matches carry the document index and offset
+    std::vector<std::size_t> documents;
+    std::vector<std::size_t> offsets;
+    auto count = PathQuery("jobs[*].name")
+                     .run(stream, [&](const PathQuery::Match& match) {
+                         documents.push_back(match.document);
+                         offsets.push_back(match.offset);
+                     });
+    EXPECT_EQ(4, count);
+    EXPECT_EQ(std::vector<std::size_t>({0, 0, 0, 1}), documents);
+    EXPECT_EQ("small", std::string_view(stream).substr(offsets[0], 5));
+    EXPECT_EQ("other", std::string_view(stream).substr(offsets[3], 5));
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(PathQueryTest, skipped_values)
+{
+    // Without anchors and aliases, other values are skipped untokenized
+    const char input[] = R"(
+config:
+  solver:
+    tolerance: 1e-8
+    stages:
+      - {name: "a]", order: 2}
+      - name: b
+        order: [4, '}']
+  output:
+    - path: out
+      format: hdf5
+    - path: log
+      format:
+        text
+  mesh: {cells: [10, 20], file: "m{"}
+config2: 1
+)";
+    EXPECT_EQ((std::vector<std::string>{"m{"}),
+              select("config.mesh.file", input));
+    EXPECT_EQ((std::vector<std::string>{"text"}),
+              select("config.output[1].format", input));
+    EXPECT_EQ((std::vector<std::string>{"hdf5", "text"}),
+              select("config.output[*].format", input));
+    EXPECT_EQ((std::vector<std::string>{"1"}), select("config2", input));
+    EXPECT_EQ((std::vector<std::string>{}),
+              select("config.solver.stages[2]", input));
+
+    // Lines may end with a bare carriage return
+    EXPECT_EQ((std::vector<std::string>{"3"}),
+              select("b", "a:\r  x: 1\rb: 3\r"));
+
+    // Flow and quoted continuation lines are indented past their mapping,
+    // so skipping agrees with the parser
+    for (const char* text : {"a:\n  k1: [1,\n   2]\nb: 1",
+                             "a:\n  k1: \"x\n   y\"\nb: 1",
+                             "a:\n  k1: [1,\n  ]\nb: 1",
+                             "a:\n  [1,\n]\nb: 1"})
+    {
+        EXPECT_EQ((std::vector<std::string>{"1"}), select("b", text));
+        EXPECT_EQ("1", yayp::Parser().parse(text)->find("b")->scalar());
+    }
+    for (const char* text : {"a:\n  k1: [1,\n2]\nb: 1",
+                             "a:\n  k1: \"x\ny\"\nb: 1"})
+    {
+        EXPECT_THROW(select("b", text), yayp::Exception) << text;
+        EXPECT_FALSE(yayp::Parser().tryParseAll(text)) << text;
+    }
+    EXPECT_THROW(select("a.k1", "a:\n  k1: [1,\n  2]\nb: 1"),
+                 yayp::Exception);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(PathQueryTest, errors)
+{
+    PathQuery query("a.b");
+
+    auto result = query.tryRun("a: {b: 1\n", [](const PathQuery::Match&) {});
+    ASSERT_FALSE(result);
+    EXPECT_EQ(yayp::ParseErrorCode::UnterminatedFlow, result.error().code);
+    EXPECT_EQ(1, result.error().line);
+
+    // Errors in skipped subtrees are still reported
+    result = query.tryRun("x: *missing\na: {b: 1}\n",
+                          [](const PathQuery::Match&) {});
+    ASSERT_FALSE(result);
+    EXPECT_EQ(yayp::ParseErrorCode::UndefinedAlias, result.error().code);
+
+    result = query.tryRun("a: {<<: 1}\n", [](const PathQuery::Match&) {});
+    ASSERT_FALSE(result);
+    EXPECT_EQ(yayp::ParseErrorCode::InvalidMerge, result.error().code);
+
+    yayp::ParseLimits limits;
+    limits.max_document_size = 4;
+    EXPECT_THROW(query.select("a: {b: 1}\n", limits),
+                 yayp::LimitExceededException);
+    EXPECT_THROW(query.select("a: [\n"), yayp::Exception);
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstPathQuery.cc
+//---------------------------------------------------------------------------//
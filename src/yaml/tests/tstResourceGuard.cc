@@ -0,0 +1,87 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstResourceGuard.cc
+ * \brief  Tests for class ResourceGuard.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../ResourceGuard.hh"
+
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::LimitExceededException;
+using yayp::ParseLimits;
+using yayp::ResourceGuard;
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(ResourceGuardTest, limits)
+{
+    ParseLimits limits;
+    limits.max_depth         = 2;
+    limits.max_document_size = 100;
+    limits.max_scalar_length = 10;
+    limits.max_nodes         = 3;
+    ResourceGuard guard(limits);
+
+    // Sizes
+    EXPECT_NO_THROW(guard.checkDocumentSize(100));
+    EXPECT_THROW(guard.checkDocumentSize(101), LimitExceededException);
+    EXPECT_NO_THROW(guard.checkScalarLength(10));
+    EXPECT_THROW(guard.checkScalarLength(11), LimitExceededException);
+
+    // Nesting
+    guard.enter();
+    guard.enter();
+    EXPECT_EQ(2, guard.depth());
+    EXPECT_THROW(guard.enter(), LimitExceededException);
+    guard.leave();
+    EXPECT_NO_THROW(guard.enter());
+
+    // Nodes
+    for (int i = 0; i < 3; ++i)
+    {
+        guard.addNode();
+    }
+    EXPECT_EQ(3, guard.nodes());
+    try
+    {
+        guard.addNode();
+        FAIL() << "Expected the node limit to be exceeded";
+    }
+    catch (const LimitExceededException& e)
+    {
+        EXPECT_EQ("node count", e.resource());
+        EXPECT_EQ(3, e.limit());
+    }
+
+    guard.reset();
+    EXPECT_EQ(0, guard.depth());
+    EXPECT_EQ(0, guard.nodes());
+#if YAYP_DBC > 0
+    EXPECT_THROW(guard.leave(), yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ResourceGuardTest, defaults)
+{
+    // Only the nesting depth is limited by default
+    ResourceGuard guard;
+    EXPECT_NO_THROW(guard.checkDocumentSize(std::size_t(1) << 40));
+    EXPECT_NO_THROW(guard.checkScalarLength(std::size_t(1) << 40));
+    for (std::size_t i = 0; i < guard.limits().max_depth; ++i)
+    {
+        guard.enter();
+    }
+    EXPECT_THROW(guard.enter(), LimitExceededException);
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstResourceGuard.cc
+//---------------------------------------------------------------------------//
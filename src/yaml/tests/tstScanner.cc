@@ -0,0 +1,457 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstScanner.cc
+ * \brief  Tests for class Scanner.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../Scanner.hh"
+
+#include <string>
+
+#include "harness/Testing.hh"
+
+using yayp::Event;
+using yayp::EventType;
+using yayp::ParseErrorCode;
+using yayp::Scanner;
+
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the events of an input in a compact form
+ *
+ * Collections are written as "+SEQ"/"-SEQ" and "+MAP"/"-MAP", scalars as
+ * "=value" and aliases as "*name", each preceded by its anchor as "&name".
+ * An error is written as "!offset".  The node following each scalar equal
+ * to \c skip is skipped and written as "~".
+ */
+std::string events(std::string_view         input,
+                   const yayp::ParseLimits& limits = {},
+                   std::string_view         skip   = {})
+{
+    Scanner     scanner(input, limits);
+    std::string result;
+    Event       event;
+    while (true)
+    {
+        if (!result.empty())
+        {
+            result += ' ';
+        }
+        if (!scanner.next(event))
+        {
+            result += '!' + std::to_string(scanner.error().offset);
+            return result;
+        }
+        if (!event.anchor.empty())
+        {
+            result += '&';
+            result += event.anchor;
+            result += ' ';
+        }
+        switch (event.type)
+        {
+            // clang-format off
+            case EventType::StreamEnd:     return result.substr(
+                                               0, result.size() - 1);
+            case EventType::DocumentStart: result += "+DOC"; break;
+            case EventType::DocumentEnd:   result += "-DOC"; break;
+            case EventType::SequenceStart: result += "+SEQ"; break;
+            case EventType::SequenceEnd:   result += "-SEQ"; break;
+            case EventType::MappingStart:  result += "+MAP"; break;
+            case EventType::MappingEnd:    result += "-MAP"; break;
+            case EventType::Scalar:        result += '=';    break;
+            case EventType::Alias:         result += '*';    break;
+            case EventType::PackedSequence:
+                result += "[" + std::to_string(event.packed->size()) + "]";
+                break;
+            // clang-format on
+        }
+        result += event.value;
+        if (!skip.empty() && event.type == EventType::Scalar
+            && event.value == skip)
+        {
+            if (!scanner.skipValue())
+            {
+                result += " !" + std::to_string(scanner.error().offset);
+                return result;
+            }
+            result += " ~";
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return the error code of an invalid input
+ */
+ParseErrorCode errorCode(std::string_view input)
+{
+    Scanner scanner(input);
+    Event   event;
+    while (scanner.next(event))
+    {
+        if (event.type == EventType::StreamEnd)
+        {
+            return ParseErrorCode::None;
+        }
+    }
+    return scanner.error().code;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(ScannerTest, block)
+{
+    EXPECT_EQ("", events(""));
+    EXPECT_EQ("+DOC =value -DOC", events("value\n"));
+    EXPECT_EQ("+DOC = -DOC", events("# comment only\n---\n"));
+    EXPECT_EQ("+DOC +MAP =a =1 =b =2 -MAP -DOC", events("a: 1\nb: 2"));
+    EXPECT_EQ("+DOC +SEQ =x =y -SEQ -DOC", events("- x\n- y\n"));
+
+    // Nested collections and empty values
+    EXPECT_EQ("+DOC +MAP =outer +MAP =inner =v -MAP =empty = -MAP -DOC",
+              events("outer:\n  inner: v\nempty:\n"));
+    EXPECT_EQ("+DOC +MAP =list +SEQ =a =b -SEQ =next =n -MAP -DOC",
+              events("list:\n  - a\n  - b\nnext: n\n"));
+
+    // Sequence at the indentation of its key
+    EXPECT_EQ("+DOC +MAP =list +SEQ =a =b -SEQ =next =n -MAP -DOC",
+              events("list:\n- a\n- b\nnext: n\n"));
+
+    // Compact nested entries
+    EXPECT_EQ("+DOC +SEQ +MAP =k =v =l =w -MAP +SEQ =x =y -SEQ -SEQ -DOC",
+              events("- k: v\n  l: w\n- - x\n  - y\n"));
+
+    // Comments, blank lines and trailing whitespace
+    EXPECT_EQ("+DOC +MAP =a =b c -MAP -DOC",
+              events("# head\n\na:   b c   # tail\n\n  # indented\n"));
+
+    // Plain scalars may contain indicators that are not followed by spaces
+    EXPECT_EQ("+DOC +MAP =url =http://x.y/z#a =t =a-b:c -MAP -DOC",
+              events("url: http://x.y/z#a\nt: a-b:c\n"));
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ScannerTest, flow)
+{
+    EXPECT_EQ("+DOC +SEQ =a =b -SEQ -DOC", events("[a, b]"));
+    EXPECT_EQ("+DOC +SEQ -SEQ -DOC", events("[ ]"));
+    EXPECT_EQ("+DOC +MAP =a =1 =b = -MAP -DOC", events("{a: 1, b}"));
+    EXPECT_EQ("+DOC +MAP =k +SEQ =1 +MAP =x =y -MAP -SEQ -MAP -DOC",
+              events("k: [1, {x: y}]\n"));
+
+    // Multiple lines, comments and a trailing comma
+    EXPECT_EQ("+DOC +MAP =k +SEQ =a =b -SEQ =l =m -MAP -DOC",
+              events("k: [a,  # first\n    b,\n]\nl: m\n"));
+
+    // Colons within plain scalars
+    EXPECT_EQ("+DOC +MAP =url =http://x -MAP -DOC",
+              events("{url: http://x}"));
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ScannerTest, quoted)
+{
+    EXPECT_EQ("+DOC +MAP =a b =c: d -MAP -DOC", events("'a b': \"c: d\"\n"));
+    EXPECT_EQ("+DOC =it's -DOC", events("'it''s'"));
+
+    // Escapes
+    EXPECT_EQ(
+        std::string("+DOC =tab\there\nquote\" \xC3\xA9\xE2\x82\xAC -DOC"),
+              events(R"("tab\there\nquote\" \xe9\u20AC")"));
+
+    // Line folding
+    EXPECT_EQ("+DOC =one two\nthree -DOC",
+              events("\"one  \n  two\n\n three\""));
+    EXPECT_EQ("+DOC =joined -DOC", events("\"join\\\n   ed\""));
+
+    // Unescaped values are views into the input
+    std::string input = "key: 'value'";
+    Scanner     scanner(input);
+    Event       event;
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(scanner.next(event));
+    }
+    EXPECT_EQ("value", event.value);
+    EXPECT_EQ(yayp::ScalarStyle::SingleQuoted, event.style);
+    EXPECT_EQ(input.data() + 6, event.value.data());
+    EXPECT_EQ(5, event.offset);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ScannerTest, block_scalar)
+{
+    EXPECT_EQ("+DOC +MAP =text =line 1\nline 2\n =next =n -MAP -DOC",
+              events("text: |\n  line 1\n  line 2\nnext: n\n"));
+    EXPECT_EQ("+DOC +SEQ =a b -SEQ -DOC", events("- >-\n  a\n  b\n"));
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ScannerTest, anchors)
+{
+    EXPECT_EQ("+DOC +MAP =a &x =1 =b *x -MAP -DOC",
+              events("a: &x 1\nb: *x\n"));
+
+    // Anchors of collections, inline or on the preceding line
+    EXPECT_EQ("+DOC +MAP =base &b +MAP =k =v -MAP =copy *b -MAP -DOC",
+              events("base: &b\n  k: v\ncopy: *b\n"));
+    EXPECT_EQ("+DOC &s +SEQ =1 -SEQ -DOC", events("&s [1]"));
+    EXPECT_EQ("+DOC &t +SEQ =1 -SEQ -DOC", events("--- &t\n- 1\n"));
+
+    // Tags are skipped
+    EXPECT_EQ("+DOC +MAP =n =1 -MAP -DOC", events("n: !!int 1\n"));
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ScannerTest, documents)
+{
+    EXPECT_EQ("+DOC =a -DOC +DOC =b -DOC", events("--- a\n--- b\n"));
+    EXPECT_EQ("+DOC +MAP =k =v -MAP -DOC +DOC = -DOC",
+              events("%YAML 1.2\n---\nk: v\n...\n---\n"));
+    EXPECT_EQ("+DOC =bom -DOC", events("\xEF\xBB\xBF" "bom"));
+
+    // Windows line endings
+    EXPECT_EQ("+DOC +MAP =a =1 =b =2 -MAP -DOC", events("a: 1\r\nb: 2\r\n"));
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ScannerTest, errors)
+{
+    // The error is reported at the offending position
+    EXPECT_EQ("+DOC +MAP =a =1 !7", events("a: 1\n  b: 2\n"));
+    EXPECT_EQ("+DOC +MAP =k !3", events("k: 'open\n"));
+
+    EXPECT_EQ(ParseErrorCode::InvalidIndentation,
+              errorCode("a:\n  b: 1\n c: 2"));
+    EXPECT_EQ(ParseErrorCode::InvalidIndentation, errorCode("a: [b,\nc]"));
+    EXPECT_EQ(ParseErrorCode::InvalidIndentation,
+              errorCode("- a: {b: 1,\n  c: 2}"));
+    EXPECT_EQ(ParseErrorCode::InvalidIndentation, errorCode("a: \"b\nc\""));
+    EXPECT_EQ(ParseErrorCode::InvalidIndentation, errorCode("a: 'b\n\nc'"));
+    EXPECT_EQ(ParseErrorCode::InvalidIndentation,
+              errorCode("a: \"b\\\nc\""));
+    EXPECT_EQ(ParseErrorCode::TabIndentation, errorCode("a:\n\tb: 1"));
+    EXPECT_EQ(ParseErrorCode::ExpectedKey, errorCode("a: 1\nb\n"));
+    EXPECT_EQ(ParseErrorCode::UnexpectedContent, errorCode("a: b: c"));
+    EXPECT_EQ(ParseErrorCode::UnexpectedContent, errorCode("'a' b"));
+    EXPECT_EQ(ParseErrorCode::UnterminatedQuote, errorCode("\"abc"));
+    EXPECT_EQ(ParseErrorCode::InvalidEscape, errorCode("\"\\q\""));
+    EXPECT_EQ(ParseErrorCode::InvalidEscape, errorCode("\"\\uD800\""));
+    EXPECT_EQ(ParseErrorCode::UnterminatedFlow, errorCode("[a, b"));
+    EXPECT_EQ(ParseErrorCode::UnexpectedCharacter, errorCode("['a' b]"));
+    EXPECT_EQ(ParseErrorCode::UnexpectedCharacter, errorCode("[a}"));
+    EXPECT_EQ(ParseErrorCode::InvalidBlockHeader, errorCode("k: |x\n  a\n"));
+    EXPECT_EQ(ParseErrorCode::InvalidAnchor, errorCode("a: & b"));
+    EXPECT_EQ(ParseErrorCode::NonScalarKey, errorCode("[a]: b"));
+    EXPECT_EQ(ParseErrorCode::UnsupportedFeature, errorCode("? a\n: b\n"));
+    EXPECT_EQ(ParseErrorCode::UnsupportedFeature, errorCode("[a: b]"));
+
+    // Errors are sticky
+    Scanner scanner("[");
+    Event   event;
+    while (scanner.next(event)) {}
+    EXPECT_FALSE(scanner.next(event));
+    EXPECT_EQ(ParseErrorCode::UnterminatedFlow, scanner.error().code);
+    EXPECT_EQ(0, scanner.error().offset);
+
+    // The scanner may be reused
+    scanner.reset("x");
+    ASSERT_TRUE(scanner.next(event));
+    EXPECT_EQ(EventType::DocumentStart, event.type);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ScannerTest, depth_limit)
+{
+    yayp::ParseLimits limits;
+    limits.max_depth = 3;
+    EXPECT_EQ("+DOC +SEQ +SEQ +SEQ -SEQ -SEQ -SEQ -DOC",
+              events("[[[]]]", limits));
+    EXPECT_EQ("+DOC +SEQ +SEQ +SEQ !3", events("[[[[]]]]", limits));
+
+    Scanner scanner("a:\n b:\n  c:\n   d: 1\n", limits);
+    Event   event;
+    while (scanner.next(event)) {}
+    EXPECT_EQ(ParseErrorCode::DepthLimit, scanner.error().code);
+    EXPECT_EQ(3, scanner.error().limit);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ScannerTest, skip_value)
+{
+    auto skipping = [](std::string_view input) {
+        return events(input, {}, "x");
+    };
+
+    // Scalars and aliases
+    EXPECT_EQ("+DOC +MAP =x ~ =y =2 -MAP -DOC", skipping("x: 1\ny: 2\n"));
+    EXPECT_EQ("+DOC +MAP =a &a =1 =x ~ =y =2 -MAP -DOC",
+              skipping("a: &a 1\nx: *a\ny: 2\n"));
+
+    // Block collections on the following lines, including comments and
+    // lines that are less indented than the content but more than the key
+    EXPECT_EQ("+DOC +MAP =a +MAP =x ~ =y =1 -MAP =z =2 -MAP -DOC",
+              skipping("a:\n  x:\n      b:\n        - [\n\n"
+                       "#c\n     c: 1\n  y: 1\nz: 2\n"));
+    EXPECT_EQ("+DOC +MAP =x ~ =y =3 -MAP -DOC",
+              skipping("x:\n- 1\n- a: 2\n\n  # c\ny: 3\n"));
+    EXPECT_EQ("+DOC +SEQ +MAP =x ~ =y =2 -MAP =z -SEQ -DOC",
+              skipping("- x:\n    a: 1\n  y: 2\n- z\n"));
+    EXPECT_EQ("+DOC +MAP =x ~ -MAP -DOC +DOC =y -DOC",
+              skipping("x:\n  a: 1\n---\ny\n"));
+
+    // Any line break ends a skipped line
+    EXPECT_EQ("+DOC +MAP =x ~ =b =3 -MAP -DOC",
+              skipping("x:\r  a: 1\rb: 3\r"));
+    EXPECT_EQ("+DOC +MAP =x ~ =b =3 -MAP -DOC",
+              skipping("x:\r\n  a: 1\r\nb: 3\r\n"));
+    EXPECT_EQ("+DOC +MAP =x ~ =b =3 -MAP -DOC",
+              skipping("x:\n  a: 1 # c\rb: 3\n"));
+
+    // Block collections beginning on the same line
+    EXPECT_EQ("+DOC +SEQ =x ~ =y -SEQ -DOC",
+              skipping("- x\n- - a: 1\n    b: [2\n  - - 3\n- y\n"));
+    EXPECT_EQ("+DOC +SEQ =x ~ =y -SEQ -DOC",
+              skipping("- x\n- a: {b: 1}\n  c: 2\n- y\n"));
+
+    // Flow collections, in block and flow context
+    EXPECT_EQ("+DOC +MAP =x ~ =y =2 -MAP -DOC",
+              skipping("x: [1, {a: ']'}, \"\\\"]\", don't] # ]\ny: 2\n"));
+    EXPECT_EQ("+DOC +MAP =x ~ =y =2 -MAP -DOC",
+              skipping("x: {a: [1,\n  2], b: 'it''s]'\n  }\ny: 2\n"));
+    EXPECT_EQ("+DOC +MAP =x ~ =y =2 -MAP -DOC",
+              skipping("{x: {a: [1]}, y: 2}"));
+    EXPECT_EQ("+DOC +SEQ =x ~ =y -SEQ -DOC", skipping("[x, [1, [2]], y]"));
+
+    // Errors in the scanned part are reported, others may not be
+    EXPECT_EQ("+DOC +MAP =x !3", skipping("x: [1, 2\n"));
+    EXPECT_EQ("+DOC +MAP =x !6", skipping("x: [1]: 2\n"));
+    EXPECT_EQ("+DOC +MAP =x ~ =y =2 -MAP -DOC",
+              skipping("x:\n  a: 1\n  - 2\ny: 2\n"));
+
+    // Items of a sequence are skipped after peeking
+    Scanner scanner("- - a: 1\n    b: 2\n  - c\n- d\n- e: 3\n  f: 4\n");
+    Event   event;
+    for (int i = 0; i < 2; ++i)
+    {
+        ASSERT_TRUE(scanner.next(event));
+    }
+    EXPECT_EQ(EventType::SequenceStart, event.type);
+    ASSERT_TRUE(scanner.peek(event));
+    EXPECT_EQ(EventType::SequenceStart, event.type);
+    ASSERT_TRUE(scanner.skipValue());
+    ASSERT_TRUE(scanner.next(event));
+    EXPECT_EQ("d", event.value);
+    ASSERT_TRUE(scanner.skipValue());
+    ASSERT_TRUE(scanner.next(event));
+    EXPECT_EQ(EventType::SequenceEnd, event.type);
+    ASSERT_TRUE(scanner.next(event));
+    EXPECT_EQ(EventType::DocumentEnd, event.type);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ScannerTest, packing)
+{
+    const std::string input
+        = "a: &n [1.5, 2.5, 3.5]\nb: [1, x]\nc: {d: [[4, 5], 6]}\n";
+    Scanner scanner(input);
+    EXPECT_FALSE(scanner.packing());
+    scanner.enablePacking();
+    EXPECT_TRUE(scanner.packing());
+
+    // Packed sequences are single events, anchored as collections are
+    Event event;
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(scanner.next(event));
+    }
+    ASSERT_EQ(EventType::PackedSequence, event.type);
+    EXPECT_EQ("n", event.anchor);
+    EXPECT_EQ(6, event.offset);
+    ASSERT_TRUE(event.packed);
+    EXPECT_EQ(3, event.packed->size());
+    EXPECT_EQ("2.5", event.packed->format(1));
+
+    // Other sequences are scanned as usual, and inner ones may be packed
+    std::string rest;
+    while (scanner.next(event) && event.type != EventType::StreamEnd)
+    {
+        rest += event.type == EventType::PackedSequence ? "[]"
+                : event.type == EventType::Scalar       ? event.value
+                                                        : "";
+    }
+    EXPECT_EQ("b1xcd[]6", rest);
+    EXPECT_EQ(ParseErrorCode::None, scanner.error().code);
+
+    // Packed sequences are skipped as single nodes
+    scanner.reset("a: [1, 2]\nb: 3\n");
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(scanner.next(event));
+    }
+    ASSERT_TRUE(scanner.skipValue());
+    ASSERT_TRUE(scanner.next(event));
+    EXPECT_EQ("b", event.value);
+
+    // Errors after a packed sequence are still found
+    scanner.reset("[1, 2]: x\n");
+    while (scanner.next(event) && event.type != EventType::StreamEnd) {}
+    EXPECT_EQ(ParseErrorCode::NonScalarKey, scanner.error().code);
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(ScannerTest, steady_state)
+{
+    // Once its buffers have grown, a scanner reads a stream of the same
+    // shape without allocating
+    const std::string input = "a: &x {b: [1, 2], c: 'it''s'}\n"
+                              "d:\n"
+                              "  - \"tab\\there\"\n"
+                              "  - *x\n"
+                              "  - |\n"
+                              "    line one\n"
+                              "    line two\n"
+                              "e: {f: {g: {h: [i, j]}}}\n"
+                              "---\n"
+                              "- k\n";
+    Scanner     scanner;
+    Event       event;
+    std::size_t count = 0;
+    auto        scan  = [&scanner, &event, &count, &input] {
+        scanner.reset(input);
+        while (scanner.next(event) && event.type != EventType::StreamEnd)
+        {
+            ++count;
+        }
+    };
+    scan();
+    EXPECT_EQ(ParseErrorCode::None, scanner.error().code);
+    const std::size_t first = count;
+    EXPECT_NO_ALLOCATIONS(scan());
+    EXPECT_EQ(ParseErrorCode::None, scanner.error().code);
+    EXPECT_EQ(2 * first, count);
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstScanner.cc
+//---------------------------------------------------------------------------//
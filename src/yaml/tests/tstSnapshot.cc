@@ -0,0 +1,247 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstSnapshot.cc
+ * \brief  Tests for class Snapshot.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../Snapshot.hh"
+
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../Parser.hh"
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::Snapshot;
+using yayp::SnapshotNode;
+using Kind = yayp::Node::Kind;
+
+namespace
+{
+//---------------------------------------------------------------------------//
+const char source[] = R"(
+defaults: &defaults
+  cpu: 2
+  memory: 4
+jobs:
+  - name: small
+    <<: *defaults
+  - name: large
+    <<: *defaults
+    cpu: 16
+  - *defaults
+empty: ~
+)";
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Return a snapshot image, copied to 8-byte aligned storage
+ */
+std::vector<std::uint64_t> makeImage(const yayp::Node& root,
+                                     std::string_view  text = source)
+{
+    std::ostringstream os;
+    yayp::writeSnapshot(os, root, text);
+    const std::string          bytes = os.str();
+    std::vector<std::uint64_t> image(bytes.size() / 8);
+    EXPECT_EQ(0, bytes.size() % 8);
+    std::memcpy(image.data(), bytes.data(), bytes.size());
+    return image;
+}
+
+//---------------------------------------------------------------------------//
+std::string_view view(const std::vector<std::uint64_t>& image)
+{
+    return std::string_view(reinterpret_cast<const char*>(image.data()),
+                            image.size() * 8);
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(SnapshotTest, view)
+{
+    auto root  = yayp::Parser().parse(source);
+    auto image = makeImage(*root);
+
+    Snapshot     snapshot = Snapshot::fromImage(view(image));
+    SnapshotNode doc      = snapshot.root();
+    ASSERT_EQ(Kind::Mapping, doc.kind());
+    EXPECT_EQ(3, doc.size());
+    EXPECT_EQ("defaults", doc.keyAt(0));
+
+    SnapshotNode jobs = doc.find("jobs");
+    ASSERT_TRUE(jobs);
+    ASSERT_EQ(3, jobs.size());
+
+    // Merged keys, with own keys taking precedence
+    EXPECT_EQ("small", jobs.at(0).find("name").scalar());
+    EXPECT_EQ("2", jobs.at(0).find("cpu").scalar());
+    EXPECT_EQ("16", jobs.at(1).find("cpu").scalar());
+    EXPECT_EQ("4", jobs.at(1).find("memory").scalar());
+    EXPECT_EQ(1, jobs.at(1).numMerges());
+    EXPECT_FALSE(jobs.at(1).find("missing"));
+
+    // Aliases refer to the stored anchored node
+    SnapshotNode alias = jobs.at(2);
+    EXPECT_TRUE(alias.isAlias());
+    EXPECT_EQ("defaults", alias.anchor());
+    EXPECT_EQ(doc.find("defaults").index(), alias.target().index());
+    EXPECT_EQ(Kind::Mapping, alias.resolvedKind());
+    EXPECT_EQ("2", alias.find("cpu").scalar());
+
+    EXPECT_EQ(Kind::Null, doc.find("empty").kind());
+
+#if YAYP_DBC > 0
+    EXPECT_THROW(doc.at(0), yayp::DBCException);
+    EXPECT_THROW(jobs.at(3), yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(SnapshotTest, sharing_and_interning)
+{
+    // Shared nodes are stored once and repeated strings are interned
+    auto leaf = yayp::Node::makeScalar("repeated value");
+    auto root = yayp::Node::makeSequence(
+        {leaf, leaf, yayp::Node::makeScalar("repeated value"),
+         yayp::Node::makeScalar("12", false)});
+    auto image = makeImage(*root);
+
+    Snapshot snapshot = Snapshot::fromImage(view(image));
+    EXPECT_EQ(4, snapshot.numNodes());
+    SnapshotNode seq = snapshot.root();
+    EXPECT_EQ(seq.at(0).index(), seq.at(1).index());
+    EXPECT_NE(seq.at(0).index(), seq.at(2).index());
+    EXPECT_EQ(seq.at(0).scalar().data(), seq.at(2).scalar().data());
+
+    // Quoted scalars remain strings
+    EXPECT_TRUE(seq.at(0).isPlain());
+    EXPECT_FALSE(seq.at(3).isPlain());
+
+    // Rebuilding the tree preserves sharing
+    auto rebuilt = snapshot.toNode();
+    ASSERT_EQ(4, rebuilt->size());
+    EXPECT_EQ(rebuilt->items()[0], rebuilt->items()[1]);
+    EXPECT_EQ("repeated value", rebuilt->at(2).scalar());
+    EXPECT_FALSE(rebuilt->at(3).number());
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(SnapshotTest, packed)
+{
+    // Packed sequences store their values, not their items
+    const char text[] = "f: [0.5, -1.25, 1e+300]\ni: [1, -2]\n"
+                        "b: [true, false, true]\n";
+    auto       root   = yayp::Parser().parse(text);
+    auto       image  = makeImage(*root, text);
+
+    Snapshot snapshot = Snapshot::fromImage(view(image));
+    EXPECT_EQ(4, snapshot.numNodes());
+    SnapshotNode floats = snapshot.root().find("f");
+    ASSERT_TRUE(floats.isPacked());
+    EXPECT_EQ(yayp::PackedArray::Type::Float, floats.packedType());
+    EXPECT_EQ(3, floats.size());
+    EXPECT_CONT_EQ((std::vector<double>{0.5, -1.25, 1e300}), floats.floats());
+    EXPECT_CONT_EQ((std::vector<std::int64_t>{1, -2}),
+                   snapshot.root().find("i").ints());
+    EXPECT_CONT_EQ((std::vector<bool>{true, false, true}),
+                   snapshot.root().find("b").bools());
+    EXPECT_FALSE(snapshot.root().isPacked());
+
+    // Rebuilding the tree keeps the sequences packed
+    auto rebuilt = snapshot.toNode();
+    const yayp::PackedArray* packed = rebuilt->find("f")->packed();
+    ASSERT_NE(nullptr, packed);
+    EXPECT_EQ("1e+300", packed->format(2));
+    EXPECT_EQ("-2", rebuilt->find("i")->at(1).scalar());
+    EXPECT_EQ("false", rebuilt->find("b")->at(1).scalar());
+
+#if YAYP_DBC > 0
+    EXPECT_THROW(floats.at(0), yayp::DBCException);
+    EXPECT_THROW(floats.ints(), yayp::DBCException);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(SnapshotTest, round_trip_file)
+{
+    yayp::Parser parser;
+    auto         root = parser.parse(source);
+    yayp::saveSnapshot("SnapshotTest.snap", *root, source);
+
+    Snapshot snapshot = Snapshot::open("SnapshotTest.snap");
+    EXPECT_TRUE(snapshot.isCurrent(source));
+    EXPECT_FALSE(snapshot.isCurrent(std::string(source) + "extra: 1\n"));
+
+    auto rebuilt = snapshot.toNode();
+    ASSERT_EQ(Kind::Mapping, rebuilt->kind());
+    const yayp::Node* jobs = rebuilt->find("jobs");
+    ASSERT_NE(nullptr, jobs);
+    EXPECT_EQ("16", jobs->at(1).find("cpu")->scalar());
+    EXPECT_EQ("4", jobs->at(0).find("memory")->scalar());
+    EXPECT_TRUE(jobs->items()[2]->isAlias());
+    EXPECT_EQ(&jobs->items()[2]->resolve(), rebuilt->find("defaults"));
+
+    EXPECT_THROW(Snapshot::open("./data/ThisWontWork.snap"), yayp::Exception);
+
+    // Replacing the snapshot leaves no temporary file behind
+    yayp::saveSnapshot("SnapshotTest.snap", *root, source);
+    EXPECT_TRUE(Snapshot::open("SnapshotTest.snap").isCurrent(source));
+    for (const auto& entry : std::filesystem::directory_iterator("."))
+    {
+        const std::string name = entry.path().filename().string();
+        EXPECT_NE(0, name.rfind("SnapshotTest.snap.", 0)) << name;
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(SnapshotTest, corruption)
+{
+    auto root  = yayp::Parser().parse(source);
+    auto image = makeImage(*root);
+
+    // Any changed byte after the header fails the checksum
+    for (std::size_t i = 80; i < image.size() * 8; i += 13)
+    {
+        auto  corrupt = image;
+        char* bytes   = reinterpret_cast<char*>(corrupt.data());
+        bytes[i] ^= 0x10;
+        EXPECT_THROW(Snapshot::fromImage(view(corrupt)), yayp::Exception)
+            << i;
+
+        // A header-only check does not read the records
+        EXPECT_NO_THROW(
+            Snapshot::fromImage(view(corrupt), Snapshot::Verify::Header));
+    }
+
+    // Truncated images, bad magic and other versions
+    auto truncated = image;
+    truncated.pop_back();
+    EXPECT_THROW(Snapshot::fromImage(view(truncated)), yayp::Exception);
+    EXPECT_THROW(Snapshot::fromImage("not a snapshot"), yayp::Exception);
+
+    auto other_version = image;
+    reinterpret_cast<std::uint32_t*>(other_version.data())[2] += 1;
+    EXPECT_THROW(
+        Snapshot::fromImage(view(other_version), Snapshot::Verify::Header),
+        yayp::Exception);
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstSnapshot.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,230 @@
+//---------------------------------*-C++-*-----------------------------------//
+/*!
+ * \file   src/yaml/tests/tstStreamComparison.cc
+ * \brief  Tests for class StreamComparison.
+ * \note   Copyright (c) 2023 Oak Ridge National Laboratory, UT-Battelle, LLC.
+ */
+//---------------------------------------------------------------------------//
+
+#include "../StreamComparison.hh"
+
+#include <string>
+#include <vector>
+
+#include "harness/DBC.hh"
+#include "harness/Testing.hh"
+
+using yayp::StreamComparison;
+
+namespace
+{
+//---------------------------------------------------------------------------//
+const char golden[] = R"(
+name: run
+energy: 1.25
+counts: [1, 2, 3]
+flux: [0.5, 1.5, 2.5]
+tallies:
+  - cell: 1
+    value: 3.0e-5
+  - cell: 2
+    value: ~
+)";
+
+//---------------------------------------------------------------------------//
+//! Return the differences as "path: expected != actual" strings
+std::vector<std::string> describe(const StreamComparison& comparison)
+{
+    std::vector<std::string> result;
+    for (const auto& d : comparison.differences())
+    {
+        result.push_back((d.document > 0 ? std::to_string(d.document) + ":"
+                                         : std::string())
+                         + d.path + ": " + d.expected + " != " + d.actual);
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+} // end anonymous namespace
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+
+TEST(StreamComparisonTest, equal)
+{
+    StreamComparison comparison;
+    EXPECT_TRUE(comparison.compare(golden, golden));
+    EXPECT_EQ(0, comparison.count());
+    EXPECT_FALSE(comparison.mismatch());
+
+    // Numbers within the tolerance, other spellings and other styles
+    const char actual[] = R"(
+name: "run"
+energy: 1.2500000000000002
+counts:
+  - 1
+  - 2.0
+  - 0x3
+flux: [0.5, 1.5000000000000002, 2.5]
+tallies: [{cell: 1, value: 0.00003}, {cell: 2, value: null}]
+)";
+    EXPECT_TRUE(comparison.compare(golden, actual));
+    EXPECT_EQ(std::vector<std::string>(), describe(comparison));
+
+    // A looser tolerance
+    StreamComparison loose(1.0e-3);
+    EXPECT_EQ(1.0e-3, loose.relTol());
+    EXPECT_TRUE(loose.compare("[1.0, 2.0]", "[1.0001, 1.9999]"));
+    EXPECT_FALSE(comparison.compare("[1.0, 2.0]", "[1.0001, 1.9999]"));
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(StreamComparisonTest, values)
+{
+    // Unequal values are all reported by path, without stopping
+    const char actual[] = R"(
+name: walk
+energy: 1.26
+counts: [1, 2, 4]
+flux: [0.5, 1.6, 2.5]
+tallies:
+  - cell: 1
+    value: "3.0e-5"
+  - cell: 2
+    value: 0
+)";
+    StreamComparison comparison;
+    EXPECT_FALSE(comparison.compare(golden, actual));
+    EXPECT_FALSE(comparison.mismatch());
+    EXPECT_EQ(6, comparison.count());
+    const std::vector<std::string> expected = {
+        "name: run != walk",
+        "energy: 1.25 != 1.26",
+        "counts[2]: 3 != 4",
+        "flux[1]: 1.5 != 1.6",
+        "tallies[0].value: 3.0e-5 != \"3.0e-5\"",
+        "tallies[1].value: ~ != 0",
+    };
+    EXPECT_EQ(expected, describe(comparison));
+
+    // Aliases are compared by name, and keys are written as in a query
+    EXPECT_FALSE(comparison.compare("{a: &x 1, 'b.c': *x, '': [*x]}",
+                                    "{a: &y 1, 'b.c': *y, '': [1]}"));
+    EXPECT_EQ(
+        (std::vector<std::string>{"['b.c']: *x != *y", "[''][0]: *x != 1"}),
+        describe(comparison));
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(StreamComparisonTest, structure)
+{
+    StreamComparison comparison;
+    auto mismatch = [&comparison](const char* expected, const char* actual) {
+        EXPECT_FALSE(comparison.compare(expected, actual));
+        EXPECT_TRUE(comparison.mismatch());
+        if (!comparison.mismatch())
+        {
+            return std::string();
+        }
+        const auto& d = *comparison.mismatch();
+        return d.path + ": " + d.expected + " != " + d.actual;
+    };
+
+    // Values found before the mismatch are counted
+    EXPECT_EQ(": c != d",
+              mismatch("{a: 1, b: x, c: 3}", "{a: 2, b: y, d: 3}"));
+    EXPECT_EQ(2, comparison.count());
+
+    EXPECT_EQ("a: a mapping != a sequence", mismatch("a: {b: 1}", "a: [1]"));
+    EXPECT_EQ("a[2]: the end of the sequence != 3",
+              mismatch("a: [1, 2]", "a: [1, 2, 3]"));
+    EXPECT_EQ("a[1]: x != the end of the sequence",
+              mismatch("a: [1, x]", "a: [1]"));
+    EXPECT_EQ("a: the end of the mapping != b",
+              mismatch("a: {x: 1}", "a: {x: 1, b: 2}"));
+    EXPECT_EQ("x: 1 != a sequence", mismatch("x: 1", "x: [1]"));
+    EXPECT_EQ(": the end of the stream != the start of a document",
+              mismatch("a: 1", "a: 1\n---\na: 1"));
+
+    // Invalid input
+    const std::string invalid = mismatch("a: [1, 2", "a: [1, 2]");
+    EXPECT_EQ(0, invalid.find("a[2]: invalid YAML: Flow collection is not "
+                              "terminated at offset"))
+        << invalid;
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(StreamComparisonTest, documents)
+{
+    StreamComparison comparison;
+    EXPECT_TRUE(comparison.compare("a: 1\n---\nb: 2\n", "a: 1\n---\nb: 2\n"));
+    EXPECT_FALSE(
+        comparison.compare("a: 1\n---\nb: [2]\n", "a: 1\n---\nb: [3]\n"));
+    EXPECT_EQ((std::vector<std::string>{"1:b[0]: 2 != 3"}),
+              describe(comparison));
+}
+
+//---------------------------------------------------------------------------//
+
+TEST(StreamComparisonTest, packed)
+{
+    // Large packed sequences of each type, written in either style
+    std::string flow_floats   = "[";
+    std::string block_floats  = "";
+    std::string flow_ints     = "[";
+    std::string shifted_ints  = "[";
+    std::string flow_bools    = "[";
+    std::string changed_bools = "[";
+    for (int i = 0; i < 1000; ++i)
+    {
+        const std::string sep = i > 0 ? ", " : "";
+        flow_floats += sep + std::to_string(i) + ".5";
+        block_floats += "- " + std::to_string(i) + ".5\n";
+        flow_ints += sep + std::to_string(i);
+        shifted_ints += sep + std::to_string(i % 100 == 0 ? i + 1 : i);
+        flow_bools += sep + (i % 2 ? "true" : "false");
+        changed_bools += sep + (i % 2 || i == 10 ? "true" : "false");
+    }
+    flow_floats += "]";
+    flow_ints += "]";
+    shifted_ints += "]";
+    flow_bools += "]";
+    changed_bools += "]";
+
+    StreamComparison comparison;
+    EXPECT_TRUE(comparison.compare(flow_floats, flow_floats));
+    EXPECT_TRUE(comparison.compare(flow_floats, block_floats));
+    EXPECT_TRUE(comparison.compare(block_floats, flow_floats));
+    EXPECT_TRUE(comparison.compare(flow_ints, flow_ints));
+    EXPECT_TRUE(comparison.compare(flow_bools, flow_bools));
+
+    // Differences are all counted, but only the first are stored
+    EXPECT_FALSE(comparison.compare(flow_ints, shifted_ints));
+    EXPECT_EQ(10, comparison.count());
+    EXPECT_EQ("[100]: 100 != 101", describe(comparison)[1]);
+    EXPECT_FALSE(comparison.compare(flow_bools, changed_bools));
+    EXPECT_EQ((std::vector<std::string>{"[10]: false != true"}),
+              describe(comparison));
+
+    EXPECT_FALSE(comparison.compare(flow_floats, flow_ints));
+    EXPECT_EQ(1000, comparison.count());
+    EXPECT_EQ(StreamComparison::max_stored, comparison.differences().size());
+    EXPECT_EQ("[0]: 0.5 != 0", describe(comparison).front());
+    EXPECT_EQ("[29]: 29.5 != 29", describe(comparison).back());
+
+    // Packed sequences of different lengths or types
+    EXPECT_FALSE(comparison.compare("[1, 2, 3]", "[1, 2]"));
+    EXPECT_EQ("[2]", comparison.mismatch()->path);
+    EXPECT_FALSE(comparison.compare("[1, 2]", "[true, false]"));
+    EXPECT_EQ(2, comparison.count());
+    EXPECT_FALSE(comparison.mismatch());
+}
+
+//---------------------------------------------------------------------------//
+// end of src/yaml/tests/tstStreamComparison.cc
+//---------------------------------------------------------------------------//